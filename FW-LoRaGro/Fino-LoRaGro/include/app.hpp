@@ -4,18 +4,34 @@
 
 #include "power_rail_3v3.hpp"
 #include "sample_manager.hpp"
-#include "sensors/env_sensor_adapter.hpp"
+#include "sensors/bme280_adapter.hpp"
 #include "sensors/light_sensor_adapter.hpp"
 #include "sensors/co2_sensor_adapter.hpp"
-#include "sensors/soil_3in1_adapter.hpp"
+#include "sensors/soil_probe_bus.hpp"
+#include "sensors/soil_3in1_sim_probe.hpp"
 #include "sensors/soil_capacitive_adapter.hpp"
 #include "sensors/battery_sense.hpp"
+#include "sensors/energy_sensor_adapter.hpp"
 #include "lora/lora_interface.hpp"
 #include "lora/lora_auth.hpp"
 #include "lora/lora_frame_codec.hpp"
 #include "lora/lora_protocol_handler.hpp"
+#include "modbus/modbus_rtu.hpp"
+#include "modbus/modbus_sim_slave.hpp"
+#include "modbus/modbus_uart_transport.hpp"
+#include "bme280/bme280_forced.hpp"
+#include "bme280/bme280_sim.hpp"
+#include "scd41/scd41_bus.hpp"
+#ifdef CONFIG_SENSOR_P4V_SCD41_FAKE
+#include "scd41/scd41_fake_bus.hpp"
+#endif
 #include "config_manager.hpp"
 #include "power_management.hpp"
+#include "energy_ledger.hpp"
+#include "cycle_profiler.hpp"
+
+/* 3-in-1 soil probes described in devicetree (depth hints, simulated slaves) */
+#define SOIL_PROBE_DT_COUNT DT_NUM_INST_STATUS_OKAY(p4v_sensor_soil3in1_fake)
 
 namespace loragro
 {
@@ -28,9 +44,11 @@ namespace loragro
         int init();
         void run();
 
+        /* One wake-up, sleep included; run() loops it, benchmarks call it directly */
+        void run_cycle();
+
     private:
         int register_sensors();
-        void run_cycle();
 
     private:
         /* ---- Core ---- */
@@ -47,13 +65,38 @@ namespace loragro
         ProtocolHandler rx_handler_;
         PowerManagement pwr_mgr_;
 
+        /* ---- RS485 Modbus bus ---- */
+#ifdef CONFIG_SOIL_SENSOR_MODBUS_FAKE
+        ModbusSimSlave modbus_transport_;
+        Soil3in1SimProbe soil_probe_sim_[SOIL_PROBE_DT_COUNT];
+#else
+        ModbusUartTransport modbus_transport_;
+#endif
+        ModbusRtuClient modbus_;
+
+        /* ---- BME280 on I2C ---- */
+#ifdef CONFIG_SENSOR_P4V_BME280_FAKE
+        Bme280Sim env_bus_;
+#else
+        Bme280I2cBus env_bus_;
+#endif
+        Bme280Forced env_driver_;
+
+        /* ---- SCD41 on I2C ---- */
+#ifdef CONFIG_SENSOR_P4V_SCD41_FAKE
+        Scd41FakeBus co2_bus_;
+#else
+        Scd41I2cBus co2_bus_;
+#endif
+
         /* ---- Sensors (persistent instances) ---- */
-        EnvSensorAdapter env_sensor_;
+        Bme280Adapter env_sensor_;
         LightSensorAdapter light_sensor_;
         CO2SensorAdapter co2_sensor_;
-        SoilSensor3in1ModbusAdapter soil_3in1_sensor_;
+        SoilProbeBus<CONFIG_LORAGRO_SOIL_PROBES_MAX> soil_probes_;
         SoilCapacitiveSensor soil_analog_sensor_;
         BatterySenseAdapter battery_sense_;
+        EnergySensorAdapter energy_sensor_;
     };
 
 } // namespace loragro
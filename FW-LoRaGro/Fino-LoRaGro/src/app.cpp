@@ -1,20 +1,45 @@
 #include "app.hpp"
 
-LOG_MODULE_REGISTER(app, LOG_LEVEL_DBG);
+#ifdef CONFIG_SX1262_BSIM_NODE_ID
+#include "lora/sx1262_bsim.hpp"
+#endif
+
+LOG_MODULE_REGISTER(app, CONFIG_LORAGRO_APP_LOG_LEVEL);
 
 /* ---- Device tree bindings ---- */
 
-static const struct device *const envi_dev =
-    DEVICE_DT_GET(DT_ALIAS(environmental_sensor));
+/* BME280, read by the native forced mode driver */
+#ifndef CONFIG_SENSOR_P4V_BME280_FAKE
+static const struct i2c_dt_spec env_i2c =
+    I2C_DT_SPEC_GET(DT_ALIAS(environmental_sensor));
+#endif
 
 static const struct device *const light_dev =
     DEVICE_DT_GET(DT_ALIAS(light_sensor));
 
+/* SCD41, single-shot commands over I2C */
+#ifdef CONFIG_SENSOR_P4V_SCD41_FAKE
 static const struct device *const co2_dev =
     DEVICE_DT_GET(DT_ALIAS(co2_sensor));
+#else
+static const struct i2c_dt_spec co2_i2c =
+    I2C_DT_SPEC_GET(DT_ALIAS(co2_sensor));
+#endif
+
+/* RS485 bus the soil probes hang on */
+#define SOIL_PROBE_NODE DT_ALIAS(soil_sensor)
+#define SOIL_BUS_BAUDRATE DT_PROP(DT_PARENT(SOIL_PROBE_NODE), current_speed)
+
+#ifndef CONFIG_SOIL_SENSOR_MODBUS_FAKE
+static const struct device *const modbus_uart_dev =
+    DEVICE_DT_GET(DT_PARENT(SOIL_PROBE_NODE));
+#endif
 
-static const struct device *const soil_modbus_dev =
-    DEVICE_DT_GET(DT_ALIAS(soil_sensor));
+/* Installation depth per probe address, the bus scan finds the probes */
+#define SOIL_PROBE_HINT(node) {DT_PROP(node, slave_address), DT_PROP(node, depth_cm)},
+
+static constexpr loragro::SoilProbeHint soil_probe_hints[] = {
+    DT_FOREACH_STATUS_OKAY(p4v_sensor_soil3in1_fake, SOIL_PROBE_HINT)};
 
 static const struct device *const adc_dev =
     DEVICE_DT_GET(DT_ALIAS(adc0));
@@ -32,20 +57,36 @@ loragro::App::App()
       lora_transceiver_(lora_dev, cfg_.get(), auth_),
       tx_codec_(cfg_),
       rx_handler_(cfg_),
-      pwr_mgr_(sample_mgr_, loragro::SensorID::BATTERY_VOLTAGE, cfg_.get()),
-      env_sensor_(envi_dev,
+      pwr_mgr_(battery_sense_, cfg_.get(), lora_dev),
+#ifdef CONFIG_SOIL_SENSOR_MODBUS_FAKE
+      modbus_transport_(SOIL_BUS_BAUDRATE),
+#else
+      modbus_transport_(modbus_uart_dev, SOIL_BUS_BAUDRATE),
+#endif
+      modbus_(modbus_transport_, SOIL_BUS_BAUDRATE),
+#ifndef CONFIG_SENSOR_P4V_BME280_FAKE
+      env_bus_(env_i2c),
+#endif
+      env_driver_(env_bus_),
+#ifdef CONFIG_SENSOR_P4V_SCD41_FAKE
+      co2_bus_(co2_dev),
+#else
+      co2_bus_(co2_i2c),
+#endif
+      env_sensor_(env_driver_,
                   SensorID::ENV_TEMP,
                   SensorID::ENV_RH,
                   SensorID::ENV_PRESS),
       light_sensor_(light_dev, SensorID::AMB_LIGHT),
-      co2_sensor_(co2_dev,
+      co2_sensor_(co2_bus_,
                   SensorID::CO2_CONC,
                   SensorID::CO2_TEMP,
                   SensorID::CO2_RH),
-      soil_3in1_sensor_(soil_modbus_dev,
-                        SensorID::SOIL_MOISTURE,
-                        SensorID::SOIL_TEMP,
-                        SensorID::SOIL_EC),
+      soil_probes_(modbus_,
+                   CONFIG_LORAGRO_SOIL_PROBE_SCAN_FIRST,
+                   CONFIG_LORAGRO_SOIL_PROBE_SCAN_LAST,
+                   soil_probe_hints,
+                   ARRAY_SIZE(soil_probe_hints)),
       soil_analog_sensor_(adc_dev,
                           SensorID::SOIL_ANALOG_MOISTURE),
       battery_sense_(adc_dev,
@@ -60,8 +101,26 @@ loragro::App::App()
 int loragro::App::init()
 {
     cfg_.load();
+
+#ifdef CONFIG_SX1262_BSIM_NODE_ID
+    /* Every bsim device runs this image, the device number makes the node ID */
+    loragro::DeviceConfig &stored = cfg_.get();
+    const uint16_t bsim_id = loragro::make_combined_id(loragro::extract_gateway(stored.combined_id),
+                                                       static_cast<uint16_t>(sx1262_bsim_device_number()));
+    if (stored.combined_id != bsim_id)
+    {
+        stored.combined_id = bsim_id;
+        cfg_.save();
+    }
+#endif
+
     dev_cfg_ = cfg_.get();
 
+#ifdef CONFIG_LORAGRO_FRAME_TRACE_DUMP_ON_BOOT
+    /* Frames of the previous run, for tools/frametrace */
+    FrameTrace::instance().dump();
+#endif
+
     LOG_DBG("Device ID: %d",
             loragro::extract_node(dev_cfg_.combined_id));
 
@@ -85,17 +144,33 @@ int loragro::App::register_sensors()
 {
     LOG_DBG("Registering sensors");
 
-    if (device_is_ready(envi_dev))
+#ifdef CONFIG_SENSOR_P4V_BME280_FAKE
+    sample_mgr_.add_sensor(&env_sensor_);
+#else
+    if (env_bus_.ready())
         sample_mgr_.add_sensor(&env_sensor_);
+#endif
 
     if (device_is_ready(light_dev))
         sample_mgr_.add_sensor(&light_sensor_);
 
-    if (device_is_ready(co2_dev))
+    if (co2_bus_.ready())
         sample_mgr_.add_sensor(&co2_sensor_);
 
-    if (device_is_ready(soil_modbus_dev))
-        sample_mgr_.add_sensor(&soil_3in1_sensor_);
+#ifdef CONFIG_SOIL_SENSOR_MODBUS_FAKE
+    /* Simulated probes answer on their DT slave addresses */
+    for (size_t i = 0; i < ARRAY_SIZE(soil_probe_hints); ++i)
+    {
+        soil_probe_sim_[i] = Soil3in1SimProbe(soil_probe_hints[i].depth_cm);
+        modbus_transport_.add_slave(soil_probe_hints[i].slave_addr,
+                                    &Soil3in1SimProbe::read, &soil_probe_sim_[i]);
+    }
+    sample_mgr_.add_sensor(&soil_probes_);
+#else
+    /* Probes sit behind the switched rail, the bus is scanned in init_all() until one answers */
+    if (modbus_transport_.init() == 0)
+        sample_mgr_.add_sensor(&soil_probes_);
+#endif
 
     if (device_is_ready(adc_dev) && soil_analog_sensor_.is_connected())
         sample_mgr_.add_sensor(&soil_analog_sensor_);
@@ -103,6 +178,9 @@ int loragro::App::register_sensors()
     if (device_is_ready(adc_dev) && battery_sense_.is_connected())
         sample_mgr_.add_sensor(&battery_sense_);
 
+    if (IS_ENABLED(CONFIG_LORAGRO_ENERGY_TELEMETRY))
+        sample_mgr_.add_sensor(&energy_sensor_);
+
     return 0;
 }
 
@@ -127,23 +205,58 @@ void loragro::App::run()
 
 void loragro::App::run_cycle()
 {
+    EnergyLedger &energy = EnergyLedger::instance();
+    energy.begin_cycle();
+    CycleProfiler &profiler = CycleProfiler::instance();
+    profiler.begin_cycle();
+
+    /* Handoff from the sleep that just ended */
+    const WakeInfo &wake = pwr_mgr_.wake_info();
+    if (wake.reason == WakeReason::BATTERY_RECOVERED)
+    {
+        LOG_INF("Back from recovery mode: %u min, %u checks, battery %d mV",
+                wake.recovery_s / 60, wake.recovery_checks, wake.battery_mv);
+    }
+    else if (wake.reason == WakeReason::BATTERY_UNKNOWN)
+    {
+        LOG_WRN("Left recovery mode after %u min, battery unreadable",
+                wake.recovery_s / 60);
+    }
+
+    profiler.start(CyclePhase::CONFIG_LOAD);
     cfg_.load();
     dev_cfg_ = cfg_.get();
+    profiler.stop(CyclePhase::CONFIG_LOAD);
+
+    profiler.start(CyclePhase::RAIL_ON);
     regulator_.powerOn();
+    profiler.stop(CyclePhase::RAIL_ON);
 
+    profiler.start(CyclePhase::INIT);
     sample_mgr_.init_all();
+
+    /* Keep TX sag above cutoff, the stored config is left untouched */
+    dev_cfg_.lora.tx_power = MIN(dev_cfg_.lora.tx_power, pwr_mgr_.tx_power_cap_dbm());
     lora_transceiver_.init(dev_cfg_);
     auth_.init_key();
+    profiler.stop(CyclePhase::INIT);
 
+    profiler.start(CyclePhase::SAMPLE);
     sample_mgr_.sample_all();
     auto batch = sample_mgr_.get_batch();
+    profiler.stop(CyclePhase::SAMPLE);
 
+    profiler.start(CyclePhase::ENCODE);
     tx_codec_.begin(batch);
+    profiler.stop(CyclePhase::ENCODE);
 
     std::array<uint8_t, 255> au8Frame;
     size_t max_payload = lora_transceiver_.get_max_payload();
     size_t usable_payload = max_payload - FrameLayout::AUTH_SIZE;
 
+    /* Lets the slot scheduler wake us early enough for the first frame to hit the slot */
+    pwr_mgr_.mark_tx_start();
+
     uint8_t sent_frame_count = 0;
     while (tx_codec_.has_frame_to_send())
     {
@@ -156,12 +269,16 @@ void loragro::App::run_cycle()
 
         au8Frame.fill(0);
 
+        profiler.start(CyclePhase::ENCODE);
         int len = tx_codec_.build_frame(au8Frame.begin(), usable_payload);
+        profiler.stop(CyclePhase::ENCODE);
         if (len <= 0)
             break;
 
+        profiler.start(CyclePhase::SIGN);
         if (auth_.sign_frame(au8Frame.begin(), len, max_payload) < 0)
             LOG_ERR("Frame Auth Failed");
+        profiler.stop(CyclePhase::SIGN);
 
         uint8_t frame_nmbr = tx_codec_.get_frame_number(au8Frame.begin(), len);
         len += FrameLayout::AUTH_SIZE;
@@ -177,9 +294,14 @@ void loragro::App::run_cycle()
     /* Only 1 RX for each sleep cycle */
     au8Frame.fill(0);
 
+    profiler.start(CyclePhase::RX);
     int received = lora_transceiver_.receive(au8Frame.begin(), max_payload);
+    profiler.stop(CyclePhase::RX);
     if (received > 0)
     {
+        /* TX of the RESPONSE is counted by the interface, not here */
+        profiler.start(CyclePhase::DOWNLINK);
+
         const uint8_t *tag = au8Frame.begin() + (received - FrameLayout::AUTH_SIZE);
         const uint8_t data_len = (received - FrameLayout::AUTH_SIZE);
         const uint8_t frame_ctr = au8Frame[FrameLayout::FRAME_CTR];
@@ -209,16 +331,25 @@ void loragro::App::run_cycle()
                     LOG_ERR("Response Frame Auth Failed");
                 else
                 {
+                    profiler.stop(CyclePhase::DOWNLINK);
                     lora_transceiver_.send_response(au8Frame.begin(), len);
-                    LOG_HEXDUMP_INF(au8Frame.begin(), len + 4, "Respond:");
+                    LOG_HEXDUMP_DBG(au8Frame.begin(), len + 4, "Respond:");
                 }
             }
         }
+        profiler.stop(CyclePhase::DOWNLINK);
     }
 
     regulator_.powerOff();
 
+    profiler.start(CyclePhase::FLASH_SAVE);
+    FrameTrace::instance().flush();
     cfg_.save();
+    profiler.stop(CyclePhase::FLASH_SAVE);
+    energy.end_cycle();
     LOG_DBG("\n\n");
+
+    /* Closed by the scheduler right before the k_sleep */
+    profiler.start(CyclePhase::SLEEP_CALC);
     pwr_mgr_.handle_sleep();
 }
@@ -7,7 +7,7 @@
 
 #include "app.hpp"
 
-LOG_MODULE_REGISTER(main, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(main, CONFIG_LORAGRO_APP_LOG_LEVEL);
 
 static loragro::App app;
 
@@ -0,0 +1,457 @@
+// sx1262_bsim.cpp
+#define DT_DRV_COMPAT p4v_sx1262_bsim
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/irq.h>
+#include <zephyr/drivers/lora.h>
+#include <zephyr/drivers/clock_control/nrf_clock_control.h>
+#include <zephyr/sys/onoff.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include <hal/nrf_radio.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <cmath>
+
+#include "bsim_args_runner.h"
+
+#include "lora/lora_protocol.hpp"
+#include "lora/sx1262_bsim.hpp"
+
+using namespace loragro;
+
+LOG_MODULE_REGISTER(sx1262_bsim, CONFIG_LORAGRO_SIM_DRIVERS_LOG_LEVEL);
+
+/* =========================================================
+ * Packet train layout
+ *
+ *   [magic][sf][seq lo][seq hi][count lo][count hi][LoRa frame]
+ *
+ * Every packet repeats the whole frame, the receiver keeps the first
+ * copy and only checks that the sequence is complete.
+ * ========================================================= */
+#define TRAIN_MAGIC 0x4C // 'L'
+#define TRAIN_HEADER_SIZE 6
+#define MAX_FRAME_SIZE 242 // SF7 payload limit, keeps a packet below 255 bytes
+#define MAX_PACKET_SIZE (TRAIN_HEADER_SIZE + MAX_FRAME_SIZE)
+
+/* BLE 1M on air: preamble 1, address 4, length 1, CRC 3 bytes, 8 us per byte */
+#define PACKET_OVERHEAD_BYTES 9
+#define US_PER_BYTE 8
+
+/* Longest packet plus ramp-up, the radio is stuck if END does not come by then */
+#define PACKET_TIMEOUT K_USEC((PACKET_OVERHEAD_BYTES + 255) * US_PER_BYTE + 200)
+
+/* SNR is not simulated, it is the RSSI above this floor */
+#define NOISE_FLOOR_DBM (-100)
+
+/* =========================================================
+ * Driver config + data
+ * ========================================================= */
+struct sx1262_bsim_config
+{
+    uint16_t channel_base_mhz;
+    uint16_t chunk_gap_us;
+};
+
+struct sx1262_bsim_data
+{
+    /* Modem settings from lora_config(), drive the airtime */
+    uint8_t sf;
+    uint32_t bw_hz;
+    uint8_t cr;
+    uint16_t preamble_len;
+
+    struct k_sem address_sem; // RADIO ADDRESS: a packet started
+    struct k_sem done_sem;    // RADIO DISABLED: TX or RX finished
+
+    /* RADIO EasyDMA buffer, one packet */
+    uint8_t packet[1 + MAX_PACKET_SIZE];
+};
+
+/* =========================================================
+ * Airtime calculation (SX126x formula, same as the fake driver)
+ * ========================================================= */
+static uint32_t lora_airtime_us(uint8_t sf, uint32_t bw_hz, uint8_t cr,
+                                uint16_t payload_len, uint16_t preamble_len)
+{
+    const float DE = (sf >= 11) ? 1.0f : 0.0f;
+    const float H = 0.0f;
+    const float tsym = powf(2.0f, sf) / static_cast<float>(bw_hz);
+    const float tpreamble = (preamble_len + 4.25f) * tsym;
+
+    float tmp = (8.0f * payload_len - 4.0f * sf + 28.0f + 16.0f - 20.0f * H) /
+                (4.0f * (sf - 2.0f * DE));
+    if (tmp < 0.0f)
+        tmp = 0.0f;
+
+    float payloadSymbNb = 8.0f + ceilf(tmp) * (cr + 4);
+    float tpacket = tpreamble + payloadSymbNb * tsym;
+    return static_cast<uint32_t>(tpacket * 1000000.0f);
+}
+
+/* =========================================================
+ * RADIO
+ * ========================================================= */
+static void radio_isr(const void *arg)
+{
+    const struct device *dev = (const struct device *)arg;
+    struct sx1262_bsim_data *data = (struct sx1262_bsim_data *)dev->data;
+
+    if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_ADDRESS))
+    {
+        nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_ADDRESS);
+        k_sem_give(&data->address_sem);
+    }
+
+    if (nrf_radio_event_check(NRF_RADIO, NRF_RADIO_EVENT_DISABLED))
+    {
+        nrf_radio_event_clear(NRF_RADIO, NRF_RADIO_EVENT_DISABLED);
+        k_sem_give(&data->done_sem);
+    }
+}
+
+static void radio_start(struct sx1262_bsim_data *data, nrf_radio_task_t task)
+{
+    k_sem_reset(&data->address_sem);
+    k_sem_reset(&data->done_sem);
+
+    nrf_radio_packetptr_set(NRF_RADIO, data->packet);
+    nrf_radio_task_trigger(NRF_RADIO, task);
+}
+
+static void radio_stop(struct sx1262_bsim_data *data)
+{
+    nrf_radio_task_trigger(NRF_RADIO, NRF_RADIO_TASK_DISABLE);
+    k_sem_take(&data->done_sem, PACKET_TIMEOUT);
+}
+
+static void radio_set_channel(const struct device *dev)
+{
+    const struct sx1262_bsim_config *cfg = (const struct sx1262_bsim_config *)dev->config;
+    const struct sx1262_bsim_data *data = (const struct sx1262_bsim_data *)dev->data;
+
+    nrf_radio_frequency_set(NRF_RADIO, cfg->channel_base_mhz + 2U * (data->sf - 7U));
+}
+
+static int radio_setup(const struct device *dev)
+{
+    /* The RADIO needs the HF crystal */
+    struct onoff_manager *hf = z_nrf_clock_control_get_onoff(CLOCK_CONTROL_NRF_SUBSYS_HF);
+    struct onoff_client cli;
+    int res = 0;
+
+    sys_notify_init_spinwait(&cli.notify);
+    int ret = onoff_request(hf, &cli);
+    if (ret < 0)
+        return ret;
+
+    while (sys_notify_fetch_result(&cli.notify, &res) == -EAGAIN)
+        k_busy_wait(10);
+    if (res < 0)
+        return res;
+
+    nrf_radio_power_set(NRF_RADIO, true);
+    nrf_radio_mode_set(NRF_RADIO, NRF_RADIO_MODE_BLE_1MBIT);
+    nrf_radio_fast_ramp_up_enable_set(NRF_RADIO, true);
+    nrf_radio_txpower_set(NRF_RADIO, NRF_RADIO_TXPOWER_0DBM);
+
+    nrf_radio_packet_conf_t conf{};
+    conf.lflen = 8;
+    conf.s0len = 0;
+    conf.s1len = 0;
+    conf.plen = NRF_RADIO_PREAMBLE_LENGTH_8BIT;
+    conf.maxlen = MAX_PACKET_SIZE;
+    conf.statlen = 0;
+    conf.balen = 3;
+    conf.big_endian = false;
+    conf.whiteen = true;
+    nrf_radio_packet_configure(NRF_RADIO, &conf);
+
+    nrf_radio_base0_set(NRF_RADIO, 0x4C6F5200); // "LoR"
+    nrf_radio_prefix0_set(NRF_RADIO, 0x61);     // "a"
+    nrf_radio_txaddress_set(NRF_RADIO, 0);
+    nrf_radio_rxaddresses_set(NRF_RADIO, BIT(0));
+
+    nrf_radio_crc_configure(NRF_RADIO, 3, NRF_RADIO_CRC_ADDR_SKIP, 0x00065B);
+    nrf_radio_crcinit_set(NRF_RADIO, 0x555555);
+    nrf_radio_datawhiteiv_set(NRF_RADIO, 0x25);
+
+    nrf_radio_shorts_set(NRF_RADIO, NRF_RADIO_SHORT_READY_START_MASK |
+                                        NRF_RADIO_SHORT_END_DISABLE_MASK |
+                                        NRF_RADIO_SHORT_ADDRESS_RSSISTART_MASK);
+    nrf_radio_int_enable(NRF_RADIO, NRF_RADIO_INT_ADDRESS_MASK | NRF_RADIO_INT_DISABLED_MASK);
+
+    radio_set_channel(dev);
+    return 0;
+}
+
+/* =========================================================
+ * API: config
+ * ========================================================= */
+static int bsim_lora_config(const struct device *dev,
+                            struct lora_modem_config *config)
+{
+    struct sx1262_bsim_data *data = (struct sx1262_bsim_data *)dev->data;
+
+    if (!config || config->datarate < SF_7 || config->datarate > SF_12)
+        return -EINVAL;
+
+    data->sf = static_cast<uint8_t>(config->datarate);
+    data->cr = static_cast<uint8_t>(config->coding_rate);
+    data->preamble_len = config->preamble_len ? config->preamble_len : 8;
+
+    switch (config->bandwidth)
+    {
+    case BW_250_KHZ:
+        data->bw_hz = 250000;
+        break;
+    case BW_500_KHZ:
+        data->bw_hz = 500000;
+        break;
+    default:
+        data->bw_hz = 125000;
+        break;
+    }
+
+    radio_set_channel(dev);
+    return 0;
+}
+
+/* =========================================================
+ * API: send — one packet train for the LoRa airtime
+ * ========================================================= */
+static int bsim_lora_send(const struct device *dev,
+                          uint8_t *buf,
+                          uint32_t len)
+{
+    const struct sx1262_bsim_config *cfg = (const struct sx1262_bsim_config *)dev->config;
+    struct sx1262_bsim_data *data = (struct sx1262_bsim_data *)dev->data;
+
+    if (!buf || len < FrameLayout::HEADER_SIZE || len > MAX_FRAME_SIZE)
+        return -EINVAL;
+
+    const uint32_t air_us = lora_airtime_us(data->sf, data->bw_hz, data->cr,
+                                            static_cast<uint16_t>(len), data->preamble_len);
+    const uint32_t packet_us = (PACKET_OVERHEAD_BYTES + TRAIN_HEADER_SIZE + len) * US_PER_BYTE;
+    const uint32_t count = CLAMP(DIV_ROUND_UP(air_us, packet_us + cfg->chunk_gap_us), 1U, UINT16_MAX);
+
+    LOG_INF("TX id=0x%04x type=0x%02x ctr=%u len=%u air_ms=%u",
+            read_u16_le(buf, 0), buf[FrameLayout::FRAME_TYPE], buf[FrameLayout::FRAME_CTR],
+            len, air_us / 1000);
+
+    uint8_t *pdu = data->packet;
+    pdu[0] = static_cast<uint8_t>(TRAIN_HEADER_SIZE + len);
+    pdu[1] = TRAIN_MAGIC;
+    pdu[2] = data->sf;
+    write_u16_le(pdu, 5, static_cast<uint16_t>(count));
+    memcpy(pdu + 1 + TRAIN_HEADER_SIZE, buf, len);
+
+    const int64_t start = k_uptime_ticks();
+
+    for (uint32_t seq = 0; seq < count; ++seq)
+    {
+        write_u16_le(pdu, 3, static_cast<uint16_t>(seq));
+
+        radio_start(data, NRF_RADIO_TASK_TXEN);
+        if (k_sem_take(&data->done_sem, PACKET_TIMEOUT) != 0)
+        {
+            radio_stop(data);
+            return -EIO;
+        }
+
+        k_busy_wait(cfg->chunk_gap_us);
+    }
+
+    /* Rounding of the train, lora_send() returns at the end of the LoRa airtime */
+    const int64_t spent_us = k_ticks_to_us_floor64(k_uptime_ticks() - start);
+    if (spent_us < air_us)
+        k_busy_wait(static_cast<uint32_t>(air_us - spent_us));
+
+    return 0;
+}
+
+/* =========================================================
+ * API: recv — reassemble one complete train
+ * ========================================================= */
+static int bsim_lora_recv(const struct device *dev,
+                          uint8_t *buf,
+                          uint8_t size,
+                          k_timeout_t timeout,
+                          int16_t *rssi,
+                          int8_t *snr)
+{
+    const struct sx1262_bsim_config *cfg = (const struct sx1262_bsim_config *)dev->config;
+    struct sx1262_bsim_data *data = (struct sx1262_bsim_data *)dev->data;
+
+    if (!buf)
+        return -EINVAL;
+
+    const k_timepoint_t end = sys_timepoint_calc(timeout);
+
+    /* Train being received */
+    bool in_train = false;
+    uint16_t next_seq = 0;
+    uint16_t count = 0;
+    uint8_t frame_len = 0;
+    int16_t frame_rssi = 0;
+    k_timeout_t next_packet = K_NO_WAIT;
+
+    while (true)
+    {
+        /* The timeout covers the start of a frame, like the preamble detection of the SX1262 */
+        const k_timeout_t wait = in_train ? next_packet : sys_timepoint_timeout(end);
+
+        radio_start(data, NRF_RADIO_TASK_RXEN);
+
+        if (k_sem_take(&data->address_sem, wait) != 0)
+        {
+            radio_stop(data);
+            if (!in_train)
+                return -EAGAIN;
+
+            LOG_DBG("Train lost at %u/%u", next_seq, count);
+            in_train = false;
+            continue;
+        }
+
+        if (k_sem_take(&data->done_sem, PACKET_TIMEOUT) != 0)
+        {
+            radio_stop(data);
+            in_train = false;
+            continue;
+        }
+
+        const uint8_t *pdu = data->packet;
+        const bool valid = nrf_radio_crc_status_check(NRF_RADIO) &&
+                           pdu[0] >= TRAIN_HEADER_SIZE + FrameLayout::HEADER_SIZE &&
+                           pdu[1] == TRAIN_MAGIC && pdu[2] == data->sf;
+        const uint16_t seq = valid ? read_u16_le(pdu, 3) : 0;
+        const uint8_t len = valid ? static_cast<uint8_t>(pdu[0] - TRAIN_HEADER_SIZE) : 0;
+
+        if (!valid)
+        {
+            /* Collision, the rest of the train is worthless */
+            in_train = false;
+            continue;
+        }
+
+        if (seq == 0)
+        {
+            if (len > size)
+            {
+                in_train = false;
+                continue;
+            }
+
+            count = read_u16_le(pdu, 5);
+            frame_len = len;
+            frame_rssi = -static_cast<int16_t>(nrf_radio_rssi_sample_get(NRF_RADIO));
+            memcpy(buf, pdu + 1 + TRAIN_HEADER_SIZE, len);
+
+            const uint32_t packet_us = (PACKET_OVERHEAD_BYTES + TRAIN_HEADER_SIZE + len) * US_PER_BYTE;
+            next_packet = K_USEC(packet_us + cfg->chunk_gap_us + 100);
+            next_seq = 1;
+            in_train = true;
+        }
+        else if (!in_train || seq != next_seq || len != frame_len ||
+                 memcmp(buf, pdu + 1 + TRAIN_HEADER_SIZE, len) != 0)
+        {
+            in_train = false;
+            continue;
+        }
+        else
+        {
+            next_seq++;
+        }
+
+        if (next_seq == count)
+            break;
+    }
+
+    if (rssi)
+        *rssi = frame_rssi;
+    if (snr)
+        *snr = static_cast<int8_t>(CLAMP(frame_rssi - NOISE_FLOOR_DBM, -20, 20));
+
+    LOG_INF("RX id=0x%04x type=0x%02x ctr=%u len=%u rssi=%d",
+            read_u16_le(buf, 0), buf[FrameLayout::FRAME_TYPE], buf[FrameLayout::FRAME_CTR],
+            frame_len, frame_rssi);
+
+    return frame_len;
+}
+
+static const struct lora_driver_api sx1262_bsim_api = {
+    .config = bsim_lora_config,
+    .send = bsim_lora_send,
+    .recv = bsim_lora_recv,
+};
+
+/* =========================================================
+ * Init
+ * ========================================================= */
+static int sx1262_bsim_init(const struct device *dev)
+{
+    struct sx1262_bsim_data *data = (struct sx1262_bsim_data *)dev->data;
+
+    k_sem_init(&data->address_sem, 0, 1);
+    k_sem_init(&data->done_sem, 0, 1);
+
+    /* SF12 / 125 kHz / 4/5 until lora_config() says otherwise */
+    data->sf = 12;
+    data->bw_hz = 125000;
+    data->cr = 1;
+    data->preamble_len = 8;
+
+    IRQ_CONNECT(RADIO_IRQn, 1, radio_isr, DEVICE_DT_INST_GET(0), 0);
+    irq_enable(RADIO_IRQn);
+
+    int ret = radio_setup(dev);
+    if (ret < 0)
+    {
+        LOG_ERR("RADIO setup failed (%d)", ret);
+        return ret;
+    }
+
+    LOG_INF("bsim device %u on the shared medium", sx1262_bsim_device_number());
+    return 0;
+}
+
+extern "C"
+{
+    uint32_t sx1262_bsim_airtime_us(const struct device *dev, uint32_t len)
+    {
+        const struct sx1262_bsim_data *data = (const struct sx1262_bsim_data *)dev->data;
+        return lora_airtime_us(data->sf, data->bw_hz, data->cr,
+                               static_cast<uint16_t>(len), data->preamble_len);
+    }
+
+    uint32_t sx1262_bsim_device_number(void)
+    {
+        return get_device_nbr();
+    }
+}
+
+/* =========================================================
+ * Device instantiation, one RADIO so one instance
+ * ========================================================= */
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1, "One p4v,sx1262-bsim per image");
+
+#define SX1262_BSIM_DEFINE(inst)                                          \
+    static struct sx1262_bsim_data sx1262_bsim_data_##inst;               \
+    static const struct sx1262_bsim_config sx1262_bsim_config_##inst = {  \
+        .channel_base_mhz = DT_INST_PROP(inst, channel_base_mhz),         \
+        .chunk_gap_us = DT_INST_PROP(inst, chunk_gap_us),                 \
+    };                                                                    \
+    DEVICE_DT_INST_DEFINE(inst,                                           \
+                          sx1262_bsim_init,                               \
+                          NULL,                                           \
+                          &sx1262_bsim_data_##inst,                       \
+                          &sx1262_bsim_config_##inst,                     \
+                          POST_KERNEL,                                    \
+                          CONFIG_SX1262_BSIM_INIT_PRIORITY,               \
+                          &sx1262_bsim_api);
+
+DT_INST_FOREACH_STATUS_OKAY(SX1262_BSIM_DEFINE)
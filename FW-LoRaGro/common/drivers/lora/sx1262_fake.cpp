@@ -13,24 +13,41 @@
 
 #include "lora/lora_protocol.hpp"
 #include "lora/lora_auth.hpp"
+#include "lora/sx1262_fake.hpp"
 #include "config_manager.hpp"
 
 using namespace loragro;
 
-LOG_MODULE_REGISTER(sx1262_fake, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(sx1262_fake, CONFIG_LORAGRO_SIM_DRIVERS_LOG_LEVEL);
 
 #define MAX_TX_SIZE 256
 
+/* Wall clock the fake gateway hands out in SET_UNIX_TIME_MS (2026-01-01 00:00:00 UTC) */
+#define FAKE_GW_EPOCH_MS 1767225600000ULL
+
 /* =========================================================
  * Driver config + data
  * ========================================================= */
 struct sx1262_fake_config
 {
     uint16_t gw_combined_id{0x801}; // from DT property gw-combined-id
+    struct sx1262_fake_channel channel;
+    uint32_t seed;
 };
 
 struct sx1262_fake_data
 {
+    /* Channel model */
+    struct sx1262_fake_channel channel;
+    struct sx1262_fake_stats stats;
+    uint32_t rng_state;
+
+    /* Modem settings from lora_config(), drive the airtime */
+    uint8_t sf;
+    uint32_t bw_hz;
+    uint8_t cr;
+    uint16_t preamble_len;
+
     DeviceConfig gw_cfg;
     Auth *device_auth;                               // set externally via sx1262_fake_set_auth
     alignas(Auth) uint8_t gw_auth_buf[sizeof(Auth)]; // gw_auth constructed in init()
@@ -46,7 +63,15 @@ struct sx1262_fake_data
     bool ack_ready;
     int64_t ack_ready_time;
 
+    bool uplink_heard;
+    bool config_due;
+    int64_t rx_window_time; // CONFIG only goes to a recv opened after this
+
     uint8_t pending_rx[MAX_TX_SIZE];
+
+    uint8_t dup_frame[MAX_TX_SIZE];
+    uint32_t dup_len;
+    bool dup_ready;
 };
 
 /* =========================================================
@@ -57,6 +82,62 @@ static inline Auth *get_gw_auth(struct sx1262_fake_data *data)
     return reinterpret_cast<Auth *>(data->gw_auth_buf);
 }
 
+/* =========================================================
+ * Channel model: xorshift32, good enough for loss statistics
+ * ========================================================= */
+static uint32_t channel_rand(struct sx1262_fake_data *data)
+{
+    uint32_t x = data->rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    data->rng_state = x;
+    return x;
+}
+
+static bool channel_chance(struct sx1262_fake_data *data, uint16_t permille)
+{
+    if (permille == 0)
+        return false;
+    return (channel_rand(data) % 1000U) < permille;
+}
+
+/* Irwin-Hall: sum of 12 uniforms minus 6 is close to N(0, 1), here scaled by 1000 */
+static int32_t channel_normal(struct sx1262_fake_data *data, int32_t mean, uint32_t stddev)
+{
+    if (stddev == 0)
+        return mean;
+
+    int32_t sum = 0;
+    for (int i = 0; i < 12; ++i)
+        sum += static_cast<int32_t>(channel_rand(data) % 1000U);
+
+    return mean + ((sum - 6000) * static_cast<int32_t>(stddev)) / 1000;
+}
+
+static void channel_report(struct sx1262_fake_data *data, int16_t *rssi, int8_t *snr)
+{
+    if (rssi)
+        *rssi = static_cast<int16_t>(channel_normal(data, data->channel.rssi_dbm,
+                                                    data->channel.rssi_stddev_db));
+    if (snr)
+        *snr = static_cast<int8_t>(CLAMP(channel_normal(data, data->channel.snr_db,
+                                                         data->channel.snr_stddev_db),
+                                         INT8_MIN, INT8_MAX));
+}
+
+/* Remember a delivered frame, the next recv gets it once more */
+static void channel_maybe_duplicate(struct sx1262_fake_data *data, const uint8_t *frame, uint32_t len)
+{
+    if (!channel_chance(data, data->channel.duplicate_permille))
+        return;
+
+    memcpy(data->dup_frame, frame, len);
+    data->dup_len = len;
+    data->dup_ready = true;
+    data->stats.duplicates++;
+}
+
 /* =========================================================
  * Airtime calculation (SX126x formula)
  * ========================================================= */
@@ -84,9 +165,28 @@ static uint32_t lora_airtime_ms(uint8_t sf, uint32_t bw_hz, uint8_t cr,
 static int fake_lora_config(const struct device *dev,
                             struct lora_modem_config *config)
 {
-    (void)dev;
-    (void)config;
-    // LOG_INF("Fake SX1262 configured (no-op)");
+    struct sx1262_fake_data *data = (struct sx1262_fake_data *)dev->data;
+
+    if (!config)
+        return -EINVAL;
+
+    data->sf = static_cast<uint8_t>(config->datarate);
+    data->cr = static_cast<uint8_t>(config->coding_rate);
+    data->preamble_len = config->preamble_len ? config->preamble_len : 8;
+
+    switch (config->bandwidth)
+    {
+    case BW_250_KHZ:
+        data->bw_hz = 250000;
+        break;
+    case BW_500_KHZ:
+        data->bw_hz = 500000;
+        break;
+    default:
+        data->bw_hz = 125000;
+        break;
+    }
+
     return 0;
 }
 
@@ -144,11 +244,40 @@ static int fake_lora_send(const struct device *dev,
         memset(data->last_ack + FrameLayout::HEADER_SIZE, 0x00, FrameLayout::AUTH_SIZE);
     }
 
-    uint32_t tx_airtime = lora_airtime_ms(12, 125000, 1, len, 8);
-    uint32_t ack_airtime = lora_airtime_ms(12, 125000, 1, data->last_ack_len, 8);
+    uint32_t tx_airtime = lora_airtime_ms(data->sf, data->bw_hz, data->cr, len, data->preamble_len);
+    uint32_t ack_airtime = lora_airtime_ms(data->sf, data->bw_hz, data->cr,
+                                           data->last_ack_len, data->preamble_len);
+
+    data->rx_window_time = k_uptime_get() + tx_airtime + ack_airtime;
+    data->ack_ready = false;
+    data->config_due = false;
+    data->dup_ready = false;
+
+    /* Gateway side: heard at all, then ACK on air or not */
+    data->stats.uplinks++;
+    data->uplink_heard = !channel_chance(data, data->channel.uplink_loss_permille);
+    if (!data->uplink_heard)
+    {
+        data->stats.uplinks_lost++;
+        return len;
+    }
 
+    const uint8_t period = data->channel.config_period;
+    data->config_due = period != 0 && (frame_ctr % period) == (1 % period);
+
+    if (channel_chance(data, data->channel.ack_loss_permille))
+    {
+        data->stats.acks_lost++;
+        return len;
+    }
+
+    uint32_t jitter_ms = 0;
+    if (data->channel.latency_jitter_ms != 0)
+        jitter_ms = channel_rand(data) % (data->channel.latency_jitter_ms + 1U);
+
+    data->stats.acks_sent++;
     data->ack_ready = true;
-    data->ack_ready_time = k_uptime_get() + tx_airtime + ack_airtime;
+    data->ack_ready_time = data->rx_window_time + jitter_ms;
 
     // LOG_DBG("Fake SX1262 sent frame, len=%u, ACK ready in %u ms (tx=%u + ack=%u)",
     //         len, tx_airtime + ack_airtime, tx_airtime, ack_airtime);
@@ -175,6 +304,17 @@ static int fake_lora_recv(const struct device *dev,
     int64_t start = k_uptime_get();
     int64_t deadline = start + k_ticks_to_ms_floor64(timeout.ticks);
 
+    if (data->dup_ready)
+    {
+        uint32_t copy_len = MIN(data->dup_len, size);
+        memcpy(buf, data->dup_frame, copy_len);
+        data->dup_ready = false;
+        channel_report(data, rssi, snr);
+
+        LOG_INF("Fake SX1262 returning duplicate, len=%u", copy_len);
+        return copy_len;
+    }
+
     while (k_uptime_get() < deadline)
     {
         if (data->ack_ready && k_uptime_get() >= data->ack_ready_time)
@@ -182,20 +322,26 @@ static int fake_lora_recv(const struct device *dev,
             uint32_t copy_len = MIN(data->last_ack_len, size);
             memcpy(buf, data->last_ack, copy_len);
             data->ack_ready = false;
+            channel_report(data, rssi, snr);
+            channel_maybe_duplicate(data, buf, copy_len);
 
-            if (rssi)
-                *rssi = -42;
-            if (snr)
-                *snr = 10;
-
-            LOG_INF("Fake SX1262 returning ACK, len=%u", copy_len);
+            LOG_DBG("Fake SX1262 returning ACK, len=%u", copy_len);
             return copy_len;
         }
         k_sleep(K_MSEC(1));
     }
 
-    if ((data->last_tx[FrameLayout::FRAME_CTR] % 2) == 1)
+    /* CONFIG follows the ACK, only a window opened after the ACK slot (App RX) sees it */
+    if (data->config_due && start >= data->rx_window_time)
     {
+        data->config_due = false;
+
+        if (channel_chance(data, data->channel.downlink_loss_permille))
+        {
+            data->stats.downlinks_lost++;
+            return -EAGAIN;
+        }
+
         uint8_t *f = data->pending_rx;
         memset(f, 0, MAX_TX_SIZE);
 
@@ -203,13 +349,26 @@ static int fake_lora_recv(const struct device *dev,
         write_u16_le(f, 0, data->gw_cfg.combined_id);
         f[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::CONFIG);
         f[FrameLayout::FRAME_CTR] = static_cast<uint8_t>(++data->tx_counter);
-        f[4] = 1;                   // cmd_count
-        f[5] = PROTOCOL_VERSION;    // prot_ver
-        f[6] = (0x00 << 2) | 0x01;  // SET_COMBINED_ID
-        write_u16_le(f, 7, 0x0803); // new combined_id
+        size_t pos = FrameLayout::FIRST_CMD;
+        f[FrameLayout::CMD_COUNT] = 2;                       // cmd_count
+        f[FrameLayout::PROTOCOL_VERSION] = PROTOCOL_VERSION; // prot_ver
+
+        // SET_COMBINED_ID (2 B)
+        f[pos++] = static_cast<uint8_t>(MessageOp::SET_COMBINED_ID);
+        pos += write_varint(f, pos, 2);
+        write_u16_le(f, pos, 0x0803); // new combined_id
+        pos += 2;
+
+        // SET_UNIX_TIME_MS (8 B) batched into the same downlink
+        const uint64_t unix_ms = FAKE_GW_EPOCH_MS + static_cast<uint64_t>(k_uptime_get());
+        f[pos++] = static_cast<uint8_t>(MessageOp::SET_UNIX_TIME_MS);
+        pos += write_varint(f, pos, 8);
+        write_u32_le(f, pos, static_cast<uint32_t>(unix_ms));
+        write_u32_le(f, pos + 4, static_cast<uint32_t>(unix_ms >> 32));
+        pos += 8;
 
         // Podpiš STARÝM klíčem
-        size_t data_len = 9;
+        size_t data_len = pos;
         uint8_t tag[16];
         get_gw_auth(data)->compute_cmac(f, data_len,
                                         static_cast<uint32_t>(data->tx_counter), tag);
@@ -222,6 +381,9 @@ static int fake_lora_recv(const struct device *dev,
 
         size_t total = data_len + FrameLayout::AUTH_SIZE;
         memcpy(buf, f, MIN(total, size));
+        channel_report(data, rssi, snr);
+        channel_maybe_duplicate(data, f, total);
+        data->stats.downlinks_sent++;
 
         LOG_INF("Fake SX1262 injecting CONFIG frame, ctr=%u", data->tx_counter);
         return static_cast<int>(total);
@@ -245,6 +407,17 @@ static const struct lora_driver_api sx1262_fake_api = {
 static int sx1262_fake_init(const struct device *dev)
 {
     struct sx1262_fake_data *data = (struct sx1262_fake_data *)dev->data;
+    const struct sx1262_fake_config *cfg = (const struct sx1262_fake_config *)dev->config;
+
+    data->channel = cfg->channel;
+    data->rng_state = cfg->seed ? cfg->seed : 1;
+    memset(&data->stats, 0, sizeof(data->stats));
+
+    /* SF12 / 125 kHz / 4/5 until lora_config() says otherwise */
+    data->sf = 12;
+    data->bw_hz = 125000;
+    data->cr = 1;
+    data->preamble_len = 8;
 
     data->combined_id = 0x0801;
     data->gw_cfg.combined_id = data->combined_id;
@@ -273,20 +446,73 @@ extern "C"
         data->device_auth = device_auth;
         LOG_INF("Fake SX1262 device_auth set (%p)", (void *)device_auth);
     }
+
+    int sx1262_fake_set_channel(const struct device *dev, const struct sx1262_fake_channel *channel)
+    {
+        struct sx1262_fake_data *data = (struct sx1262_fake_data *)dev->data;
+
+        if (!channel ||
+            channel->uplink_loss_permille > 1000 || channel->ack_loss_permille > 1000 ||
+            channel->downlink_loss_permille > 1000 || channel->duplicate_permille > 1000)
+            return -EINVAL;
+
+        data->channel = *channel;
+        return 0;
+    }
+
+    void sx1262_fake_get_channel(const struct device *dev, struct sx1262_fake_channel *channel)
+    {
+        const struct sx1262_fake_data *data = (const struct sx1262_fake_data *)dev->data;
+        *channel = data->channel;
+    }
+
+    void sx1262_fake_seed(const struct device *dev, uint32_t seed)
+    {
+        struct sx1262_fake_data *data = (struct sx1262_fake_data *)dev->data;
+        data->rng_state = seed ? seed : 1;
+    }
+
+    void sx1262_fake_get_stats(const struct device *dev, struct sx1262_fake_stats *stats)
+    {
+        const struct sx1262_fake_data *data = (const struct sx1262_fake_data *)dev->data;
+        *stats = data->stats;
+    }
+
+    void sx1262_fake_reset_stats(const struct device *dev)
+    {
+        struct sx1262_fake_data *data = (struct sx1262_fake_data *)dev->data;
+        memset(&data->stats, 0, sizeof(data->stats));
+    }
 }
 
 /* =========================================================
  * Device instantiation
  * ========================================================= */
-#define SX1262_FAKE_DEFINE(inst)                              \
-    static struct sx1262_fake_data sx1262_fake_data_##inst;   \
-    DEVICE_DT_INST_DEFINE(inst,                               \
-                          sx1262_fake_init,                   \
-                          NULL,                               \
-                          &sx1262_fake_data_##inst,           \
-                          NULL,                               \
-                          POST_KERNEL,                        \
-                          CONFIG_KERNEL_INIT_PRIORITY_DEVICE, \
+#define SX1262_FAKE_DEFINE(inst)                                                   \
+    static struct sx1262_fake_data sx1262_fake_data_##inst;                        \
+    static const struct sx1262_fake_config sx1262_fake_config_##inst = {           \
+        .gw_combined_id = 0x801,                                                   \
+        .channel = {                                                               \
+            .uplink_loss_permille = DT_INST_PROP(inst, uplink_loss_permille),      \
+            .ack_loss_permille = DT_INST_PROP(inst, ack_loss_permille),            \
+            .downlink_loss_permille = DT_INST_PROP(inst, downlink_loss_permille),  \
+            .duplicate_permille = DT_INST_PROP(inst, duplicate_permille),          \
+            .rssi_dbm = DT_INST_PROP(inst, rssi_dbm),                              \
+            .rssi_stddev_db = DT_INST_PROP(inst, rssi_stddev_db),                  \
+            .snr_db = DT_INST_PROP(inst, snr_db),                                  \
+            .snr_stddev_db = DT_INST_PROP(inst, snr_stddev_db),                    \
+            .latency_jitter_ms = DT_INST_PROP(inst, latency_jitter_ms),            \
+            .config_period = DT_INST_PROP(inst, config_period),                    \
+        },                                                                         \
+        .seed = DT_INST_PROP(inst, seed),                                          \
+    };                                                                             \
+    DEVICE_DT_INST_DEFINE(inst,                                                    \
+                          sx1262_fake_init,                                        \
+                          NULL,                                                    \
+                          &sx1262_fake_data_##inst,                                \
+                          &sx1262_fake_config_##inst,                              \
+                          POST_KERNEL,                                             \
+                          CONFIG_KERNEL_INIT_PRIORITY_DEVICE,                      \
                           &sx1262_fake_api);
 
 DT_INST_FOREACH_STATUS_OKAY(SX1262_FAKE_DEFINE)
\ No newline at end of file
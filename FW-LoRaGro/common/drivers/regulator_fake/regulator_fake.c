@@ -5,7 +5,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/init.h>
 
-LOG_MODULE_REGISTER(regulator_fake, LOG_LEVEL_DBG); // ← Changed to DBG
+LOG_MODULE_REGISTER(regulator_fake, CONFIG_LORAGRO_SIM_DRIVERS_LOG_LEVEL);
 
 #ifndef CONFIG_REGULATOR_P4V_FAKE_INIT_PRIORITY
 #define CONFIG_REGULATOR_P4V_FAKE_INIT_PRIORITY 55
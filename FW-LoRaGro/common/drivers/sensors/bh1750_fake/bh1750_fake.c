@@ -5,7 +5,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
-LOG_MODULE_REGISTER(bh1750_fake, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(bh1750_fake, CONFIG_LORAGRO_SIM_DRIVERS_LOG_LEVEL);
 
 struct bh1750_fake_config
 {
@@ -11,7 +11,9 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
-LOG_MODULE_REGISTER(scd41_fake, LOG_LEVEL_DBG);
+#include "regs/scd41_fake.h"
+
+LOG_MODULE_REGISTER(scd41_fake, CONFIG_LORAGRO_SIM_DRIVERS_LOG_LEVEL);
 
 /* ----------------------------- */
 /* Helpers                       */
@@ -38,11 +40,42 @@ static inline void sensor_value_add_micro(struct sensor_value *v, int32_t delta_
 /* Driver data/config            */
 /* ----------------------------- */
 
+/*
+ * Command model of the SCD41 in single-shot mode:
+ *
+ *   IDLE --single_shot--> MEASURING --5 s--> IDLE (data ready)
+ *   IDLE --power_down---> SLEEP --wake_up (30 ms)--> IDLE
+ *
+ * Blocking commands consume their datasheet execution time
+ * (k_msleep, simulated time on native_sim / bsim), the single-shot
+ * conversion runs in the background and fetch returns -EBUSY until it
+ * is done. In SLEEP the sensor does not acknowledge (-EIO).
+ */
+enum scd41_fake_state
+{
+    SCD41_FAKE_IDLE,
+    SCD41_FAKE_MEASURING,
+    SCD41_FAKE_SLEEP,
+};
+
 struct scd41_fake_data
 {
     struct sensor_value co2;  /* ppm */
     struct sensor_value temp; /* °C */
     struct sensor_value hum;  /* %RH */
+
+    enum scd41_fake_state state;
+    int64_t ready_at_ms;
+    bool data_ready;
+
+    bool asc_enabled;        /* RAM copy */
+    bool asc_enabled_eeprom; /* survives power cycles */
+
+    /* Statistics */
+    int64_t awake_since_ms;
+    uint32_t awake_ms;
+    uint32_t readings;
+    uint32_t eeprom_writes;
 };
 
 struct scd41_fake_config
@@ -51,22 +84,30 @@ struct scd41_fake_config
 };
 
 /* ----------------------------- */
-/* Sample fetch                  */
+/* Command timing                */
 /* ----------------------------- */
 
-static int scd41_fake_sample_fetch(const struct device *dev,
-                                   enum sensor_channel chan)
+static void scd41_fake_execute(uint32_t exec_ms)
 {
-    struct scd41_fake_data *data = dev->data;
+    k_msleep(exec_ms);
+}
 
-    if (chan != SENSOR_CHAN_ALL &&
-        chan != SENSOR_CHAN_CO2 &&
-        chan != SENSOR_CHAN_AMBIENT_TEMP &&
-        chan != SENSOR_CHAN_HUMIDITY)
+static void scd41_fake_update(struct scd41_fake_data *data)
+{
+    if (data->state == SCD41_FAKE_MEASURING &&
+        k_uptime_get() >= data->ready_at_ms)
     {
-        return -ENOTSUP;
+        data->state = SCD41_FAKE_IDLE;
+        data->data_ready = true;
     }
+}
+
+/* ----------------------------- */
+/* Sample fetch                  */
+/* ----------------------------- */
 
+static void scd41_fake_next_values(struct scd41_fake_data *data)
+{
     /* --- CO2: 400–2000 ppm slow drift --- */
     data->co2.val1 += 15;
     if (data->co2.val1 > 4500)
@@ -95,10 +136,166 @@ static int scd41_fake_sample_fetch(const struct device *dev,
     {
         hum_dir = 1;
     }
+}
+
+static int scd41_fake_sample_fetch(const struct device *dev,
+                                   enum sensor_channel chan)
+{
+    struct scd41_fake_data *data = dev->data;
+
+    if (chan != SENSOR_CHAN_ALL &&
+        chan != SENSOR_CHAN_CO2 &&
+        chan != SENSOR_CHAN_AMBIENT_TEMP &&
+        chan != SENSOR_CHAN_HUMIDITY)
+    {
+        return -ENOTSUP;
+    }
+
+    scd41_fake_update(data);
+
+    switch (data->state)
+    {
+    case SCD41_FAKE_SLEEP:
+        return -EIO;
+    case SCD41_FAKE_MEASURING:
+        return -EBUSY;
+    default:
+        break;
+    }
+
+    if (!data->data_ready)
+    {
+        return -ENODATA;
+    }
+
+    /* read_measurement, clears data ready */
+    scd41_fake_execute(SCD41_READ_MEASUREMENT_MS);
+    scd41_fake_next_values(data);
+    data->data_ready = false;
+    data->readings++;
 
     return 0;
 }
 
+/* ----------------------------- */
+/* Commands (private attributes) */
+/* ----------------------------- */
+
+static int scd41_fake_attr_set(const struct device *dev,
+                               enum sensor_channel chan,
+                               enum sensor_attribute attr,
+                               const struct sensor_value *val)
+{
+    struct scd41_fake_data *data = dev->data;
+
+    scd41_fake_update(data);
+
+    if ((int)attr == SCD41_ATTR_WAKE_UP)
+    {
+        if (data->state == SCD41_FAKE_SLEEP)
+        {
+            scd41_fake_execute(SCD41_WAKE_UP_MS);
+            data->state = SCD41_FAKE_IDLE;
+            data->awake_since_ms = k_uptime_get();
+        }
+        return 0;
+    }
+
+    if (data->state == SCD41_FAKE_SLEEP)
+    {
+        return -EIO;
+    }
+
+    /* Only read_measurement / data ready are allowed while measuring */
+    if (data->state == SCD41_FAKE_MEASURING)
+    {
+        return -EBUSY;
+    }
+
+    switch ((int)attr)
+    {
+    case SCD41_ATTR_MEASURE_SINGLE_SHOT:
+        data->state = SCD41_FAKE_MEASURING;
+        data->data_ready = false;
+        data->ready_at_ms = k_uptime_get() + SCD41_SINGLE_SHOT_MS;
+        return 0;
+
+    case SCD41_ATTR_POWER_DOWN:
+        scd41_fake_execute(SCD41_POWER_DOWN_MS);
+        data->state = SCD41_FAKE_SLEEP;
+        data->awake_ms += (uint32_t)(k_uptime_get() - data->awake_since_ms);
+        return 0;
+
+    case SCD41_ATTR_ASC_ENABLED:
+        scd41_fake_execute(SCD41_SET_ASC_MS);
+        data->asc_enabled = (val->val1 != 0);
+        return 0;
+
+    case SCD41_ATTR_PERSIST_SETTINGS:
+        scd41_fake_execute(SCD41_PERSIST_SETTINGS_MS);
+        data->asc_enabled_eeprom = data->asc_enabled;
+        data->eeprom_writes++;
+        return 0;
+
+    default:
+        return -ENOTSUP;
+    }
+}
+
+static int scd41_fake_attr_get(const struct device *dev,
+                               enum sensor_channel chan,
+                               enum sensor_attribute attr,
+                               struct sensor_value *val)
+{
+    struct scd41_fake_data *data = dev->data;
+
+    scd41_fake_update(data);
+    val->val2 = 0;
+
+    switch ((int)attr)
+    {
+    case SCD41_ATTR_ASC_ENABLED:
+        if (data->state != SCD41_FAKE_IDLE)
+        {
+            return data->state == SCD41_FAKE_SLEEP ? -EIO : -EBUSY;
+        }
+        val->val1 = data->asc_enabled;
+        return 0;
+
+    case SCD41_ATTR_DATA_READY_IN:
+        if (data->state == SCD41_FAKE_SLEEP)
+        {
+            return -EIO;
+        }
+        if (data->state == SCD41_FAKE_MEASURING)
+        {
+            val->val1 = (int32_t)(data->ready_at_ms - k_uptime_get());
+            return 0;
+        }
+        val->val1 = 0;
+        return data->data_ready ? 0 : -ENODATA;
+
+    case SCD41_FAKE_ATTR_READINGS:
+        val->val1 = (int32_t)data->readings;
+        return 0;
+
+    case SCD41_FAKE_ATTR_AWAKE_MS:
+        val->val1 = (int32_t)data->awake_ms;
+        if (data->state != SCD41_FAKE_SLEEP)
+        {
+            val->val1 += (int32_t)(k_uptime_get() - data->awake_since_ms);
+        }
+        return 0;
+
+    case SCD41_FAKE_ATTR_EEPROM_WRITES:
+        val->val1 = (int32_t)data->eeprom_writes;
+        return 0;
+
+    default:
+        return -ENOTSUP;
+    }
+}
+
 /* ----------------------------- */
 /* Channel get                   */
 /* ----------------------------- */
@@ -153,6 +350,12 @@ static int scd41_fake_init(const struct device *dev)
     data->hum.val1 = 55;
     data->hum.val2 = 0;
 
+    /* Factory default: ASC on, sensor idle after power-up */
+    data->asc_enabled_eeprom = true;
+    data->asc_enabled = data->asc_enabled_eeprom;
+    data->state = SCD41_FAKE_IDLE;
+    data->awake_since_ms = k_uptime_get();
+
     LOG_INF("Fake SCD41 CO2 sensor initialized");
     return 0;
 }
@@ -164,6 +367,8 @@ static int scd41_fake_init(const struct device *dev)
 static const struct sensor_driver_api scd41_fake_api = {
     .sample_fetch = scd41_fake_sample_fetch,
     .channel_get = scd41_fake_channel_get,
+    .attr_set = scd41_fake_attr_set,
+    .attr_get = scd41_fake_attr_get,
 };
 
 #define SENSOR_SCD41_FAKE_DEFINE(inst)                                \
@@ -0,0 +1,92 @@
+/**
+ * Battery state-of-charge estimator
+ *
+ * Turns one battery reading per cycle into:
+ *  - filtered open-circuit voltage, compensated for the load flowing
+ *    while the ADC sampled (V_ocv = V_meas + I_load * R_int)
+ *  - SoC from a Li-ion OCV curve
+ *  - predicted terminal voltage during TX (V_ocv - I_tx * R_int)
+ *  - average current and time to cutoff, from the EnergyLedger cycle
+ *    charge
+ *
+ * Interval scaling:
+ *
+ *   budget  = capacity / target_lifetime          (uA)
+ *   budget *= (V - cutoff) / (critical - cutoff)  (below critical only)
+ *   T_min   = cycle_charge / (budget - I_sleep)
+ *   stride  = ceil(T_min / sample_interval)       (1 .. low_battery / sample_interval)
+ *
+ * The node keeps waking on its TDMA grid and skips stride - 1 slots, so
+ * a gateway assigned slot stays valid for any stride.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "config_manager.hpp"
+#include "energy_ledger.hpp"
+
+namespace loragro
+{
+    class BatteryEstimator
+    {
+    public:
+        explicit BatteryEstimator(const DeviceConfig &dev_cfg)
+            : dev_cfg_(dev_cfg) {};
+
+        /* One battery reading (mV) taken while load_ua was flowing */
+        void update(int32_t measured_mv, uint32_t load_ua);
+
+        /* Energy of a completed cycle, from EnergyLedger */
+        void account_cycle(const EnergyReport &report);
+
+        bool valid() const { return samples_ > 0; }
+
+        /* Drop voltage history, next update() seeds the filter */
+        void reset() { samples_ = 0; }
+
+        /* Filtered, load compensated open-circuit voltage */
+        int32_t ocv_mv() const { return ocv_q4_ / 16; }
+
+        /* State of charge in permille from OCV curve */
+        uint16_t soc_permille() const { return soc_from_ocv(ocv_mv()); }
+
+        /* Predicted battery terminal voltage during TX burst */
+        int32_t tx_voltage_mv() const;
+
+        /* TX power limit so TX sag stays above cutoff */
+        int8_t tx_power_cap_dbm() const;
+
+        /* Average current (uA) when waking every stride * sample interval */
+        uint32_t avg_current_ua(uint8_t stride) const;
+
+        /* Forecast time until cutoff at given stride, UINT32_MAX if unknown */
+        uint32_t hours_to_cutoff(uint8_t stride) const;
+
+        /* Number of sample intervals per wake needed to meet the lifetime target */
+        uint8_t interval_stride() const;
+
+        /* Largest allowed stride (low battery interval / sample interval) */
+        uint8_t max_stride() const;
+
+        static uint16_t soc_from_ocv(int32_t mv);
+
+    private:
+        const DeviceConfig &dev_cfg_;
+
+        int32_t ocv_q4_{0};       // Q4 fixed point mV
+        uint32_t cycle_nAh_{0};   // filtered awake charge per cycle
+        uint8_t samples_{0};
+        uint8_t cycles_{0};
+
+        /* EWMA weight 1/N for voltage and cycle charge */
+        static constexpr int32_t FILTER_DIV = 8;
+
+        /* Keep TX sag this far above cutoff */
+        static constexpr int32_t TX_SAG_MARGIN_MV = 100;
+
+        /* Step down when TX sag would cross cutoff */
+        static constexpr int8_t TX_POWER_BACKOFF_DB = 6;
+        static constexpr int8_t TX_POWER_MIN_DBM = 2;
+    };
+} // namespace loragro
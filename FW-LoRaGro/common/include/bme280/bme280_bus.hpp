@@ -0,0 +1,48 @@
+/**
+ * BME280 register access
+ *
+ * Bme280Forced talks to the sensor through this interface, so the
+ * same driver runs against the I2C bus on hardware and against the
+ * in-process register model (Bme280Sim) on native_sim / bsim.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <zephyr/drivers/i2c.h>
+
+namespace loragro
+{
+    class Bme280Bus
+    {
+    public:
+        virtual ~Bme280Bus() = default;
+
+        /* Burst read of len registers starting at reg, one bus transaction */
+        virtual int read(uint8_t reg, uint8_t *buf, size_t len) = 0;
+
+        virtual int write(uint8_t reg, uint8_t value) = 0;
+    };
+
+    class Bme280I2cBus : public Bme280Bus
+    {
+    public:
+        explicit Bme280I2cBus(const struct i2c_dt_spec &spec) : spec_(spec) {}
+
+        int read(uint8_t reg, uint8_t *buf, size_t len) override
+        {
+            return i2c_burst_read_dt(&spec_, reg, buf, static_cast<uint32_t>(len));
+        }
+
+        int write(uint8_t reg, uint8_t value) override
+        {
+            return i2c_reg_write_byte_dt(&spec_, reg, value);
+        }
+
+        bool ready() const { return i2c_is_ready_dt(&spec_); }
+
+    private:
+        const struct i2c_dt_spec spec_;
+    };
+
+} // namespace loragro
@@ -0,0 +1,87 @@
+/**
+ * BME280 forced mode driver
+ *
+ * Native driver on top of Bme280Bus, replaces the generic Zephyr
+ * sensor path for the environmental sensor:
+ *
+ *   init()   per rail cycle: chip ID check, calibration from the RAM
+ *            cache, else from NVS, else read from the chip once and
+ *            stored to NVS
+ *   start()  ctrl_hum + ctrl_meas (mode FORCED), returns the datasheet
+ *            max conversion time for the configured oversampling
+ *   read()   ONE burst read of 0xF7..0xFE (press, temp, hum) and
+ *            integer compensation (bme280_calib.hpp)
+ *
+ * Oversampling per channel trades conversion time against noise, from
+ * CONFIG_LORAGRO_BME280_OSRS_T/P/H (register codes, 0 = skipped):
+ *
+ *   t_meas = 1.25 + 2.3 * T + (2.3 * P + 0.575) + (2.3 * H + 0.575) ms
+ *
+ * The sensor is back in sleep mode by itself after each conversion.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "bme280/bme280_bus.hpp"
+#include "regs/bme280_regs.hpp"
+#include "regs/bme280_calib.hpp"
+
+namespace loragro
+{
+    /* Compensated values of one conversion */
+    struct Bme280Sample
+    {
+        int32_t temperature_centi_c; // 0.01 degC
+        uint32_t pressure_q24_8;     // Pa * 256, 0 if skipped
+        uint32_t humidity_q22_10;    // %RH * 1024, 0 if skipped
+        bool has_pressure;
+        bool has_humidity;
+    };
+
+    class Bme280Forced
+    {
+    public:
+        struct Oversampling
+        {
+            uint8_t t;
+            uint8_t p;
+            uint8_t h;
+        };
+
+        static constexpr Oversampling DEFAULT_OVERSAMPLING = {
+            CONFIG_LORAGRO_BME280_OSRS_T,
+            CONFIG_LORAGRO_BME280_OSRS_P,
+            CONFIG_LORAGRO_BME280_OSRS_H};
+
+        explicit Bme280Forced(Bme280Bus &bus, Oversampling osrs = DEFAULT_OVERSAMPLING);
+
+        int init();
+
+        /* Trigger one conversion, returns ms until read() has data */
+        int start();
+
+        /* -EBUSY while the conversion is running */
+        int read(Bme280Sample &out);
+
+        uint32_t measurement_time_us() const
+        {
+            return bme280::measurement_time_us(osrs_.t, osrs_.p, osrs_.h);
+        }
+
+        bool calibrated() const { return calibrated_; }
+        const bme280::Calibration &calibration() const { return calib_; }
+
+        /* Forget the RAM copy, next init() restores from NVS */
+        void drop_calibration_cache() { calibrated_ = false; }
+
+    private:
+        int load_calibration();
+
+        Bme280Bus &bus_;
+        const Oversampling osrs_;
+        bme280::Calibration calib_{};
+        bool calibrated_{false};
+    };
+
+} // namespace loragro
@@ -0,0 +1,229 @@
+/**
+ * Simulated BME280 register map
+ *
+ * Bme280Bus that behaves like the chip for native_sim / bsim builds
+ * and tests:
+ *
+ *   - NVM calibration at 0x88 / 0xE1 (BMP280 datasheet example set
+ *     for T / P, typical BME280 values for H)
+ *   - writing mode FORCED to ctrl_meas starts a conversion, status
+ *     bit measuring is set for measurement_time_us() and the data
+ *     registers are updated when it ends, mode falls back to SLEEP
+ *   - ctrl_hum only takes effect with the next ctrl_meas write
+ *   - skipped channels read 0x80000 / 0x8000
+ *
+ * Raw ADC values drift slowly between conversions. Counts transactions
+ * so tests can check one burst read per sample and no calibration
+ * re-reads.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "bme280/bme280_bus.hpp"
+#include "regs/bme280_regs.hpp"
+
+namespace loragro
+{
+    class Bme280Sim : public Bme280Bus
+    {
+    public:
+        /* dig_T1..dig_P9 as stored in 0x88..0x9F */
+        static constexpr int32_t NVM_TP[] = {27504, 26435, -1000,
+                                             36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000};
+        static constexpr uint8_t NVM_H1 = 75;
+        static constexpr int16_t NVM_H2 = 362;
+        static constexpr uint8_t NVM_H3 = 0;
+        static constexpr int16_t NVM_H4 = 313;
+        static constexpr int16_t NVM_H5 = 50;
+        static constexpr int8_t NVM_H6 = 30;
+
+        /* Datasheet example: 25.08 degC, 100653.27 Pa; ~55 %RH */
+        static constexpr int32_t DEFAULT_ADC_T = 519888;
+        static constexpr int32_t DEFAULT_ADC_P = 415148;
+        static constexpr int32_t DEFAULT_ADC_H = 30000;
+
+        Bme280Sim()
+        {
+            using namespace bme280;
+
+            regs_[REG_CHIP_ID] = CHIP_ID;
+
+            uint8_t *c00 = &regs_[REG_CALIB_00];
+            for (size_t i = 0; i < ARRAY_SIZE(NVM_TP); ++i)
+                sys_put_le16(static_cast<uint16_t>(NVM_TP[i]), &c00[2 * i]);
+            c00[25] = NVM_H1;
+
+            uint8_t *c26 = &regs_[REG_CALIB_26];
+            sys_put_le16(static_cast<uint16_t>(NVM_H2), &c26[0]);
+            c26[2] = NVM_H3;
+            c26[3] = static_cast<uint8_t>(NVM_H4 >> 4);
+            c26[4] = static_cast<uint8_t>((NVM_H4 & 0x0F) | ((NVM_H5 & 0x0F) << 4));
+            c26[5] = static_cast<uint8_t>(NVM_H5 >> 4);
+            c26[6] = static_cast<uint8_t>(NVM_H6);
+
+            latch(ADC_SKIPPED_20BIT, ADC_SKIPPED_20BIT, ADC_SKIPPED_16BIT);
+        }
+
+        int read(uint8_t reg, uint8_t *buf, size_t len) override
+        {
+            if (static_cast<size_t>(reg) + len > sizeof(regs_))
+                return -EINVAL;
+
+            update();
+            reads_++;
+            bytes_read_ += len;
+
+            regs_[bme280::REG_STATUS] = measuring_ ? bme280::STATUS_MEASURING : 0;
+            memcpy(buf, &regs_[reg], len);
+            return 0;
+        }
+
+        int write(uint8_t reg, uint8_t value) override
+        {
+            using namespace bme280;
+
+            update();
+            writes_++;
+
+            switch (reg)
+            {
+            case REG_RESET:
+                if (value == SOFT_RESET)
+                {
+                    regs_[REG_CTRL_HUM] = 0;
+                    regs_[REG_CTRL_MEAS] = 0;
+                    regs_[REG_CONFIG] = 0;
+                    measuring_ = false;
+                }
+                return 0;
+
+            case REG_CTRL_HUM:
+                regs_[REG_CTRL_HUM] = value & OSRS_MASK;
+                return 0;
+
+            case REG_CTRL_MEAS:
+                regs_[REG_CTRL_MEAS] = value;
+                osrs_h_ = regs_[REG_CTRL_HUM];
+                if ((value & MODE_MASK) != MODE_SLEEP && !measuring_)
+                {
+                    measuring_ = true;
+                    ready_at_us_ = now_us() +
+                                   measurement_time_us((value >> OSRS_T_SHIFT) & OSRS_MASK,
+                                                       (value >> OSRS_P_SHIFT) & OSRS_MASK,
+                                                       osrs_h_);
+                }
+                return 0;
+
+            case REG_CONFIG:
+                regs_[REG_CONFIG] = value;
+                return 0;
+
+            default:
+                /* Read-only register, the chip ignores the write */
+                return 0;
+            }
+        }
+
+        void set_raw(int32_t adc_T, int32_t adc_P, int32_t adc_H)
+        {
+            adc_T_ = adc_T;
+            adc_P_ = adc_P;
+            adc_H_ = adc_H;
+            drift_ = false;
+        }
+
+        uint32_t reads() const { return reads_; }
+        uint32_t writes() const { return writes_; }
+        uint32_t bytes_read() const { return bytes_read_; }
+        uint32_t conversions() const { return conversions_; }
+
+        void reset_stats()
+        {
+            reads_ = 0;
+            writes_ = 0;
+            bytes_read_ = 0;
+            conversions_ = 0;
+        }
+
+    private:
+        void update()
+        {
+            using namespace bme280;
+
+            if (!measuring_ || now_us() < ready_at_us_)
+                return;
+
+            const uint8_t ctrl = regs_[REG_CTRL_MEAS];
+            const uint8_t osrs_t = (ctrl >> OSRS_T_SHIFT) & OSRS_MASK;
+            const uint8_t osrs_p = (ctrl >> OSRS_P_SHIFT) & OSRS_MASK;
+
+            latch(osrs_t ? adc_T_ : ADC_SKIPPED_20BIT,
+                  osrs_p ? adc_P_ : ADC_SKIPPED_20BIT,
+                  osrs_h_ ? adc_H_ : ADC_SKIPPED_16BIT);
+
+            measuring_ = false;
+            regs_[REG_CTRL_MEAS] = ctrl & ~MODE_MASK;
+            conversions_++;
+
+            if (drift_)
+            {
+                adc_T_ = bounce(adc_T_, dir_t_, 500, 505000, 535000);
+                adc_P_ = bounce(adc_P_, dir_p_, 100, 410000, 420000);
+                adc_H_ = bounce(adc_H_, dir_h_, 200, 26000, 32000);
+            }
+        }
+
+        static uint64_t now_us()
+        {
+            return k_ticks_to_us_floor64(k_uptime_ticks());
+        }
+
+        void latch(uint32_t adc_T, uint32_t adc_P, uint32_t adc_H)
+        {
+            using namespace bme280;
+
+            /* 20 bit values: msb, lsb, xlsb[7:4] */
+            regs_[REG_PRESS_MSB] = static_cast<uint8_t>(adc_P >> 12);
+            regs_[REG_PRESS_LSB] = static_cast<uint8_t>(adc_P >> 4);
+            regs_[REG_PRESS_XLSB] = static_cast<uint8_t>((adc_P & 0x0F) << 4);
+            regs_[REG_TEMP_MSB] = static_cast<uint8_t>(adc_T >> 12);
+            regs_[REG_TEMP_LSB] = static_cast<uint8_t>(adc_T >> 4);
+            regs_[REG_TEMP_XLSB] = static_cast<uint8_t>((adc_T & 0x0F) << 4);
+            regs_[REG_HUM_MSB] = static_cast<uint8_t>(adc_H >> 8);
+            regs_[REG_HUM_LSB] = static_cast<uint8_t>(adc_H);
+        }
+
+        static int32_t bounce(int32_t v, int8_t &dir, int32_t step, int32_t lo, int32_t hi)
+        {
+            v += dir * step;
+            if (v >= hi || v <= lo)
+                dir = static_cast<int8_t>(-dir);
+            return std::clamp(v, lo, hi);
+        }
+
+        uint8_t regs_[256]{};
+        uint8_t osrs_h_{0};
+        bool measuring_{false};
+        uint64_t ready_at_us_{0};
+
+        int32_t adc_T_{DEFAULT_ADC_T};
+        int32_t adc_P_{DEFAULT_ADC_P};
+        int32_t adc_H_{DEFAULT_ADC_H};
+        bool drift_{true};
+        int8_t dir_t_{1};
+        int8_t dir_p_{1};
+        int8_t dir_h_{1};
+
+        uint32_t reads_{0};
+        uint32_t writes_{0};
+        uint32_t bytes_read_{0};
+        uint32_t conversions_{0};
+    };
+
+} // namespace loragro
@@ -0,0 +1,63 @@
+/**
+ * CO2 automatic self-calibration, kept on the node
+ *
+ * The SCD41 ASC history lives in sensor RAM. The sensor rail is cut
+ * after every cycle, so the on-chip ASC never sees a complete period
+ * and its state is lost on each power-up. The node keeps the same
+ * algorithm in MCU RAM instead, which survives the sensor rail:
+ *
+ *   per window (CONFIG_LORAGRO_CO2_ASC_PERIOD_HOURS):
+ *     min   = lowest corrected reading seen in the window
+ *     step  = clamp(target - min, -MAX_STEP, MAX_STEP)
+ *     offset += step
+ *
+ *   reported = raw + offset
+ *
+ * Assumes the sensor sees fresh air (target, ~400 ppm) at least once
+ * per window, as the on-chip ASC does. The offset and the window
+ * count are persisted to NVS at the end of every window only, so a
+ * week long period costs one flash write per week. A partially filled
+ * window is lost on MCU reset, which only delays the next step.
+ */
+#pragma once
+
+#include <cstdint>
+#include <climits>
+
+namespace loragro
+{
+    /* NVS record layout */
+    struct Co2AscRecord
+    {
+        int16_t offset_ppm;
+        uint16_t windows; // completed windows since first boot
+    };
+
+    class Co2Asc
+    {
+    public:
+        static constexpr uint32_t PERIOD_S = CONFIG_LORAGRO_CO2_ASC_PERIOD_HOURS * 3600U;
+        static constexpr int32_t TARGET_PPM = CONFIG_LORAGRO_CO2_ASC_TARGET_PPM;
+        static constexpr int32_t MAX_STEP_PPM = CONFIG_LORAGRO_CO2_ASC_MAX_STEP_PPM;
+
+        /* Restore offset from NVS, once per boot */
+        int load();
+
+        /* Feed one raw reading taken at uptime now_s, returns corrected ppm */
+        int32_t apply(int32_t raw_ppm, uint32_t now_s);
+
+        int16_t offset_ppm() const { return record_.offset_ppm; }
+        uint16_t windows() const { return record_.windows; }
+        uint32_t window_elapsed_s() const { return window_elapsed_s_; }
+
+    private:
+        void close_window();
+
+        Co2AscRecord record_{};
+        int32_t window_min_ppm_{INT32_MAX};
+        uint32_t window_elapsed_s_{0};
+        uint32_t last_s_{0};
+        bool started_{false};
+    };
+
+} // namespace loragro
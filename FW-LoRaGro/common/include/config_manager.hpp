@@ -9,6 +9,20 @@
 
 namespace loragro
 {
+    // -----------------------------
+    // TDMA slot assigned by gateway
+    // -----------------------------
+    struct TdmaSlot
+    {
+        uint8_t interval_minutes; // interval grid this slot belongs to, 0 = unused
+        uint16_t slot_index;      // compact index assigned by gateway
+        uint16_t width_ms;        // window reserved for this node
+        uint32_t offset_ms;       // slot start measured from interval start
+    };
+
+    /* One slot per interval grid: normal + low battery */
+    static constexpr size_t MAX_TDMA_SLOTS = 2;
+
     // -----------------------------
     // Device configuration
     // -----------------------------
@@ -30,6 +44,9 @@ namespace loragro
         uint8_t critically_low_battery_timeout_hours;
         uint8_t max_tx_frames_per_cycle;
 
+        /* Gateway assigned slots, unused entries fall back to node_id based slot */
+        TdmaSlot tdma_slots[MAX_TDMA_SLOTS];
+
         uint8_t max_retries;
         uint16_t ack_timeout_ms;
         float air_time_margin_factor;
@@ -39,6 +56,8 @@ namespace loragro
 
         uint16_t battery_cutoff_mv;
         uint16_t battery_critical_mv;
+        uint16_t battery_capacity_mah;
+        uint16_t battery_target_days; // lifetime of full battery, 0 = no interval scaling
 
         uint8_t config_version;
         uint8_t protocol_version;
@@ -60,13 +79,25 @@ namespace loragro
         DeviceConfig &get();
         const DeviceConfig &get() const;
 
+        /* Auxiliary NVS records next to DeviceConfig (e.g. probe calibration) */
+        int read_record(uint16_t id, void *data, size_t len);
+        int write_record(uint16_t id, const void *data, size_t len);
+
+        /* NVS record IDs */
+        static constexpr uint16_t NVS_ID_DEVICE_CONFIG = 1;
+        static constexpr uint16_t NVS_ID_SOIL_CALIB_BASE = 0x10; // + probe index
+        static constexpr uint16_t NVS_ID_CO2_ASC = 0x20;
+        static constexpr uint16_t NVS_ID_BME280_CALIB = 0x21;
+        static constexpr uint16_t NVS_ID_FRAME_TRACE_BASE = 0x40; // + block index
+
     private:
         ConfigManager() = default;
         DeviceConfig config_;
         int init_nvs();
-        static constexpr uint8_t CONFIG_VERSION = 1;
-        static constexpr uint8_t PROTOCOL_VERSION = 1;
+        static constexpr uint8_t CONFIG_VERSION = 3;
+        static constexpr uint8_t PROTOCOL_VERSION = 2;
 
         bool config_loaded_{false};
+        bool nvs_mounted_{false};
     };
 }
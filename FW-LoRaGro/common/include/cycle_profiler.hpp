@@ -0,0 +1,125 @@
+/**
+ * Cycle profiler
+ *
+ * Per-phase timing of App::run_cycle(), kept over many cycles for
+ * benchmarks (tests/run_cycle_bench):
+ *
+ *   begin_cycle()          - wake-up
+ *   start(p) ... stop(p)   - hook pairs around each phase; a phase may
+ *                            run several times per cycle (TX per frame),
+ *                            its spans add up to one per-cycle value
+ *   end_cycle()            - right before the sleep, folds the cycle
+ *                            into the per-phase statistics
+ *
+ * Every span is measured on two clocks:
+ *
+ *   k_cycle   hardware cycles on target; simulated time on native_sim,
+ *             where radio waits and sleeps show up but code runs in
+ *             zero time
+ *   host      CPU time of the host thread, native_sim only
+ *             (CONFIG_LORAGRO_CYCLE_PROFILER_HOST_CLOCK), the cost of
+ *             the code itself
+ *
+ * Hooks are no-ops unless CONFIG_LORAGRO_CYCLE_PROFILER is set.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <zephyr/kernel.h>
+
+namespace loragro
+{
+    enum class CyclePhase : uint8_t
+    {
+        CONFIG_LOAD = 0, // ConfigManager::load
+        RAIL_ON,         // PowerRail3V3::powerOn
+        INIT,            // sensor init, radio config, key derivation
+        SAMPLE,          // SampleManager::sample_all
+        ENCODE,          // FrameCodec::begin + build_frame
+        SIGN,            // Auth::sign_frame
+        TX,              // lora_send, retries and RESPONSE included
+        ACK_WAIT,        // post-TX airtime sleep, ACK window, retry back-off
+        RX,              // downlink RX window
+        DOWNLINK,        // verify, decode and RESPONSE build of a received frame
+        FLASH_SAVE,      // ConfigManager::save
+        SLEEP_CALC,      // battery model and next slot, up to the k_sleep
+        COUNT
+    };
+
+    static constexpr size_t CYCLE_PHASE_COUNT = static_cast<size_t>(CyclePhase::COUNT);
+
+    /* One phase over all profiled cycles, per-cycle sums */
+    struct PhaseStats
+    {
+        uint32_t calls;  // start() count, e.g. TX attempts
+        uint32_t cycles; // cycles the phase ran in
+        uint64_t total_us;
+        uint32_t max_us;
+        uint64_t host_total_ns;
+        uint32_t host_max_ns;
+    };
+
+    class CycleProfiler
+    {
+    public:
+        static CycleProfiler &instance();
+
+        void begin_cycle();
+
+        /* Before the sleep, closes open spans; no-op outside a cycle */
+        void end_cycle();
+
+        /* Hook pair, nested start() of the same phase is ignored */
+        void start(CyclePhase p);
+        void stop(CyclePhase p);
+
+        const PhaseStats &stats(CyclePhase p) const { return stats_[idx(p)]; }
+
+        /* begin_cycle -> end_cycle, same clocks */
+        const PhaseStats &awake() const { return awake_; }
+
+        uint32_t cycles() const { return cycles_; }
+
+        void reset();
+
+        static const char *name(CyclePhase p);
+
+    private:
+        CycleProfiler() = default;
+
+        static constexpr size_t idx(CyclePhase p) { return static_cast<size_t>(p); }
+
+        static void fold(PhaseStats &s, uint64_t cyc, uint64_t host_ns);
+
+        uint32_t started_cyc_[CYCLE_PHASE_COUNT]{};
+        uint64_t started_host_ns_[CYCLE_PHASE_COUNT]{};
+        uint64_t acc_cyc_[CYCLE_PHASE_COUNT]{};
+        uint64_t acc_host_ns_[CYCLE_PHASE_COUNT]{};
+        uint16_t calls_[CYCLE_PHASE_COUNT]{};
+        uint32_t running_mask_{0};
+
+        bool in_cycle_{false};
+        uint32_t cycle_start_cyc_{0};
+        uint64_t cycle_start_host_ns_{0};
+
+        PhaseStats stats_[CYCLE_PHASE_COUNT]{};
+        PhaseStats awake_{};
+        uint32_t cycles_{0};
+    };
+
+    /* RAII span for hooks that start and stop in one scope */
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(CyclePhase p) : p_(p) { CycleProfiler::instance().start(p_); }
+        ~ProfileScope() { CycleProfiler::instance().stop(p_); }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        CyclePhase p_;
+    };
+
+} // namespace loragro
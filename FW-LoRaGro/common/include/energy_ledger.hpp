@@ -0,0 +1,108 @@
+/**
+ * Energy ledger
+ *
+ * Cheap per-cycle accounting of where the charge goes:
+ *
+ *   start(c) ... stop(c)   - hook pairs around rail on/off, sampling,
+ *                            radio TX/RX and flash writes
+ *   begin_cycle()          - wake-up, closes the sleep interval
+ *   end_cycle()            - right before sleep, computes charge
+ *
+ * Hooks only read the tick counter and add to an accumulator, the
+ * charge is computed once per cycle in end_cycle():
+ *
+ *   charge_nAh = current_uA * active_us / 3.6e6
+ *
+ * Currents come from the per-board model in Kconfig
+ * (CONFIG_LORAGRO_ENERGY_*_UA). Each component current is the draw
+ * ON TOP of the MCU active baseline, which is charged for the whole
+ * awake time, so overlapping spans (rail on while sampling) add up
+ * correctly.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <zephyr/kernel.h>
+
+namespace loragro
+{
+    enum class EnergyComponent : uint8_t
+    {
+        MCU_ACTIVE = 0, // whole awake time, begin_cycle -> end_cycle
+        SENSOR_RAIL,    // PowerRail3V3 on-time
+        SAMPLING,       // SampleManager::sample_all
+        RADIO_TX,       // lora_send
+        RADIO_RX,       // lora_recv (RX window + ACK wait)
+        FLASH,          // ConfigManager::save
+        SLEEP,          // end_cycle -> next begin_cycle
+        COUNT
+    };
+
+    static constexpr size_t ENERGY_COMPONENT_COUNT = static_cast<size_t>(EnergyComponent::COUNT);
+
+    /* Result of one completed cycle (sleep before it + awake part) */
+    struct EnergyReport
+    {
+        uint32_t active_us[ENERGY_COMPONENT_COUNT];
+        uint32_t charge_nAh[ENERGY_COMPONENT_COUNT];
+        uint16_t events[ENERGY_COMPONENT_COUNT]; // e.g. TX attempts incl. retries
+        uint32_t total_nAh;
+        uint32_t cycle;
+    };
+
+    class EnergyLedger
+    {
+    public:
+        static EnergyLedger &instance();
+
+        /* Wake-up, accounts the sleep since previous end_cycle() */
+        void begin_cycle();
+
+        /* Before sleep, closes open spans, computes and logs the report */
+        void end_cycle();
+
+        /* Hook pair, nested start() of the same component is ignored */
+        void start(EnergyComponent c);
+        void stop(EnergyComponent c);
+
+        /* Report of last completed cycle, valid() is false before the first one */
+        const EnergyReport &last_report() const { return report_; }
+        bool valid() const { return report_.cycle > 0; }
+
+        /* Current model for component (uA) */
+        static uint32_t current_ua(EnergyComponent c);
+
+        /* nAh for current_ua flowing for active_us */
+        static uint32_t charge_nAh(uint32_t current_ua, uint64_t active_us);
+
+    private:
+        EnergyLedger() = default;
+
+        static constexpr size_t idx(EnergyComponent c) { return static_cast<size_t>(c); }
+
+        int64_t started_ticks_[ENERGY_COMPONENT_COUNT]{};
+        uint64_t active_ticks_[ENERGY_COMPONENT_COUNT]{};
+        uint16_t events_[ENERGY_COMPONENT_COUNT]{};
+        uint32_t running_mask_{0};
+
+        int64_t sleep_start_ticks_{-1};
+
+        EnergyReport report_{};
+    };
+
+    /* RAII span for hooks that start and stop in one scope */
+    class EnergyScope
+    {
+    public:
+        explicit EnergyScope(EnergyComponent c) : c_(c) { EnergyLedger::instance().start(c_); }
+        ~EnergyScope() { EnergyLedger::instance().stop(c_); }
+
+        EnergyScope(const EnergyScope &) = delete;
+        EnergyScope &operator=(const EnergyScope &) = delete;
+
+    private:
+        EnergyComponent c_;
+    };
+
+} // namespace loragro
@@ -0,0 +1,132 @@
+/**
+ * Frame trace
+ *
+ * Binary capture of every frame the Interface puts on or takes off the
+ * air, for field debugging without LOG_HEXDUMP on the hot path:
+ *
+ *   record()   - Interface hook, copies a fixed-size record into a RAM
+ *                ring; no formatting, no logging
+ *   flush()    - end of cycle, writes full blocks of records to NVS
+ *                (CONFIG_LORAGRO_FRAME_TRACE_FLASH), a ring of
+ *                CONFIG_LORAGRO_FRAME_TRACE_FLASH_BLOCKS records
+ *   dump()     - off the hot path (boot, test), prints flash and RAM
+ *                records as hex lines for tools/frametrace/ftrace2pcap.py,
+ *                which writes a pcap for the LoRaGro Wireshark dissector
+ *
+ * Console format:
+ *
+ *   FTRACE-BEGIN <version> <record size> <snaplen> <uptime ms> <unix ms|0>
+ *   FTRACE <record as hex>
+ *   FTRACE-END <records> <overwritten>
+ *
+ * Like EnergyLedger, only the App thread calls in, there is no locking.
+ *
+ * Records are little-endian, FrameTraceRecord below. Timestamps are the
+ * low 32 bits of TimeManager::unix_ms_at() (uptime until the first sync,
+ * SYNCED flag set after), the converter widens them with the dump header.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <zephyr/kernel.h>
+
+/* Hooks stay in the Interface, a disabled trace keeps a one-record stub */
+#ifdef CONFIG_LORAGRO_FRAME_TRACE
+#define FRAME_TRACE_RECORDS CONFIG_LORAGRO_FRAME_TRACE_RECORDS
+#define FRAME_TRACE_SNAPLEN CONFIG_LORAGRO_FRAME_TRACE_SNAPLEN
+#else
+#define FRAME_TRACE_RECORDS 1
+#define FRAME_TRACE_SNAPLEN 1
+#endif
+
+namespace loragro
+{
+    enum class TraceKind : uint8_t
+    {
+        TX = 1,     // lora_send, result = driver return
+        RX = 2,     // RX window, result = received length or -errno
+        ACK = 3,    // ACK window, result = 0 valid, -ETIMEDOUT, -EIO rejected
+    };
+
+    struct __packed FrameTraceRecord
+    {
+        static constexpr uint8_t KIND_MASK = 0x0F;
+        static constexpr uint8_t SYNCED = 0x80; // time_ms is unix time, not uptime
+
+        uint32_t time_ms;
+        uint16_t seq;        // running record number, gaps = overwritten
+        uint8_t kind;        // TraceKind | flags
+        uint8_t len;         // on-air length
+        uint8_t cap_len;     // bytes in data[], <= snaplen
+        int8_t snr;          // dB, 0 for TX
+        int16_t rssi;        // dBm, 0 for TX
+        uint16_t airtime_ms; // estimated from len and the modem config
+        int16_t result;
+        uint8_t data[FRAME_TRACE_SNAPLEN];
+    };
+
+    static constexpr size_t FRAME_TRACE_HEADER_SIZE = offsetof(FrameTraceRecord, data);
+    static_assert(FRAME_TRACE_HEADER_SIZE == 16, "Record header is part of the pcap format");
+
+    class FrameTrace
+    {
+    public:
+        static constexpr uint8_t FORMAT_VERSION = 1;
+
+        static FrameTrace &instance();
+
+        void record(TraceKind kind, const uint8_t *frame, size_t len,
+                    int result, int16_t rssi = 0, int8_t snr = 0, uint16_t airtime_ms = 0);
+
+        /* Writes full blocks only unless forced, returns blocks written or -errno */
+        int flush(bool force = false);
+
+        /* Prints the stored trace, returns records printed */
+        int dump();
+
+        /* Newest-first access to the RAM ring, for tests */
+        size_t count() const { return count_; }
+        const FrameTraceRecord *latest(size_t age = 0) const;
+
+        /* Records lost to ring overrun since boot */
+        uint32_t overwritten() const { return overwritten_; }
+
+        void reset();
+
+    private:
+        FrameTrace() = default;
+
+        static constexpr size_t RING_SIZE = FRAME_TRACE_RECORDS;
+
+        FrameTraceRecord ring_[RING_SIZE]{};
+        size_t head_{0};  // next write
+        size_t count_{0};
+        size_t unflushed_{0};
+        uint16_t seq_{0};
+        uint32_t overwritten_{0};
+
+#ifdef CONFIG_LORAGRO_FRAME_TRACE_FLASH
+        static constexpr size_t BLOCK_RECORDS = CONFIG_LORAGRO_FRAME_TRACE_BLOCK_RECORDS;
+        static_assert(BLOCK_RECORDS <= RING_SIZE, "A block is filled from the RAM ring");
+
+        /* NVS record layout of one block */
+        struct FlashBlock
+        {
+            uint32_t block_seq;
+            uint8_t count;
+            uint8_t record_size;
+            uint8_t reserved[2];
+            FrameTraceRecord records[BLOCK_RECORDS];
+        };
+
+        void find_flash_head();
+        int dump_flash();
+
+        FlashBlock block_{};
+        uint32_t next_block_seq_{0};
+        bool flash_head_known_{false};
+#endif
+    };
+
+} // namespace loragro
@@ -10,6 +10,8 @@
 #include "data_types.hpp"
 #include "lora/lora_protocol.hpp"
 #include "lora/lora_auth.hpp"
+#include "lora/lora_frame_trace.hpp"
+#include "time_manager.hpp"
 
 namespace loragro
 {
@@ -86,6 +88,9 @@ namespace loragro
 
         k_timeout_t compute_rx_timeout(size_t payload_len) const;
 
+        /* Frame trace of an RX or ACK window, received <= 0 = nothing heard */
+        void trace_rx(TraceKind kind, const uint8_t *buffer, int received, int result);
+
     private:
         const struct device *dev_;
         struct DeviceConfig &cfg_;
@@ -9,16 +9,20 @@ namespace loragro
      * Protocol constants, enums, and ID helpers (your previous version)
      * ========================================================= */
 
-    static constexpr uint8_t PROTOCOL_VERSION = 1;
+    static constexpr uint8_t PROTOCOL_VERSION = 2;
     static constexpr size_t AUTH_TAG_SIZE = 4;
 
+    /* Command IDs as carried on the wire in CONFIG frames (index into the schema table) */
     enum class MessageOp : uint8_t
     {
-        SET_ID = 1,
+        SET_COMBINED_ID = 0,
         SET_SAMPLING_INTERVAL,
         REBOOT,
         SET_UNIX_TIME,
         SET_LORA_CONFIG,
+        SET_UNIX_TIME_MS,
+        SET_TDMA_SLOT,
+        SET_SOIL_CALIB,
         MAX_OP
     };
 
@@ -32,7 +36,8 @@ namespace loragro
         EXECUTED_REBOOT,
         DIFFERENT_ID,
         FLASH_FAILED,
-        AUTH_FAILED
+        AUTH_FAILED,
+        INVALID_VALUE
     };
 
     enum class FrameType : uint8_t
@@ -49,10 +54,9 @@ namespace loragro
         static constexpr size_t COMBINED_ID_MSB = 1;
         static constexpr size_t FRAME_TYPE = 2;
         static constexpr size_t FRAME_CTR = 3;
-        static constexpr size_t CMD_COUNT = 5;
-        static constexpr size_t PROTOCOL_VERSION = 6;
-        static constexpr size_t CMD_ID_AND_SIZE = 7;
-        static constexpr size_t CMD_PAYLOAD = 8;
+        static constexpr size_t CMD_COUNT = 4;
+        static constexpr size_t PROTOCOL_VERSION = 5;
+        static constexpr size_t FIRST_CMD = 6;
 
         static constexpr size_t HEADER_SIZE = 4;
         static constexpr size_t AUTH_SIZE = 4;
@@ -97,6 +101,49 @@ namespace loragro
         buf[offset + 1] = (val >> 8) & 0xFF;
     }
 
+    /* =========================================================
+     * Varint (unsigned LEB128) helpers
+     * ---------------------------------------------------------
+     * Used for CONFIG command lengths. Lengths never exceed one
+     * LoRa frame, so at most 2 bytes (values < 16384) are accepted.
+     * ========================================================= */
+    static constexpr size_t VARINT_MAX_BYTES = 2;
+
+    /* Returns number of bytes consumed, 0 on truncated/overlong input */
+    static inline size_t read_varint(const uint8_t *buf, size_t offset, size_t end, uint16_t &val)
+    {
+        val = 0;
+        for (size_t i = 0; i < VARINT_MAX_BYTES; ++i)
+        {
+            if (offset + i >= end)
+                return 0;
+
+            const uint8_t b = buf[offset + i];
+            val |= static_cast<uint16_t>(b & 0x7F) << (7 * i);
+
+            if ((b & 0x80) == 0)
+                return i + 1;
+        }
+        return 0;
+    }
+
+    /* Returns number of bytes written, 0 if value does not fit */
+    static inline size_t write_varint(uint8_t *buf, size_t offset, uint16_t val)
+    {
+        if (val < 0x80)
+        {
+            buf[offset] = static_cast<uint8_t>(val);
+            return 1;
+        }
+        if (val < 0x4000)
+        {
+            buf[offset] = static_cast<uint8_t>(val & 0x7F) | 0x80;
+            buf[offset + 1] = static_cast<uint8_t>(val >> 7);
+            return 2;
+        }
+        return 0;
+    }
+
     static inline uint32_t read_u32_le(const uint8_t *buf, size_t offset)
     {
         return static_cast<uint32_t>(buf[offset]) |
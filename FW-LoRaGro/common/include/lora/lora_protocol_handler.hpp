@@ -7,19 +7,26 @@
 
 namespace loragro
 {
+    struct SoilLutPoint;
+
     /* =========================================================
      * LoRa RX Config Frame (from gateway to node)
      * ---------------------------------------------------------
-     * [0] target_id         - node ID
-     * [1] source_id         - gateway ID
+     * [0..1] combined_id    - target node (LE)
      * [2] frame_type        - CONFIG frame type
      * [3] packet_counter
      * [4] command_count
      * [5] protocol_version
      * [6] command_id1
-     * [7..10] config1
-     * [11] command_idN
-     * [12..15] configN
+     * [7..] length1         - varint (LEB128, 1-2 bytes)
+     * [..]  payload1        - length1 bytes
+     * ...
+     * [6+x] command_idN, lengthN, payloadN
+     * [..]  auth tag (4 B)
+     * ---------------------------------------------------------
+     * Any number of commands fits into one frame as long as the
+     * frame stays within max payload, so time sync, interval and
+     * radio params can all be delivered in a single RX window.
      * --------------------------------------------------------- */
 
     class ProtocolHandler
@@ -34,40 +41,79 @@ namespace loragro
     private:
         ConfigManager &cfg_;
         using HandlerFn = DecodeResult (ProtocolHandler::*)(const uint8_t *, uint8_t);
+        using ValidateFn = DecodeResult (*)(const uint8_t *, uint8_t);
 
         DecodeResult handle_set_combined_id(const uint8_t *data, const uint8_t payload_ctr);
         DecodeResult handle_sampling_interval(const uint8_t *data, const uint8_t payload_ctr);
         DecodeResult handle_reboot(const uint8_t *data, const uint8_t payload_ctr);
         DecodeResult handle_set_unix_time(const uint8_t *data, const uint8_t payload_ctr);
         DecodeResult handle_lora_config(const uint8_t *data, const uint8_t payload_ctr);
+        DecodeResult handle_set_unix_time_ms(const uint8_t *data, const uint8_t payload_ctr);
+        DecodeResult handle_set_tdma_slot(const uint8_t *data, const uint8_t payload_ctr);
+        DecodeResult handle_set_soil_calib(const uint8_t *data, const uint8_t payload_ctr);
+
+        static DecodeResult validate_tdma_slot(const uint8_t *data, const uint8_t payload_ctr);
+        static DecodeResult validate_soil_calib(const uint8_t *data, const uint8_t payload_ctr);
+        static uint8_t read_soil_calib(const uint8_t *data, SoilLutPoint *points);
+
+        /* =====================================================
+         * Command schema
+         * -----------------------------------------------------
+         * One entry per MessageOp, indexed by the wire command ID.
+         * decode() checks the length bounds and runs the validate
+         * hook (value checks, nullptr if the length is enough) for
+         * every command of the batch before the first handler runs,
+         * so handlers only apply and a bad tail changes nothing.
+         * ===================================================== */
+        /* SET_SOIL_CALIB: [probe][count] + count * [mv u16 LE][moisture] */
+        static constexpr uint8_t SOIL_CALIB_HEADER = 2;
+        static constexpr uint8_t SOIL_CALIB_POINT_SIZE = 3;
 
-        static constexpr HandlerFn dispatch_table[static_cast<uint8_t>(MessageOp::MAX_OP)] = {
-            &ProtocolHandler::handle_set_combined_id,
-            &ProtocolHandler::handle_sampling_interval,
-            &ProtocolHandler::handle_reboot,
-            &ProtocolHandler::handle_set_unix_time,
-            &ProtocolHandler::handle_lora_config,
+        struct CommandSchema
+        {
+            MessageOp op;
+            uint8_t min_len;
+            uint8_t max_len;
+            HandlerFn handler;
+            ValidateFn validate;
+        };
+
+        static constexpr CommandSchema command_table[] = {
+            {MessageOp::SET_COMBINED_ID, 2, 2, &ProtocolHandler::handle_set_combined_id, nullptr},
+            {MessageOp::SET_SAMPLING_INTERVAL, 1, 1, &ProtocolHandler::handle_sampling_interval, nullptr},
+            {MessageOp::REBOOT, 0, 0, &ProtocolHandler::handle_reboot, nullptr},
+            {MessageOp::SET_UNIX_TIME, 8, 8, &ProtocolHandler::handle_set_unix_time, nullptr},
+            {MessageOp::SET_LORA_CONFIG, 10, 10, &ProtocolHandler::handle_lora_config, nullptr},
+            {MessageOp::SET_UNIX_TIME_MS, 8, 8, &ProtocolHandler::handle_set_unix_time_ms, nullptr},
+            {MessageOp::SET_TDMA_SLOT, 9, 9, &ProtocolHandler::handle_set_tdma_slot,
+             &ProtocolHandler::validate_tdma_slot},
+            {MessageOp::SET_SOIL_CALIB, SOIL_CALIB_HEADER + 2 * SOIL_CALIB_POINT_SIZE,
+             SOIL_CALIB_HEADER + SoilSensorConstants::SOIL_CALIB_MAX_POINTS * SOIL_CALIB_POINT_SIZE,
+             &ProtocolHandler::handle_set_soil_calib, &ProtocolHandler::validate_soil_calib},
         };
 
-        static constexpr size_t dispatch_table_size_ =
-            sizeof(dispatch_table) / sizeof(dispatch_table[0]);
+        static constexpr size_t command_table_size_ =
+            sizeof(command_table) / sizeof(command_table[0]);
 
-        constexpr uint8_t decode_cmd_id(uint8_t raw) { return (raw >> 2) & 0x3F; }
-        constexpr uint8_t decode_cmd_size(uint8_t raw) { return raw & 0x03; }
+        /* Largest command payload a single CONFIG frame can carry (SF7/SF8) */
+        static constexpr uint8_t MAX_CMD_PAYLOAD = 242 - FrameLayout::FIRST_CMD - AUTH_TAG_SIZE;
 
-        static constexpr uint8_t payload_size(uint8_t encoded_size)
+        static constexpr bool schema_is_valid()
         {
-            switch (encoded_size)
+            if (command_table_size_ != static_cast<size_t>(MessageOp::MAX_OP))
+                return false;
+
+            for (size_t i = 0; i < command_table_size_; ++i)
             {
-            case 0x00:
-                return 1;
-            case 0x01:
-                return 2;
-            case 0x02:
-                return 4;
-            default:
-                return 0;
+                const CommandSchema &s = command_table[i];
+                if (static_cast<size_t>(s.op) != i)
+                    return false;
+                if (s.handler == nullptr)
+                    return false;
+                if (s.min_len > s.max_len || s.max_len > MAX_CMD_PAYLOAD)
+                    return false;
             }
+            return true;
         }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,31 @@
+/**
+ * SX1262 on the BabbleSim shared medium (drivers/lora/sx1262_bsim.cpp)
+ *
+ * BabbleSim has no LoRa PHY, so the driver maps a LoRa frame onto the
+ * simulated nRF RADIO: a train of BLE 1M packets, each carrying the
+ * whole frame plus [seq][count], back to back for the LoRa airtime of
+ * the frame at the configured SF/BW/CR. The receiver only delivers a
+ * frame when it heard the complete train, so any overlap with another
+ * transmitter on the same spreading factor (the same 2.4 GHz channel)
+ * that the 2G4 phy does not capture destroys the frame, and
+ * lora_send() blocks for the real airtime.
+ *
+ * Every TX and every delivered RX is logged in one line, which is what
+ * tools/bsim/scripts/report.py reads back:
+ *
+ *   TX id=0x0801 type=0x01 ctr=12 len=47 air_ms=1482
+ *   RX id=0x0801 type=0xa5 ctr=12 len=8 rssi=-61
+ */
+#pragma once
+
+#include <zephyr/device.h>
+#include <stdint.h>
+
+extern "C"
+{
+    /* LoRa airtime of len bytes with the settings of the last lora_config() */
+    uint32_t sx1262_bsim_airtime_us(const struct device *dev, uint32_t len);
+
+    /* bsim device number (-d=), unique per simulated device */
+    uint32_t sx1262_bsim_device_number(void);
+}
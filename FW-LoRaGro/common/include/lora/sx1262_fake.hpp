@@ -0,0 +1,59 @@
+/**
+ * Fake SX1262 channel model (drivers/lora/sx1262_fake.cpp)
+ *
+ * The fake radio plays the gateway: it ACKs every heard uplink and
+ * injects CONFIG frames into the following RX window. The link between
+ * node and gateway is a small statistical model:
+ *
+ *   uplink     lost with uplink_loss_permille, no ACK, no CONFIG
+ *   ACK        lost with ack_loss_permille, delayed by 0..jitter ms
+ *   CONFIG     after every config_period-th heard uplink,
+ *              lost with downlink_loss_permille
+ *   duplicate  a delivered ACK / CONFIG comes again on the next recv
+ *   RSSI, SNR  normal distribution (mean, stddev)
+ *
+ * Defaults come from devicetree (see p4v,sx1262-fake.yaml); tests and
+ * simulations can swap the model at runtime and read the counters.
+ */
+#pragma once
+
+#include <zephyr/device.h>
+#include <stdint.h>
+
+struct sx1262_fake_channel
+{
+    uint16_t uplink_loss_permille;
+    uint16_t ack_loss_permille;
+    uint16_t downlink_loss_permille;
+    uint16_t duplicate_permille;
+    int16_t rssi_dbm;
+    uint8_t rssi_stddev_db;
+    int8_t snr_db;
+    uint8_t snr_stddev_db;
+    uint16_t latency_jitter_ms;
+    uint8_t config_period; // 0 = no CONFIG injection
+};
+
+struct sx1262_fake_stats
+{
+    uint32_t uplinks;
+    uint32_t uplinks_lost;
+    uint32_t acks_sent;
+    uint32_t acks_lost;
+    uint32_t downlinks_sent;
+    uint32_t downlinks_lost;
+    uint32_t duplicates;
+};
+
+extern "C"
+{
+    /* Replace the channel model, -EINVAL for probabilities above 1000 */
+    int sx1262_fake_set_channel(const struct device *dev, const struct sx1262_fake_channel *channel);
+    void sx1262_fake_get_channel(const struct device *dev, struct sx1262_fake_channel *channel);
+
+    /* Restart the random sequence, same seed gives the same losses */
+    void sx1262_fake_seed(const struct device *dev, uint32_t seed);
+
+    void sx1262_fake_get_stats(const struct device *dev, struct sx1262_fake_stats *stats);
+    void sx1262_fake_reset_stats(const struct device *dev);
+}
@@ -0,0 +1,193 @@
+/**
+ * Modbus RTU client
+ *
+ * Minimal master side of Modbus RTU for the RS485 sensor bus:
+ *
+ *   request  [addr][fc][start hi][start lo][count hi][count lo][crc lo][crc hi]
+ *   response [addr][fc][byte count][reg0 hi][reg0 lo]...[crc lo][crc hi]
+ *   exception[addr][fc | 0x80][code][crc lo][crc hi]
+ *
+ * One client per bus, any number of slave addresses. The client owns
+ * frame building, CRC16 and validation; the byte transfer is done by a
+ * ModbusTransport (UART async on hardware, ModbusSimSlave in tests and
+ * simulation).
+ *
+ * Frame timing (Modbus over serial line, 2.3.1.4):
+ *   character = 11 bits (start, 8 data, parity/2nd stop, stop)
+ *   t3.5 = 3.5 characters, fixed 1750 us above 19200 baud
+ *   t1.5 = 1.5 characters, fixed  750 us above 19200 baud
+ * The client keeps t3.5 of silence between the end of a response and
+ * the next request, the transport ends a frame on a t1.5 RX gap.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <zephyr/kernel.h>
+
+namespace loragro
+{
+    namespace modbus
+    {
+        enum FunctionCode : uint8_t
+        {
+            READ_HOLDING_REGISTERS = 0x03,
+            READ_INPUT_REGISTERS = 0x04,
+        };
+
+        enum ExceptionCode : uint8_t
+        {
+            ILLEGAL_FUNCTION = 0x01,
+            ILLEGAL_DATA_ADDRESS = 0x02,
+            ILLEGAL_DATA_VALUE = 0x03,
+            SLAVE_DEVICE_FAILURE = 0x04,
+        };
+
+        static constexpr uint8_t EXCEPTION_FLAG = 0x80;
+        static constexpr uint8_t BROADCAST_ADDR = 0;
+        static constexpr uint8_t MAX_SLAVE_ADDR = 247;
+
+        /* Serial line ADU limit and register count per read */
+        static constexpr size_t MAX_ADU = 256;
+        static constexpr uint16_t MAX_READ_REGISTERS = 125;
+
+        static constexpr size_t READ_REQUEST_LEN = 8;
+        static constexpr size_t EXCEPTION_LEN = 5;
+        static constexpr size_t read_response_len(uint16_t count) { return 5 + 2 * count; }
+
+        /* CRC-16/MODBUS, poly 0xA001 reflected, init 0xFFFF, sent LSB first */
+        constexpr uint16_t crc16(const uint8_t *data, size_t len)
+        {
+            uint16_t crc = 0xFFFF;
+            for (size_t i = 0; i < len; ++i)
+            {
+                crc ^= data[i];
+                for (uint8_t bit = 0; bit < 8; ++bit)
+                    crc = (crc & 1) ? static_cast<uint16_t>((crc >> 1) ^ 0xA001) : static_cast<uint16_t>(crc >> 1);
+            }
+            return crc;
+        }
+
+        /* Silent interval between frames (us) */
+        constexpr uint32_t t35_us(uint32_t baudrate)
+        {
+            return baudrate > 19200 ? 1750 : static_cast<uint32_t>((35ULL * 11 * 1000000) / (10ULL * baudrate));
+        }
+
+        /* Max gap between characters of one frame (us) */
+        constexpr uint32_t t15_us(uint32_t baudrate)
+        {
+            return baudrate > 19200 ? 750 : static_cast<uint32_t>((15ULL * 11 * 1000000) / (10ULL * baudrate));
+        }
+
+        /* Time on the line for len bytes (us) */
+        constexpr uint32_t frame_us(uint32_t baudrate, size_t len)
+        {
+            return static_cast<uint32_t>((static_cast<uint64_t>(len) * 11 * 1000000) / baudrate);
+        }
+    } // namespace modbus
+
+    /**
+     * Half-duplex byte transport below the client.
+     *
+     * transceive() sends one request frame and receives the answer into
+     * rx, ending on rx_len bytes, a t1.5 character gap or timeout_ms
+     * without an answer. Returns the number of bytes received (0 is not
+     * a valid answer) or a negative errno, -ETIMEDOUT if nobody answered.
+     */
+    class ModbusTransport
+    {
+    public:
+        virtual ~ModbusTransport() = default;
+
+        virtual int transceive(const uint8_t *tx, size_t tx_len,
+                               uint8_t *rx, size_t rx_len,
+                               uint32_t timeout_ms) = 0;
+
+        /* Keep the line powered across several transactions */
+        virtual int open() { return 0; }
+        virtual void close() {}
+    };
+
+    class ModbusRtuClient
+    {
+    public:
+        ModbusRtuClient(ModbusTransport &transport, uint32_t baudrate,
+                        uint32_t response_timeout_ms = DEFAULT_RESPONSE_TIMEOUT_MS);
+
+        /**
+         * Read count consecutive registers of one slave in a single
+         * request. Returns 0, or
+         *   -EINVAL     bad address / count
+         *   -ETIMEDOUT  no answer
+         *   -EBADMSG    CRC, length or header mismatch
+         *   -EREMOTEIO  slave answered with an exception (last_exception())
+         */
+        int read_holding_registers(uint8_t slave, uint16_t start, uint16_t count, uint16_t *regs);
+        int read_input_registers(uint8_t slave, uint16_t start, uint16_t count, uint16_t *regs);
+
+        /* Anybody at this address? Any valid answer counts, incl. exceptions */
+        bool probe(uint8_t slave, uint16_t reg);
+
+        /**
+         * Back-to-back transactions in one transport session: the UART
+         * stays up and requests follow each other at t3.5 spacing.
+         * Half-duplex RTU allows a single outstanding request, so this
+         * is as close to pipelining as the bus gets.
+         */
+        class Session
+        {
+        public:
+            explicit Session(ModbusRtuClient &client) : client_(client)
+            {
+                status_ = client_.transport_.open();
+            }
+            ~Session() { client_.transport_.close(); }
+
+            Session(const Session &) = delete;
+            Session &operator=(const Session &) = delete;
+
+            int status() const { return status_; }
+
+        private:
+            ModbusRtuClient &client_;
+            int status_;
+        };
+
+        /* Exception code of the last -EREMOTEIO */
+        uint8_t last_exception() const { return last_exception_; }
+
+        /* Bus statistics since boot */
+        uint32_t transactions() const { return transactions_; }
+        uint32_t failures() const { return failures_; }
+
+        uint32_t baudrate() const { return baudrate_; }
+
+        static constexpr uint32_t DEFAULT_RESPONSE_TIMEOUT_MS = 200;
+
+        /* Slaves answer within a few ms, scanning empty addresses must be cheap */
+        static constexpr uint32_t PROBE_TIMEOUT_MS = 20;
+
+    private:
+        int read_registers(uint8_t fc, uint8_t slave, uint16_t start, uint16_t count,
+                           uint16_t *regs, uint32_t response_timeout_ms);
+        int parse_read_response(uint8_t fc, uint8_t slave, const uint8_t *rx, int rx_len,
+                                uint16_t count, uint16_t *regs);
+
+        /* Keep t3.5 of silence after the previous frame */
+        void wait_frame_gap() const;
+
+        ModbusTransport &transport_;
+        const uint32_t baudrate_;
+        const uint32_t response_timeout_ms_;
+        const uint32_t gap_us_;
+
+        int64_t last_frame_end_ticks_{0};
+        uint8_t last_exception_{0};
+        uint32_t transactions_{0};
+        uint32_t failures_{0};
+
+        uint8_t rx_buf_[modbus::MAX_ADU]{};
+    };
+
+} // namespace loragro
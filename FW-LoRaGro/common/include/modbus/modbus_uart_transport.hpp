@@ -0,0 +1,64 @@
+/**
+ * Modbus RTU transport over the Zephyr UART async API
+ *
+ * Request goes out with uart_tx() (EasyDMA), the answer is received
+ * into the caller's buffer with uart_rx_enable() and a t1.5 inactivity
+ * timeout, so the CPU only wakes for TX done, RX ready and RX disabled.
+ * RS485 direction is switched by the transceiver (auto-direction) or by
+ * the UART driver (hw flow control as DE), not here.
+ *
+ * With CONFIG_PM_DEVICE the UART is resumed for the transaction (or
+ * for an open() ... close() session spanning several) and suspended
+ * after it, so the UART is powered only while the bus is in use.
+ */
+#pragma once
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+
+#include "modbus/modbus_rtu.hpp"
+
+namespace loragro
+{
+    class ModbusUartTransport : public ModbusTransport
+    {
+    public:
+        ModbusUartTransport(const struct device *uart, uint32_t baudrate);
+
+        int init();
+
+        int transceive(const uint8_t *tx, size_t tx_len,
+                       uint8_t *rx, size_t rx_len,
+                       uint32_t timeout_ms) override;
+
+        /* UART resumed once for a whole bus sweep */
+        int open() override;
+        void close() override;
+
+    private:
+        int transfer(const uint8_t *tx, size_t tx_len,
+                     uint8_t *rx, size_t rx_len,
+                     uint32_t timeout_ms);
+
+        static void uart_cb(const struct device *dev, struct uart_event *evt, void *user_data);
+        void on_event(const struct uart_event *evt);
+
+        const struct device *uart_;
+        const uint32_t baudrate_;
+        bool initialized_{false};
+        bool session_open_{false};
+
+        struct k_sem tx_done_;
+        struct k_sem rx_done_;
+
+        /* Filled from UART ISR context */
+        volatile size_t rx_count_{0};
+        size_t rx_expected_{0};
+        volatile int tx_status_{0};
+
+        /* Slack for driver latency on top of the line time */
+        static constexpr uint32_t TX_MARGIN_MS = 10;
+    };
+
+} // namespace loragro
@@ -2,31 +2,84 @@
 
 #include "zephyr/kernel.h"
 #include "zephyr/logging/log.h"
+#include <zephyr/device.h>
 
-#include "sample_manager.hpp"
 #include "config_manager.hpp"
+#include "slot_scheduler.hpp"
+#include "battery_estimator.hpp"
+#include "sensors/battery_sense.hpp"
 #include "data_types.hpp"
 
 namespace loragro
 {
+    /* Why the node left handle_sleep(), handed over to the next run cycle */
+    enum class WakeReason : uint8_t
+    {
+        BOOT = 0,
+        SLOT,              // regular TDMA slot
+        BATTERY_RECOVERED, // left low-power recovery mode
+        BATTERY_UNKNOWN,   // left recovery mode, battery could not be read
+    };
+
+    struct WakeInfo
+    {
+        WakeReason reason;
+        int32_t battery_mv;   // last reading, taken after the final wake-up
+        uint32_t recovery_s;  // time spent in recovery mode
+        uint8_t recovery_checks;
+    };
+
     class PowerManagement
     {
     public:
-        PowerManagement(SampleManager &sample_mgr,
-                        const uint8_t battery_sense_id,
-                        const DeviceConfig &dev_cfg)
-            : sample_mgr_(sample_mgr),
-              battery_sense_id_(battery_sense_id),
-              dev_cfg_(dev_cfg) {};
+        PowerManagement(BatterySenseAdapter &battery,
+                        const DeviceConfig &dev_cfg,
+                        const struct device *radio_dev = nullptr)
+            : battery_(battery),
+              dev_cfg_(dev_cfg),
+              radio_dev_(radio_dev),
+              scheduler_(dev_cfg),
+              estimator_(dev_cfg) {};
 
         int handle_sleep();
 
+        /* State of the last wake-up, consumed by the run cycle */
+        const WakeInfo &wake_info() const { return wake_; }
+
+        /* Forwarded from the run cycle right before first TX */
+        void mark_tx_start() { scheduler_.mark_tx_start(); }
+
+        /* TX power limit from predicted battery sag, applied before radio init */
+        int8_t tx_power_cap_dbm() const { return estimator_.tx_power_cap_dbm(); }
+
+        const BatteryEstimator &estimator() const { return estimator_; }
+
+    private:
+        /* Battery only, sampled directly (no SampleManager pass), <= 0 on failure */
+        int32_t read_battery_mv();
+
+        /* Low-power loop until battery is back above cutoff + hysteresis, or unreadable */
+        void recovery_mode();
+
+        void suspend_peripherals();
+        void resume_peripherals();
+
     private:
-        SampleManager &sample_mgr_;
-        const uint8_t battery_sense_id_;
+        BatterySenseAdapter &battery_;
         const DeviceConfig &dev_cfg_;
+        const struct device *radio_dev_;
+        SlotScheduler scheduler_;
+        BatteryEstimator estimator_;
+
+        WakeInfo wake_{WakeReason::BOOT, 0, 0, 0};
+
+        /* First recovery check, doubled up to critically_low_battery_timeout_hours */
+        static constexpr uint32_t RECOVERY_FIRST_CHECK_MIN = 30;
+
+        /* Leave recovery only this far above cutoff, avoids bouncing at the edge */
+        static constexpr int32_t RECOVERY_HYSTERESIS_MV = 100;
 
-        static const float calculate_airtime_s(const DeviceConfig &cfg, const uint8_t payload_len);
-        static const uint8_t get_max_payload(const DeviceConfig &cfg);
+        /* Failed readings in a row before recovery gives up on the ADC */
+        static constexpr uint8_t RECOVERY_MAX_FAILED_READS = 3;
     };
 }
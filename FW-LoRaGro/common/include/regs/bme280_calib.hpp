@@ -26,6 +26,93 @@ struct Calibration
     int16_t  dig_H4;
     int16_t  dig_H5;
     int8_t   dig_H6;
+
+    /* dig_T1 / dig_P1 are never 0 on a real part, P1 = 0 would divide by zero */
+    constexpr bool valid() const { return dig_T1 != 0 && dig_P1 != 0; }
+
+    /* Decode NVM blocks 0x88..0xA1 (c00) and 0xE1..0xE7 (c26) */
+    static constexpr Calibration parse(const uint8_t *c00, const uint8_t *c26)
+    {
+        auto u16 = [](const uint8_t *p)
+        { return static_cast<uint16_t>(p[0] | (p[1] << 8)); };
+        auto s16 = [&](const uint8_t *p)
+        { return static_cast<int16_t>(u16(p)); };
+
+        Calibration c{};
+        c.dig_T1 = u16(&c00[0]);
+        c.dig_T2 = s16(&c00[2]);
+        c.dig_T3 = s16(&c00[4]);
+
+        c.dig_P1 = u16(&c00[6]);
+        c.dig_P2 = s16(&c00[8]);
+        c.dig_P3 = s16(&c00[10]);
+        c.dig_P4 = s16(&c00[12]);
+        c.dig_P5 = s16(&c00[14]);
+        c.dig_P6 = s16(&c00[16]);
+        c.dig_P7 = s16(&c00[18]);
+        c.dig_P8 = s16(&c00[20]);
+        c.dig_P9 = s16(&c00[22]);
+
+        c.dig_H1 = c00[25];
+        c.dig_H2 = s16(&c26[0]);
+        c.dig_H3 = c26[2];
+        /* 12 bit signed values sharing the nibbles of 0xE5 */
+        c.dig_H4 = static_cast<int16_t>((static_cast<int8_t>(c26[3]) * 16) | (c26[4] & 0x0F));
+        c.dig_H5 = static_cast<int16_t>((static_cast<int8_t>(c26[5]) * 16) | (c26[4] >> 4));
+        c.dig_H6 = static_cast<int8_t>(c26[6]);
+        return c;
+    }
 };
 
+/*
+ * Integer compensation, Bosch BME280 datasheet 4.2.3 / 8.2
+ * (32 bit temperature and humidity, 64 bit pressure).
+ */
+
+/* Temperature in 0.01 degC, t_fine feeds pressure and humidity */
+constexpr int32_t compensate_temperature(const Calibration &c, int32_t adc_T, int32_t &t_fine)
+{
+    const int32_t var1 = ((((adc_T >> 3) - (static_cast<int32_t>(c.dig_T1) << 1))) *
+                          static_cast<int32_t>(c.dig_T2)) >> 11;
+    const int32_t var2 = (((((adc_T >> 4) - static_cast<int32_t>(c.dig_T1)) *
+                            ((adc_T >> 4) - static_cast<int32_t>(c.dig_T1))) >> 12) *
+                          static_cast<int32_t>(c.dig_T3)) >> 14;
+    t_fine = var1 + var2;
+    return (t_fine * 5 + 128) >> 8;
+}
+
+/* Pressure in Pa as Q24.8 (value / 256 = Pa), 0 on invalid calibration */
+constexpr uint32_t compensate_pressure(const Calibration &c, int32_t adc_P, int32_t t_fine)
+{
+    int64_t var1 = static_cast<int64_t>(t_fine) - 128000;
+    int64_t var2 = var1 * var1 * c.dig_P6;
+    var2 = var2 + ((var1 * c.dig_P5) * (int64_t{1} << 17));
+    var2 = var2 + (static_cast<int64_t>(c.dig_P4) * (int64_t{1} << 35));
+    var1 = ((var1 * var1 * c.dig_P3) >> 8) + ((var1 * c.dig_P2) * (int64_t{1} << 12));
+    var1 = ((int64_t{1} << 47) + var1) * static_cast<int64_t>(c.dig_P1) >> 33;
+    if (var1 == 0)
+        return 0;
+
+    int64_t p = 1048576 - adc_P;
+    p = ((p * (int64_t{1} << 31)) - var2) * 3125 / var1;
+    var1 = (static_cast<int64_t>(c.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (static_cast<int64_t>(c.dig_P8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (static_cast<int64_t>(c.dig_P7) * 16);
+    return static_cast<uint32_t>(p);
+}
+
+/* Relative humidity in %RH as Q22.10 (value / 1024 = %RH) */
+constexpr uint32_t compensate_humidity(const Calibration &c, int32_t adc_H, int32_t t_fine)
+{
+    int32_t v = t_fine - 76800;
+    v = (((((adc_H << 14) - (static_cast<int32_t>(c.dig_H4) * (1 << 20)) -
+            (static_cast<int32_t>(c.dig_H5) * v)) + 16384) >> 15) *
+         (((((((v * c.dig_H6) >> 10) * (((v * c.dig_H3) >> 11) + 32768)) >> 10) + 2097152) *
+               c.dig_H2 + 8192) >> 14));
+    v = v - (((((v >> 15) * (v >> 15)) >> 7) * c.dig_H1) >> 4);
+    v = v < 0 ? 0 : v;
+    v = v > 419430400 ? 419430400 : v;
+    return static_cast<uint32_t>(v >> 12);
+}
+
 } // namespace loragro::bme280
@@ -34,5 +34,48 @@ namespace loragro::bme280
     /* Calib helpers */
     static constexpr uint8_t REG_CALIB_00 = 0x88;
     static constexpr uint8_t REG_CALIB_26 = 0xE1;
+    static constexpr uint8_t CALIB_00_LEN = 26; // 0x88..0xA1, T1..P9, H1
+    static constexpr uint8_t CALIB_26_LEN = 7;  // 0xE1..0xE7, H2..H6
+
+    /* REG_RESET */
+    static constexpr uint8_t SOFT_RESET = 0xB6;
+
+    /* REG_STATUS */
+    static constexpr uint8_t STATUS_MEASURING = 0x08;
+    static constexpr uint8_t STATUS_IM_UPDATE = 0x01;
+
+    /* REG_CTRL_MEAS: osrs_t[7:5] osrs_p[4:2] mode[1:0], REG_CTRL_HUM: osrs_h[2:0] */
+    static constexpr uint8_t MODE_SLEEP = 0x00;
+    static constexpr uint8_t MODE_FORCED = 0x01;
+    static constexpr uint8_t MODE_MASK = 0x03;
+    static constexpr uint8_t OSRS_T_SHIFT = 5;
+    static constexpr uint8_t OSRS_P_SHIFT = 2;
+    static constexpr uint8_t OSRS_MASK = 0x07;
+
+    /* Oversampling register codes, 0 = channel skipped */
+    static constexpr uint8_t OSRS_SKIP = 0;
+    static constexpr uint8_t OSRS_X1 = 1;
+    static constexpr uint8_t OSRS_X2 = 2;
+    static constexpr uint8_t OSRS_X4 = 3;
+    static constexpr uint8_t OSRS_X8 = 4;
+    static constexpr uint8_t OSRS_X16 = 5;
+
+    /* Oversampling count of a register code: 0, 1, 2, 4, 8, 16 */
+    constexpr uint32_t osrs_count(uint8_t code)
+    {
+        return code == OSRS_SKIP ? 0 : (1U << ((code > OSRS_X16 ? OSRS_X16 : code) - 1));
+    }
+
+    /* Max forced mode conversion time (datasheet 9.1), us */
+    constexpr uint32_t measurement_time_us(uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h)
+    {
+        return 1250 + 2300 * osrs_count(osrs_t) +
+               (osrs_p ? 2300 * osrs_count(osrs_p) + 575 : 0) +
+               (osrs_h ? 2300 * osrs_count(osrs_h) + 575 : 0);
+    }
+
+    /* Data register value of a skipped channel */
+    static constexpr uint32_t ADC_SKIPPED_20BIT = 0x80000;
+    static constexpr uint32_t ADC_SKIPPED_16BIT = 0x8000;
 
 } // namespace loragro::bme280
@@ -0,0 +1,49 @@
+/**
+ * Private sensor attributes of the fake SCD41 driver (p4v,sensor-scd41-fake).
+ *
+ * The fake driver exposes the SCD41 commands as private attributes on
+ * SENSOR_CHAN_CO2, Scd41FakeBus maps the I2C commands onto them:
+ *
+ *   sensor_attr_set(dev, SENSOR_CHAN_CO2, SCD41_ATTR_MEASURE_SINGLE_SHOT, &v)
+ *
+ * sensor_sample_fetch() maps to read_measurement and returns -EBUSY
+ * until the single-shot conversion is done. Other drivers number their
+ * own private attributes from SENSOR_ATTR_PRIV_START too, so these IDs
+ * mean nothing to a real device.
+ */
+#pragma once
+
+#ifndef CONFIG_SENSOR_P4V_SCD41_FAKE
+#error "SCD41 private attributes only exist in the fake driver"
+#endif
+
+#include <zephyr/drivers/sensor.h>
+
+#include "regs/scd41_regs.h"
+
+enum scd41_attribute
+{
+    /* set: start a 5 s single-shot conversion */
+    SCD41_ATTR_MEASURE_SINGLE_SHOT = SENSOR_ATTR_PRIV_START,
+    /* set: sleep (idle ~0.5 uA), RAM kept while VDD stays on */
+    SCD41_ATTR_POWER_DOWN,
+    /* set: leave sleep, 30 ms */
+    SCD41_ATTR_WAKE_UP,
+    /* set/get: on-chip automatic self-calibration, val1 = 0 / 1 */
+    SCD41_ATTR_ASC_ENABLED,
+    /* set: write settings to EEPROM (limited write cycles) */
+    SCD41_ATTR_PERSIST_SETTINGS,
+    /* get: val1 = ms until the running conversion is ready, 0 if ready */
+    SCD41_ATTR_DATA_READY_IN,
+};
+
+/* Command timing statistics for benchmarks */
+enum scd41_fake_attribute
+{
+    /* get: val1 = completed single-shot readings */
+    SCD41_FAKE_ATTR_READINGS = SCD41_ATTR_DATA_READY_IN + 1,
+    /* get: val1 = ms spent awake (not in power-down) */
+    SCD41_FAKE_ATTR_AWAKE_MS,
+    /* get: val1 = EEPROM writes (persist_settings) */
+    SCD41_FAKE_ATTR_EEPROM_WRITES,
+};
@@ -0,0 +1,67 @@
+/**
+ * SCD41 command set and timing (Sensirion SCD4x datasheet).
+ *
+ * Shared by the I2C command path (scd41/scd41_bus.hpp), the adapter
+ * and the fake driver. The fake driver's private sensor attributes
+ * live in regs/scd41_fake.h, the upstream Zephyr scd4x driver is not
+ * used.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* I2C commands */
+#define SCD41_CMD_MEASURE_SINGLE_SHOT 0x219D
+#define SCD41_CMD_READ_MEASUREMENT 0xEC05
+#define SCD41_CMD_GET_DATA_READY 0xE4B8
+#define SCD41_CMD_POWER_DOWN 0x36E0
+#define SCD41_CMD_WAKE_UP 0x36F6
+#define SCD41_CMD_PERSIST_SETTINGS 0x3615
+#define SCD41_CMD_SET_ASC_ENABLED 0x2416
+#define SCD41_CMD_GET_ASC_ENABLED 0x2313
+
+/* Command execution times, ms */
+#define SCD41_SINGLE_SHOT_MS 5000
+#define SCD41_READ_MEASUREMENT_MS 1
+#define SCD41_POWER_DOWN_MS 1
+#define SCD41_WAKE_UP_MS 30     /* also power-up time after VDD on */
+#define SCD41_PERSIST_SETTINGS_MS 800
+#define SCD41_SET_ASC_MS 1
+#define SCD41_GET_ASC_MS 1
+#define SCD41_GET_DATA_READY_MS 1
+
+/* get_data_ready_status: not ready while the low 11 bits are 0 */
+#define SCD41_DATA_READY_MASK 0x07FF
+
+/* read_measurement: CO2, temperature, humidity */
+#define SCD41_MAX_READ_WORDS 3
+
+#ifdef __cplusplus
+namespace loragro::scd41
+{
+    /* Sensirion CRC-8 over one data word: poly 0x31, init 0xFF */
+    constexpr uint8_t crc8(const uint8_t *data, size_t len)
+    {
+        uint8_t crc = 0xFF;
+        for (size_t i = 0; i < len; ++i)
+        {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31) : static_cast<uint8_t>(crc << 1);
+        }
+        return crc;
+    }
+
+    /* Raw words to milli units (datasheet conversion) */
+    constexpr int32_t temp_milli_c(uint16_t raw)
+    {
+        return -45000 + static_cast<int32_t>((175000LL * raw) / 65535);
+    }
+
+    constexpr int32_t rh_milli(uint16_t raw)
+    {
+        return static_cast<int32_t>((100000LL * raw) / 65535);
+    }
+} // namespace loragro::scd41
+#endif
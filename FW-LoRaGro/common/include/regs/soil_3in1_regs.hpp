@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+namespace loragro::soil3in1
+{
+
+    /* Holding registers (FC 0x03), RS485 8N1 */
+    static constexpr uint16_t REG_MOISTURE = 0x0000;     /* % x10 */
+    static constexpr uint16_t REG_TEMPERATURE = 0x0001;  /* C x10, signed */
+    static constexpr uint16_t REG_CONDUCTIVITY = 0x0002; /* uS/cm */
+
+    /* Moisture, temperature and EC in one multi-register read */
+    static constexpr uint16_t BLOCK_START = REG_MOISTURE;
+    static constexpr uint16_t BLOCK_COUNT = 3;
+
+} // namespace loragro::soil3in1
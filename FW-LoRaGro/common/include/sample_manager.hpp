@@ -12,6 +12,22 @@
  *   → sample_all()
  *   → disable_3v3()
  *
+ * sample_all() runs in three phases so slow conversions overlap:
+ *   1. start() on every sensor, the longest reported wait sets ready time
+ *   2. sample() the sensors that need no wait
+ *   3. sleep until ready time, sample() the started ones
+ *
+ * Rail-on time is max(slowest conversion, sum of fast samples), not
+ * the sum of all of them.
+ *
+ * Failures are isolated per sensor (SensorHealth): a sensor failing
+ * init(), start() or sample() is left out of this cycle's batch and
+ * backed off exponentially, the other sensors are sampled as usual.
+ * If any sensor failed or is backing off, a DIAG_SENSOR_HEALTH entry
+ * with the failed / quarantined bitmaps (bit = registration index)
+ * is appended to the batch, also when sampling stopped early. The last
+ * batch slot is kept free for it.
+ *
  */
 #pragma once
 
@@ -20,6 +36,7 @@
 #include <array>
 
 #include "sensors/sensor_base.hpp"
+#include "sensor_health.hpp"
 #include "data_types.hpp"
 
 namespace loragro
@@ -27,9 +44,12 @@ namespace loragro
     class SampleManager
     {
     public:
-        static constexpr uint8_t MAX_SENSORS = 32;
+        static constexpr uint8_t MAX_SENSORS = 16;
         static constexpr uint8_t MAX_MEASUREMENT = 255;
 
+        /* One bit per sensor in the int16 values of DIAG_SENSOR_HEALTH */
+        static_assert(MAX_SENSORS <= 16, "health bitmaps are 16 bits wide");
+
         int add_sensor(SensorBase *sensor);
         int init_all();
         int sample_all();
@@ -38,10 +58,26 @@ namespace loragro
 
         size_t batch_size() const { return batch_size_; }
 
+        const SensorHealth &health(size_t index) const { return health_[index]; }
+
+        /* Bit i = sensor i (registration order) */
+        uint16_t failed_mask() const { return failed_mask_; }
+        uint16_t quarantined_mask() const { return quarantined_mask_; }
+
     private:
+        int sample_phases();
+        int sample_into_batch(size_t index);
+        void mark_failed(size_t index, int err, uint16_t latency_ms);
+        void append_health_entry();
+
         std::array<SensorBase *, MAX_SENSORS> sensors_;
         uint8_t sensor_count_ = 0;
 
+        std::array<SensorHealth, MAX_SENSORS> health_{};
+        std::array<bool, MAX_SENSORS> active_{}; // initialized and not backing off this cycle
+        uint16_t failed_mask_ = 0;
+        uint16_t quarantined_mask_ = 0;
+
         std::array<Measurement, MAX_MEASUREMENT> batch_;
         uint8_t batch_size_ = 0;
     };
@@ -0,0 +1,99 @@
+/**
+ * SCD41 command access
+ *
+ * CO2SensorAdapter talks to the sensor through this interface, so the
+ * same single-shot sequence runs against the I2C bus on hardware and
+ * against the fake driver (Scd41FakeBus) on native_sim / bsim.
+ *
+ * Sensirion framing: 16-bit command big endian, every data word
+ * followed by its CRC-8 (poly 0x31, init 0xFF). The caller passes the
+ * datasheet execution time of the command, the bus waits it out.
+ */
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "regs/scd41_regs.h"
+
+namespace loragro
+{
+    class Scd41Bus
+    {
+    public:
+        virtual ~Scd41Bus() = default;
+
+        /* Command without data */
+        virtual int send(uint16_t cmd, uint32_t exec_ms) = 0;
+
+        /* Command with one data word */
+        virtual int write(uint16_t cmd, uint16_t word, uint32_t exec_ms) = 0;
+
+        /* Command, execution time, then n data words (-EBADMSG on a CRC mismatch) */
+        virtual int read(uint16_t cmd, uint16_t *words, size_t n, uint32_t exec_ms) = 0;
+
+        virtual bool ready() const = 0;
+    };
+
+    class Scd41I2cBus : public Scd41Bus
+    {
+    public:
+        explicit Scd41I2cBus(const struct i2c_dt_spec &spec) : spec_(spec) {}
+
+        int send(uint16_t cmd, uint32_t exec_ms) override
+        {
+            uint8_t buf[2];
+            sys_put_be16(cmd, buf);
+
+            int ret = i2c_write_dt(&spec_, buf, sizeof(buf));
+            k_msleep(exec_ms);
+            return ret;
+        }
+
+        int write(uint16_t cmd, uint16_t word, uint32_t exec_ms) override
+        {
+            uint8_t buf[5];
+            sys_put_be16(cmd, buf);
+            sys_put_be16(word, &buf[2]);
+            buf[4] = scd41::crc8(&buf[2], 2);
+
+            int ret = i2c_write_dt(&spec_, buf, sizeof(buf));
+            k_msleep(exec_ms);
+            return ret;
+        }
+
+        int read(uint16_t cmd, uint16_t *words, size_t n, uint32_t exec_ms) override
+        {
+            uint8_t buf[3 * SCD41_MAX_READ_WORDS];
+            if (n > SCD41_MAX_READ_WORDS)
+                return -EINVAL;
+
+            int ret = send(cmd, exec_ms);
+            if (ret)
+                return ret;
+
+            ret = i2c_read_dt(&spec_, buf, static_cast<uint32_t>(3 * n));
+            if (ret)
+                return ret;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint8_t *w = &buf[3 * i];
+                if (scd41::crc8(w, 2) != w[2])
+                    return -EBADMSG;
+                words[i] = sys_get_be16(w);
+            }
+            return 0;
+        }
+
+        bool ready() const override { return i2c_is_ready_dt(&spec_); }
+
+    private:
+        const struct i2c_dt_spec spec_;
+    };
+
+} // namespace loragro
@@ -0,0 +1,128 @@
+/**
+ * SCD41 commands on the fake driver
+ *
+ * Scd41Bus for native_sim / bsim builds and tests: maps the I2C
+ * commands onto the private attributes of p4v,sensor-scd41-fake and
+ * packs its sensor values into raw words the way the chip reports
+ * them. The fake driver sleeps out the execution times itself.
+ */
+#pragma once
+
+#include <zephyr/device.h>
+
+#include "scd41/scd41_bus.hpp"
+#include "regs/scd41_fake.h"
+
+namespace loragro
+{
+    class Scd41FakeBus : public Scd41Bus
+    {
+    public:
+        explicit Scd41FakeBus(const struct device *dev) : dev_(dev) {}
+
+        int send(uint16_t cmd, uint32_t exec_ms) override
+        {
+            ARG_UNUSED(exec_ms);
+
+            switch (cmd)
+            {
+            case SCD41_CMD_WAKE_UP:
+                return set(SCD41_ATTR_WAKE_UP, 0);
+            case SCD41_CMD_MEASURE_SINGLE_SHOT:
+                return set(SCD41_ATTR_MEASURE_SINGLE_SHOT, 0);
+            case SCD41_CMD_POWER_DOWN:
+                return set(SCD41_ATTR_POWER_DOWN, 0);
+            case SCD41_CMD_PERSIST_SETTINGS:
+                return set(SCD41_ATTR_PERSIST_SETTINGS, 0);
+            default:
+                return -ENOTSUP;
+            }
+        }
+
+        int write(uint16_t cmd, uint16_t word, uint32_t exec_ms) override
+        {
+            ARG_UNUSED(exec_ms);
+
+            if (cmd != SCD41_CMD_SET_ASC_ENABLED)
+                return -ENOTSUP;
+            return set(SCD41_ATTR_ASC_ENABLED, word);
+        }
+
+        int read(uint16_t cmd, uint16_t *words, size_t n, uint32_t exec_ms) override
+        {
+            ARG_UNUSED(exec_ms);
+
+            switch (cmd)
+            {
+            case SCD41_CMD_GET_ASC_ENABLED:
+                return n == 1 ? get(SCD41_ATTR_ASC_ENABLED, words[0]) : -EINVAL;
+            case SCD41_CMD_GET_DATA_READY:
+                return n == 1 ? data_ready(words[0]) : -EINVAL;
+            case SCD41_CMD_READ_MEASUREMENT:
+                return n == 3 ? measurement(words) : -EINVAL;
+            default:
+                return -ENOTSUP;
+            }
+        }
+
+        bool ready() const override { return device_is_ready(dev_); }
+
+    private:
+        int set(int attr, int32_t arg) const
+        {
+            sensor_value val{arg, 0};
+            return sensor_attr_set(dev_, SENSOR_CHAN_CO2, static_cast<enum sensor_attribute>(attr), &val);
+        }
+
+        int get(int attr, uint16_t &word) const
+        {
+            sensor_value val{};
+            int ret = sensor_attr_get(dev_, SENSOR_CHAN_CO2, static_cast<enum sensor_attribute>(attr), &val);
+            if (ret == 0)
+                word = static_cast<uint16_t>(val.val1);
+            return ret;
+        }
+
+        /* Ready bits set once the conversion is done and not yet read */
+        int data_ready(uint16_t &word) const
+        {
+            sensor_value val{};
+            int ret = sensor_attr_get(dev_, SENSOR_CHAN_CO2,
+                                      static_cast<enum sensor_attribute>(SCD41_ATTR_DATA_READY_IN), &val);
+            if (ret == -ENODATA)
+            {
+                word = 0x8000;
+                return 0;
+            }
+            if (ret)
+                return ret;
+
+            word = val.val1 > 0 ? 0x8000 : 0x8006;
+            return 0;
+        }
+
+        int measurement(uint16_t *words) const
+        {
+            int ret = sensor_sample_fetch(dev_);
+            if (ret)
+                return ret;
+
+            sensor_value co2, temp, hum;
+            sensor_channel_get(dev_, SENSOR_CHAN_CO2, &co2);
+            sensor_channel_get(dev_, SENSOR_CHAN_AMBIENT_TEMP, &temp);
+            sensor_channel_get(dev_, SENSOR_CHAN_HUMIDITY, &hum);
+
+            /* Inverse of scd41::temp_milli_c() / rh_milli(), to the nearest LSB (2.7 mdegC, 1.5 m%RH) */
+            const int64_t temp_milli = sensor_value_to_milli(&temp) + 45000;
+            const int64_t rh_milli = sensor_value_to_milli(&hum);
+
+            words[0] = static_cast<uint16_t>(CLAMP(co2.val1, 0, UINT16_MAX));
+            words[1] = static_cast<uint16_t>(CLAMP((temp_milli * 65535 + 87500) / 175000, 0, UINT16_MAX));
+            words[2] = static_cast<uint16_t>(CLAMP((rh_milli * 65535 + 50000) / 100000, 0, UINT16_MAX));
+            return 0;
+        }
+
+        const struct device *dev_;
+    };
+
+} // namespace loragro
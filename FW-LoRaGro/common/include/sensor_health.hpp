@@ -0,0 +1,65 @@
+/**
+ * Per-sensor health and retry backoff
+ *
+ * SampleManager keeps one SensorHealth per registered sensor. A sensor
+ * whose init(), start() or sample() fails is skipped for an
+ * exponentially growing number of cycles instead of being retried
+ * (and timing out) every cycle:
+ *
+ *   failures in a row   1  2  3  4  5  ...
+ *   cycles skipped      0  1  3  7  15 ... (max CONFIG_LORAGRO_SENSOR_BACKOFF_MAX_CYCLES)
+ *
+ * A single glitch costs nothing, the next cycle retries. One success
+ * clears the history.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace loragro
+{
+    struct SensorHealth
+    {
+        static constexpr uint8_t MAX_BACKOFF_CYCLES = CONFIG_LORAGRO_SENSOR_BACKOFF_MAX_CYCLES;
+
+        uint8_t consecutive_failures{0};
+        uint8_t skip_cycles{0};       // cycles left in backoff
+        int16_t last_error{0};        // negative errno of the last failure
+        uint16_t last_latency_ms{0};  // duration of the last sample()
+        uint16_t failures_total{0};
+
+        /* Backing off, not to be touched this cycle */
+        bool quarantined() const { return skip_cycles > 0; }
+
+        void record_success(uint16_t latency_ms)
+        {
+            consecutive_failures = 0;
+            skip_cycles = 0;
+            last_latency_ms = latency_ms;
+        }
+
+        void record_failure(int err, uint16_t latency_ms)
+        {
+            if (consecutive_failures < UINT8_MAX)
+                consecutive_failures++;
+            if (failures_total < UINT16_MAX)
+                failures_total++;
+
+            last_error = static_cast<int16_t>(err);
+            last_latency_ms = latency_ms;
+            skip_cycles = backoff_cycles(consecutive_failures);
+        }
+
+        static constexpr uint8_t backoff_cycles(uint8_t failures)
+        {
+            if (failures <= 1)
+                return 0;
+            if (failures > 8)
+                return MAX_BACKOFF_CYCLES;
+
+            const uint32_t cycles = (1U << (failures - 1)) - 1;
+            return cycles < MAX_BACKOFF_CYCLES ? static_cast<uint8_t>(cycles) : MAX_BACKOFF_CYCLES;
+        }
+    };
+
+} // namespace loragro
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cstdint>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+
+/* Every analog input of the board: zephyr,user { io-channels = <...>, ...; } */
+#define ADC_GROUP_NODE DT_PATH(zephyr_user)
+#define ADC_GROUP_RESOLUTION DT_PROP(ADC_GROUP_NODE, resolution)
+#define ADC_GROUP_SIZE DT_PROP_LEN(ADC_GROUP_NODE, io_channels)
+
+#define ADC_GROUP_CHANNEL_ID(node, prop, idx) DT_IO_CHANNELS_INPUT_BY_IDX(node, idx),
+
+/* SAADC oversampling only works with one channel enabled (adc_read
+ * returns -EINVAL otherwise), a multi-channel group averages in software */
+#define ADC_GROUP_HW_OVERSAMPLING ((ADC_GROUP_SIZE == 1) ? CONFIG_LORAGRO_ADC_OVERSAMPLING : 0)
+#define ADC_GROUP_SCANS ((ADC_GROUP_SIZE == 1) ? 1 : (1 << CONFIG_LORAGRO_ADC_OVERSAMPLING))
+
+BUILD_ASSERT(ADC_GROUP_SIZE == 1 || ADC_GROUP_HW_OVERSAMPLING == 0,
+             "SAADC hardware oversampling needs a single-channel sequence");
+
+namespace loragro
+{
+    /**
+     * AdcChannelGroup
+     *
+     * Owns the channel config of all analog inputs listed under
+     * zephyr,user io-channels (same ADC controller). Channels are set up
+     * once and converted together in ONE multi-channel sequence straight
+     * into a DMA buffer.
+     *
+     * CONFIG_LORAGRO_ADC_OVERSAMPLING averages 2^N conversions. The SAADC
+     * oversampler rejects sequences with more than one channel, so a
+     * group of several inputs runs the scan 2^N times back to back inside
+     * the same adc_read (extra_samplings, no interval) and averages per
+     * channel afterwards. A single-input group keeps hardware
+     * oversampling in burst mode.
+     *
+     * Adapters do not touch the ADC, they read their slot from the last
+     * scan. The first adapter sampled in a cycle triggers the scan, the
+     * others reuse it as long as it is younger than SCAN_MAX_AGE_MS:
+     *
+     *   sample_all()
+     *     soil.sample()    → scan (one adc_read)  → slot of soil channel
+     *     battery.sample() → reuse                → slot of battery channel
+     *
+     * Raw -> mV uses precomputed Q16 factors:
+     *   mV = (raw * factor_q16) >> 16
+     */
+    class AdcChannelGroup
+    {
+    public:
+        static AdcChannelGroup &instance(const struct device *adc_dev)
+        {
+            static AdcChannelGroup group(adc_dev);
+            return group;
+        }
+
+        /* Channel setup, done once, SAADC keeps it across sleep */
+        int init()
+        {
+            if (!device_is_ready(dev_))
+                return -ENODEV;
+
+            if (configured_)
+                return 0;
+
+            for (uint8_t i = 0; i < ADC_GROUP_SIZE; ++i)
+            {
+                int ret = adc_channel_setup(dev_, &channel_cfg_[i]);
+                if (ret != 0)
+                    return ret;
+            }
+
+            configured_ = true;
+            return 0;
+        }
+
+        /* Convert all inputs now */
+        int scan()
+        {
+            int ret = init();
+            if (ret)
+                return ret;
+
+#ifdef CONFIG_ADC_EMUL
+            for (uint8_t i = 0; i < ADC_GROUP_SIZE; ++i)
+            {
+                if (emulators_[i])
+                    adc_emul_const_raw_value_set(dev_, channel_ids_[i], emulators_[i]());
+            }
+#endif
+
+            ret = adc_read(dev_, &sequence_);
+            if (ret)
+            {
+                scanned_ = false;
+                return ret;
+            }
+
+            /* Scans are consecutive rows of the buffer */
+            if constexpr (ADC_GROUP_SCANS > 1)
+            {
+                for (uint8_t c = 0; c < ADC_GROUP_SIZE; ++c)
+                {
+                    int32_t sum = 0;
+                    for (uint16_t row = 0; row < ADC_GROUP_SCANS; ++row)
+                        sum += buffer_[row * ADC_GROUP_SIZE + c];
+                    buffer_[c] = static_cast<int16_t>(sum / ADC_GROUP_SCANS);
+                }
+            }
+
+            scanned_ = true;
+            last_scan_ms_ = k_uptime_get();
+            return 0;
+        }
+
+        /* Reuse the scan of this cycle, convert only if there is none */
+        int latest()
+        {
+            if (scanned_ && (k_uptime_get() - last_scan_ms_) < SCAN_MAX_AGE_MS)
+                return 0;
+
+            return scan();
+        }
+
+        /* Buffer slot of ADC channel, -ENOENT if not in zephyr,user */
+        int slot(uint8_t channel_id) const
+        {
+            for (uint8_t i = 0; i < ADC_GROUP_SIZE; ++i)
+            {
+                if (channel_ids_[i] == channel_id)
+                    return slot_[i];
+            }
+            return -ENOENT;
+        }
+
+        int16_t raw(int slot) const { return buffer_[slot]; }
+
+        /* mV at the ADC pin */
+        int32_t pin_mv(int slot) const
+        {
+            return scaled_mv(slot, MV_PER_LSB_Q16);
+        }
+
+        /* Convert with a caller supplied Q16 factor (e.g. divider folded in) */
+        int32_t scaled_mv(int slot, uint32_t factor_q16) const
+        {
+            return static_cast<int32_t>((static_cast<int64_t>(buffer_[slot]) * factor_q16) >> 16);
+        }
+
+#ifdef CONFIG_ADC_EMUL
+        /* Source of simulated raw values for a channel, applied before every scan */
+        using EmulatorFn = int32_t (*)();
+
+        void set_emulator(uint8_t channel_id, EmulatorFn fn)
+        {
+            for (uint8_t i = 0; i < ADC_GROUP_SIZE; ++i)
+            {
+                if (channel_ids_[i] == channel_id)
+                    emulators_[i] = fn;
+            }
+        }
+#endif
+
+        /* nRF internal reference 600 mV, gain 1/6 -> 3600 mV full scale */
+        static constexpr uint32_t FULL_SCALE_MV = 600 * 6;
+        static constexpr uint32_t MAX_RAW = (1U << ADC_GROUP_RESOLUTION) - 1;
+        static constexpr uint32_t MV_PER_LSB_Q16 =
+            static_cast<uint32_t>((static_cast<uint64_t>(FULL_SCALE_MV) << 16) / MAX_RAW);
+
+        /* Adapters sampled within this window share one scan */
+        static constexpr int64_t SCAN_MAX_AGE_MS = 100;
+
+    private:
+        explicit AdcChannelGroup(const struct device *adc_dev)
+            : dev_(adc_dev)
+        {
+            uint32_t mask = 0;
+            for (uint8_t i = 0; i < ADC_GROUP_SIZE; ++i)
+            {
+                channel_cfg_[i] = {};
+                channel_cfg_[i].gain = ADC_GAIN_1_6;
+                channel_cfg_[i].reference = ADC_REF_INTERNAL;
+                channel_cfg_[i].acquisition_time = ADC_ACQ_TIME_DEFAULT;
+                channel_cfg_[i].channel_id = channel_ids_[i];
+                channel_cfg_[i].differential = 0;
+                mask |= BIT(channel_ids_[i]);
+            }
+
+            /* Samples land in the buffer in ascending channel ID order */
+            for (uint8_t i = 0; i < ADC_GROUP_SIZE; ++i)
+            {
+                slot_[i] = static_cast<uint8_t>(__builtin_popcount(mask & (BIT(channel_ids_[i]) - 1)));
+            }
+
+            options_ = {};
+            options_.interval_us = 0;
+            options_.extra_samplings = ADC_GROUP_SCANS - 1;
+
+            sequence_ = {};
+            sequence_.options = (ADC_GROUP_SCANS > 1) ? &options_ : nullptr;
+            sequence_.buffer = buffer_;
+            sequence_.buffer_size = sizeof(buffer_);
+            sequence_.resolution = ADC_GROUP_RESOLUTION;
+            sequence_.oversampling = ADC_GROUP_HW_OVERSAMPLING;
+            sequence_.channels = mask;
+        }
+
+        static constexpr uint8_t channel_ids_[] = {
+            DT_FOREACH_PROP_ELEM(ADC_GROUP_NODE, io_channels, ADC_GROUP_CHANNEL_ID)};
+        static_assert(sizeof(channel_ids_) == ADC_GROUP_SIZE);
+
+        const struct device *dev_;
+        struct adc_channel_cfg channel_cfg_[ADC_GROUP_SIZE];
+        struct adc_sequence_options options_;
+        struct adc_sequence sequence_;
+
+        /* SAADC EasyDMA writes the scans here, row 0 holds the average */
+        int16_t buffer_[ADC_GROUP_SCANS * ADC_GROUP_SIZE] __aligned(4){};
+        uint8_t slot_[ADC_GROUP_SIZE]{};
+
+        bool configured_{false};
+        bool scanned_{false};
+        int64_t last_scan_ms_{0};
+
+#ifdef CONFIG_ADC_EMUL
+        EmulatorFn emulators_[ADC_GROUP_SIZE]{};
+#endif
+    };
+
+} // namespace loragro
@@ -1,5 +1,6 @@
 #pragma once
 #include "zephyr_sensor_adapter.hpp"
+#include "adc_channel_group.hpp"
 #include "time_manager.hpp"
 #include <zephyr/drivers/adc.h>
 #include <zephyr/drivers/adc/adc_emul.h>
@@ -16,128 +17,76 @@ namespace loragro
     {
     public:
         BatterySenseAdapter(const struct device *adc_dev, uint16_t battery_mv_id)
-            : ZephyrSensorAdapter(adc_dev)
+            : ZephyrSensorAdapter(adc_dev),
+              adc_(AdcChannelGroup::instance(adc_dev)),
+              slot_(adc_.slot(BATTERY_ADC_CHANNEL))
         {
             measurements_[0].sensor_id = battery_mv_id;
 
-            channel_cfg_.gain = ADC_GAIN_1_6;
-            channel_cfg_.reference = ADC_REF_INTERNAL;
-            channel_cfg_.acquisition_time = ADC_ACQ_TIME_DEFAULT;
-            channel_cfg_.channel_id = BATTERY_ADC_CHANNEL;
-            channel_cfg_.differential = 0;
-
-            sequence_.buffer = &raw_value_;
-            sequence_.buffer_size = sizeof(raw_value_);
-            sequence_.resolution = BATTERY_ADC_RESOLUTION;
-            sequence_.oversampling = 0;
-            sequence_.channels = BIT(BATTERY_ADC_CHANNEL);
+#ifdef CONFIG_ADC_EMUL
+            adc_.set_emulator(BATTERY_ADC_CHANNEL, &emulate_raw);
+#endif
 
             /* Voltage divider from DT */
             r1_ohm_ = DT_PROP_BY_IDX(BATTERY_NODE, voltage_divider, 0);
             r2_ohm_ = DT_PROP_BY_IDX(BATTERY_NODE, voltage_divider, 1);
+
+            /* Vbat = Vadc * (R1 + R2) / R2, folded into the raw -> mV factor */
+            battery_mv_q16_ = static_cast<uint32_t>(
+                (static_cast<uint64_t>(AdcChannelGroup::MV_PER_LSB_Q16) * (r1_ohm_ + r2_ohm_)) / r2_ohm_);
         }
 
         int init() override
         {
-            if (!device_is_ready(dev_))
+            if (slot_ < 0)
             {
                 return -ENODEV;
             }
 
-            int ret = adc_channel_setup(dev_, &channel_cfg_);
-            if (ret != 0)
-            {
-                return ret;
-            }
-
-#ifdef CONFIG_ADC_EMUL
-            // Initialize with realistic battery voltage
-            adc_emul_const_raw_value_set(dev_, BATTERY_ADC_CHANNEL, 2100);
-#endif
-
-            return 0;
+            return adc_.init();
         }
 
         int sample() override
         {
-            int ret;
-
-#ifdef CONFIG_ADC_EMUL
-            /* Simulate battery ramp in RAW domain */
-            static int32_t fake_raw = 1400;
-
-            fake_raw += 25;
-
-            if (fake_raw > 2300) // upper limit
-                fake_raw = 1300; // wrap around
-
-            adc_emul_const_raw_value_set(dev_, BATTERY_ADC_CHANNEL, fake_raw);
-#endif
-
-            /* Trigger ADC sampling */
-            ret = adc_read(dev_, &sequence_);
+            /* All analog inputs share one scan per cycle */
+            int ret = adc_.latest();
             if (ret < 0)
             {
                 return ret;
             }
 
-            /* ---- Convert RAW -> mV at ADC pin ---- */
-            const int32_t raw = raw_value_;
-            // printk("raw_value_ = %d\n", (int)raw_value_);
-
-            constexpr int32_t max_adc = (1 << BATTERY_ADC_RESOLUTION) - 1; // e.g. 4095 (12bit)
-            constexpr int32_t vref_mv = 600;                               // nRF internal reference
-            constexpr int32_t gain_multiplier = 6;                         // gain = 1/6
-
-            int32_t adc_mv = (raw * vref_mv * gain_multiplier) / max_adc;
-
-            /* ---- Compensate resistor divider (from DT ideally) ---- */
-
-            int32_t battery_mv = adc_mv * (r1_ohm_ + r2_ohm_) / r2_ohm_;
+            const int32_t battery_mv = adc_.scaled_mv(slot_, battery_mv_q16_);
 
             /* ---- Store measurement ---- */
 
-            measurements_[0].sensor_id = measurements_[0].sensor_id;
             measurements_[0].timestamp =
                 TimeManager::best_effort_unix_s(k_uptime_seconds());
 
-            /* Store as volts + microvolts */
-            measurements_[0].value.val1 = battery_mv; // integer volts
+            measurements_[0].value.val1 = battery_mv; // battery voltage in mV
             return 0;
         }
 
         int is_connected() override
         {
-            int ret = adc_read(dev_, &sequence_);
-            if (ret)
+            if (slot_ < 0)
             {
-                return ret;
+                return -ENODEV;
             }
 
-            const int32_t raw = raw_value_;
-            // printk("raw_value_ = %d\n", (int)raw_value_);
-
-            constexpr int32_t max_adc = (1 << BATTERY_ADC_RESOLUTION) - 1; // e.g. 4095 (12bit)
-            constexpr int32_t vref_mv = 600;                               // nRF internal reference
-            constexpr int32_t gain_multiplier = 6;                         // gain = 1/6
-
-            int32_t adc_mv = (raw * vref_mv * gain_multiplier) / max_adc;
-
-            if (adc_mv < 100)
+            /* Detection reuses the cycle scan, no extra conversion */
+            int ret = adc_.latest();
+            if (ret)
             {
-                return -EINVAL;
+                return ret;
             }
 
-            /* ---- Compensate resistor divider (from DT ideally) ---- */
-
-            int32_t battery_mv = adc_mv * (r1_ohm_ + r2_ohm_) / r2_ohm_;
-
-            if (ret)
+            if (adc_.pin_mv(slot_) < 100)
             {
-                return ret;
+                return -EINVAL;
             }
 
             // Also check actual battery voltage range
+            const int32_t battery_mv = adc_.scaled_mv(slot_, battery_mv_q16_);
             if (battery_mv < 2200 || battery_mv > 4400)
             {
                 return -EIO;
@@ -152,17 +101,32 @@ namespace loragro
         }
 
     private:
-        int32_t scale_by_divider(int32_t mv) const
+#ifdef CONFIG_ADC_EMUL
+        /* Simulate slow discharge and solar recharge in RAW domain,
+         * continuous so the SoC estimator sees a plausible trend */
+        static int32_t emulate_raw()
         {
-            /* Vbat = Vadc * (R1 + R2) / R2 */
-            return (mv * (r1_ohm_ + r2_ohm_)) / r2_ohm_;
+            static int32_t fake_raw = 2100;
+            static int32_t fake_slope = -3;
+            static uint32_t noise_seed = 1;
+
+            fake_raw += fake_slope;
+
+            if (fake_raw < 1350) // empty, start charging
+                fake_slope = 25;
+            if (fake_raw > 2300) // full, discharge again
+                fake_slope = -3;
+
+            noise_seed = noise_seed * 1103515245u + 12345u;
+            return fake_raw + static_cast<int32_t>((noise_seed >> 16) % 9) - 4;
         }
+#endif
 
     private:
-        struct adc_channel_cfg channel_cfg_;
-        struct adc_sequence sequence_;
-        int32_t raw_value_;
+        AdcChannelGroup &adc_;
+        const int slot_;
         uint32_t r1_ohm_;
         uint32_t r2_ohm_;
+        uint32_t battery_mv_q16_;
     };
-} // namespace loragro
\ No newline at end of file
+} // namespace loragro
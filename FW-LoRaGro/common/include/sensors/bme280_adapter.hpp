@@ -0,0 +1,109 @@
+#pragma once
+
+#include "sensor.hpp"
+#include "time_manager.hpp"
+#include "bme280/bme280_forced.hpp"
+#include <zephyr/kernel.h>
+
+namespace loragro
+{
+    /**
+     * BME280 through the native forced mode driver.
+     *
+     * start() triggers the conversion so it runs while SampleManager
+     * samples the other sensors, sample() reads and compensates it.
+     * Units match the Zephyr sensor channels the generic
+     * EnvSensorAdapter publishes: degC, %RH, kPa. Channels with
+     * oversampling 0 are left out of the batch.
+     */
+    class Bme280Adapter : public Sensor<3>
+    {
+    public:
+        Bme280Adapter(Bme280Forced &driver,
+                      uint16_t temp_id, uint16_t humidity_id, uint16_t pressure_id)
+            : driver_(driver), temp_id_(temp_id), humidity_id_(humidity_id), pressure_id_(pressure_id)
+        {
+        }
+
+        int init() override
+        {
+            started_ = false;
+            return driver_.init();
+        }
+
+        int start() override
+        {
+            int ret = driver_.start();
+            started_ = ret >= 0;
+            return ret;
+        }
+
+        int sample() override
+        {
+            count_ = 0;
+
+            if (!started_)
+            {
+                int ret = start();
+                if (ret < 0)
+                    return ret;
+                k_msleep(ret);
+            }
+            started_ = false;
+
+            Bme280Sample s;
+            int ret = driver_.read(s);
+            if (ret)
+                return ret;
+
+            const uint32_t timestamp = TimeManager::best_effort_unix_s(k_uptime_seconds());
+
+            /* 0.01 degC */
+            push(temp_id_, s.temperature_centi_c / 100, (s.temperature_centi_c % 100) * 10000, timestamp);
+
+            /* Q22.10 %RH, 1e6 / 1024 = 15625 / 16 */
+            if (s.has_humidity)
+            {
+                const uint64_t micro = static_cast<uint64_t>(s.humidity_q22_10) * 15625 / 16;
+                push(humidity_id_, micro / 1000000, micro % 1000000, timestamp);
+            }
+
+            /* Q24.8 Pa to kPa, 1e6 / (256 * 1000) = 125 / 32 */
+            if (s.has_pressure)
+            {
+                const uint64_t micro = static_cast<uint64_t>(s.pressure_q24_8) * 125 / 32;
+                push(pressure_id_, micro / 1000000, micro % 1000000, timestamp);
+            }
+
+            return 0;
+        }
+
+        int is_connected() override
+        {
+            return driver_.init() == 0;
+        }
+
+        size_t count() const override { return count_; }
+
+        const Measurement *get_measurements() const { return measurements_; }
+
+        const char *getName() const override { return "BME280 (forced mode)"; }
+
+    private:
+        void push(uint16_t id, int32_t val1, int32_t val2, uint32_t timestamp)
+        {
+            Measurement &m = measurements_[count_++];
+            m.sensor_id = id;
+            m.value.val1 = val1;
+            m.value.val2 = val2;
+            m.timestamp = timestamp;
+        }
+
+        Bme280Forced &driver_;
+        const uint16_t temp_id_;
+        const uint16_t humidity_id_;
+        const uint16_t pressure_id_;
+        size_t count_{0};
+        bool started_{false};
+    };
+}
@@ -1,17 +1,40 @@
 #pragma once
 
-#include "zephyr_sensor_adapter.hpp"
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+
+#include "sensor.hpp"
 #include "time_manager.hpp"
+#include "co2_asc.hpp"
+#include "scd41/scd41_bus.hpp"
 
 namespace loragro
 {
-    class CO2SensorAdapter : public ZephyrSensorAdapter<3> // Changed from <1> to <3>
+    /**
+     * SCD41 in low-power single-shot mode.
+     *
+     * Per cycle (sensor rail on):
+     *
+     *   init()    wake_up, once per boot: on-chip ASC off + node ASC load
+     *   start()   measure_single_shot, returns 5000 ms to SampleManager
+     *   ...       other sensors are sampled meanwhile
+     *   sample()  get_data_ready_status, read_measurement, ASC
+     *             correction, power_down
+     *
+     * The on-chip ASC is disabled (and persisted once to the sensor
+     * EEPROM) because its history is wiped every time the rail is cut;
+     * Co2Asc keeps the baseline in MCU RAM / NVS instead.
+     *
+     * sample() without start() (e.g. SampleManager::sample_one) starts
+     * the conversion itself and blocks until it is done.
+     */
+    class CO2SensorAdapter : public Sensor<3>
     {
     public:
-        CO2SensorAdapter(const struct device *dev,
+        CO2SensorAdapter(Scd41Bus &bus,
                          const uint16_t co2_id,
                          const uint16_t temp_id,
-                         const uint16_t hum_id) : ZephyrSensorAdapter(dev)
+                         const uint16_t hum_id) : bus_(bus)
         {
             // CO2 measurement
             measurements_[0].sensor_id = co2_id;
@@ -23,35 +46,143 @@ namespace loragro
             measurements_[2].sensor_id = hum_id;
         };
 
+        int init() override
+        {
+            if (!bus_.ready())
+                return -ENODEV;
+
+            /* Leaves power-down, covers the 30 ms power-up time after rail on.
+             * The sensor does not acknowledge wake_up, the next command checks it answers. */
+            bus_.send(SCD41_CMD_WAKE_UP, SCD41_WAKE_UP_MS);
+
+            uint16_t status;
+            int ret = bus_.read(SCD41_CMD_GET_DATA_READY, &status, 1, SCD41_GET_DATA_READY_MS);
+            if (ret)
+                return ret;
+
+            if (!configured_)
+            {
+                ret = disable_onchip_asc();
+                if (ret)
+                    return ret;
+
+                asc_.load();
+                configured_ = true;
+            }
+
+            started_ = false;
+            return 0;
+        }
+
+        int start() override
+        {
+            int ret = bus_.send(SCD41_CMD_MEASURE_SINGLE_SHOT, 0);
+            if (ret)
+                return ret;
+
+            started_ = true;
+            ready_at_ms_ = k_uptime_get() + SCD41_SINGLE_SHOT_MS;
+            return SCD41_SINGLE_SHOT_MS;
+        }
+
         int sample() override
         {
-            int ret = fetch();
+            if (!started_)
+            {
+                int ret = start();
+                if (ret < 0)
+                    return ret;
+            }
+
+            uint16_t raw[SCD41_MAX_READ_WORDS];
+            int ret = wait_ready();
+            if (ret == 0)
+                ret = bus_.read(SCD41_CMD_READ_MEASUREMENT, raw, SCD41_MAX_READ_WORDS, SCD41_READ_MEASUREMENT_MS);
+
+            started_ = false;
             if (ret)
             {
+                bus_.send(SCD41_CMD_POWER_DOWN, SCD41_POWER_DOWN_MS);
                 return ret;
             }
 
-            sensor_value val;
-            uint32_t timestamp = TimeManager::best_effort_unix_s(k_uptime_seconds());
+            uint32_t uptime_s = k_uptime_seconds();
+            uint32_t timestamp = TimeManager::best_effort_unix_s(uptime_s);
 
-            // Get CO2
-            get(SENSOR_CHAN_CO2, &val);
-            measurements_[0].value = val;
+            // CO2 in ppm, corrected by the node-side ASC
+            measurements_[0].value.val1 = asc_.apply(raw[0], uptime_s);
+            measurements_[0].value.val2 = 0;
             measurements_[0].timestamp = timestamp;
 
-            // Get temperature
-            get(SENSOR_CHAN_AMBIENT_TEMP, &val);
-            measurements_[1].value = val;
+            // Temperature
+            measurements_[1].value = from_milli(scd41::temp_milli_c(raw[1]));
             measurements_[1].timestamp = timestamp;
 
-            // Get humidity
-            get(SENSOR_CHAN_HUMIDITY, &val);
-            measurements_[2].value = val;
+            // Humidity
+            measurements_[2].value = from_milli(scd41::rh_milli(raw[2]));
             measurements_[2].timestamp = timestamp;
 
-            return 0;
+            /* Idle current drops from ~0.2 mA to 0.5 uA if the rail stays on */
+            return bus_.send(SCD41_CMD_POWER_DOWN, SCD41_POWER_DOWN_MS);
         }
 
+        int is_connected() override { return bus_.ready(); }
+
+        const Measurement *get_measurements() const { return measurements_; }
+
+        const Co2Asc &asc() const { return asc_; }
+
         const char *getName() const override { return "SCD41 Sensor"; }
+
+    private:
+        /* A slow sensor gets this long past the datasheet conversion time */
+        static constexpr int READY_POLL_MS = 10;
+        static constexpr int READY_POLLS = 100;
+
+        static sensor_value from_milli(int32_t milli)
+        {
+            return sensor_value{milli / 1000, (milli % 1000) * 1000};
+        }
+
+        /* Sleep out the conversion, then poll get_data_ready_status */
+        int wait_ready() const
+        {
+            if (ready_at_ms_ > k_uptime_get())
+                k_sleep(K_TIMEOUT_ABS_MS(ready_at_ms_));
+
+            for (int i = 0; i < READY_POLLS; ++i)
+            {
+                uint16_t status;
+                int ret = bus_.read(SCD41_CMD_GET_DATA_READY, &status, 1, SCD41_GET_DATA_READY_MS);
+                if (ret)
+                    return ret;
+                if (status & SCD41_DATA_READY_MASK)
+                    return 0;
+
+                k_msleep(READY_POLL_MS);
+            }
+            return -ETIMEDOUT;
+        }
+
+        /* Only touches the sensor EEPROM if the setting differs */
+        int disable_onchip_asc() const
+        {
+            uint16_t enabled;
+            int ret = bus_.read(SCD41_CMD_GET_ASC_ENABLED, &enabled, 1, SCD41_GET_ASC_MS);
+            if (ret || enabled == 0)
+                return ret;
+
+            ret = bus_.write(SCD41_CMD_SET_ASC_ENABLED, 0, SCD41_SET_ASC_MS);
+            if (ret)
+                return ret;
+
+            return bus_.send(SCD41_CMD_PERSIST_SETTINGS, SCD41_PERSIST_SETTINGS_MS);
+        }
+
+        Scd41Bus &bus_;
+        Co2Asc asc_;
+        int64_t ready_at_ms_{0};
+        bool configured_{false};
+        bool started_{false};
     };
-}
\ No newline at end of file
+}
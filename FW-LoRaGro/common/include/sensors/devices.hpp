@@ -7,8 +7,8 @@ static const struct device *const light_dev =
 static const struct device *const co2_dev =
     DEVICE_DT_GET(DT_ALIAS(co2_sensor));
 
-static const struct device *const soil_modbus_dev =
-    DEVICE_DT_GET(DT_ALIAS(soil_sensor));
+static const struct device *const modbus_uart_dev =
+    DEVICE_DT_GET(DT_PARENT(DT_ALIAS(soil_sensor)));
 
 static const struct device *const adc_dev =
     DEVICE_DT_GET(DT_ALIAS(adc0));
@@ -16,6 +16,8 @@ namespace loragro
         CARBON_DIOXIDE = 2,
         SOIL = 3,
         BATTERY = 4,
+        ENERGY = 5,
+        DIAGNOSTICS = 6,
     };
 
     /* =========================================================
@@ -26,8 +28,18 @@ namespace loragro
      * | CLASS   | TYPE    |
      * +---------+---------+
      *
-     * CLASS  (upper nibble)  : 0–15
+     * CLASS  (upper nibble)  : 0–7
      * TYPE   (lower nibble)  : 0–15
+     *
+     * Soil probe bus IDs (bit 7 set), one set per probe:
+     *
+     *  7 | 6 5 4 3 2 | 1 0
+     * +--+-----------+------+
+     * | 1| PROBE     | TYPE |
+     * +--+-----------+------+
+     *
+     * PROBE  : 0–31, enumeration order on the RS485 bus
+     * TYPE   : depth, moisture, temperature, EC
      * ========================================================= */
     namespace SensorID
     {
@@ -41,6 +53,8 @@ namespace loragro
         constexpr uint8_t CO2 = 0x20;
         constexpr uint8_t SOIL = 0x30;
         constexpr uint8_t BATTERY = 0x40;
+        constexpr uint8_t ENERGY = 0x50;
+        constexpr uint8_t DIAG = 0x60;
 
         /* Environmental types */
         constexpr uint8_t ENV_TEMP = ENV | 0x00;
@@ -61,9 +75,51 @@ namespace loragro
         constexpr uint8_t SOIL_EC = SOIL | 0x02;
         constexpr uint8_t SOIL_ANALOG_MOISTURE = SOIL | 0x03;
 
+        /* DATA frame entry packing all soil probe IDs of a frame (depth profile) */
+        constexpr uint8_t SOIL_PROFILE = SOIL | 0x0F;
+
         /* Battery */
         constexpr uint8_t BATTERY_VOLTAGE = BATTERY | 0x00;
 
+        /* Energy report of previous cycle (telemetry, 10 nAh / 10 ms units) */
+        constexpr uint8_t ENERGY_TOTAL = ENERGY | 0x00;   // total charge, awake time
+        constexpr uint8_t ENERGY_RADIO = ENERGY | 0x01;   // TX charge, RX charge
+        constexpr uint8_t ENERGY_SENSORS = ENERGY | 0x02; // rail charge, sampling charge
+        constexpr uint8_t ENERGY_SYSTEM = ENERGY | 0x03;  // flash charge, sleep charge
+
+        /* Node diagnostics (telemetry, raw bitmaps) */
+        constexpr uint8_t DIAG_SENSOR_HEALTH = DIAG | 0x00; // failed bitmap, quarantined bitmap
+
+        /* Soil probe bus */
+        constexpr uint8_t SOIL_PROBE = 0x80;
+        constexpr uint8_t SOIL_PROBE_MAX = 32;
+
+        constexpr uint8_t PROBE_DEPTH = 0;       // cm below surface
+        constexpr uint8_t PROBE_MOISTURE = 1;    // %
+        constexpr uint8_t PROBE_TEMPERATURE = 2; // C
+        constexpr uint8_t PROBE_EC = 3;          // uS/cm
+        constexpr uint8_t PROBE_TYPE_COUNT = 4;
+
+        constexpr uint8_t soil_probe(uint8_t probe, uint8_t type)
+        {
+            return SOIL_PROBE | ((probe & 0x1F) << 2) | (type & 0x03);
+        }
+
+        constexpr bool is_soil_probe(uint8_t id)
+        {
+            return (id & SOIL_PROBE) != 0;
+        }
+
+        constexpr uint8_t probe_index(uint8_t id)
+        {
+            return (id >> 2) & 0x1F;
+        }
+
+        constexpr uint8_t probe_type(uint8_t id)
+        {
+            return id & 0x03;
+        }
+
         /* Helpers */
         constexpr uint8_t sensor_class(uint8_t id)
         {
@@ -74,6 +130,12 @@ namespace loragro
         {
             return id & TYPE_MASK;
         }
+
+        /* Telemetry entries carry raw int16 pairs, not scaled sensor values */
+        constexpr bool is_telemetry(uint8_t id)
+        {
+            return (id & CLASS_MASK) == ENERGY || (id & CLASS_MASK) == DIAG;
+        }
     }
 
     /* =========================================================
@@ -0,0 +1,81 @@
+#pragma once
+#include "sensor.hpp"
+#include "energy_ledger.hpp"
+#include "time_manager.hpp"
+
+#include <climits>
+#include <zephyr/kernel.h>
+
+namespace loragro
+{
+    /**
+     * Virtual sensor publishing the EnergyLedger report.
+     *
+     * Sampling happens in the middle of a cycle, so the entries describe
+     * the PREVIOUS completed cycle (its sleep + awake part). Values are
+     * raw int16 pairs (see SensorID::is_telemetry):
+     *
+     *   ENERGY_TOTAL   : total charge [10 nAh], awake time [10 ms]
+     *   ENERGY_RADIO   : TX charge    [10 nAh], RX charge  [10 nAh]
+     *   ENERGY_SENSORS : rail charge  [10 nAh], sampling   [10 nAh]
+     *   ENERGY_SYSTEM  : flash charge [10 nAh], sleep      [10 nAh]
+     */
+    class EnergySensorAdapter : public Sensor<4>
+    {
+    public:
+        EnergySensorAdapter()
+        {
+            measurements_[0].sensor_id = SensorID::ENERGY_TOTAL;
+            measurements_[1].sensor_id = SensorID::ENERGY_RADIO;
+            measurements_[2].sensor_id = SensorID::ENERGY_SENSORS;
+            measurements_[3].sensor_id = SensorID::ENERGY_SYSTEM;
+        }
+
+        int init() override
+        {
+            return 0;
+        }
+
+        int sample() override
+        {
+            /* Report is zeroed until the first cycle completes */
+            const EnergyReport &r = EnergyLedger::instance().last_report();
+            const uint32_t ts = TimeManager::best_effort_unix_s(k_uptime_seconds());
+            const uint32_t awake_ms = r.active_us[idx(EnergyComponent::MCU_ACTIVE)] / 1000;
+
+            set(0, r.total_nAh, awake_ms, ts);
+            set(1, charge(r, EnergyComponent::RADIO_TX), charge(r, EnergyComponent::RADIO_RX), ts);
+            set(2, charge(r, EnergyComponent::SENSOR_RAIL), charge(r, EnergyComponent::SAMPLING), ts);
+            set(3, charge(r, EnergyComponent::FLASH), charge(r, EnergyComponent::SLEEP), ts);
+
+            return 0;
+        }
+
+        int is_connected() override
+        {
+            return 0;
+        }
+
+        const char *getName() const override
+        {
+            return "Energy Ledger";
+        }
+
+    private:
+        static constexpr size_t idx(EnergyComponent c) { return static_cast<size_t>(c); }
+
+        static uint32_t charge(const EnergyReport &r, EnergyComponent c)
+        {
+            return r.charge_nAh[idx(c)];
+        }
+
+        /* Both inputs in base unit (nAh / ms), stored in 10x units saturated to int16 */
+        void set(size_t i, uint32_t v1, uint32_t v2, uint32_t ts)
+        {
+            measurements_[i].value.val1 = static_cast<int32_t>(MIN(v1 / 10, INT16_MAX));
+            measurements_[i].value.val2 = static_cast<int32_t>(MIN(v2 / 10, INT16_MAX));
+            measurements_[i].timestamp = ts;
+        }
+    };
+
+} // namespace loragro
@@ -14,6 +14,11 @@ namespace loragro
         virtual int sample() = 0;
         virtual int is_connected() = 0;
 
+        /* Kick off a slow conversion before sample(), so it runs while the
+         * other sensors are read. Returns ms until sample() has data,
+         * 0 if sample() can read right away, negative errno on failure. */
+        virtual int start() { return 0; }
+
         virtual const Measurement *measurements() const = 0;
         virtual size_t count() const = 0;
         virtual const char *getName() const = 0;
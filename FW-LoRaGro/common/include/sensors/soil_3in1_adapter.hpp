@@ -1,43 +1,29 @@
 #pragma once
 
-#include "zephyr_sensor_adapter.hpp"
+#include "sensor.hpp"
 #include "time_manager.hpp"
-#include <zephyr/drivers/sensor.h>
+#include "modbus/modbus_rtu.hpp"
+#include "regs/soil_3in1_regs.hpp"
 #include <zephyr/kernel.h>
-#include <zephyr/devicetree.h>
 
 namespace loragro
 {
-    namespace dt
-    {
-#define SOIL_NODE DT_ALIAS(soil_sensor)
-
-        static_assert(DT_NODE_EXISTS(SOIL_NODE),
-                      "DT alias 'soil_sensor' not defined");
-
-        struct Soil3in1
-        {
-            static constexpr uint8_t slave_addr =
-                DT_PROP(SOIL_NODE, slave_address);
-        };
-
-#undef SOIL_NODE
-    }
-
-    // Custom sensor channel for soil EC (must match your driver)
-    enum p4v_soil_channel
-    {
-        SENSOR_CHAN_SOIL_EC = SENSOR_CHAN_PRIV_START,
-    };
-
-    class SoilSensor3in1ModbusAdapter : public ZephyrSensorAdapter<3>
+    /**
+     * 3-in-1 soil probe (moisture, temperature, EC) on a Modbus RTU bus.
+     *
+     * All three values come from one multi-register read, so a sample is
+     * a single round-trip on the bus. Several probes share one
+     * ModbusRtuClient, each adapter talks to its own slave address.
+     */
+    class SoilSensor3in1ModbusAdapter : public Sensor<3>
     {
     public:
-        SoilSensor3in1ModbusAdapter(const struct device *dev,
+        SoilSensor3in1ModbusAdapter(ModbusRtuClient &bus,
+                                    const uint8_t slave_addr,
                                     const uint16_t moisture_id,
                                     const uint16_t temperature_id,
                                     const uint16_t conductivity_id)
-            : ZephyrSensorAdapter(dev)
+            : bus_(bus), slave_addr_(slave_addr)
         {
             // Initialize measurement IDs
             measurements_[0].sensor_id = moisture_id;
@@ -47,61 +33,71 @@ namespace loragro
             measurements_[2].sensor_id = conductivity_id;
         }
 
+        /* Probe on a multi-probe bus, IDs carry the probe index */
+        SoilSensor3in1ModbusAdapter(ModbusRtuClient &bus,
+                                    const uint8_t slave_addr,
+                                    const uint8_t probe)
+            : SoilSensor3in1ModbusAdapter(bus, slave_addr,
+                                          SensorID::soil_probe(probe, SensorID::PROBE_MOISTURE),
+                                          SensorID::soil_probe(probe, SensorID::PROBE_TEMPERATURE),
+                                          SensorID::soil_probe(probe, SensorID::PROBE_EC))
+        {
+        }
+
+        int init() override
+        {
+            return 0;
+        }
+
         int sample() override
         {
-            // Use Zephyr sensor API instead of direct Modbus
-            int ret = this->fetch();
+            uint16_t regs[soil3in1::BLOCK_COUNT];
+
+            int ret = bus_.read_holding_registers(slave_addr_, soil3in1::BLOCK_START,
+                                                  soil3in1::BLOCK_COUNT, regs);
             if (ret != 0)
             {
                 return ret;
             }
 
             uint32_t timestamp = TimeManager::best_effort_unix_s(k_uptime_seconds());
-            sensor_value val;
 
-            // Read humidity
-            ret = get(SENSOR_CHAN_HUMIDITY, &val);
-            if (!ret)
-            {
-                measurements_[0].value = val;
-                measurements_[0].timestamp = timestamp;
-            }
-            else
-            {
-                return ret;
-            }
-            // Read temperature
-            ret = get(SENSOR_CHAN_AMBIENT_TEMP, &val);
-            if (!ret)
-            {
-                measurements_[1].value = val;
-                measurements_[1].timestamp = timestamp;
-            }
-            else
-            {
-                return ret;
-            }
+            set_x10(0, static_cast<int16_t>(regs[soil3in1::REG_MOISTURE - soil3in1::BLOCK_START]), timestamp);
+            set_x10(1, static_cast<int16_t>(regs[soil3in1::REG_TEMPERATURE - soil3in1::BLOCK_START]), timestamp);
 
-            // Read conductivity (custom channel)
-            ret = get(static_cast<sensor_channel>(SENSOR_CHAN_SOIL_EC),
-                      &val);
-            if (!ret)
-            {
-                measurements_[2].value = val;
-                measurements_[2].timestamp = timestamp;
-            }
-            else
-            {
-                return ret;
-            }
+            measurements_[2].value.val1 = regs[soil3in1::REG_CONDUCTIVITY - soil3in1::BLOCK_START];
+            measurements_[2].value.val2 = 0;
+            measurements_[2].timestamp = timestamp;
 
             return 0;
         }
 
+        int is_connected() override
+        {
+            uint16_t moisture;
+            return bus_.read_holding_registers(slave_addr_, soil3in1::REG_MOISTURE, 1, &moisture);
+        }
+
+        const Measurement *get_measurements() const { return measurements_; }
+
+        uint8_t slave_addr() const { return slave_addr_; }
+
         const char *
         getName() const override
         {
             return "DFRobot Soil Sensor 3in1 Soil Moisture, Temp and EC (Modbus)";
         }
+
+    private:
+        /* Fixed point x10 register to sensor_value */
+        void set_x10(size_t i, int16_t raw_x10, uint32_t timestamp)
+        {
+            measurements_[i].value.val1 = raw_x10 / 10;
+            measurements_[i].value.val2 = (raw_x10 % 10) * 100000;
+            measurements_[i].timestamp = timestamp;
+        }
+
+        ModbusRtuClient &bus_;
+        const uint8_t slave_addr_;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+
+#include "regs/soil_3in1_regs.hpp"
+
+namespace loragro
+{
+    /**
+     * Register model of the 3-in-1 soil probe for ModbusSimSlave.
+     *
+     * Deterministic drift, one step per read of the moisture register
+     * (i.e. once per batch read):
+     *   moisture    40.0 - 80.0 %
+     *   temperature 18.0 - 32.0 C
+     *   EC          600 - 1800 uS/cm
+     * Deeper probes start wetter and cooler.
+     */
+    class Soil3in1SimProbe
+    {
+    public:
+        explicit Soil3in1SimProbe(uint8_t depth_cm = 0)
+            : moisture_x10_(static_cast<int16_t>(523 + 2 * depth_cm)),
+              temperature_x10_(static_cast<int16_t>(214 - depth_cm / 2))
+        {
+        }
+
+        static int read(void *ctx, uint16_t reg, uint16_t *value)
+        {
+            return static_cast<Soil3in1SimProbe *>(ctx)->read_reg(reg, value);
+        }
+
+        uint32_t reads() const { return reads_; }
+
+    private:
+        int read_reg(uint16_t reg, uint16_t *value)
+        {
+            switch (reg)
+            {
+            case soil3in1::REG_MOISTURE:
+                step();
+                *value = static_cast<uint16_t>(moisture_x10_);
+                return 0;
+            case soil3in1::REG_TEMPERATURE:
+                *value = static_cast<uint16_t>(temperature_x10_);
+                return 0;
+            case soil3in1::REG_CONDUCTIVITY:
+                *value = conductivity_;
+                return 0;
+            default:
+                return -1;
+            }
+        }
+
+        void step()
+        {
+            if (reads_++ == 0)
+                return;
+
+            moisture_x10_ += 4;
+            if (moisture_x10_ > 800)
+                moisture_x10_ = 400;
+
+            temperature_x10_ += 1;
+            if (temperature_x10_ > 320)
+                temperature_x10_ = 180;
+
+            conductivity_ += 10;
+            if (conductivity_ > 1800)
+                conductivity_ = 600;
+        }
+
+        int16_t moisture_x10_;         /* 52.3 % at surface */
+        int16_t temperature_x10_;      /* 21.4 C at surface */
+        uint16_t conductivity_{812};   /* uS/cm */
+        uint32_t reads_{0};
+    };
+
+} // namespace loragro
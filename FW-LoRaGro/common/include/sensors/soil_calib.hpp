@@ -17,6 +17,7 @@ namespace SoilSensorConstants
         uint8_t moisture;
     };
 
+    /* Default curve of the capacitive v1.2 probe, mV falling with moisture */
     static constexpr SoilLutPoint SOIL_LUT[] =
         {
             {3000, 0},
@@ -30,4 +31,120 @@ namespace SoilSensorConstants
 
     static constexpr size_t SOIL_LUT_SIZE =
         sizeof(SOIL_LUT) / sizeof(SOIL_LUT[0]);
+
+    /* Calibration points accepted from NVS / downlink */
+    static constexpr size_t SOIL_CALIB_MIN_POINTS = 2;
+    static constexpr size_t SOIL_CALIB_MAX_POINTS = 8;
 }
+
+namespace loragro
+{
+    using SoilSensorConstants::SoilLutPoint;
+
+    /**
+     * SoilCalibration
+     *
+     * Piecewise linear calibration curve resampled onto a uniform mV grid:
+     *
+     *   table[i] = moisture(i * STEP_MV)   (Q8 percent)
+     *
+     * Conversion is one shift for the index and one fixed-point lerp
+     * between the two neighbouring grid points, no search and no data
+     * dependent branches, so it costs the same for any curve:
+     *
+     *   x = clamp(mv, 0, MAX_MV - 1)
+     *   i = x >> STEP_SHIFT,  f = x & (STEP_MV - 1)
+     *   y = table[i] + ((table[i + 1] - table[i]) * f) >> STEP_SHIFT
+     *
+     * The table is built by the same constexpr code at compile time for
+     * the default curve and at runtime for per-probe curves from NVS.
+     * Resampling error stays below 1 % for curves with >= 128 mV spacing.
+     */
+    class SoilCalibration
+    {
+    public:
+        /* 128 mV grid over the 0..4096 mV input range */
+        static constexpr uint8_t STEP_SHIFT = 7;
+        static constexpr int32_t STEP_MV = 1 << STEP_SHIFT;
+        static constexpr int32_t MAX_MV = 4096;
+        static constexpr size_t TABLE_SIZE = MAX_MV / STEP_MV + 1;
+
+        constexpr SoilCalibration(const SoilLutPoint *points, size_t count)
+        {
+            for (size_t i = 0; i < TABLE_SIZE; ++i)
+                table_q8_[i] = sample_q8(points, count, static_cast<int32_t>(i) * STEP_MV);
+        }
+
+        template <size_t N>
+        constexpr explicit SoilCalibration(const SoilLutPoint (&points)[N])
+            : SoilCalibration(points, N)
+        {
+        }
+
+        /* Moisture in percent, 0..100 */
+        constexpr uint8_t percent(int32_t mv) const
+        {
+            /* Compiles to min/max (cmov / usat), not branches */
+            const int32_t x = mv < 0 ? 0 : (mv > MAX_MV - 1 ? MAX_MV - 1 : mv);
+            const size_t i = static_cast<size_t>(x) >> STEP_SHIFT;
+            const int32_t f = x & (STEP_MV - 1);
+
+            const int32_t y0 = table_q8_[i];
+            const int32_t y1 = table_q8_[i + 1];
+            const int32_t y = y0 + (((y1 - y0) * f) >> STEP_SHIFT);
+
+            return static_cast<uint8_t>((y + 128) >> 8);
+        }
+
+        /* Points must be ordered by falling mV with moisture 0..100 */
+        static constexpr bool points_valid(const SoilLutPoint *points, size_t count)
+        {
+            if (count < SoilSensorConstants::SOIL_CALIB_MIN_POINTS ||
+                count > SoilSensorConstants::SOIL_CALIB_MAX_POINTS)
+                return false;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (points[i].moisture > 100 || points[i].mv < 0 || points[i].mv >= MAX_MV)
+                    return false;
+                if (i > 0 && points[i].mv >= points[i - 1].mv)
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+        /* Reference piecewise linear curve, evaluated only while building */
+        static constexpr uint16_t sample_q8(const SoilLutPoint *points, size_t count, int32_t mv)
+        {
+            if (mv >= points[0].mv)
+                return static_cast<uint16_t>(points[0].moisture << 8);
+
+            for (size_t i = 1; i < count; ++i)
+            {
+                const SoilLutPoint &p0 = points[i - 1];
+                const SoilLutPoint &p1 = points[i];
+
+                if (mv >= p1.mv)
+                {
+                    const int32_t span = p0.mv - p1.mv;
+                    const int32_t q8 = (p0.moisture << 8) +
+                                       ((p1.moisture - p0.moisture) * (p0.mv - mv) * 256 + span / 2) / span;
+                    return static_cast<uint16_t>(q8);
+                }
+            }
+
+            return static_cast<uint16_t>(points[count - 1].moisture << 8);
+        }
+
+        uint16_t table_q8_[TABLE_SIZE]{};
+    };
+
+    static_assert(SoilCalibration::points_valid(SoilSensorConstants::SOIL_LUT,
+                                                SoilSensorConstants::SOIL_LUT_SIZE),
+                  "default soil curve must be ordered by falling mV");
+
+    /* Default table, generated at compile time */
+    inline constexpr SoilCalibration DEFAULT_SOIL_CALIBRATION{SoilSensorConstants::SOIL_LUT};
+
+} // namespace loragro
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "zephyr_sensor_adapter.hpp"
+#include "adc_channel_group.hpp"
+#include "soil_calib.hpp"
+#include "soil_calibration_store.hpp"
 #include "time_manager.hpp"
 #include <zephyr/drivers/adc.h>
 #include <zephyr/drivers/adc/adc_emul.h>
@@ -18,70 +21,42 @@ namespace loragro
     {
     public:
         SoilCapacitiveSensor(const struct device *dev,
-                             uint16_t moisture_id)
-            : ZephyrSensorAdapter(dev)
+                             uint16_t moisture_id,
+                             uint8_t probe = 0)
+            : ZephyrSensorAdapter(dev),
+              adc_(AdcChannelGroup::instance(dev)),
+              slot_(adc_.slot(SOIL_ADC_CHANNEL)),
+              probe_(probe)
         {
             measurements_[0].sensor_id = moisture_id;
 
-            channel_cfg_.gain = ADC_GAIN_1_6;
-            channel_cfg_.reference = ADC_REF_INTERNAL;
-            channel_cfg_.acquisition_time = ADC_ACQ_TIME_DEFAULT;
-            channel_cfg_.channel_id = SOIL_ADC_CHANNEL;
-            channel_cfg_.differential = 0;
-
-            sequence_.buffer = &raw_value_;
-            sequence_.buffer_size = sizeof(raw_value_);
-            sequence_.resolution = SOIL_ADC_RESOLUTION;
-            sequence_.oversampling = 0;
-            sequence_.channels = BIT(SOIL_ADC_CHANNEL);
+#ifdef CONFIG_ADC_EMUL
+            adc_.set_emulator(SOIL_ADC_CHANNEL, &emulate_raw);
+#endif
         }
 
         int init() override
         {
-            if (!device_is_ready(dev_))
+            if (slot_ < 0)
             {
                 return -ENODEV;
             }
 
-            int ret = adc_channel_setup(dev_, &channel_cfg_);
-            if (ret != 0)
-            {
-                return ret;
-            }
-
-#ifdef CONFIG_ADC_EMUL
-            // Initialize with realistic sensor voltage
-            adc_emul_const_raw_value_set(dev_, SOIL_ADC_CHANNEL, 2400);
-#endif
-
-            return 0;
+            refresh_calibration();
+            return adc_.init();
         }
 
         int sample() override
         {
-#ifdef CONFIG_ADC_EMUL
-            static int fake_soil_raw = 1365;
-            fake_soil_raw += 50;
-            if (fake_soil_raw > 4095)
-            {
-                fake_soil_raw = 1365;
-            }
-            adc_emul_const_raw_value_set(dev_, SOIL_ADC_CHANNEL, fake_soil_raw);
-#endif
-
-            int ret = adc_read(dev_, &sequence_);
+            /* All analog inputs share one scan per cycle */
+            int ret = adc_.latest();
             if (ret)
                 return ret;
 
-            /* ---- Convert RAW -> mV at ADC pin ---- */
-            const int32_t raw = raw_value_;
-            // printk("raw_value_ = %d\n", (int)raw_value_);
+            /* Curve replaced over downlink since last sample */
+            refresh_calibration();
 
-            constexpr int32_t max_adc = (1 << SOIL_ADC_RESOLUTION) - 1; // e.g. 4095 (12bit)
-            constexpr int32_t vref_mv = 600;                            // nRF internal reference
-            constexpr int32_t gain_multiplier = 6;                      // gain = 1/6
-
-            int32_t adc_mv = (raw * vref_mv * gain_multiplier) / max_adc;
+            const int32_t adc_mv = adc_.pin_mv(slot_);
             uint8_t moisture = soil_mv_to_percent(adc_mv);
 
             measurements_[0].value.val1 = moisture;
@@ -91,55 +66,23 @@ namespace loragro
             return 0;
         }
 
-        uint8_t soil_mv_to_percent(int32_t mv)
+        /* Constant time: one table index + fixed-point lerp */
+        uint8_t soil_mv_to_percent(int32_t mv) const
         {
-            // Clamp high (too dry)
-            if (mv >= SoilSensorConstants::SOIL_LUT[0].mv)
-            {
-                return SoilSensorConstants::SOIL_LUT[0].moisture;
-            }
-
-            // Clamp low (too wet)
-            if (mv <= SoilSensorConstants::SOIL_LUT[SoilSensorConstants::SOIL_LUT_SIZE - 1].mv)
-            {
-                return SoilSensorConstants::SOIL_LUT[SoilSensorConstants::SOIL_LUT_SIZE - 1].moisture;
-            }
-
-            for (size_t i = 0; i < SoilSensorConstants::SOIL_LUT_SIZE - 1; i++)
-            {
-                const auto &p0 = SoilSensorConstants::SOIL_LUT[i];
-                const auto &p1 = SoilSensorConstants::SOIL_LUT[i + 1];
-
-                if (mv <= p0.mv && mv >= p1.mv)
-                {
-                    // Linear interpolation
-                    return p0.moisture +
-                           (p1.moisture - p0.moisture) *
-                               (p0.mv - mv) /
-                               (p0.mv - p1.mv);
-                }
-            }
-
-            return 0; // should never hit
+            return calib_.percent(mv);
         }
 
         int is_connected() override
         {
+            if (slot_ < 0)
+                return -ENODEV;
 
-            int ret = adc_read(dev_, &sequence_);
+            /* Detection reuses the cycle scan, no extra conversion */
+            int ret = adc_.latest();
             if (ret)
                 return ret;
-            /* ---- Convert RAW -> mV at ADC pin ---- */
-            const int32_t raw = raw_value_;
-            // printk("raw_value_ = %d\n", (int)raw_value_);
 
-            constexpr int32_t max_adc = (1 << SOIL_ADC_RESOLUTION) - 1; // e.g. 4095 (12bit)
-            constexpr int32_t vref_mv = 600;                            // nRF internal reference
-            constexpr int32_t gain_multiplier = 6;                      // gain = 1/6
-
-            int32_t adc_mv = (raw * vref_mv * gain_multiplier) / max_adc;
-
-            if (adc_mv < 100)
+            if (adc_.pin_mv(slot_) < 100)
             {
                 return -EIO;
             }
@@ -152,9 +95,41 @@ namespace loragro
         }
 
     private:
-        struct adc_channel_cfg channel_cfg_;
-        struct adc_sequence sequence_;
-        int32_t raw_value_;
+#ifdef CONFIG_ADC_EMUL
+        static int32_t emulate_raw()
+        {
+            static int32_t fake_soil_raw = 1365;
+            fake_soil_raw += 50;
+            if (fake_soil_raw > 4095)
+            {
+                fake_soil_raw = 1365;
+            }
+            return fake_soil_raw;
+        }
+#endif
+
+        /* Rebuild table from NVS curve of this probe, only when one was stored */
+        void refresh_calibration()
+        {
+            const uint32_t gen = SoilCalibrationStore::generation();
+            if (gen == calib_generation_)
+                return;
+            calib_generation_ = gen;
+
+            SoilCalibRecord record;
+            if (SoilCalibrationStore::load(probe_, record) == 0)
+                calib_ = SoilCalibration(record.points, record.count);
+            else
+                calib_ = DEFAULT_SOIL_CALIBRATION;
+        }
+
+    private:
+        AdcChannelGroup &adc_;
+        const int slot_;
+        const uint8_t probe_;
+
+        SoilCalibration calib_{DEFAULT_SOIL_CALIBRATION};
+        uint32_t calib_generation_{0};
     };
 
 } // namespace loragro
\ No newline at end of file
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <optional>
+
+#include "sensor.hpp"
+#include "soil_3in1_adapter.hpp"
+#include "modbus/modbus_rtu.hpp"
+#include "regs/soil_3in1_regs.hpp"
+
+namespace loragro
+{
+    /* Known probe from devicetree: address -> installation depth */
+    struct SoilProbeHint
+    {
+        uint8_t slave_addr;
+        uint8_t depth_cm;
+    };
+
+    /**
+     * All 3-in-1 soil probes on one RS485 bus as a single sensor.
+     *
+     * init() (sensor rail is on) scans slave addresses
+     * first_addr..last_addr and creates one SoilSensor3in1ModbusAdapter
+     * per probe that answers, again on later cycles until one does. Probe index = position in the scan, depth
+     * comes from the hints (devicetree), 0 if unknown.
+     *
+     * sample() polls every probe back-to-back in one bus session and
+     * publishes, per probe that answered:
+     *
+     *   soil_probe(p, DEPTH), soil_probe(p, MOISTURE),
+     *   soil_probe(p, TEMPERATURE), soil_probe(p, EC)
+     *
+     * FrameCodec packs such runs into one depth-profile entry per frame.
+     * One SampleManager registration covers the whole bus.
+     */
+    template <size_t MaxProbes>
+    class SoilProbeBus : public Sensor<MaxProbes * SensorID::PROBE_TYPE_COUNT>
+    {
+        static_assert(MaxProbes >= 1 && MaxProbes <= SensorID::SOIL_PROBE_MAX,
+                      "SoilProbeBus: probe index must fit the SensorID probe field");
+
+    public:
+        SoilProbeBus(ModbusRtuClient &bus,
+                     uint8_t first_addr,
+                     uint8_t last_addr,
+                     const SoilProbeHint *hints = nullptr,
+                     size_t hint_count = 0)
+            : bus_(bus),
+              first_addr_(first_addr),
+              last_addr_(last_addr),
+              hints_(hints),
+              hint_count_(hint_count)
+        {
+        }
+
+        /* Scans until a probe answers, -ENODEV keeps the rescan on the backoff schedule */
+        int init() override
+        {
+            if (enumerated_)
+                return 0;
+
+            int ret = enumerate();
+            if (ret < 0)
+                return ret;
+
+            return probe_count_ > 0 ? 0 : -ENODEV;
+        }
+
+        /* Scan the bus, replaces the current probe list. Probe count or negative errno */
+        int enumerate()
+        {
+            ModbusRtuClient::Session session(bus_);
+            if (session.status())
+                return session.status();
+
+            probe_count_ = 0;
+            for (uint16_t addr = first_addr_; addr <= last_addr_ && probe_count_ < MaxProbes; ++addr)
+            {
+                if (!bus_.probe(static_cast<uint8_t>(addr), soil3in1::REG_MOISTURE))
+                    continue;
+
+                probes_[probe_count_].emplace(bus_, static_cast<uint8_t>(addr), probe_count_);
+                depth_cm_[probe_count_] = depth_for(static_cast<uint8_t>(addr));
+                probe_count_++;
+            }
+
+            enumerated_ = probe_count_ > 0;
+            return probe_count_;
+        }
+
+        int sample() override
+        {
+            count_ = 0;
+            if (probe_count_ == 0)
+                return 0;
+
+            ModbusRtuClient::Session session(bus_);
+            if (session.status())
+                return session.status();
+
+            int last_err = 0;
+            for (uint8_t p = 0; p < probe_count_; ++p)
+            {
+                int ret = probes_[p]->sample();
+                if (ret)
+                {
+                    /* One silent probe must not drop the rest of the profile */
+                    last_err = ret;
+                    continue;
+                }
+
+                const Measurement *m = probes_[p]->get_measurements();
+
+                Measurement &depth = this->measurements_[count_++];
+                depth.sensor_id = SensorID::soil_probe(p, SensorID::PROBE_DEPTH);
+                depth.value.val1 = depth_cm_[p];
+                depth.value.val2 = 0;
+                depth.timestamp = m[0].timestamp;
+
+                for (size_t i = 0; i < probes_[p]->count(); ++i)
+                    this->measurements_[count_++] = m[i];
+            }
+
+            return count_ > 0 ? 0 : last_err;
+        }
+
+        int is_connected() override
+        {
+            return probe_count_ > 0 ? 0 : -ENODEV;
+        }
+
+        /* Entries of probes that answered in the last sample() */
+        size_t count() const override
+        {
+            return count_;
+        }
+
+        uint8_t probe_count() const { return probe_count_; }
+        uint8_t probe_addr(uint8_t p) const { return probes_[p]->slave_addr(); }
+        uint8_t depth_cm(uint8_t p) const { return depth_cm_[p]; }
+
+        const char *getName() const override
+        {
+            return "Soil Probe Bus (Modbus)";
+        }
+
+    private:
+        uint8_t depth_for(uint8_t addr) const
+        {
+            for (size_t i = 0; i < hint_count_; ++i)
+            {
+                if (hints_[i].slave_addr == addr)
+                    return hints_[i].depth_cm;
+            }
+            return 0;
+        }
+
+        ModbusRtuClient &bus_;
+        const uint8_t first_addr_;
+        const uint8_t last_addr_;
+        const SoilProbeHint *hints_;
+        const size_t hint_count_;
+
+        std::optional<SoilSensor3in1ModbusAdapter> probes_[MaxProbes];
+        uint8_t depth_cm_[MaxProbes]{};
+        uint8_t probe_count_{0};
+        size_t count_{0};
+        bool enumerated_{false};
+    };
+
+} // namespace loragro
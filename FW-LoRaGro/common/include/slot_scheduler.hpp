@@ -0,0 +1,72 @@
+/**
+ * TDMA slot scheduler
+ *
+ * Every node owns one slot inside the sampling interval:
+ *
+ *   interval start (wall clock, multiple of interval)
+ *   |-- slot 0 --|-- slot 1 --| ... |-- slot N --| ... |
+ *                              ^ offset = slot_index * slot_width
+ *
+ * The next wake-up is computed as an ABSOLUTE deadline from the synced
+ * epoch (or from uptime before the first sync) and slept with
+ * K_TIMEOUT_ABS_MS, so the period does not stretch by the cycle runtime
+ * and slots do not walk into each other.
+ *
+ * The node wakes early by the time it needs from wake-up to first TX
+ * (measured in the previous cycle), so the first frame leaves at
+ * slot start + clock guard.
+ *
+ * If the gateway assigned a slot for the interval (SET_TDMA_SLOT), its
+ * offset and width are used as-is. Otherwise the node falls back to
+ * slot_index = node_id with a locally estimated width, which wastes
+ * air for sparse node IDs and may overflow the interval.
+ */
+#pragma once
+
+#include <cstdint>
+#include <zephyr/kernel.h>
+
+#include "config_manager.hpp"
+
+namespace loragro
+{
+    class SlotScheduler
+    {
+    public:
+        explicit SlotScheduler(const DeviceConfig &dev_cfg)
+            : dev_cfg_(dev_cfg) {};
+
+        /* Sleep until this node's slot stride intervals ahead (stride - 1 slots skipped) */
+        int sleep_until_next_slot(uint32_t interval_min, uint8_t stride = 1);
+
+        /* Absolute local uptime (ms) of next wake-up for given interval */
+        int64_t next_wake_local_ms(uint32_t interval_min, uint8_t stride = 1) const;
+
+        /* Called right before first TX of a cycle, measures wake -> TX lead time */
+        void mark_tx_start();
+
+        /* Slot index of this node inside the interval */
+        uint16_t slot_index(uint32_t interval_min) const;
+
+        /* Gateway assigned slot for interval, nullptr if none */
+        const TdmaSlot *assigned_slot(uint32_t interval_min) const;
+
+        /* Width of one TDMA slot (ms) for the interval, including clock guard */
+        static uint32_t slot_width_ms(const DeviceConfig &cfg, uint32_t interval_ms);
+
+        /* Airtime estimate of one LoRa packet in seconds */
+        static float calculate_airtime_s(const DeviceConfig &cfg, const uint8_t payload_len);
+
+        /* Max payload for configured SF */
+        static uint8_t get_max_payload(const DeviceConfig &cfg);
+
+    private:
+        const DeviceConfig &dev_cfg_;
+
+        int64_t last_wake_local_ms_{0};
+        uint32_t tx_lead_ms_{0};
+
+        /* Never schedule closer than this to now, covers wake-up latency */
+        static constexpr int64_t MIN_SLEEP_MS = 100;
+    };
+}
@@ -0,0 +1,44 @@
+/**
+ * Soil probe calibration store
+ *
+ * Per-probe calibration curves in NVS (record NVS_ID_SOIL_CALIB_BASE +
+ * probe). A curve is written by the SET_SOIL_CALIB downlink and picked
+ * up by the soil adapter on its next init(), which rebuilds the uniform
+ * lookup table once. Probes without a stored curve use the compile-time
+ * default table.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "sensors/soil_calib.hpp"
+
+namespace loragro
+{
+    /* NVS record layout */
+    struct SoilCalibRecord
+    {
+        uint8_t count;
+        SoilLutPoint points[SoilSensorConstants::SOIL_CALIB_MAX_POINTS];
+    };
+
+    class SoilCalibrationStore
+    {
+    public:
+        static constexpr uint8_t MAX_PROBES = 4;
+
+        /* Stored curve of probe, -ENOENT if none (caller keeps default) */
+        static int load(uint8_t probe, SoilCalibRecord &record);
+
+        /* Validate and persist a curve, bumps generation() */
+        static int store(uint8_t probe, const SoilLutPoint *points, size_t count);
+
+        /* Changes whenever a curve was stored, adapters reload on mismatch */
+        static uint32_t generation() { return generation_; }
+
+    private:
+        static inline uint32_t generation_ = 1;
+    };
+
+} // namespace loragro
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdlib>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
@@ -13,9 +14,16 @@ namespace loragro
      * - Uses Zephyr monotonic uptime for sampling timestamps
      * - Supports optional synchronization to real (Unix) time
      * - Allows retroactive conversion of old samples
+     * - Estimates crystal drift (ppb) from successive syncs and
+     *   corrects both timestamps and local sleep durations
      *
      * All timestamps inside the system are stored as MONOTONIC seconds.
      * Conversion to real time is done only when needed.
+     *
+     * Clock model (all values in ms):
+     *   unix = epoch_base + local + (local - sync_local) * drift_ppb / 1e9
+     *
+     * drift_ppb > 0 means the local clock runs slow against the gateway.
      */
     class TimeManager
     {
@@ -26,6 +34,35 @@ namespace loragro
             return k_uptime_seconds();
         }
 
+        /** Monotonic uptime in milliseconds (always valid) */
+        static int64_t monotonic_ms()
+        {
+            return k_uptime_get();
+        }
+
+        /**
+         * Remember the local instant a downlink finished.
+         *
+         * Called by the radio layer on RX done, so a time sync carried
+         * in that frame is referenced to reception instead of to the
+         * moment the command handler happened to run.
+         */
+        static void mark_rx()
+        {
+            last_rx_local_ms_ = monotonic_ms();
+        }
+
+        /** Local uptime (ms) to use as reference for a sync received just now */
+        static int64_t sync_reference_ms()
+        {
+            const int64_t now = monotonic_ms();
+            if (last_rx_local_ms_ > 0 && (now - last_rx_local_ms_) < RX_REFERENCE_MAX_AGE_MS)
+            {
+                return last_rx_local_ms_;
+            }
+            return now;
+        }
+
         /**
          * Synchronize real (Unix epoch) time.
          *
@@ -33,8 +70,62 @@ namespace loragro
          */
         static void sync_unix_time_s(uint64_t unix_s)
         {
-            uint32_t now_s = monotonic_s();
-            epoch_base_s_ = unix_s - now_s;
+            sync_unix_time_ms(unix_s * 1000ULL, sync_reference_ms(), false);
+        }
+
+        /**
+         * Synchronize real time with millisecond resolution.
+         *
+         * unix_ms:  milliseconds since Unix epoch, stamped by the gateway
+         *           at the end of its transmission
+         * local_ms: local uptime at which that instant was observed
+         * precise:  whether the sync may be used for drift estimation
+         *           (whole-second syncs carry up to 1 s of quantization)
+         */
+        static void sync_unix_time_ms(uint64_t unix_ms, int64_t local_ms, bool precise = true)
+        {
+            if (synced_ && precise && last_sync_precise_)
+            {
+                const int64_t elapsed_ms = local_ms - sync_local_ms_;
+
+                if (elapsed_ms >= MIN_DRIFT_WINDOW_MS)
+                {
+                    /* Residual error of current model, the part the old drift did not explain */
+                    const int64_t predicted_ms = static_cast<int64_t>(unix_ms_at(local_ms));
+                    const int64_t error_ms = static_cast<int64_t>(unix_ms) - predicted_ms;
+                    const int64_t residual_ppb = (error_ms * 1000000000LL) / elapsed_ms;
+
+                    int64_t drift = drift_ppb_;
+                    if (drift_samples_ == 0)
+                    {
+                        drift += residual_ppb;
+                    }
+                    else
+                    {
+                        drift += residual_ppb / DRIFT_FILTER_DIV;
+                    }
+
+                    if (drift > MAX_DRIFT_PPB)
+                        drift = MAX_DRIFT_PPB;
+                    if (drift < -MAX_DRIFT_PPB)
+                        drift = -MAX_DRIFT_PPB;
+
+                    drift_ppb_ = static_cast<int32_t>(drift);
+
+                    const uint32_t abs_residual = static_cast<uint32_t>(llabs(residual_ppb));
+                    residual_ppb_ = (drift_samples_ == 0)
+                                        ? abs_residual
+                                        : residual_ppb_ - residual_ppb_ / DRIFT_FILTER_DIV +
+                                              abs_residual / DRIFT_FILTER_DIV;
+
+                    if (drift_samples_ < UINT8_MAX)
+                        drift_samples_++;
+                }
+            }
+
+            epoch_base_ms_ = static_cast<int64_t>(unix_ms) - local_ms;
+            sync_local_ms_ = local_ms;
+            last_sync_precise_ = precise;
             synced_ = true;
         }
 
@@ -44,6 +135,41 @@ namespace loragro
             return synced_;
         }
 
+        /** Returns true once crystal drift has been measured at least once */
+        static bool has_drift_estimate()
+        {
+            return drift_samples_ > 0;
+        }
+
+        /** Estimated crystal drift in parts per billion */
+        static int32_t drift_ppb()
+        {
+            return drift_ppb_;
+        }
+
+        /**
+         * Unix time in ms at local uptime local_ms, drift corrected.
+         *
+         * Returns local_ms if not synchronized yet.
+         */
+        static uint64_t unix_ms_at(int64_t local_ms)
+        {
+            if (!synced_)
+            {
+                return static_cast<uint64_t>(local_ms);
+            }
+
+            const int64_t since_sync = local_ms - sync_local_ms_;
+            const int64_t correction = (since_sync * drift_ppb_) / 1000000000LL;
+            return static_cast<uint64_t>(epoch_base_ms_ + local_ms + correction);
+        }
+
+        /** Current Unix time in ms (best effort) */
+        static uint64_t unix_ms()
+        {
+            return unix_ms_at(monotonic_ms());
+        }
+
         /**
          * Convert monotonic timestamp to Unix time (seconds).
          *
@@ -55,15 +181,87 @@ namespace loragro
             {
                 return (uint32_t)monotonic_s; // uptime in seconds
             }
-            return (uint32_t)(epoch_base_s_ + monotonic_s);
+            return (uint32_t)(unix_ms_at(static_cast<int64_t>(monotonic_s) * 1000) / 1000);
+        }
+
+        /**
+         * Local uptime (ms) at which the wall clock will read unix_ms.
+         *
+         * Inverse of unix_ms_at(), used to turn wall-clock deadlines into
+         * absolute kernel timeouts.
+         */
+        static int64_t local_ms_for_unix_ms(uint64_t unix_ms)
+        {
+            if (!synced_)
+            {
+                return static_cast<int64_t>(unix_ms);
+            }
+
+            const int64_t wall_since_sync = static_cast<int64_t>(unix_ms) - epoch_base_ms_ - sync_local_ms_;
+            return sync_local_ms_ + local_duration_ms(wall_since_sync);
+        }
+
+        /** Local clock duration that corresponds to wall_ms of real time */
+        static int64_t local_duration_ms(int64_t wall_ms)
+        {
+            return (wall_ms * 1000000000LL) / (1000000000LL + drift_ppb_);
+        }
+
+        /**
+         * Worst-case clock error (ms) accumulated over horizon_ms.
+         *
+         * Without a drift estimate the full crystal tolerance applies,
+         * afterwards only the filtered residual of the estimate does.
+         * Used to size TDMA guard time instead of a blanket margin.
+         */
+        static uint32_t guard_ms(uint32_t horizon_ms)
+        {
+            const uint64_t ppb = has_drift_estimate()
+                                     ? static_cast<uint64_t>(residual_ppb_) + RESIDUAL_FLOOR_PPB
+                                     : XTAL_TOLERANCE_PPB;
+            return static_cast<uint32_t>((static_cast<uint64_t>(horizon_ms) * ppb) / 1000000000ULL) +
+                   SYNC_JITTER_MS;
         }
 
     private:
-        /** Unix epoch offset: unix_s = epoch_base_s_ + monotonic_s */
-        inline static uint64_t epoch_base_s_ = 0;
+        /** Syncs closer together than this are too short to measure ppm-level drift */
+        static constexpr int64_t MIN_DRIFT_WINDOW_MS = 10 * 60 * 1000;
+
+        /** RX-done reference older than this is not the frame carrying the sync */
+        static constexpr int64_t RX_REFERENCE_MAX_AGE_MS = 2000;
+
+        /** EWMA weight 1/N for drift updates after the first measurement */
+        static constexpr int64_t DRIFT_FILTER_DIV = 4;
+
+        /** Reject implausible estimates (32 kHz crystals are within ±100 ppm) */
+        static constexpr int64_t MAX_DRIFT_PPB = 500000;
+
+        /** Assumed 32.768 kHz crystal tolerance before first drift measurement */
+        static constexpr uint32_t XTAL_TOLERANCE_PPB = 50000;
+
+        /** Floor for residual (temperature swings between syncs) */
+        static constexpr uint32_t RESIDUAL_FLOOR_PPB = 2000;
+
+        /** Gateway timestamping + RX done latency */
+        static constexpr uint32_t SYNC_JITTER_MS = 5;
+
+        /** Unix epoch offset in ms at sync point: unix_ms = epoch_base_ms_ + local_ms */
+        inline static int64_t epoch_base_ms_ = 0;
+
+        /** Local uptime (ms) of the last sync */
+        inline static int64_t sync_local_ms_ = 0;
+
+        /** Local uptime (ms) of last RX done */
+        inline static int64_t last_rx_local_ms_ = 0;
+
+        /** Filtered crystal drift and residual of the estimate */
+        inline static int32_t drift_ppb_ = 0;
+        inline static uint32_t residual_ppb_ = 0;
+        inline static uint8_t drift_samples_ = 0;
 
         /** Whether real time has been synchronized */
         inline static bool synced_ = false;
+        inline static bool last_sync_precise_ = false;
     };
 
 } // namespace loragro
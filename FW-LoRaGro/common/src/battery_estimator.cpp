@@ -0,0 +1,183 @@
+#include "battery_estimator.hpp"
+
+#include <climits>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(battery_estimator, CONFIG_LORAGRO_POWER_LOG_LEVEL);
+
+namespace loragro
+{
+    /* Li-ion open-circuit voltage curve, 25 C, rest voltage */
+    struct OcvPoint
+    {
+        int16_t mv;
+        uint16_t soc_permille;
+    };
+
+    static constexpr OcvPoint ocv_curve[] = {
+        {4200, 1000},
+        {4110, 900},
+        {4020, 800},
+        {3950, 700},
+        {3870, 600},
+        {3840, 500},
+        {3800, 400},
+        {3770, 300},
+        {3730, 200},
+        {3690, 100},
+        {3610, 50},
+        {3270, 0},
+    };
+
+    uint16_t BatteryEstimator::soc_from_ocv(int32_t mv)
+    {
+        if (mv >= ocv_curve[0].mv)
+            return ocv_curve[0].soc_permille;
+
+        for (size_t i = 1; i < ARRAY_SIZE(ocv_curve); ++i)
+        {
+            const OcvPoint &hi = ocv_curve[i - 1];
+            const OcvPoint &lo = ocv_curve[i];
+
+            if (mv >= lo.mv)
+            {
+                return lo.soc_permille + (mv - lo.mv) * (hi.soc_permille - lo.soc_permille) /
+                                             (hi.mv - lo.mv);
+            }
+        }
+        return 0;
+    }
+
+    /* =========================
+     * Inputs
+     * ========================= */
+
+    void BatteryEstimator::update(int32_t measured_mv, uint32_t load_ua)
+    {
+        if (measured_mv <= 0)
+            return;
+
+        /* uA * mOhm = nV */
+        const int32_t sag_mv = static_cast<int32_t>(
+            (static_cast<uint64_t>(load_ua) * CONFIG_LORAGRO_BATTERY_R_INT_MOHM) / 1000000ULL);
+        const int32_t ocv_q4 = (measured_mv + sag_mv) * 16;
+
+        if (samples_ == 0)
+            ocv_q4_ = ocv_q4;
+        else
+            ocv_q4_ += (ocv_q4 - ocv_q4_) / FILTER_DIV;
+
+        if (samples_ < UINT8_MAX)
+            samples_++;
+    }
+
+    void BatteryEstimator::account_cycle(const EnergyReport &report)
+    {
+        /* Sleep is modelled separately, it depends on the chosen interval */
+        const uint32_t sleep_nAh = report.charge_nAh[static_cast<size_t>(EnergyComponent::SLEEP)];
+        const uint32_t awake_nAh = report.total_nAh - sleep_nAh;
+
+        if (cycles_ == 0)
+            cycle_nAh_ = awake_nAh;
+        else
+            cycle_nAh_ = cycle_nAh_ - cycle_nAh_ / FILTER_DIV + awake_nAh / FILTER_DIV;
+
+        if (cycles_ < UINT8_MAX)
+            cycles_++;
+    }
+
+    /* =========================
+     * Radio
+     * ========================= */
+
+    int32_t BatteryEstimator::tx_voltage_mv() const
+    {
+        const uint32_t tx_ua = EnergyLedger::current_ua(EnergyComponent::RADIO_TX) +
+                               EnergyLedger::current_ua(EnergyComponent::MCU_ACTIVE);
+        return ocv_mv() - static_cast<int32_t>(
+                              (static_cast<uint64_t>(tx_ua) * CONFIG_LORAGRO_BATTERY_R_INT_MOHM) / 1000000ULL);
+    }
+
+    int8_t BatteryEstimator::tx_power_cap_dbm() const
+    {
+        int8_t cap = dev_cfg_.lora.tx_power;
+        if (!valid())
+            return cap;
+
+        const int32_t floor_mv = dev_cfg_.battery_cutoff_mv + TX_SAG_MARGIN_MV;
+        int32_t sag_mv = ocv_mv() - tx_voltage_mv();
+
+        /* PA supply current roughly halves per 6 dB of output power */
+        while (ocv_mv() - sag_mv < floor_mv && cap - TX_POWER_BACKOFF_DB >= TX_POWER_MIN_DBM)
+        {
+            cap -= TX_POWER_BACKOFF_DB;
+            sag_mv /= 2;
+        }
+        return cap;
+    }
+
+    /* =========================
+     * Forecast
+     * ========================= */
+
+    uint8_t BatteryEstimator::max_stride() const
+    {
+        const uint8_t base = MAX(dev_cfg_.sample_interval_minutes, 1);
+        return MAX(dev_cfg_.sample_interval_min_low_battery / base, 1);
+    }
+
+    uint32_t BatteryEstimator::avg_current_ua(uint8_t stride) const
+    {
+        const uint32_t period_s = static_cast<uint32_t>(dev_cfg_.sample_interval_minutes) * 60 * MAX(stride, 1);
+        if (period_s == 0)
+            return 0;
+
+        /* 1 nAh over 1 s = 3.6 uA */
+        const uint32_t awake_ua = static_cast<uint32_t>((static_cast<uint64_t>(cycle_nAh_) * 36) / (10ULL * period_s));
+        return awake_ua + EnergyLedger::current_ua(EnergyComponent::SLEEP);
+    }
+
+    uint32_t BatteryEstimator::hours_to_cutoff(uint8_t stride) const
+    {
+        const uint32_t avg_ua = avg_current_ua(stride);
+        if (!valid() || cycles_ == 0 || avg_ua == 0)
+            return UINT32_MAX;
+
+        /* mAh * permille = uAh */
+        const uint32_t remaining_uAh = static_cast<uint32_t>(dev_cfg_.battery_capacity_mah) * soc_permille();
+        return remaining_uAh / avg_ua;
+    }
+
+    uint8_t BatteryEstimator::interval_stride() const
+    {
+        if (!valid() || cycles_ == 0 || dev_cfg_.battery_target_days == 0)
+            return 1;
+
+        /* Current that drains a full battery exactly in target lifetime */
+        uint64_t budget_ua = (static_cast<uint64_t>(dev_cfg_.battery_capacity_mah) * 1000) /
+                             (static_cast<uint64_t>(dev_cfg_.battery_target_days) * 24);
+
+        /* Taper budget between critical and cutoff instead of a hard switch */
+        const int32_t v = ocv_mv();
+        if (v <= dev_cfg_.battery_cutoff_mv)
+            return max_stride();
+        if (v < dev_cfg_.battery_critical_mv && dev_cfg_.battery_critical_mv > dev_cfg_.battery_cutoff_mv)
+        {
+            budget_ua = budget_ua * (v - dev_cfg_.battery_cutoff_mv) /
+                        (dev_cfg_.battery_critical_mv - dev_cfg_.battery_cutoff_mv);
+        }
+
+        const uint32_t sleep_ua = EnergyLedger::current_ua(EnergyComponent::SLEEP);
+        if (budget_ua <= sleep_ua)
+            return max_stride();
+
+        /* Shortest period for which cycle charge + sleep fits into budget */
+        const uint64_t min_period_s = (static_cast<uint64_t>(cycle_nAh_) * 36) / (10ULL * (budget_ua - sleep_ua));
+        const uint64_t base_s = static_cast<uint64_t>(MAX(dev_cfg_.sample_interval_minutes, 1)) * 60;
+        const uint64_t stride = (min_period_s + base_s - 1) / base_s;
+
+        return static_cast<uint8_t>(CLAMP(stride, 1, max_stride()));
+    }
+
+} // namespace loragro
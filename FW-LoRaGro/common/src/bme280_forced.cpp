@@ -0,0 +1,128 @@
+#include "bme280/bme280_forced.hpp"
+#include "config_manager.hpp"
+
+#include <cerrno>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(bme280_forced, CONFIG_LORAGRO_SAMPLING_LOG_LEVEL);
+
+namespace loragro
+{
+    using namespace bme280;
+
+    Bme280Forced::Bme280Forced(Bme280Bus &bus, Oversampling osrs)
+        : bus_(bus), osrs_(osrs)
+    {
+    }
+
+    int Bme280Forced::init()
+    {
+        uint8_t id = 0;
+        int ret = bus_.read(REG_CHIP_ID, &id, 1);
+        if (ret)
+            return ret;
+
+        if (id != CHIP_ID)
+        {
+            LOG_ERR("Unexpected chip ID 0x%02x", id);
+            return -ENODEV;
+        }
+
+        /* RAM copy survives the rail cycle, the chip NVM does not change */
+        if (calibrated_)
+            return 0;
+
+        return load_calibration();
+    }
+
+    int Bme280Forced::load_calibration()
+    {
+        ConfigManager &cfg = ConfigManager::instance();
+
+        if (cfg.read_record(ConfigManager::NVS_ID_BME280_CALIB, &calib_, sizeof(calib_)) == 0 &&
+            calib_.valid())
+        {
+            calibrated_ = true;
+            LOG_DBG("Calibration restored from NVS");
+            return 0;
+        }
+
+        uint8_t c00[CALIB_00_LEN];
+        uint8_t c26[CALIB_26_LEN];
+
+        int ret = bus_.read(REG_CALIB_00, c00, sizeof(c00));
+        if (ret == 0)
+            ret = bus_.read(REG_CALIB_26, c26, sizeof(c26));
+        if (ret)
+            return ret;
+
+        calib_ = Calibration::parse(c00, c26);
+        if (!calib_.valid())
+        {
+            LOG_ERR("Calibration NVM blank");
+            return -EIO;
+        }
+
+        calibrated_ = true;
+
+        ret = cfg.write_record(ConfigManager::NVS_ID_BME280_CALIB, &calib_, sizeof(calib_));
+        if (ret)
+            LOG_WRN("Calibration not persisted: %d", ret);
+
+        LOG_INF("Calibration read from chip");
+        return 0;
+    }
+
+    int Bme280Forced::start()
+    {
+        if (!calibrated_)
+            return -EACCES;
+
+        /* ctrl_hum is latched by the following ctrl_meas write */
+        int ret = bus_.write(REG_CTRL_HUM, osrs_.h & OSRS_MASK);
+        if (ret)
+            return ret;
+
+        const uint8_t ctrl_meas = static_cast<uint8_t>(((osrs_.t & OSRS_MASK) << OSRS_T_SHIFT) |
+                                                       ((osrs_.p & OSRS_MASK) << OSRS_P_SHIFT) |
+                                                       MODE_FORCED);
+        ret = bus_.write(REG_CTRL_MEAS, ctrl_meas);
+        if (ret)
+            return ret;
+
+        return static_cast<int>((measurement_time_us() + 999) / 1000);
+    }
+
+    int Bme280Forced::read(Bme280Sample &out)
+    {
+        /* Status + ctrl regs precede the data block, one transaction covers both */
+        uint8_t buf[REG_DATA_START - REG_STATUS + DATA_LEN];
+
+        int ret = bus_.read(REG_STATUS, buf, sizeof(buf));
+        if (ret)
+            return ret;
+
+        if (buf[0] & STATUS_MEASURING)
+            return -EBUSY;
+
+        const uint8_t *d = &buf[REG_DATA_START - REG_STATUS];
+        const int32_t adc_P = (d[0] << 12) | (d[1] << 4) | (d[2] >> 4);
+        const int32_t adc_T = (d[3] << 12) | (d[4] << 4) | (d[5] >> 4);
+        const int32_t adc_H = (d[6] << 8) | d[7];
+
+        if (adc_T == static_cast<int32_t>(ADC_SKIPPED_20BIT))
+            return -ENODATA;
+
+        int32_t t_fine = 0;
+        out.temperature_centi_c = compensate_temperature(calib_, adc_T, t_fine);
+
+        out.has_pressure = adc_P != static_cast<int32_t>(ADC_SKIPPED_20BIT);
+        out.pressure_q24_8 = out.has_pressure ? compensate_pressure(calib_, adc_P, t_fine) : 0;
+
+        out.has_humidity = adc_H != static_cast<int32_t>(ADC_SKIPPED_16BIT);
+        out.humidity_q22_10 = out.has_humidity ? compensate_humidity(calib_, adc_H, t_fine) : 0;
+
+        return 0;
+    }
+
+} // namespace loragro
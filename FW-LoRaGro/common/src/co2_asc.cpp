@@ -0,0 +1,68 @@
+#include "co2_asc.hpp"
+#include "config_manager.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(co2_asc, CONFIG_LORAGRO_SAMPLING_LOG_LEVEL);
+
+namespace loragro
+{
+    int Co2Asc::load()
+    {
+        Co2AscRecord record{};
+        int rc = ConfigManager::instance().read_record(
+            ConfigManager::NVS_ID_CO2_ASC, &record, sizeof(record));
+        if (rc)
+            return -ENOENT;
+
+        if (record.offset_ppm < -TARGET_PPM || record.offset_ppm > TARGET_PPM)
+        {
+            LOG_WRN("Stored CO2 offset %d ppm out of range, ignored", record.offset_ppm);
+            return -EBADMSG;
+        }
+
+        record_ = record;
+        LOG_INF("CO2 ASC offset %d ppm after %u windows", record_.offset_ppm, record_.windows);
+        return 0;
+    }
+
+    int32_t Co2Asc::apply(int32_t raw_ppm, uint32_t now_s)
+    {
+        if (started_)
+            window_elapsed_s_ += now_s - last_s_;
+
+        started_ = true;
+        last_s_ = now_s;
+
+        const int32_t corrected = std::max<int32_t>(0, raw_ppm + record_.offset_ppm);
+        window_min_ppm_ = std::min(window_min_ppm_, corrected);
+
+        if (window_elapsed_s_ >= PERIOD_S)
+            close_window();
+
+        return corrected;
+    }
+
+    void Co2Asc::close_window()
+    {
+        const int32_t step = std::clamp(TARGET_PPM - window_min_ppm_, -MAX_STEP_PPM, MAX_STEP_PPM);
+
+        record_.offset_ppm = static_cast<int16_t>(
+            std::clamp<int32_t>(record_.offset_ppm + step, -TARGET_PPM, TARGET_PPM));
+        record_.windows++;
+
+        LOG_INF("CO2 ASC window %u: min %d ppm, offset %d ppm",
+                record_.windows, window_min_ppm_, record_.offset_ppm);
+
+        window_min_ppm_ = INT32_MAX;
+        window_elapsed_s_ = 0;
+
+        int rc = ConfigManager::instance().write_record(
+            ConfigManager::NVS_ID_CO2_ASC, &record_, sizeof(record_));
+        if (rc)
+            LOG_WRN("CO2 ASC state not persisted: %d", rc);
+    }
+
+} // namespace loragro
@@ -1,6 +1,7 @@
 #include "config_manager.hpp"
+#include "energy_ledger.hpp"
 
-LOG_MODULE_REGISTER(config_manager, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(config_manager, CONFIG_LORAGRO_CONFIG_LOG_LEVEL);
 
 namespace loragro
 {
@@ -11,7 +12,7 @@ namespace loragro
 
     static struct nvs_fs nvs;
 
-#define CONFIG_NVS_ID 1
+#define CONFIG_NVS_ID ConfigManager::NVS_ID_DEVICE_CONFIG
 
     /* =========================
      * Singleton
@@ -64,6 +65,7 @@ namespace loragro
         {
             LOG_ERR("nvs_mount failed: %d", rc);
         }
+        nvs_mounted_ = (rc == 0);
 
         flash_area_close(flash_area);
         return rc;
@@ -103,7 +105,7 @@ namespace loragro
         }
 
         config_loaded_ = true;
-        LOG_INF("Config loaded from NVS");
+        LOG_DBG("Config loaded from NVS");
         return 0;
     }
 
@@ -135,11 +137,12 @@ namespace loragro
         {
             if (memcmp(&stored, &config_, sizeof(DeviceConfig)) == 0)
             {
-                LOG_INF("Config unchanged, skipping NVS write");
+                LOG_DBG("Config unchanged, skipping NVS write");
                 return 0;
             }
         }
 
+        EnergyScope energy(EnergyComponent::FLASH);
         int rc = nvs_write(&nvs,
                            CONFIG_NVS_ID,
                            &config_,
@@ -154,6 +157,53 @@ namespace loragro
         return 0;
     }
 
+    /* =========================
+     * Auxiliary records
+     * ========================= */
+
+    int ConfigManager::read_record(uint16_t id, void *data, size_t len)
+    {
+        if (!nvs_mounted_)
+        {
+            int rc = init_nvs();
+            if (rc)
+                return rc;
+        }
+
+        ssize_t rc = nvs_read(&nvs, id, data, len);
+        if (rc < 0)
+            return rc;
+
+        /* Layout changed between firmware versions */
+        if (static_cast<size_t>(rc) != len)
+            return -EBADMSG;
+
+        return 0;
+    }
+
+    int ConfigManager::write_record(uint16_t id, const void *data, size_t len)
+    {
+        if (id == CONFIG_NVS_ID)
+            return -EINVAL;
+
+        if (!nvs_mounted_)
+        {
+            int rc = init_nvs();
+            if (rc)
+                return rc;
+        }
+
+        /* nvs_write skips identical data itself, no flash wear on resend */
+        EnergyScope energy(EnergyComponent::FLASH);
+        ssize_t rc = nvs_write(&nvs, id, data, len);
+        if (rc < 0)
+        {
+            LOG_ERR("Failed to save record 0x%x: %d", id, static_cast<int>(rc));
+            return rc;
+        }
+        return 0;
+    }
+
     /* =========================
      * Defaults
      * ========================= */
@@ -193,9 +243,15 @@ namespace loragro
         config_.confirmed_uplink = true;
         config_.max_tx_frames_per_cycle = 3;
 
+        /* TDMA: no gateway assigned slots yet */
+        for (auto &slot : config_.tdma_slots)
+            slot = TdmaSlot{};
+
         /* Power */
         config_.battery_cutoff_mv = 2600;
         config_.battery_critical_mv = 3000;
+        config_.battery_capacity_mah = 2600; // 18650 cell
+        config_.battery_target_days = 365;
 
         config_.config_version = CONFIG_VERSION;
         config_.protocol_version = PROTOCOL_VERSION;
@@ -0,0 +1,160 @@
+#include "cycle_profiler.hpp"
+
+#include <zephyr/sys/util.h>
+
+namespace loragro
+{
+#ifdef CONFIG_LORAGRO_CYCLE_PROFILER_HOST_CLOCK
+    /* native/host_cpu_time.c, linked into the native simulator runner */
+    extern "C" uint64_t loragro_host_cpu_time_ns(void);
+#endif
+
+    static inline uint64_t host_now_ns()
+    {
+#ifdef CONFIG_LORAGRO_CYCLE_PROFILER_HOST_CLOCK
+        return loragro_host_cpu_time_ns();
+#else
+        return 0;
+#endif
+    }
+
+    static const char *const phase_names[CYCLE_PHASE_COUNT] = {
+        "config_load",
+        "rail_on",
+        "init",
+        "sample",
+        "encode",
+        "sign",
+        "tx",
+        "ack_wait",
+        "rx",
+        "downlink",
+        "flash_save",
+        "sleep_calc",
+    };
+
+    /* =========================
+     * Singleton
+     * ========================= */
+
+    CycleProfiler &CycleProfiler::instance()
+    {
+        static CycleProfiler instance;
+        return instance;
+    }
+
+    const char *CycleProfiler::name(CyclePhase p)
+    {
+        return idx(p) < CYCLE_PHASE_COUNT ? phase_names[idx(p)] : "?";
+    }
+
+    void CycleProfiler::reset()
+    {
+        for (size_t i = 0; i < CYCLE_PHASE_COUNT; ++i)
+            stats_[i] = PhaseStats{};
+        awake_ = PhaseStats{};
+        cycles_ = 0;
+        in_cycle_ = false;
+        running_mask_ = 0;
+    }
+
+    /* =========================
+     * Hooks
+     * ========================= */
+
+    void CycleProfiler::start(CyclePhase p)
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_CYCLE_PROFILER) || !in_cycle_)
+            return;
+
+        const size_t i = idx(p);
+        if (running_mask_ & BIT(i))
+            return;
+
+        running_mask_ |= BIT(i);
+        calls_[i]++;
+        started_host_ns_[i] = host_now_ns();
+        started_cyc_[i] = k_cycle_get_32();
+    }
+
+    void CycleProfiler::stop(CyclePhase p)
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_CYCLE_PROFILER))
+            return;
+
+        const uint32_t now_cyc = k_cycle_get_32();
+        const size_t i = idx(p);
+        if (!(running_mask_ & BIT(i)))
+            return;
+
+        /* 32-bit difference survives one counter wrap */
+        acc_cyc_[i] += static_cast<uint32_t>(now_cyc - started_cyc_[i]);
+        acc_host_ns_[i] += host_now_ns() - started_host_ns_[i];
+        running_mask_ &= ~BIT(i);
+    }
+
+    /* =========================
+     * Cycle boundaries
+     * ========================= */
+
+    void CycleProfiler::begin_cycle()
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_CYCLE_PROFILER))
+            return;
+
+        for (size_t i = 0; i < CYCLE_PHASE_COUNT; ++i)
+        {
+            acc_cyc_[i] = 0;
+            acc_host_ns_[i] = 0;
+            calls_[i] = 0;
+        }
+        running_mask_ = 0;
+        in_cycle_ = true;
+
+        cycle_start_host_ns_ = host_now_ns();
+        cycle_start_cyc_ = k_cycle_get_32();
+    }
+
+    void CycleProfiler::fold(PhaseStats &s, uint64_t cyc, uint64_t host_ns)
+    {
+        const uint64_t us = k_cyc_to_us_floor64(cyc);
+
+        s.cycles++;
+        s.total_us += us;
+        s.max_us = MAX(s.max_us, static_cast<uint32_t>(MIN(us, UINT32_MAX)));
+        s.host_total_ns += host_ns;
+        s.host_max_ns = MAX(s.host_max_ns, static_cast<uint32_t>(MIN(host_ns, UINT32_MAX)));
+    }
+
+    void CycleProfiler::end_cycle()
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_CYCLE_PROFILER) || !in_cycle_)
+            return;
+
+        /* Close anything left open, e.g. SLEEP_CALC ends at the k_sleep */
+        for (size_t i = 0; i < CYCLE_PHASE_COUNT; ++i)
+        {
+            if (running_mask_ & BIT(i))
+                stop(static_cast<CyclePhase>(i));
+        }
+
+        const uint32_t awake_cyc = k_cycle_get_32() - cycle_start_cyc_;
+        const uint64_t awake_host_ns = host_now_ns() - cycle_start_host_ns_;
+
+        for (size_t i = 0; i < CYCLE_PHASE_COUNT; ++i)
+        {
+            if (calls_[i] == 0)
+                continue;
+
+            fold(stats_[i], acc_cyc_[i], acc_host_ns_[i]);
+            stats_[i].calls += calls_[i];
+        }
+
+        fold(awake_, awake_cyc, awake_host_ns);
+        awake_.calls++;
+
+        cycles_++;
+        in_cycle_ = false;
+    }
+
+} // namespace loragro
@@ -0,0 +1,165 @@
+#include "energy_ledger.hpp"
+
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(energy_ledger, CONFIG_LORAGRO_POWER_LOG_LEVEL);
+
+namespace loragro
+{
+    static const char *const component_names[ENERGY_COMPONENT_COUNT] = {
+        "mcu",
+        "sensor_rail",
+        "sampling",
+        "radio_tx",
+        "radio_rx",
+        "flash",
+        "sleep",
+    };
+
+    /* =========================
+     * Singleton
+     * ========================= */
+
+    EnergyLedger &EnergyLedger::instance()
+    {
+        static EnergyLedger instance;
+        return instance;
+    }
+
+    /* =========================
+     * Current model
+     * ========================= */
+
+    uint32_t EnergyLedger::current_ua(EnergyComponent c)
+    {
+#ifdef CONFIG_LORAGRO_ENERGY_LEDGER
+        switch (c)
+        {
+        case EnergyComponent::MCU_ACTIVE:
+            return CONFIG_LORAGRO_ENERGY_MCU_ACTIVE_UA;
+        case EnergyComponent::SENSOR_RAIL:
+            return CONFIG_LORAGRO_ENERGY_SENSOR_RAIL_UA;
+        case EnergyComponent::SAMPLING:
+            return CONFIG_LORAGRO_ENERGY_SAMPLING_UA;
+        case EnergyComponent::RADIO_TX:
+            return CONFIG_LORAGRO_ENERGY_RADIO_TX_UA;
+        case EnergyComponent::RADIO_RX:
+            return CONFIG_LORAGRO_ENERGY_RADIO_RX_UA;
+        case EnergyComponent::FLASH:
+            return CONFIG_LORAGRO_ENERGY_FLASH_UA;
+        case EnergyComponent::SLEEP:
+            return CONFIG_LORAGRO_ENERGY_SLEEP_UA;
+        default:
+            return 0;
+        }
+#else
+        ARG_UNUSED(c);
+        return 0;
+#endif
+    }
+
+    uint32_t EnergyLedger::charge_nAh(uint32_t current_ua, uint64_t active_us)
+    {
+        /* uA * us = pAs, 1 nAh = 3.6e6 pAs */
+        return static_cast<uint32_t>((static_cast<uint64_t>(current_ua) * active_us) / 3600000ULL);
+    }
+
+    /* =========================
+     * Hooks
+     * ========================= */
+
+    void EnergyLedger::start(EnergyComponent c)
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_ENERGY_LEDGER))
+            return;
+
+        const size_t i = idx(c);
+        if (running_mask_ & BIT(i))
+            return;
+
+        started_ticks_[i] = k_uptime_ticks();
+        running_mask_ |= BIT(i);
+        events_[i]++;
+    }
+
+    void EnergyLedger::stop(EnergyComponent c)
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_ENERGY_LEDGER))
+            return;
+
+        const size_t i = idx(c);
+        if (!(running_mask_ & BIT(i)))
+            return;
+
+        active_ticks_[i] += k_uptime_ticks() - started_ticks_[i];
+        running_mask_ &= ~BIT(i);
+    }
+
+    /* =========================
+     * Cycle boundaries
+     * ========================= */
+
+    void EnergyLedger::begin_cycle()
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_ENERGY_LEDGER))
+            return;
+
+        const int64_t now = k_uptime_ticks();
+
+        for (size_t i = 0; i < ENERGY_COMPONENT_COUNT; ++i)
+        {
+            active_ticks_[i] = 0;
+            events_[i] = 0;
+        }
+        running_mask_ = 0;
+
+        /* First cycle after boot has no sleep in front of it */
+        if (sleep_start_ticks_ >= 0)
+        {
+            active_ticks_[idx(EnergyComponent::SLEEP)] = now - sleep_start_ticks_;
+            events_[idx(EnergyComponent::SLEEP)] = 1;
+        }
+
+        start(EnergyComponent::MCU_ACTIVE);
+    }
+
+    void EnergyLedger::end_cycle()
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_ENERGY_LEDGER))
+            return;
+
+        /* Close anything left open, e.g. rail not powered off on error path */
+        for (size_t i = 0; i < ENERGY_COMPONENT_COUNT; ++i)
+        {
+            if (running_mask_ & BIT(i))
+                stop(static_cast<EnergyComponent>(i));
+        }
+
+        report_.total_nAh = 0;
+        for (size_t i = 0; i < ENERGY_COMPONENT_COUNT; ++i)
+        {
+            const uint64_t us = k_ticks_to_us_floor64(active_ticks_[i]);
+            report_.active_us[i] = static_cast<uint32_t>(MIN(us, UINT32_MAX)); // sleep > 71 min saturates
+            report_.charge_nAh[i] = charge_nAh(current_ua(static_cast<EnergyComponent>(i)), us);
+            report_.events[i] = events_[i];
+            report_.total_nAh += report_.charge_nAh[i];
+        }
+        report_.cycle++;
+
+        LOG_INF("Energy cycle %u: %u.%03u uAh total", report_.cycle,
+                report_.total_nAh / 1000, report_.total_nAh % 1000);
+        for (size_t i = 0; i < ENERGY_COMPONENT_COUNT; ++i)
+        {
+            if (report_.events[i] == 0)
+                continue;
+
+            LOG_DBG("  %-11s %2u x %8u us  %4u.%03u uAh", component_names[i],
+                    report_.events[i], report_.active_us[i],
+                    report_.charge_nAh[i] / 1000, report_.charge_nAh[i] % 1000);
+        }
+
+        sleep_start_ticks_ = k_uptime_ticks();
+    }
+
+} // namespace loragro
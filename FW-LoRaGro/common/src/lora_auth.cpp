@@ -2,7 +2,7 @@
 #include "config_manager.hpp"
 
 #include "data_types.hpp"
-LOG_MODULE_REGISTER(lora_auth, LOG_LEVEL_WRN);
+LOG_MODULE_REGISTER(lora_auth, CONFIG_LORAGRO_LORA_LOG_LEVEL);
 
 namespace loragro
 {
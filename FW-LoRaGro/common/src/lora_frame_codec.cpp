@@ -1,8 +1,11 @@
 #include "lora/lora_frame_codec.hpp"
 #include "lora/lora_protocol.hpp"
 #include <array>
+#include <climits>
+#include <cstring>
+#include <zephyr/sys/util.h>
 
-LOG_MODULE_REGISTER(lora_packetizer, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(lora_packetizer, CONFIG_LORAGRO_LORA_LOG_LEVEL);
 
 namespace loragro
 {
@@ -20,6 +23,86 @@ namespace loragro
     static_assert(FrameLayout::HEADER_SIZE == 4,
                   "Header size mismatch with protocol.hpp");
 
+    /* Depth profile: [SOIL_PROFILE][probe count] + count * record */
+    static constexpr size_t SOIL_PROFILE_HEADER_SIZE = 2;
+    static constexpr size_t SOIL_PROFILE_RECORD_SIZE = 5; // probe, depth, moisture, temp, EC
+
+    /* sensor_value in 1/2 units, rounded, saturated to int8/uint8 range */
+    static int32_t half_units(const sensor_value &v)
+    {
+        const int64_t micro = static_cast<int64_t>(v.val1) * 1000000 + v.val2;
+        return static_cast<int32_t>((micro * 2 + (micro >= 0 ? 500000 : -500000)) / 1000000);
+    }
+
+    /* =========================================================
+     * SOIL DEPTH PROFILE
+     * ---------------------------------------------------------
+     * Packs the run of soil probe entries starting at batch[first]
+     * into one record per probe:
+     *   [0] probe index  bus scan order, the receiver's key for the
+     *                    probe (probes that failed are left out, a
+     *                    split profile continues in the next frame)
+     *   [1] depth        cm            uint8
+     *   [2] moisture     0.5 %         uint8
+     *   [3] temperature  0.5 C         int8
+     *   [4] EC           10 uS/cm      uint8
+     * As many probes as fit into space. Returns bytes written (0 if
+     * not even one probe fits) and the number of batch entries used.
+     * ========================================================= */
+    static size_t encode_soil_profile(uint8_t *out, size_t space,
+                                      const BatchView &batch, size_t first,
+                                      size_t &consumed)
+    {
+        consumed = 0;
+        if (space < SOIL_PROFILE_HEADER_SIZE + SOIL_PROFILE_RECORD_SIZE)
+            return 0;
+
+        size_t pos = SOIL_PROFILE_HEADER_SIZE;
+        uint8_t probes = 0;
+        size_t i = first;
+
+        while (i < batch.count && SensorID::is_soil_probe(batch.data[i].sensor_id) &&
+               pos + SOIL_PROFILE_RECORD_SIZE <= space && probes < UINT8_MAX)
+        {
+            const uint8_t probe = SensorID::probe_index(batch.data[i].sensor_id);
+            uint8_t *rec = &out[pos];
+            memset(rec, 0, SOIL_PROFILE_RECORD_SIZE);
+            rec[0] = probe;
+
+            /* All entries of this probe */
+            for (; i < batch.count; ++i)
+            {
+                const Measurement &m = batch.data[i];
+                if (!SensorID::is_soil_probe(m.sensor_id) || SensorID::probe_index(m.sensor_id) != probe)
+                    break;
+
+                switch (SensorID::probe_type(m.sensor_id))
+                {
+                case SensorID::PROBE_DEPTH:
+                    rec[1] = static_cast<uint8_t>(CLAMP(m.value.val1, 0, UINT8_MAX));
+                    break;
+                case SensorID::PROBE_MOISTURE:
+                    rec[2] = static_cast<uint8_t>(CLAMP(half_units(m.value), 0, 200));
+                    break;
+                case SensorID::PROBE_TEMPERATURE:
+                    rec[3] = static_cast<uint8_t>(static_cast<int8_t>(CLAMP(half_units(m.value), INT8_MIN, INT8_MAX)));
+                    break;
+                case SensorID::PROBE_EC:
+                    rec[4] = static_cast<uint8_t>(CLAMP((m.value.val1 + 5) / 10, 0, UINT8_MAX));
+                    break;
+                }
+            }
+
+            pos += SOIL_PROFILE_RECORD_SIZE;
+            probes++;
+        }
+
+        out[0] = SensorID::SOIL_PROFILE;
+        out[1] = probes;
+        consumed = i - first;
+        return pos;
+    }
+
     /* =========================================================
      * BEGIN
      * ========================================================= */
@@ -71,17 +154,39 @@ namespace loragro
         pos += 4;
 
         uint8_t measurement_count = 0;
+        size_t i = batch_count_offset_;
 
-        for (size_t i = batch_count_offset_; i < batch_.count; ++i)
+        while (i < batch_.count)
         {
+            const Measurement &m = batch_.data[i];
+
+            /* Probe bus entries travel as one depth profile */
+            if (SensorID::is_soil_probe(m.sensor_id))
+            {
+                size_t consumed = 0;
+                const size_t len = encode_soil_profile(&frame[pos], packet_length - AUTH_TAG_SIZE - pos,
+                                                       batch_, i, consumed);
+                if (len == 0)
+                    break;
+
+                pos += len;
+                i += consumed;
+                measurement_count++;
+                continue;
+            }
+
             if (pos + MEASUREMENT_ENCODED_SIZE + AUTH_TAG_SIZE > packet_length)
                 break;
 
-            const Measurement &m = batch_.data[i];
-
             int16_t v1 = static_cast<int16_t>(m.value.val1 / 1000);
             int16_t v2 = static_cast<int16_t>(m.value.val2 / 1000);
 
+            if (SensorID::is_telemetry(m.sensor_id))
+            {
+                v1 = static_cast<int16_t>(m.value.val1);
+                v2 = static_cast<int16_t>(m.value.val2);
+            }
+
             frame[pos++] = m.sensor_id;
 
             write_i16_le(frame, pos, v1);
@@ -91,6 +196,7 @@ namespace loragro
             pos += 2;
 
             measurement_count++;
+            i++;
         }
 
         if (measurement_count == 0)
@@ -98,7 +204,7 @@ namespace loragro
 
         frame[measurement_count_pos] = measurement_count;
 
-        batch_count_offset_ += measurement_count;
+        batch_count_offset_ = i;
         frame_ctr_++;
 
         return static_cast<int>(pos);
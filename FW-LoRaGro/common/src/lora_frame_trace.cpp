@@ -0,0 +1,242 @@
+#include "lora/lora_frame_trace.hpp"
+#include "time_manager.hpp"
+
+#ifdef CONFIG_LORAGRO_FRAME_TRACE_FLASH
+#include "config_manager.hpp"
+#endif
+
+#include <cstring>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(frame_trace, CONFIG_LORAGRO_LORA_LOG_LEVEL);
+
+namespace loragro
+{
+
+    /* =========================
+     * Singleton
+     * ========================= */
+
+    FrameTrace &FrameTrace::instance()
+    {
+        static FrameTrace instance;
+        return instance;
+    }
+
+    void FrameTrace::reset()
+    {
+        head_ = 0;
+        count_ = 0;
+        unflushed_ = 0;
+        overwritten_ = 0;
+    }
+
+    /* =========================
+     * Hot path
+     * ========================= */
+
+    void FrameTrace::record(TraceKind kind, const uint8_t *frame, size_t len,
+                            int result, int16_t rssi, int8_t snr, uint16_t airtime_ms)
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_FRAME_TRACE))
+            return;
+
+        const bool synced = TimeManager::is_synced();
+        const uint32_t time_ms = static_cast<uint32_t>(TimeManager::unix_ms_at(TimeManager::monotonic_ms()));
+        const size_t cap_len = frame ? MIN(len, FRAME_TRACE_SNAPLEN) : 0;
+
+
+        FrameTraceRecord &r = ring_[head_];
+        r.time_ms = time_ms;
+        r.seq = seq_++;
+        r.kind = static_cast<uint8_t>(kind) | (synced ? FrameTraceRecord::SYNCED : 0);
+        r.len = static_cast<uint8_t>(MIN(len, UINT8_MAX));
+        r.cap_len = static_cast<uint8_t>(cap_len);
+        r.snr = snr;
+        r.rssi = rssi;
+        r.airtime_ms = airtime_ms;
+        r.result = static_cast<int16_t>(CLAMP(result, INT16_MIN, INT16_MAX));
+        if (cap_len)
+            memcpy(r.data, frame, cap_len);
+
+        head_ = (head_ + 1) % RING_SIZE;
+        count_ = MIN(count_ + 1, RING_SIZE);
+
+        /* Without flash nothing is ever flushed, every overwrite is a loss */
+        if (unflushed_ == RING_SIZE)
+            overwritten_++;
+        else
+            unflushed_++;
+
+    }
+
+    const FrameTraceRecord *FrameTrace::latest(size_t age) const
+    {
+        if (age >= count_)
+            return nullptr;
+
+        return &ring_[(head_ + RING_SIZE - 1 - age) % RING_SIZE];
+    }
+
+    /* =========================
+     * Dump helpers
+     * ========================= */
+
+    static void print_record(const FrameTraceRecord &r)
+    {
+        static const char hex[] = "0123456789abcdef";
+        char line[2 * sizeof(FrameTraceRecord) + 1];
+
+        /* Header and the captured bytes, the converter pads the rest */
+        const uint8_t *raw = reinterpret_cast<const uint8_t *>(&r);
+        const size_t n = FRAME_TRACE_HEADER_SIZE + MIN(r.cap_len, FRAME_TRACE_SNAPLEN);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            line[2 * i] = hex[raw[i] >> 4];
+            line[2 * i + 1] = hex[raw[i] & 0x0F];
+        }
+        line[2 * n] = '\0';
+
+        printk("FTRACE %s\n", line);
+    }
+
+    /* =========================
+     * Flash drain
+     * ========================= */
+
+#ifdef CONFIG_LORAGRO_FRAME_TRACE_FLASH
+
+    static constexpr uint16_t FLASH_BLOCKS = CONFIG_LORAGRO_FRAME_TRACE_FLASH_BLOCKS;
+
+    void FrameTrace::find_flash_head()
+    {
+        ConfigManager &cfg = ConfigManager::instance();
+
+        next_block_seq_ = 0;
+        for (uint16_t i = 0; i < FLASH_BLOCKS; ++i)
+        {
+            if (cfg.read_record(ConfigManager::NVS_ID_FRAME_TRACE_BASE + i, &block_, sizeof(block_)) != 0)
+                continue;
+
+            if (block_.record_size == sizeof(FrameTraceRecord) && block_.block_seq >= next_block_seq_)
+                next_block_seq_ = block_.block_seq + 1;
+        }
+
+        flash_head_known_ = true;
+    }
+
+    int FrameTrace::flush(bool force)
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_FRAME_TRACE))
+            return 0;
+
+        if (!flash_head_known_)
+            find_flash_head();
+
+        int written = 0;
+        while (unflushed_ >= BLOCK_RECORDS || (force && unflushed_ > 0))
+        {
+            const size_t n = MIN(unflushed_, BLOCK_RECORDS);
+            const size_t oldest = (head_ + RING_SIZE - unflushed_) % RING_SIZE;
+            for (size_t i = 0; i < n; ++i)
+                block_.records[i] = ring_[(oldest + i) % RING_SIZE];
+
+            block_.block_seq = next_block_seq_;
+            block_.count = static_cast<uint8_t>(n);
+            block_.record_size = sizeof(FrameTraceRecord);
+
+            const uint16_t id = ConfigManager::NVS_ID_FRAME_TRACE_BASE + (next_block_seq_ % FLASH_BLOCKS);
+            int rc = ConfigManager::instance().write_record(id, &block_, sizeof(block_));
+            if (rc < 0)
+            {
+                LOG_ERR("Trace block %u write failed: %d", next_block_seq_, rc);
+                return rc;
+            }
+
+            unflushed_ -= n;
+            next_block_seq_++;
+            written++;
+        }
+
+        return written;
+    }
+
+    int FrameTrace::dump_flash()
+    {
+        ConfigManager &cfg = ConfigManager::instance();
+
+        if (!flash_head_known_)
+            find_flash_head();
+
+        /* Oldest surviving block first, the ring holds the last FLASH_BLOCKS */
+        const uint32_t first = next_block_seq_ > FLASH_BLOCKS ? next_block_seq_ - FLASH_BLOCKS : 0;
+
+        int printed = 0;
+        for (uint32_t seq = first; seq < next_block_seq_; ++seq)
+        {
+            const uint16_t id = ConfigManager::NVS_ID_FRAME_TRACE_BASE + (seq % FLASH_BLOCKS);
+            if (cfg.read_record(id, &block_, sizeof(block_)) != 0)
+                continue;
+
+            if (block_.block_seq != seq || block_.record_size != sizeof(FrameTraceRecord))
+                continue;
+
+            for (uint8_t i = 0; i < MIN(block_.count, BLOCK_RECORDS); ++i)
+            {
+                print_record(block_.records[i]);
+                printed++;
+            }
+        }
+
+        return printed;
+    }
+
+#else
+
+    int FrameTrace::flush(bool force)
+    {
+        ARG_UNUSED(force);
+        return 0;
+    }
+
+#endif
+
+    /* =========================
+     * Dump
+     * ========================= */
+
+    int FrameTrace::dump()
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_FRAME_TRACE))
+            return 0;
+
+        const int64_t uptime_ms = TimeManager::monotonic_ms();
+        const uint64_t unix_ms = TimeManager::is_synced() ? TimeManager::unix_ms_at(uptime_ms) : 0;
+
+        printk("FTRACE-BEGIN %u %u %u %lld %llu\n",
+               FORMAT_VERSION, static_cast<unsigned>(sizeof(FrameTraceRecord)),
+               static_cast<unsigned>(FRAME_TRACE_SNAPLEN), uptime_ms, unix_ms);
+
+        int printed = 0;
+#ifdef CONFIG_LORAGRO_FRAME_TRACE_FLASH
+        printed += dump_flash();
+
+        /* Flushed records are in flash already */
+        const size_t ram = unflushed_;
+#else
+        const size_t ram = count_;
+#endif
+
+        for (size_t age = ram; age-- > 0;)
+        {
+            print_record(*latest(age));
+            printed++;
+        }
+
+        printk("FTRACE-END %d %u\n", printed, overwritten_);
+        return printed;
+    }
+
+} // namespace loragro
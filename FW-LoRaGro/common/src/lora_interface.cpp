@@ -1,6 +1,9 @@
 #include "lora/lora_interface.hpp"
+#include "energy_ledger.hpp"
+#include "cycle_profiler.hpp"
+#include "lora/lora_frame_trace.hpp"
 
-LOG_MODULE_REGISTER(lora_interface, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(lora_interface, CONFIG_LORAGRO_LORA_LOG_LEVEL);
 
 namespace loragro
 {
@@ -21,8 +24,10 @@ namespace loragro
         if (!device_is_ready(dev_))
             return -ENODEV;
 
-        cfg_.lora.tx = false; // default RX mode
-        return lora_config(dev_, &cfg_.lora);
+        /* Radio params of this cycle, may be limited against the stored config */
+        lora_modem_config modem = cfg.lora;
+        modem.tx = false; // default RX mode
+        return lora_config(dev_, &modem);
     }
 
     int Interface::config(const DeviceConfig &cfg)
@@ -42,7 +47,19 @@ namespace loragro
         if (length > get_max_payload())
             return -EMSGSIZE;
 
-        return lora_send(dev_, data, length);
+        int ret;
+        {
+            EnergyScope energy(EnergyComponent::RADIO_TX);
+            ProfileScope profile(CyclePhase::TX);
+            ret = lora_send(dev_, data, length);
+        }
+
+        if (IS_ENABLED(CONFIG_LORAGRO_FRAME_TRACE))
+        {
+            FrameTrace::instance().record(TraceKind::TX, data, length, ret, 0, 0,
+                                          static_cast<uint16_t>(calculate_airtime_ms(static_cast<uint8_t>(length))));
+        }
+        return ret;
     }
 
     int Interface::receive(uint8_t *buffer, size_t max_length)
@@ -50,12 +67,19 @@ namespace loragro
         if (!buffer || max_length == 0)
             return -EINVAL;
 
-        return lora_recv(dev_,
-                         buffer,
-                         static_cast<uint8_t>(max_length),
-                         compute_rx_timeout(max_length),
-                         &last_rssi_,
-                         &last_snr_);
+        EnergyScope energy(EnergyComponent::RADIO_RX);
+        int ret = lora_recv(dev_,
+                            buffer,
+                            static_cast<uint8_t>(max_length),
+                            compute_rx_timeout(max_length),
+                            &last_rssi_,
+                            &last_snr_);
+
+        if (ret > 0)
+            TimeManager::mark_rx();
+
+        trace_rx(TraceKind::RX, buffer, ret, ret);
+        return ret;
     }
 
     /* =========================================================
@@ -82,6 +106,8 @@ namespace loragro
             if (ret < 0)
                 return ret;
 
+            ProfileScope profile(CyclePhase::ACK_WAIT);
+
             float tx_time = calculate_airtime_ms(len);
             LOG_DBG("sleep for tx airtime: timeout=%u ms", static_cast<uint32_t>(tx_time));
 
@@ -160,6 +186,7 @@ namespace loragro
 
         LOG_DBG("wait_for_ack: timeout=%u ms", timeout_ms);
 
+        EnergyScope energy(EnergyComponent::RADIO_RX);
         int ret = lora_recv(dev_,
                             buffer,
                             sizeof(buffer),
@@ -167,13 +194,29 @@ namespace loragro
                             &last_rssi_,
                             &last_snr_);
 
-        if (ret <= 0)
-            return -ETIMEDOUT;
+        int result = -ETIMEDOUT;
+        if (ret > 0)
+            result = is_valid_ack(buffer, ret, expected_ctr) ? 0 : -EIO;
 
-        if (is_valid_ack(buffer, ret, expected_ctr))
-            return 0;
+        trace_rx(TraceKind::ACK, buffer, ret, result);
+        return result;
+    }
+
+    void Interface::trace_rx(TraceKind kind, const uint8_t *buffer, int received, int result)
+    {
+        if (!IS_ENABLED(CONFIG_LORAGRO_FRAME_TRACE))
+            return;
+
+        /* RSSI / SNR of an empty window are stale from the last frame */
+        if (received <= 0)
+        {
+            FrameTrace::instance().record(kind, nullptr, 0, result);
+            return;
+        }
 
-        return -EIO;
+        FrameTrace::instance().record(kind, buffer, static_cast<size_t>(received), result,
+                                      last_rssi_, last_snr_,
+                                      static_cast<uint16_t>(calculate_airtime_ms(static_cast<uint8_t>(received))));
     }
 
     bool Interface::is_valid_ack(const uint8_t *buffer, size_t len, uint8_t expected_ctr)
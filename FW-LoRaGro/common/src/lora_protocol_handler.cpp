@@ -1,8 +1,9 @@
 #include "lora/lora_protocol_handler.hpp"
 #include "lora/lora_protocol.hpp"
 #include "time_manager.hpp"
+#include "soil_calibration_store.hpp"
 
-LOG_MODULE_REGISTER(lora_protocol_handler, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(lora_protocol_handler, CONFIG_LORAGRO_LORA_LOG_LEVEL);
 
 namespace loragro
 {
@@ -10,10 +11,13 @@ namespace loragro
     DecodeResult ProtocolHandler::decode(const uint8_t *data,
                                          const uint8_t data_len)
     {
+        static_assert(schema_is_valid(),
+                      "CONFIG command schema must cover every MessageOp in order with a handler and sane lengths");
+
         if (!data)
             return DecodeResult::INVALID_LENGTH;
 
-        if (data_len < FrameLayout::HEADER_SIZE + 2 + AUTH_TAG_SIZE)
+        if (data_len < FrameLayout::FIRST_CMD + AUTH_TAG_SIZE)
             return DecodeResult::INVALID_LENGTH;
 
         if (data[FrameLayout::FRAME_TYPE] != static_cast<uint8_t>(FrameType::CONFIG))
@@ -27,12 +31,8 @@ namespace loragro
         if (frame_id != dev_cfg.combined_id)
             return DecodeResult::DIFFERENT_ID;
 
-        uint8_t frame_ctr = data[FrameLayout::FRAME_CTR];
-        (void)frame_ctr;
-
-        size_t offset = FrameLayout::HEADER_SIZE;
-        uint8_t command_count = data[offset++];
-        uint8_t msg_protocol_version = data[offset++];
+        const uint8_t command_count = data[FrameLayout::CMD_COUNT];
+        const uint8_t msg_protocol_version = data[FrameLayout::PROTOCOL_VERSION];
 
         if (msg_protocol_version != PROTOCOL_VERSION)
             return DecodeResult::PROTOCOL_MISMATCH;
@@ -42,30 +42,38 @@ namespace loragro
 
         const size_t auth_start = data_len - AUTH_TAG_SIZE;
 
+        /* Pass 1: validate every command against the schema before touching config,
+         * so a malformed tail never leaves the batch half applied */
+        size_t offset = FrameLayout::FIRST_CMD;
         for (uint8_t i = 0; i < command_count; ++i)
         {
             if (offset >= auth_start)
                 return DecodeResult::INVALID_LENGTH;
 
-            uint8_t cmd_raw = data[offset++];
-            uint8_t cmd_id = decode_cmd_id(cmd_raw);
-            uint8_t encoded_size = decode_cmd_size(cmd_raw);
-            uint8_t cmd_payload_len = payload_size(encoded_size);
-
-            if (cmd_payload_len == 0)
-                return DecodeResult::INVALID_LENGTH;
+            const uint8_t cmd_id = data[offset++];
 
-            if (offset + cmd_payload_len > auth_start)
+            uint16_t cmd_payload_len = 0;
+            const size_t len_bytes = read_varint(data, offset, auth_start, cmd_payload_len);
+            if (len_bytes == 0)
                 return DecodeResult::INVALID_LENGTH;
+            offset += len_bytes;
 
-            if (cmd_id >= dispatch_table_size_ || dispatch_table[cmd_id] == nullptr)
+            if (cmd_id >= command_table_size_)
                 return DecodeResult::UNKNOWN_COMMAND;
 
-            const uint8_t *cmd_payload = &data[offset];
-            DecodeResult res = (this->*dispatch_table[cmd_id])(cmd_payload, cmd_payload_len);
+            const CommandSchema &schema = command_table[cmd_id];
+            if (cmd_payload_len < schema.min_len || cmd_payload_len > schema.max_len)
+                return DecodeResult::INVALID_LENGTH;
 
-            if (res != DecodeResult::OK)
-                return res;
+            if (offset + cmd_payload_len > auth_start)
+                return DecodeResult::INVALID_LENGTH;
+
+            if (schema.validate)
+            {
+                const DecodeResult res = schema.validate(&data[offset], static_cast<uint8_t>(cmd_payload_len));
+                if (res != DecodeResult::OK)
+                    return res;
+            }
 
             offset += cmd_payload_len;
         }
@@ -73,10 +81,29 @@ namespace loragro
         if (offset != auth_start)
             return DecodeResult::INVALID_LENGTH;
 
-        const uint8_t *received_tag = &data[auth_start];
-        (void)received_tag;
+        /* Pass 2: execute, structure and values are known to be sound */
+        bool reboot_needed = false;
+        offset = FrameLayout::FIRST_CMD;
+        for (uint8_t i = 0; i < command_count; ++i)
+        {
+            const uint8_t cmd_id = data[offset++];
 
-        return DecodeResult::OK;
+            uint16_t cmd_payload_len = 0;
+            offset += read_varint(data, offset, auth_start, cmd_payload_len);
+
+            const uint8_t *cmd_payload = &data[offset];
+            const DecodeResult res = (this->*command_table[cmd_id].handler)(
+                cmd_payload, static_cast<uint8_t>(cmd_payload_len));
+
+            if (res == DecodeResult::OK_AND_REBOOT_NEED)
+                reboot_needed = true;
+            else if (res != DecodeResult::OK)
+                return res;
+
+            offset += cmd_payload_len;
+        }
+
+        return reboot_needed ? DecodeResult::OK_AND_REBOOT_NEED : DecodeResult::OK;
     }
 
     /* =========================================================
@@ -86,9 +113,6 @@ namespace loragro
     DecodeResult ProtocolHandler::handle_set_combined_id(const uint8_t *data,
                                                          uint8_t data_len)
     {
-        if (data_len < 2)
-            return DecodeResult::INVALID_LENGTH;
-
         uint16_t new_combined_id = read_u16_le(data, 0);
 
         DeviceConfig &cfg = cfg_.get();
@@ -104,12 +128,7 @@ namespace loragro
     DecodeResult ProtocolHandler::handle_sampling_interval(const uint8_t *data,
                                                            uint8_t data_len)
     {
-        if (data_len != 1)
-        {
-            return DecodeResult::INVALID_LENGTH;
-        }
-
-        DeviceConfig cfg = cfg_.get();
+        DeviceConfig &cfg = cfg_.get();
         cfg.sample_interval_minutes = static_cast<uint8_t>(*data);
         LOG_DBG("Sampling interval set to: %d minutes", cfg.sample_interval_minutes);
         return DecodeResult::OK;
@@ -124,9 +143,6 @@ namespace loragro
     DecodeResult ProtocolHandler::handle_set_unix_time(const uint8_t *data,
                                                        uint8_t data_len)
     {
-        if (data_len != 8)
-            return DecodeResult::INVALID_LENGTH;
-
         uint64_t unix_time = 0;
         for (size_t i = 0; i < data_len; i++)
             unix_time |= static_cast<uint64_t>(data[i]) << (i * 8); // LE
@@ -135,12 +151,22 @@ namespace loragro
         return DecodeResult::OK;
     }
 
-    DecodeResult ProtocolHandler::handle_lora_config(const uint8_t *data, const uint8_t payload_ctr)
+    DecodeResult ProtocolHandler::handle_set_unix_time_ms(const uint8_t *data,
+                                                          uint8_t data_len)
     {
-        if (payload_ctr != 10)
-            return DecodeResult::INVALID_LENGTH;
+        const uint64_t unix_ms = static_cast<uint64_t>(read_u32_le(data, 0)) |
+                                 (static_cast<uint64_t>(read_u32_le(data, 4)) << 32);
+
+        /* Gateway stamps end of its TX, which is our RX done instant */
+        TimeManager::sync_unix_time_ms(unix_ms, TimeManager::sync_reference_ms());
 
-        DeviceConfig cfg = cfg_.get();
+        LOG_DBG("Time synced (ms), drift estimate: %d ppb", TimeManager::drift_ppb());
+        return DecodeResult::OK;
+    }
+
+    DecodeResult ProtocolHandler::handle_lora_config(const uint8_t *data, const uint8_t payload_ctr)
+    {
+        DeviceConfig &cfg = cfg_.get();
 
         size_t pos = 0;
         cfg.lora.frequency = read_u32_le(&data[0], pos);
@@ -150,8 +176,10 @@ namespace loragro
         cfg.lora.coding_rate = static_cast<lora_coding_rate>(data[pos++]);
         cfg.lora.preamble_len = static_cast<uint8_t>(data[pos++]);
         cfg.lora.tx_power = static_cast<int8_t>(data[pos++]);
-        cfg.lora.tx = data[pos++];
-        cfg.lora.iq_inverted = data[pos++];
+
+        const uint8_t flags = data[pos++];
+        cfg.lora.tx = (flags & 0x01) != 0;
+        cfg.lora.iq_inverted = (flags & 0x02) != 0;
 
         if (cfg_.save() < 0)
             return DecodeResult::FLASH_FAILED;
@@ -159,4 +187,120 @@ namespace loragro
         return DecodeResult::OK_AND_REBOOT_NEED;
     }
 
+    /* =========================================================
+     * SET_TDMA_SLOT
+     * ---------------------------------------------------------
+     * [0]     interval_minutes  - interval grid the slot is for
+     * [1..2]  slot_index        - compact index (LE)
+     * [3..4]  width_ms          - window reserved for node (LE), 0 = clear
+     * [5..8]  offset_ms         - slot start from interval start (LE)
+     * ========================================================= */
+    DecodeResult ProtocolHandler::validate_tdma_slot(const uint8_t *data,
+                                                     uint8_t data_len)
+    {
+        const uint32_t interval_ms = static_cast<uint32_t>(data[0]) * 60 * 1000;
+        const uint32_t width_ms = read_u16_le(data, 3);
+        const uint32_t offset_ms = read_u32_le(data, 5);
+
+        /* offset + width could wrap in 32 bits */
+        if (interval_ms == 0 || width_ms > interval_ms || offset_ms > interval_ms - width_ms)
+            return DecodeResult::INVALID_VALUE;
+
+        return DecodeResult::OK;
+    }
+
+    DecodeResult ProtocolHandler::handle_set_tdma_slot(const uint8_t *data,
+                                                       uint8_t data_len)
+    {
+        TdmaSlot slot{};
+        slot.interval_minutes = data[0];
+        slot.slot_index = read_u16_le(data, 1);
+        slot.width_ms = read_u16_le(data, 3);
+        slot.offset_ms = read_u32_le(data, 5);
+
+        DeviceConfig &cfg = cfg_.get();
+
+        /* Same interval replaces, otherwise first free entry, otherwise evict first */
+        TdmaSlot *target = &cfg.tdma_slots[0];
+        for (auto &entry : cfg.tdma_slots)
+        {
+            if (entry.interval_minutes == slot.interval_minutes)
+            {
+                target = &entry;
+                break;
+            }
+            if (entry.interval_minutes == 0 && target->interval_minutes != 0)
+                target = &entry;
+        }
+
+        if (slot.width_ms == 0)
+        {
+            /* Clear assignment, node returns to node_id based slot */
+            if (target->interval_minutes == slot.interval_minutes)
+                *target = TdmaSlot{};
+            return DecodeResult::OK;
+        }
+
+        *target = slot;
+
+        LOG_DBG("TDMA slot %u for %u min interval: offset %u ms, width %u ms",
+                slot.slot_index, slot.interval_minutes, slot.offset_ms, slot.width_ms);
+
+        return DecodeResult::OK;
+    }
+
+    /* =========================================================
+     * SET_SOIL_CALIB
+     * ---------------------------------------------------------
+     * [0]     probe
+     * [1]     count             - points that follow
+     * [2..]   count * [mv u16 LE][moisture %]
+     * ========================================================= */
+    uint8_t ProtocolHandler::read_soil_calib(const uint8_t *data, SoilLutPoint *points)
+    {
+        const uint8_t count = data[1];
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            const uint8_t off = SOIL_CALIB_HEADER + i * SOIL_CALIB_POINT_SIZE;
+            points[i].mv = static_cast<int16_t>(read_u16_le(data, off));
+            points[i].moisture = data[off + 2];
+        }
+        return count;
+    }
+
+    DecodeResult ProtocolHandler::validate_soil_calib(const uint8_t *data,
+                                                      uint8_t data_len)
+    {
+        const uint8_t probe = data[0];
+        const uint8_t count = data[1];
+
+        if (data_len != SOIL_CALIB_HEADER + count * SOIL_CALIB_POINT_SIZE)
+            return DecodeResult::INVALID_LENGTH;
+
+        SoilLutPoint points[SoilSensorConstants::SOIL_CALIB_MAX_POINTS]{};
+        read_soil_calib(data, points);
+
+        if (probe >= SoilCalibrationStore::MAX_PROBES ||
+            !SoilCalibration::points_valid(points, count))
+            return DecodeResult::INVALID_VALUE;
+
+        return DecodeResult::OK;
+    }
+
+    DecodeResult ProtocolHandler::handle_set_soil_calib(const uint8_t *data,
+                                                        uint8_t data_len)
+    {
+        const uint8_t probe = data[0];
+
+        SoilLutPoint points[SoilSensorConstants::SOIL_CALIB_MAX_POINTS]{};
+        const uint8_t count = read_soil_calib(data, points);
+
+        /* Own NVS record, adapters rebuild their table on next sample */
+        if (SoilCalibrationStore::store(probe, points, count) != 0)
+            return DecodeResult::FLASH_FAILED;
+
+        LOG_DBG("Soil probe %u calibration: %u points", probe, count);
+        return DecodeResult::OK;
+    }
+
 } // namespace loragro
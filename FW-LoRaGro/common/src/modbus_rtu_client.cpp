@@ -0,0 +1,129 @@
+#include "modbus/modbus_rtu.hpp"
+
+#include <cerrno>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+
+LOG_MODULE_REGISTER(modbus_rtu, CONFIG_LORAGRO_SAMPLING_LOG_LEVEL);
+
+namespace loragro
+{
+    ModbusRtuClient::ModbusRtuClient(ModbusTransport &transport, uint32_t baudrate,
+                                     uint32_t response_timeout_ms)
+        : transport_(transport),
+          baudrate_(baudrate),
+          response_timeout_ms_(response_timeout_ms),
+          gap_us_(modbus::t35_us(baudrate))
+    {
+    }
+
+    int ModbusRtuClient::read_holding_registers(uint8_t slave, uint16_t start,
+                                                uint16_t count, uint16_t *regs)
+    {
+        return read_registers(modbus::READ_HOLDING_REGISTERS, slave, start, count, regs,
+                              response_timeout_ms_);
+    }
+
+    int ModbusRtuClient::read_input_registers(uint8_t slave, uint16_t start,
+                                              uint16_t count, uint16_t *regs)
+    {
+        return read_registers(modbus::READ_INPUT_REGISTERS, slave, start, count, regs,
+                              response_timeout_ms_);
+    }
+
+    bool ModbusRtuClient::probe(uint8_t slave, uint16_t reg)
+    {
+        uint16_t value;
+        const int ret = read_registers(modbus::READ_HOLDING_REGISTERS, slave, reg, 1, &value,
+                                       PROBE_TIMEOUT_MS);
+        return ret == 0 || ret == -EREMOTEIO;
+    }
+
+    /* =========================
+     * Transaction
+     * ========================= */
+
+    int ModbusRtuClient::read_registers(uint8_t fc, uint8_t slave, uint16_t start,
+                                        uint16_t count, uint16_t *regs,
+                                        uint32_t response_timeout_ms)
+    {
+        /* Reads need an answer, broadcast gets none */
+        if (slave == modbus::BROADCAST_ADDR || slave > modbus::MAX_SLAVE_ADDR)
+            return -EINVAL;
+        if (count == 0 || count > modbus::MAX_READ_REGISTERS || !regs)
+            return -EINVAL;
+
+        uint8_t tx[modbus::READ_REQUEST_LEN];
+        tx[0] = slave;
+        tx[1] = fc;
+        sys_put_be16(start, &tx[2]);
+        sys_put_be16(count, &tx[4]);
+        sys_put_le16(modbus::crc16(tx, 6), &tx[6]);
+
+        wait_frame_gap();
+
+        /* Answer must arrive within the timeout after our frame left the line */
+        const uint32_t timeout_ms = response_timeout_ms +
+                                    modbus::frame_us(baudrate_, sizeof(tx) + modbus::read_response_len(count)) / 1000 + 1;
+
+        const int rx_len = transport_.transceive(tx, sizeof(tx), rx_buf_,
+                                                 modbus::read_response_len(count), timeout_ms);
+        last_frame_end_ticks_ = k_uptime_ticks();
+        transactions_++;
+
+        const int ret = rx_len < 0 ? rx_len : parse_read_response(fc, slave, rx_buf_, rx_len, count, regs);
+        if (ret)
+        {
+            failures_++;
+            /* Silence is normal while scanning the bus */
+            if (ret == -ETIMEDOUT)
+                LOG_DBG("Slave %u: no answer", slave);
+            else
+                LOG_WRN("Slave %u fc 0x%02x @%u x%u failed: %d", slave, fc, start, count, ret);
+        }
+        return ret;
+    }
+
+    int ModbusRtuClient::parse_read_response(uint8_t fc, uint8_t slave, const uint8_t *rx,
+                                             int rx_len, uint16_t count, uint16_t *regs)
+    {
+        if (rx_len < static_cast<int>(modbus::EXCEPTION_LEN))
+            return -EBADMSG;
+
+        const size_t len = static_cast<size_t>(rx_len);
+        if (modbus::crc16(rx, len - 2) != sys_get_le16(&rx[len - 2]))
+            return -EBADMSG;
+
+        /* Some other slave answered (address clash) */
+        if (rx[0] != slave)
+            return -EBADMSG;
+
+        if (rx[1] == (fc | modbus::EXCEPTION_FLAG) && len == modbus::EXCEPTION_LEN)
+        {
+            last_exception_ = rx[2];
+            return -EREMOTEIO;
+        }
+
+        if (rx[1] != fc || len != modbus::read_response_len(count) || rx[2] != 2 * count)
+            return -EBADMSG;
+
+        for (uint16_t i = 0; i < count; ++i)
+            regs[i] = sys_get_be16(&rx[3 + 2 * i]);
+
+        return 0;
+    }
+
+    void ModbusRtuClient::wait_frame_gap() const
+    {
+        if (last_frame_end_ticks_ == 0)
+            return;
+
+        const uint64_t since_us = k_ticks_to_us_floor64(k_uptime_ticks() - last_frame_end_ticks_);
+        if (since_us >= gap_us_)
+            return;
+
+        /* At most a few ms (4 ms at 9600 baud), a tick based sleep would overshoot */
+        k_busy_wait(gap_us_ - static_cast<uint32_t>(since_us));
+    }
+
+} // namespace loragro
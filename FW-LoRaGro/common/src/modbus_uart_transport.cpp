@@ -0,0 +1,175 @@
+#include "modbus/modbus_uart_transport.hpp"
+
+#include <cerrno>
+#include <zephyr/logging/log.h>
+#include <zephyr/pm/device.h>
+
+LOG_MODULE_REGISTER(modbus_uart, CONFIG_LORAGRO_SAMPLING_LOG_LEVEL);
+
+namespace loragro
+{
+    ModbusUartTransport::ModbusUartTransport(const struct device *uart, uint32_t baudrate)
+        : uart_(uart), baudrate_(baudrate)
+    {
+        k_sem_init(&tx_done_, 0, 1);
+        k_sem_init(&rx_done_, 0, 1);
+    }
+
+    int ModbusUartTransport::init()
+    {
+        if (initialized_)
+            return 0;
+
+        if (!device_is_ready(uart_))
+            return -ENODEV;
+
+        int ret = uart_callback_set(uart_, uart_cb, this);
+        if (ret)
+        {
+            LOG_ERR("UART async API not available: %d", ret);
+            return ret;
+        }
+
+#ifdef CONFIG_PM_DEVICE
+        /* Powered only during transactions */
+        pm_device_action_run(uart_, PM_DEVICE_ACTION_SUSPEND);
+#endif
+
+        initialized_ = true;
+        return 0;
+    }
+
+    /* =========================
+     * Transaction
+     * ========================= */
+
+    int ModbusUartTransport::transceive(const uint8_t *tx, size_t tx_len,
+                                        uint8_t *rx, size_t rx_len,
+                                        uint32_t timeout_ms)
+    {
+        if (session_open_)
+            return transfer(tx, tx_len, rx, rx_len, timeout_ms);
+
+        int ret = open();
+        if (ret)
+            return ret;
+
+        ret = transfer(tx, tx_len, rx, rx_len, timeout_ms);
+        close();
+        return ret;
+    }
+
+    int ModbusUartTransport::open()
+    {
+        int ret = init();
+        if (ret)
+            return ret;
+
+#ifdef CONFIG_PM_DEVICE
+        pm_device_action_run(uart_, PM_DEVICE_ACTION_RESUME);
+#endif
+        session_open_ = true;
+        return 0;
+    }
+
+    void ModbusUartTransport::close()
+    {
+        if (!session_open_)
+            return;
+
+#ifdef CONFIG_PM_DEVICE
+        pm_device_action_run(uart_, PM_DEVICE_ACTION_SUSPEND);
+#endif
+        session_open_ = false;
+    }
+
+    int ModbusUartTransport::transfer(const uint8_t *tx, size_t tx_len,
+                                      uint8_t *rx, size_t rx_len,
+                                      uint32_t timeout_ms)
+    {
+        k_sem_reset(&tx_done_);
+        k_sem_reset(&rx_done_);
+        rx_count_ = 0;
+        rx_expected_ = rx_len;
+        tx_status_ = -ETIMEDOUT; // until TX_DONE
+
+        /* Armed before TX, a fast slave may answer right after our last stop bit */
+        int ret = uart_rx_enable(uart_, rx, rx_len, modbus::t15_us(baudrate_));
+        if (ret)
+            return ret;
+
+        ret = uart_tx(uart_, tx, tx_len, SYS_FOREVER_US);
+        if (ret == 0)
+        {
+            if (k_sem_take(&tx_done_, K_MSEC(modbus::frame_us(baudrate_, tx_len) / 1000 + TX_MARGIN_MS)) != 0)
+            {
+                /* Stuck TX: stop the driver before the caller reuses tx, TX_ABORTED ends it */
+                uart_tx_abort(uart_);
+                k_sem_take(&tx_done_, K_MSEC(TX_MARGIN_MS));
+                tx_status_ = -ETIMEDOUT;
+            }
+            ret = tx_status_;
+        }
+
+        /* RX_DISABLED: full frame, end of frame gap or the disable below */
+        if (ret || k_sem_take(&rx_done_, K_MSEC(timeout_ms)) != 0)
+        {
+            uart_rx_disable(uart_);
+            k_sem_take(&rx_done_, K_MSEC(TX_MARGIN_MS));
+        }
+
+        if (ret)
+            return ret;
+
+        return rx_count_ > 0 ? static_cast<int>(rx_count_) : -ETIMEDOUT;
+    }
+
+    /* =========================
+     * UART events (ISR)
+     * ========================= */
+
+    void ModbusUartTransport::uart_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+    {
+        ARG_UNUSED(dev);
+        static_cast<ModbusUartTransport *>(user_data)->on_event(evt);
+    }
+
+    void ModbusUartTransport::on_event(const struct uart_event *evt)
+    {
+        switch (evt->type)
+        {
+        case UART_TX_DONE:
+            tx_status_ = 0;
+            k_sem_give(&tx_done_);
+            break;
+
+        case UART_TX_ABORTED:
+            tx_status_ = -EIO;
+            k_sem_give(&tx_done_);
+            break;
+
+        case UART_RX_RDY:
+            rx_count_ = evt->data.rx.offset + evt->data.rx.len;
+            /* RX_RDY before the buffer is full means a t1.5 gap: frame ended */
+            if (rx_count_ < rx_expected_)
+                uart_rx_disable(uart_);
+            break;
+
+        case UART_RX_BUF_REQUEST:
+            /* Single buffer per frame, RX stops when it is full */
+            break;
+
+        case UART_RX_STOPPED:
+            LOG_WRN("RX stopped: reason %d", evt->data.rx_stop.reason);
+            break;
+
+        case UART_RX_DISABLED:
+            k_sem_give(&rx_done_);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+} // namespace loragro
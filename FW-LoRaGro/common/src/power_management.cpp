@@ -1,135 +1,159 @@
-
 #include "power_management.hpp"
-#include "lora/lora_interface.hpp"
+#include "cycle_profiler.hpp"
+
+#include <zephyr/pm/device.h>
 
-LOG_MODULE_REGISTER(power_manager, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(power_manager, CONFIG_LORAGRO_POWER_LOG_LEVEL);
 namespace loragro
 {
+    int32_t PowerManagement::read_battery_mv()
+    {
+        if (battery_.sample() != 0)
+            return 0;
+
+        return battery_.measurements()[0].value.val1;
+    }
+
     int PowerManagement::handle_sleep()
     {
-        // Calculate time frame offset of this node
-        const uint16_t node_id = (dev_cfg_.combined_id >> 5) & 0xFFFF;
-        /* 2x Tx frame + 1 Rx frame + 2x Ack and margin */
-        float tx_time_window = static_cast<float>(dev_cfg_.max_tx_frames_per_cycle) *
-                               calculate_airtime_s(dev_cfg_, get_max_payload(dev_cfg_)); /* MAX 2 TX frames */
-
-        float rx_time_window = calculate_airtime_s(dev_cfg_, get_max_payload(dev_cfg_)); /* MAX 1 RX frame */
-        float ack_time_window = static_cast<float>(dev_cfg_.max_tx_frames_per_cycle + 1) *
-                                calculate_airtime_s(dev_cfg_, FrameLayout::RESPONSE_FRAME_SIZE); /* Max 3 ACK/Responses*/
-
-        float node_tdma_window = static_cast<uint32_t>((tx_time_window + rx_time_window + ack_time_window) *
-                                                       dev_cfg_.air_time_margin_factor);
-        const uint32_t node_sleep_time_offset_s = node_tdma_window * node_id;
-
-        // If no battery sensor is available, fall back to normal sleep interval
-        if (battery_sense_id_ < 0)
+        const int32_t battery_mv = read_battery_mv();
+
+        // If measurement failed or invalid, fall back to normal interval
+        if (battery_mv <= 0)
         {
-            LOG_WRN("Battery sensor not available, using normal sleep interval");
-            k_sleep(K_MINUTES(dev_cfg_.sample_interval_minutes));
-            return 0;
+            LOG_WRN("Battery measurement invalid, fallback to normal interval");
+            wake_ = WakeInfo{WakeReason::SLOT, 0, 0, 0};
+            return scheduler_.sleep_until_next_slot(dev_cfg_.sample_interval_minutes);
         }
 
-        // Take a single battery measurement
-        const auto meas = sample_mgr_.sample_one(battery_sense_id_);
+        /* Radio and sensor rail are already off, only the MCU loads the battery */
+        estimator_.update(battery_mv,
+                          EnergyLedger::current_ua(EnergyComponent::MCU_ACTIVE) +
+                              EnergyLedger::current_ua(EnergyComponent::SAMPLING));
+
+        const EnergyLedger &ledger = EnergyLedger::instance();
+        if (ledger.valid())
+            estimator_.account_cycle(ledger.last_report());
 
-        // If measurement failed or invalid, fall back to normal sleep
-        if (meas.value.val1 <= 0)
+        // Recovery mode if battery is below cutoff threshold
+        if (estimator_.ocv_mv() < dev_cfg_.battery_cutoff_mv)
         {
-            LOG_WRN("Battery measurement invalid, fallback to normal sleep");
-            k_sleep(K_MINUTES(dev_cfg_.sample_interval_minutes));
-            return 0;
+            recovery_mode();
+
+            /* Re-align to own slot instead of waking at an arbitrary point of the interval */
+            return scheduler_.sleep_until_next_slot(dev_cfg_.sample_interval_minutes);
         }
 
-        // Deep sleep mode if battery is below cutoff threshold
-        if (meas.value.val1 < dev_cfg_.battery_cutoff_mv)
+        /* Skip slots on the sample interval grid until the lifetime target is met */
+        const uint8_t stride = estimator_.interval_stride();
+        const uint16_t soc = estimator_.soc_permille();
+
+        LOG_INF("Battery %d mV (OCV %d mV, SoC %u.%u %%, TX sag to %d mV)",
+                battery_mv, estimator_.ocv_mv(), soc / 10, soc % 10, estimator_.tx_voltage_mv());
+        LOG_INF("Interval %u x %u min, avg %u uA, %u h to cutoff",
+                stride, dev_cfg_.sample_interval_minutes,
+                estimator_.avg_current_ua(stride), estimator_.hours_to_cutoff(stride));
+
+        wake_ = WakeInfo{WakeReason::SLOT, battery_mv, 0, 0};
+        return scheduler_.sleep_until_next_slot(dev_cfg_.sample_interval_minutes, stride);
+    }
+
+    /* =========================================================
+     * Recovery mode
+     * ---------------------------------------------------------
+     * Sensor rail is off, radio is suspended, only the RTC (kernel
+     * timeout) and the ADC stay in use. The battery is read AFTER
+     * each wake-up so a recovered battery is seen right away, and
+     * the check interval backs off exponentially because a battery
+     * below cutoff rarely recovers within minutes. A failed reading
+     * is unknown, not low: after RECOVERY_MAX_FAILED_READS of them in
+     * a row the node leaves recovery and handle_sleep() falls back to
+     * the normal interval, as it does for a failed reading there.
+     * ========================================================= */
+    void PowerManagement::recovery_mode()
+    {
+        const int32_t exit_mv = dev_cfg_.battery_cutoff_mv + RECOVERY_HYSTERESIS_MV;
+        const uint32_t max_check_min = MAX(static_cast<uint32_t>(dev_cfg_.critically_low_battery_timeout_hours) * 60,
+                                           RECOVERY_FIRST_CHECK_MIN);
+
+        uint32_t check_min = RECOVERY_FIRST_CHECK_MIN;
+        uint32_t elapsed_min = 0;
+        uint8_t checks = 0;
+        uint8_t failed_reads = 0;
+        int32_t battery_mv = 0;
+
+        LOG_WRN("Battery critically low: OCV %d mV, entering recovery mode", estimator_.ocv_mv());
+
+        suspend_peripherals();
+        CycleProfiler::instance().end_cycle();
+
+        while (true)
         {
-            while (true)
-            {
-                auto battery_meas = sample_mgr_.sample_one(battery_sense_id_);
+            LOG_DBG("Recovery: next check in %u min", check_min);
+            k_sleep(K_MINUTES(check_min));
+            elapsed_min += check_min;
 
-                LOG_WRN("Battery critically low: %d mV, entering deep sleep", battery_meas.value.val1);
-                k_sleep(K_HOURS(dev_cfg_.critically_low_battery_timeout_hours));
+            battery_mv = read_battery_mv();
+            if (checks < UINT8_MAX)
+                checks++;
 
-                // Check battery after deep sleep
-                if (battery_meas.value.val1 >= dev_cfg_.battery_cutoff_mv)
-                {
-                    LOG_INF("Battery recovered: %d mV, resuming normal operation", battery_meas.value.val1);
+            if (battery_mv <= 0)
+            {
+                if (++failed_reads >= RECOVERY_MAX_FAILED_READS)
                     break;
-                }
-            }
-        }
-        else
-        {
-            // Choose sleep interval based on battery level
-            uint32_t sleep_min = (meas.value.val1 < dev_cfg_.battery_critical_mv)
-                                     ? dev_cfg_.sample_interval_min_low_battery
-                                     : dev_cfg_.sample_interval_minutes;
 
-            // Convert minutes to milliseconds and add airtime offset
-            uint64_t sleep_time_s = static_cast<uint64_t>(sleep_min) * 60;
-            sleep_time_s += node_sleep_time_offset_s;
+                LOG_WRN("Recovery: battery reading failed after %u min (%u in a row)", elapsed_min, failed_reads);
+                check_min = MIN(check_min * 2, max_check_min);
+                continue;
+            }
+            failed_reads = 0;
 
-            LOG_DBG("Sleeping for %llu ms (battery level: %d mV)", sleep_time_s, meas.value.val1);
+            if (battery_mv >= exit_mv)
+                break;
 
-            // Use Zephyr kernel sleep API
-            k_sleep(K_SECONDS(static_cast<uint32_t>(sleep_time_s)));
+            LOG_WRN("Recovery: battery %d mV after %u min, below %d mV", battery_mv, elapsed_min, exit_mv);
+            check_min = MIN(check_min * 2, max_check_min);
         }
 
-        return 0;
-    }
-
-    /**
-     * @brief Calculate the estimated airtime of a LoRa packet in milliseconds
-     *
-     * This uses the LoRa modulation parameters: SF, bandwidth, preamble length,
-     * coding rate, and payload length to estimate how long the packet will occupy
-     * the channel. Used to add a safe sleep offset.
-     */
+        resume_peripherals();
 
-    const float PowerManagement::calculate_airtime_s(const DeviceConfig &cfg, const uint8_t payload_len)
-    {
-        const uint8_t sf = static_cast<uint8_t>(cfg.lora.datarate);
+        /* Pre-outage voltage history says nothing about a recharged battery */
+        estimator_.reset();
 
-        const float bw = cfg.lora.bandwidth; // Bandwidth in Hz
-        const float tsym = (1UL << sf) / bw; // Symbol duration in seconds
-        const uint8_t preamble = cfg.lora.preamble_len;
-        const float tpreamble = (preamble + 4.25f) * tsym;
+        if (battery_mv <= 0)
+        {
+            wake_ = WakeInfo{WakeReason::BATTERY_UNKNOWN, 0, elapsed_min * 60, checks};
+            LOG_WRN("Battery unreadable %u times in a row after %u min, leaving recovery mode",
+                    failed_reads, elapsed_min);
+            return;
+        }
 
-        const uint8_t de = (sf >= 11) ? 1 : 0;   // Low data rate optimization
-        const uint8_t cr = cfg.lora.coding_rate; // LoRa coding rate (1–4 for 4/5..4/8)
+        estimator_.update(battery_mv, EnergyLedger::current_ua(EnergyComponent::MCU_ACTIVE) +
+                                          EnergyLedger::current_ua(EnergyComponent::SAMPLING));
 
-        // Compute number of symbols for payload
-        float tmp = (8.0f * payload_len - 4.0f * sf + 28.0f + 16.0f - 20.0f) / (4.0f * (sf - 2.0f * de));
-        if (tmp < 0)
-            tmp = 0;
+        wake_ = WakeInfo{WakeReason::BATTERY_RECOVERED, battery_mv, elapsed_min * 60, checks};
 
-        float payloadSymbNb = 8.0f + ceilf(tmp) * (cr + 4);
+        LOG_INF("Battery recovered: %d mV after %u min (%u checks), resuming normal operation",
+                battery_mv, elapsed_min, checks);
+    }
 
-        float tpacket = tpreamble + payloadSymbNb * tsym;
+    void PowerManagement::suspend_peripherals()
+    {
+        if (!radio_dev_)
+            return;
 
-        return tpacket; // seconds
+        int ret = pm_device_action_run(radio_dev_, PM_DEVICE_ACTION_SUSPEND);
+        if (ret && ret != -EALREADY)
+            LOG_DBG("Radio suspend not supported (%d)", ret);
     }
 
-    /**
-     * @brief Returns the maximum payload for the given SF.
-     *
-     * These are conservative values to ensure airtime calculations match
-     * LoRa radio limitations.
-     */
-    const uint8_t PowerManagement::get_max_payload(const DeviceConfig &cfg)
+    void PowerManagement::resume_peripherals()
     {
-        switch (cfg.lora.datarate)
-        {
-        case SF_7:
-        case SF_8:
-            return 242;
-        case SF_9:
-        case SF_10:
-            return 115;
-        case SF_11:
-        case SF_12:
-        default:
-            return 51;
-        }
+        if (!radio_dev_)
+            return;
+
+        int ret = pm_device_action_run(radio_dev_, PM_DEVICE_ACTION_RESUME);
+        if (ret && ret != -EALREADY)
+            LOG_DBG("Radio resume not supported (%d)", ret);
     }
-}
\ No newline at end of file
+}
@@ -1,11 +1,12 @@
 #include "power_rail_3v3.hpp"
+#include "energy_ledger.hpp"
 
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/regulator.h>
 #include <zephyr/logging/log.h>
 
-LOG_MODULE_REGISTER(power_rail_3v3, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(power_rail_3v3, CONFIG_LORAGRO_POWER_LOG_LEVEL);
 
 #define REGULATOR_3V3_NODE DT_NODELABEL(power_rail_3v3)
 
@@ -33,6 +34,7 @@ namespace loragro
             return ret;
         }
 
+        EnergyLedger::instance().start(EnergyComponent::SENSOR_RAIL);
         k_sleep(K_MSEC(10));
 
         PowerRail3V3::powered_ = true;
@@ -64,6 +66,7 @@ namespace loragro
             return ret;
         }
 
+        EnergyLedger::instance().stop(EnergyComponent::SENSOR_RAIL);
         PowerRail3V3::powered_ = false;
         LOG_DBG("Power rail 3V3 OFF");
 
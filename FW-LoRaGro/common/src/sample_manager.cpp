@@ -1,8 +1,11 @@
 #include "sample_manager.hpp"
+#include "energy_ledger.hpp"
+#include "time_manager.hpp"
 #include <algorithm>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
-LOG_MODULE_REGISTER(sample_manager, LOG_LEVEL_DBG);
+LOG_MODULE_REGISTER(sample_manager, CONFIG_LORAGRO_SAMPLING_LOG_LEVEL);
 
 namespace loragro
 {
@@ -18,12 +21,16 @@ namespace loragro
             return -ENOMEM;
         }
 
+        active_[sensor_count_] = true;
         sensors_[sensor_count_++] = sensor;
         return sensor_count_;
     }
 
     int SampleManager::init_all()
     {
+        failed_mask_ = 0;
+        quarantined_mask_ = 0;
+
         for (size_t i = 0; i < sensor_count_; ++i)
         {
             if (!sensors_[i])
@@ -31,55 +38,168 @@ namespace loragro
                 return -EINVAL;
             }
 
+            /* init_all() runs once per cycle, backoff counts down here */
+            if (health_[i].quarantined())
+            {
+                health_[i].skip_cycles--;
+                active_[i] = false;
+                quarantined_mask_ |= BIT(i);
+                continue;
+            }
+
+            int64_t t0 = k_uptime_get();
             int ret = sensors_[i]->init();
             if (ret)
             {
-                return ret;
+                mark_failed(i, ret, static_cast<uint16_t>(k_uptime_get() - t0));
+                continue;
             }
+            active_[i] = true;
         }
         return 0;
     }
 
+    void SampleManager::mark_failed(size_t i, int err, uint16_t latency_ms)
+    {
+        health_[i].record_failure(err, latency_ms);
+        active_[i] = false;
+        failed_mask_ |= BIT(i);
+
+        LOG_WRN("%s failed: %d (%u in a row), skipped for %u cycles",
+                sensors_[i]->getName(), err,
+                health_[i].consecutive_failures, health_[i].skip_cycles);
+    }
+
     int SampleManager::sample_all()
     {
         batch_size_ = 0; /* Need to reset every sample */
+        EnergyScope energy(EnergyComponent::SAMPLING);
+
+        /* Health entry on every outcome, its slot is kept free by sample_into_batch() */
+        int ret = sample_phases();
+        append_health_entry();
+        return ret;
+    }
+
+    int SampleManager::sample_phases()
+    {
+        /* Phase 1: start slow conversions (SCD41 single shot, 5 s) */
+        std::array<bool, MAX_SENSORS> pending{};
+        int64_t ready_at_ms = 0;
 
         for (size_t i = 0; i < sensor_count_; ++i)
         {
             if (!sensors_[i])
                 return -EINVAL;
 
-            int ret = sensors_[i]->sample();
-            if (ret)
+            if (!active_[i])
+                continue;
+
+            int ret = sensors_[i]->start();
+            if (ret < 0)
+            {
+                mark_failed(i, ret, 0);
+                continue;
+            }
+            if (ret > 0)
             {
-                return ret;
+                pending[i] = true;
+                ready_at_ms = std::max(ready_at_ms, k_uptime_get() + ret);
             }
+        }
 
-            const Measurement *m = sensors_[i]->measurements();
-            size_t n = sensors_[i]->count();
+        /* Phase 2: fast sensors, inside the conversion window */
+        int last_err = 0;
+        bool full = false;
+        for (size_t i = 0; i < sensor_count_; ++i)
+        {
+            if (!active_[i] || pending[i])
+                continue;
+
+            int ret = sample_into_batch(i);
+            if (ret == -ENOMEM)
+                full = true;
+            else if (ret)
+                last_err = ret;
+        }
 
-            /* Serializing data into batch */
-            for (size_t j = 0; j < n; ++j)
-            {
-                if (batch_size_ >= MAX_MEASUREMENT)
-                {
-                    return -ENOMEM;
-                }
+        /* Phase 3: collect slow sensors once the last one is ready */
+        if (ready_at_ms > k_uptime_get())
+        {
+            LOG_DBG("Waiting %lld ms for slow conversions", (long long)(ready_at_ms - k_uptime_get()));
+            k_sleep(K_TIMEOUT_ABS_MS(ready_at_ms));
+        }
 
-                batch_[batch_size_++] = m[j];
+        /* Read out every started conversion, even into a full batch */
+        for (size_t i = 0; i < sensor_count_; ++i)
+        {
+            if (!active_[i] || !pending[i])
+                continue;
+
+            int ret = sample_into_batch(i);
+            if (ret == -ENOMEM)
+                full = true;
+            else if (ret)
+                last_err = ret;
+        }
 
-                /* Scaling down */
-                // int16_t int_part = static_cast<int16_t>(m[j].value.val1 / 1000);
-                int16_t int_part = static_cast<int16_t>(m[j].value.val1);
-                int16_t frac_3dp = static_cast<int16_t>(m[j].value.val2 / 1000);
+        if (full)
+            return -ENOMEM;
 
-                LOG_INF("Type(Manager) %u Measurement[%u]: ID=%u value=%d.%03d ts=%u",
-                        i, j,
-                        m[j].sensor_id,
-                        int_part,
-                        frac_3dp,
-                        m[j].timestamp);
-            }
+        /* One bad sensor does not cost the batch, only an empty one is an error */
+        return batch_size_ > 0 ? 0 : last_err;
+    }
+
+    void SampleManager::append_health_entry()
+    {
+        if ((failed_mask_ | quarantined_mask_) == 0 || batch_size_ >= MAX_MEASUREMENT)
+            return;
+
+        Measurement &m = batch_[batch_size_++];
+        m.sensor_id = SensorID::DIAG_SENSOR_HEALTH;
+        m.value.val1 = static_cast<int16_t>(failed_mask_);
+        m.value.val2 = static_cast<int16_t>(quarantined_mask_);
+        m.timestamp = TimeManager::best_effort_unix_s(k_uptime_seconds());
+    }
+
+    int SampleManager::sample_into_batch(size_t i)
+    {
+        int64_t t0 = k_uptime_get();
+        int ret = sensors_[i]->sample();
+        uint16_t latency_ms = static_cast<uint16_t>(MIN(k_uptime_get() - t0, UINT16_MAX));
+        if (ret)
+        {
+            mark_failed(i, ret, latency_ms);
+            return ret;
+        }
+        health_[i].record_success(latency_ms);
+
+        const Measurement *m = sensors_[i]->measurements();
+        size_t n = sensors_[i]->count();
+
+        /* All entries of a sensor or none, the last slot stays free for the health entry */
+        if (n > static_cast<size_t>(MAX_MEASUREMENT - 1 - batch_size_))
+        {
+            LOG_WRN("%s: %u entries do not fit, batch has %u", sensors_[i]->getName(), n, batch_size_);
+            return -ENOMEM;
+        }
+
+        /* Serializing data into batch */
+        for (size_t j = 0; j < n; ++j)
+        {
+            batch_[batch_size_++] = m[j];
+
+            /* Scaling down */
+            // int16_t int_part = static_cast<int16_t>(m[j].value.val1 / 1000);
+            int16_t int_part = static_cast<int16_t>(m[j].value.val1);
+            int16_t frac_3dp = static_cast<int16_t>(m[j].value.val2 / 1000);
+
+            LOG_DBG("Type(Manager) %u Measurement[%u]: ID=%u value=%d.%03d ts=%u",
+                    i, j,
+                    m[j].sensor_id,
+                    int_part,
+                    frac_3dp,
+                    m[j].timestamp);
         }
         return 0;
     }
@@ -0,0 +1,186 @@
+#include "slot_scheduler.hpp"
+#include "time_manager.hpp"
+#include "lora/lora_protocol.hpp"
+#include "cycle_profiler.hpp"
+
+#include <cmath>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(slot_scheduler, CONFIG_LORAGRO_POWER_LOG_LEVEL);
+
+namespace loragro
+{
+    const TdmaSlot *SlotScheduler::assigned_slot(uint32_t interval_min) const
+    {
+        for (const auto &slot : dev_cfg_.tdma_slots)
+        {
+            if (slot.interval_minutes != 0 && slot.interval_minutes == interval_min && slot.width_ms != 0)
+                return &slot;
+        }
+        return nullptr;
+    }
+
+    uint16_t SlotScheduler::slot_index(uint32_t interval_min) const
+    {
+        const TdmaSlot *slot = assigned_slot(interval_min);
+        return slot ? slot->slot_index : extract_node(dev_cfg_.combined_id);
+    }
+
+    int64_t SlotScheduler::next_wake_local_ms(uint32_t interval_min, uint8_t stride) const
+    {
+        const uint64_t interval_ms = static_cast<uint64_t>(interval_min) * 60 * 1000;
+        if (interval_ms == 0)
+            return TimeManager::monotonic_ms() + MIN_SLEEP_MS;
+
+        /* Gateway assignment is validated on RX, legacy node_id slot may not fit */
+        const TdmaSlot *assigned = assigned_slot(interval_min);
+        const uint32_t width_ms = assigned ? assigned->width_ms
+                                           : slot_width_ms(dev_cfg_, static_cast<uint32_t>(interval_ms));
+        const uint64_t raw_offset_ms = assigned ? assigned->offset_ms
+                                                : static_cast<uint64_t>(slot_index(interval_min)) * width_ms;
+
+        if (raw_offset_ms + width_ms > interval_ms)
+        {
+            LOG_WRN("Slot %u (%u ms wide) does not fit into %u min interval, wrapping",
+                    slot_index(interval_min), width_ms, interval_min);
+        }
+        const uint64_t offset_ms = raw_offset_ms % interval_ms;
+
+        /* First frame leaves at slot start + guard, wake early by measured lead time */
+        const int64_t start_delay_ms = static_cast<int64_t>(TimeManager::guard_ms(static_cast<uint32_t>(interval_ms))) -
+                                       static_cast<int64_t>(tx_lead_ms_);
+
+        /* Wall clock before sync is uptime, so both cases share one path */
+        const int64_t now_local = TimeManager::monotonic_ms();
+        const uint64_t now_wall = TimeManager::unix_ms_at(now_local);
+
+        /* First slot start after now; cycle 0 while now is still before the offset */
+        uint64_t cycle = (now_wall >= offset_ms) ? (now_wall - offset_ms) / interval_ms + 1 : 0;
+
+        /* Skipped cycles keep the slot offset, so the wake-up stays on this node's grid */
+        cycle += MAX(stride, 1) - 1;
+
+        for (;; ++cycle)
+        {
+            const uint64_t slot_wall = cycle * interval_ms + offset_ms;
+            const int64_t deadline_local = TimeManager::local_ms_for_unix_ms(slot_wall) + start_delay_ms;
+            if (deadline_local >= now_local + MIN_SLEEP_MS)
+                return deadline_local;
+        }
+    }
+
+    int SlotScheduler::sleep_until_next_slot(uint32_t interval_min, uint8_t stride)
+    {
+        const int64_t deadline = next_wake_local_ms(interval_min, stride);
+
+        LOG_DBG("Slot %u%s: sleeping until uptime %lld ms (in %lld ms, lead %u ms)",
+                slot_index(interval_min), assigned_slot(interval_min) ? " (assigned)" : "", deadline, deadline - TimeManager::monotonic_ms(), tx_lead_ms_);
+
+        CycleProfiler::instance().end_cycle();
+        k_sleep(K_TIMEOUT_ABS_MS(deadline));
+
+        last_wake_local_ms_ = TimeManager::monotonic_ms();
+        return 0;
+    }
+
+    void SlotScheduler::mark_tx_start()
+    {
+        if (last_wake_local_ms_ == 0)
+            return; /* first cycle after boot was not scheduled */
+
+        const int64_t lead = TimeManager::monotonic_ms() - last_wake_local_ms_;
+        const int64_t max_lead = static_cast<int64_t>(dev_cfg_.sample_interval_minutes) * 60 * 1000 / 2;
+
+        tx_lead_ms_ = static_cast<uint32_t>(CLAMP(lead, 0, max_lead));
+    }
+
+    /* =========================================================
+     * TDMA window
+     * ---------------------------------------------------------
+     * max_tx_frames DATA frames + 1 CONFIG RX + ACK/RESPONSE
+     * for each of them, scaled by air_time_margin_factor, plus
+     * the clock guard on both edges.
+     * ========================================================= */
+    uint32_t SlotScheduler::slot_width_ms(const DeviceConfig &cfg, uint32_t interval_ms)
+    {
+        const uint8_t max_payload = get_max_payload(cfg);
+        const uint8_t short_frame = FrameLayout::RESPONSE_FRAME_SIZE + FrameLayout::AUTH_SIZE;
+
+        const float tx_time_window = static_cast<float>(cfg.max_tx_frames_per_cycle) *
+                                     calculate_airtime_s(cfg, max_payload);
+        const float rx_time_window = calculate_airtime_s(cfg, max_payload);
+        const float ack_time_window = static_cast<float>(cfg.max_tx_frames_per_cycle + 1) *
+                                      calculate_airtime_s(cfg, short_frame);
+
+        const float air_window_ms = (tx_time_window + rx_time_window + ack_time_window) *
+                                    cfg.air_time_margin_factor * 1000.0f;
+
+        return static_cast<uint32_t>(ceilf(air_window_ms)) + 2 * TimeManager::guard_ms(interval_ms);
+    }
+
+    /**
+     * @brief Calculate the estimated airtime of a LoRa packet in seconds
+     *
+     * This uses the LoRa modulation parameters: SF, bandwidth, preamble length,
+     * coding rate, and payload length to estimate how long the packet will occupy
+     * the channel.
+     */
+    float SlotScheduler::calculate_airtime_s(const DeviceConfig &cfg, const uint8_t payload_len)
+    {
+        const uint8_t sf = static_cast<uint8_t>(cfg.lora.datarate);
+
+        float bw; // Bandwidth in Hz
+        switch (cfg.lora.bandwidth)
+        {
+        case BW_250_KHZ:
+            bw = 250000.0f;
+            break;
+        case BW_500_KHZ:
+            bw = 500000.0f;
+            break;
+        case BW_125_KHZ:
+        default:
+            bw = 125000.0f;
+            break;
+        }
+
+        const float tsym = (1UL << sf) / bw; // Symbol duration in seconds
+        const uint8_t preamble = cfg.lora.preamble_len;
+        const float tpreamble = (preamble + 4.25f) * tsym;
+
+        const uint8_t de = (sf >= 11) ? 1 : 0;   // Low data rate optimization
+        const uint8_t cr = cfg.lora.coding_rate; // LoRa coding rate (1–4 for 4/5..4/8)
+
+        // Compute number of symbols for payload (explicit header, CRC on)
+        float tmp = (8.0f * payload_len - 4.0f * sf + 28.0f + 16.0f) / (4.0f * (sf - 2.0f * de));
+        if (tmp < 0)
+            tmp = 0;
+
+        float payloadSymbNb = 8.0f + ceilf(tmp) * (cr + 4);
+
+        return tpreamble + payloadSymbNb * tsym; // seconds
+    }
+
+    /**
+     * @brief Returns the maximum payload for the given SF.
+     *
+     * These are conservative values to ensure airtime calculations match
+     * LoRa radio limitations.
+     */
+    uint8_t SlotScheduler::get_max_payload(const DeviceConfig &cfg)
+    {
+        switch (cfg.lora.datarate)
+        {
+        case SF_7:
+        case SF_8:
+            return 242;
+        case SF_9:
+        case SF_10:
+            return 115;
+        case SF_11:
+        case SF_12:
+        default:
+            return 51;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include "soil_calibration_store.hpp"
+#include "config_manager.hpp"
+
+#include <cerrno>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(soil_calibration, CONFIG_LORAGRO_SAMPLING_LOG_LEVEL);
+
+namespace loragro
+{
+    int SoilCalibrationStore::load(uint8_t probe, SoilCalibRecord &record)
+    {
+        if (probe >= MAX_PROBES)
+            return -EINVAL;
+
+        int rc = ConfigManager::instance().read_record(
+            ConfigManager::NVS_ID_SOIL_CALIB_BASE + probe, &record, sizeof(record));
+        if (rc)
+            return -ENOENT;
+
+        if (!SoilCalibration::points_valid(record.points, record.count))
+        {
+            LOG_WRN("Probe %u: stored calibration invalid, using default", probe);
+            return -EBADMSG;
+        }
+        return 0;
+    }
+
+    int SoilCalibrationStore::store(uint8_t probe, const SoilLutPoint *points, size_t count)
+    {
+        if (probe >= MAX_PROBES || !SoilCalibration::points_valid(points, count))
+            return -EINVAL;
+
+        SoilCalibRecord record{};
+        record.count = static_cast<uint8_t>(count);
+        for (size_t i = 0; i < count; ++i)
+            record.points[i] = points[i];
+
+        int rc = ConfigManager::instance().write_record(
+            ConfigManager::NVS_ID_SOIL_CALIB_BASE + probe, &record, sizeof(record));
+        if (rc)
+            return rc;
+
+        generation_++;
+        LOG_INF("Probe %u: stored %u point calibration", probe, static_cast<unsigned>(count));
+        return 0;
+    }
+
+} // namespace loragro
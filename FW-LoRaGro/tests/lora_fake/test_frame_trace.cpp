@@ -0,0 +1,152 @@
+#include <zephyr/ztest.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/lora.h>
+
+#include "config_manager.hpp"
+#include "lora/lora_interface.hpp"
+#include "lora/lora_frame_trace.hpp"
+#include "lora/sx1262_fake.hpp"
+
+using namespace loragro;
+
+static const struct device *const lora_dev = DEVICE_DT_GET(DT_ALIAS(lora0));
+
+static DeviceConfig &trace_cfg()
+{
+    static bool loaded = false;
+    ConfigManager &cfg = ConfigManager::instance();
+    if (!loaded)
+    {
+        cfg.load_defaults();
+        cfg.get().lora.datarate = SF_7;
+        cfg.get().lora.bandwidth = BW_125_KHZ;
+        loaded = true;
+    }
+    return cfg.get();
+}
+
+static size_t make_data_frame(uint8_t *frame, size_t len, uint8_t ctr)
+{
+    memset(frame, 0, len);
+    write_u16_le(frame, 0, trace_cfg().combined_id);
+    frame[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::DATA);
+    frame[FrameLayout::FRAME_CTR] = ctr;
+    for (size_t i = FrameLayout::HEADER_SIZE; i < len; ++i)
+        frame[i] = static_cast<uint8_t>(i);
+    return len;
+}
+
+static void frame_trace_before(void *f)
+{
+    ARG_UNUSED(f);
+
+    struct sx1262_fake_channel ch{};
+    ch.rssi_dbm = -57;
+    ch.snr_db = 8;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    /* ACK or CONFIG left over from another suite */
+    uint8_t buf[64];
+    int16_t rssi;
+    int8_t snr;
+    while (lora_recv(lora_dev, buf, sizeof(buf), K_MSEC(300), &rssi, &snr) > 0)
+    {
+    }
+
+    FrameTrace::instance().reset();
+}
+
+ZTEST(frame_trace_suite, test_tx_and_rx_recorded)
+{
+    DeviceConfig &cfg = trace_cfg();
+    Auth auth(cfg);
+    Interface radio(lora_dev, cfg, auth);
+    zassert_ok(radio.init(cfg));
+
+    uint8_t frame[20];
+    const size_t len = make_data_frame(frame, sizeof(frame), 3);
+    zassert_equal(radio.transmit(frame, len), static_cast<int>(len));
+
+    const FrameTraceRecord *tx = FrameTrace::instance().latest();
+    zassert_not_null(tx);
+    zassert_equal(tx->kind & FrameTraceRecord::KIND_MASK, static_cast<uint8_t>(TraceKind::TX));
+    zassert_equal(tx->len, len);
+    zassert_equal(tx->cap_len, len);
+    zassert_equal(tx->result, static_cast<int16_t>(len));
+    zassert_equal(tx->airtime_ms, static_cast<uint16_t>(radio.calculate_airtime_ms(len)));
+    zassert_mem_equal(tx->data, frame, len);
+
+    /* The fake answers with the ACK, the plain RX window takes it */
+    uint8_t buf[64];
+    const int received = radio.receive(buf, sizeof(buf));
+    zassert_true(received > 0, "RX %d", received);
+
+    const FrameTraceRecord *rx = FrameTrace::instance().latest();
+    zassert_equal(rx->kind & FrameTraceRecord::KIND_MASK, static_cast<uint8_t>(TraceKind::RX));
+    zassert_equal(rx->seq, static_cast<uint16_t>(tx->seq + 1));
+    zassert_equal(rx->len, received);
+    zassert_equal(rx->rssi, -57);
+    zassert_equal(rx->snr, 8);
+    zassert_equal(rx->data[FrameLayout::FRAME_TYPE], static_cast<uint8_t>(FrameType::ACK));
+    zassert_true(rx->time_ms >= tx->time_ms);
+}
+
+ZTEST(frame_trace_suite, test_empty_window_keeps_result)
+{
+    DeviceConfig &cfg = trace_cfg();
+    Auth auth(cfg);
+    Interface radio(lora_dev, cfg, auth);
+    zassert_ok(radio.init(cfg));
+
+    uint8_t buf[64];
+    const int received = radio.receive(buf, sizeof(buf));
+    zassert_true(received <= 0);
+
+    const FrameTraceRecord *rx = FrameTrace::instance().latest();
+    zassert_not_null(rx);
+    zassert_equal(rx->len, 0);
+    zassert_equal(rx->cap_len, 0);
+    zassert_equal(rx->rssi, 0, "No stale RSSI on an empty window");
+    zassert_equal(rx->result, received);
+}
+
+ZTEST(frame_trace_suite, test_snaplen_cuts_long_frames)
+{
+    uint8_t frame[CONFIG_LORAGRO_FRAME_TRACE_SNAPLEN + 20];
+    make_data_frame(frame, sizeof(frame), 9);
+
+    FrameTrace::instance().record(TraceKind::TX, frame, sizeof(frame), sizeof(frame));
+
+    const FrameTraceRecord *r = FrameTrace::instance().latest();
+    zassert_equal(r->len, sizeof(frame));
+    zassert_equal(r->cap_len, CONFIG_LORAGRO_FRAME_TRACE_SNAPLEN);
+    zassert_mem_equal(r->data, frame, CONFIG_LORAGRO_FRAME_TRACE_SNAPLEN);
+}
+
+ZTEST(frame_trace_suite, test_ring_overwrites_oldest)
+{
+    FrameTrace &trace = FrameTrace::instance();
+    const size_t n = CONFIG_LORAGRO_FRAME_TRACE_RECORDS + 5;
+    uint8_t frame[8];
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        make_data_frame(frame, sizeof(frame), static_cast<uint8_t>(i));
+        trace.record(TraceKind::TX, frame, sizeof(frame), 0);
+    }
+
+    zassert_equal(trace.count(), CONFIG_LORAGRO_FRAME_TRACE_RECORDS);
+    zassert_equal(trace.overwritten(), 5);
+    zassert_equal(trace.latest()->data[FrameLayout::FRAME_CTR], n - 1);
+
+    /* Oldest surviving record and consecutive sequence numbers */
+    const FrameTraceRecord *oldest = trace.latest(CONFIG_LORAGRO_FRAME_TRACE_RECORDS - 1);
+    zassert_equal(oldest->data[FrameLayout::FRAME_CTR], 5);
+    zassert_equal(static_cast<uint16_t>(trace.latest()->seq - oldest->seq),
+                  CONFIG_LORAGRO_FRAME_TRACE_RECORDS - 1);
+    zassert_is_null(trace.latest(CONFIG_LORAGRO_FRAME_TRACE_RECORDS));
+
+    zassert_equal(trace.dump(), CONFIG_LORAGRO_FRAME_TRACE_RECORDS);
+}
+
+ZTEST_SUITE(frame_trace_suite, NULL, NULL, frame_trace_before, NULL, NULL);
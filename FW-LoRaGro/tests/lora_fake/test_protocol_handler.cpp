@@ -0,0 +1,256 @@
+#include <zephyr/ztest.h>
+#include <cstring>
+#include <initializer_list>
+
+#include "config_manager.hpp"
+#include "lora/lora_protocol.hpp"
+#include "lora/lora_protocol_handler.hpp"
+
+using namespace loragro;
+
+/* CONFIG frame as the gateway builds it, auth tag left zero (decode() does not check it) */
+struct ConfigFrame
+{
+    uint8_t data[255]{};
+    size_t len{FrameLayout::FIRST_CMD};
+
+    explicit ConfigFrame(uint16_t combined_id)
+    {
+        write_u16_le(data, FrameLayout::COMBINED_ID_LSB, combined_id);
+        data[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::CONFIG);
+        data[FrameLayout::PROTOCOL_VERSION] = PROTOCOL_VERSION;
+    }
+
+    ConfigFrame &add(MessageOp op, const uint8_t *payload, uint16_t payload_len)
+    {
+        data[len++] = static_cast<uint8_t>(op);
+        len += write_varint(data, len, payload_len);
+        if (payload_len)
+            memcpy(&data[len], payload, payload_len);
+        len += payload_len;
+        data[FrameLayout::CMD_COUNT]++;
+        return *this;
+    }
+
+    /* Hand-made command bytes, counted as one command */
+    ConfigFrame &raw(std::initializer_list<uint8_t> bytes)
+    {
+        for (uint8_t b : bytes)
+            data[len++] = b;
+        data[FrameLayout::CMD_COUNT]++;
+        return *this;
+    }
+
+    uint8_t sealed_len() const { return static_cast<uint8_t>(len + AUTH_TAG_SIZE); }
+};
+
+static void tdma_payload(uint8_t *p, uint8_t interval_minutes, uint16_t slot_index,
+                         uint16_t width_ms, uint32_t offset_ms)
+{
+    p[0] = interval_minutes;
+    write_u16_le(p, 1, slot_index);
+    write_u16_le(p, 3, width_ms);
+    p[5] = offset_ms & 0xFF;
+    p[6] = (offset_ms >> 8) & 0xFF;
+    p[7] = (offset_ms >> 16) & 0xFF;
+    p[8] = (offset_ms >> 24) & 0xFF;
+}
+
+static DeviceConfig &protocol_cfg()
+{
+    return ConfigManager::instance().get();
+}
+
+/* Other suites of this binary share the config, leave it as found */
+static DeviceConfig saved_cfg;
+
+static void protocol_before(void *f)
+{
+    ARG_UNUSED(f);
+    saved_cfg = protocol_cfg();
+}
+
+static void protocol_after(void *f)
+{
+    ARG_UNUSED(f);
+    protocol_cfg() = saved_cfg;
+}
+
+ZTEST_SUITE(protocol_handler_suite, NULL, NULL, protocol_before, protocol_after, NULL);
+
+static DecodeResult decode(const ConfigFrame &frame)
+{
+    ProtocolHandler handler(ConfigManager::instance());
+    return handler.decode(frame.data, frame.sealed_len());
+}
+
+/* =========================================================
+ * TLV / varint structure
+ * ========================================================= */
+ZTEST(protocol_handler_suite, test_varint_truncated)
+{
+    /* Continuation bit set on the last byte before the tag */
+    ConfigFrame frame(protocol_cfg().combined_id);
+    frame.raw({static_cast<uint8_t>(MessageOp::SET_SAMPLING_INTERVAL), 0x81});
+    zassert_equal(decode(frame), DecodeResult::INVALID_LENGTH);
+
+    /* Command ID, no length at all */
+    ConfigFrame bare(protocol_cfg().combined_id);
+    bare.raw({static_cast<uint8_t>(MessageOp::REBOOT)});
+    zassert_equal(decode(bare), DecodeResult::INVALID_LENGTH);
+}
+
+ZTEST(protocol_handler_suite, test_varint_overlong)
+{
+    /* Three length bytes, VARINT_MAX_BYTES is 2 */
+    ConfigFrame frame(protocol_cfg().combined_id);
+    frame.raw({static_cast<uint8_t>(MessageOp::SET_SAMPLING_INTERVAL), 0x81, 0x80, 0x00, 5});
+    zassert_equal(decode(frame), DecodeResult::INVALID_LENGTH);
+
+    /* Two bytes are fine, even when not minimal (1 as 0x81 0x00) */
+    ConfigFrame two(protocol_cfg().combined_id);
+    two.raw({static_cast<uint8_t>(MessageOp::SET_SAMPLING_INTERVAL), 0x81, 0x00, 7});
+    zassert_equal(decode(two), DecodeResult::OK);
+    zassert_equal(protocol_cfg().sample_interval_minutes, 7);
+}
+
+ZTEST(protocol_handler_suite, test_length_past_buffer)
+{
+    /* SET_UNIX_TIME says 8 bytes, 3 follow before the tag */
+    ConfigFrame frame(protocol_cfg().combined_id);
+    frame.raw({static_cast<uint8_t>(MessageOp::SET_UNIX_TIME), 8, 1, 2, 3});
+    zassert_equal(decode(frame), DecodeResult::INVALID_LENGTH);
+
+    /* Within the buffer but outside the schema bounds */
+    ConfigFrame wide(protocol_cfg().combined_id);
+    wide.raw({static_cast<uint8_t>(MessageOp::SET_SAMPLING_INTERVAL), 2, 10, 0});
+    zassert_equal(decode(wide), DecodeResult::INVALID_LENGTH);
+}
+
+ZTEST(protocol_handler_suite, test_unknown_command)
+{
+    ConfigFrame frame(protocol_cfg().combined_id);
+    frame.raw({static_cast<uint8_t>(MessageOp::MAX_OP), 1, 0});
+    zassert_equal(decode(frame), DecodeResult::UNKNOWN_COMMAND);
+
+    ConfigFrame high(protocol_cfg().combined_id);
+    high.raw({0xFF, 0});
+    zassert_equal(decode(high), DecodeResult::UNKNOWN_COMMAND);
+}
+
+ZTEST(protocol_handler_suite, test_zero_length_values)
+{
+    /* REBOOT carries no value */
+    ConfigFrame reboot(protocol_cfg().combined_id);
+    reboot.add(MessageOp::REBOOT, nullptr, 0);
+    zassert_equal(decode(reboot), DecodeResult::OK_AND_REBOOT_NEED);
+
+    /* Everything else needs at least one byte */
+    const uint8_t before = protocol_cfg().sample_interval_minutes;
+    ConfigFrame empty(protocol_cfg().combined_id);
+    empty.add(MessageOp::SET_SAMPLING_INTERVAL, nullptr, 0);
+    zassert_equal(decode(empty), DecodeResult::INVALID_LENGTH);
+    zassert_equal(protocol_cfg().sample_interval_minutes, before);
+
+    /* No commands at all */
+    ConfigFrame none(protocol_cfg().combined_id);
+    zassert_equal(decode(none), DecodeResult::INVALID_LENGTH);
+}
+
+/* A sound head never runs when the tail of the batch is bad */
+ZTEST(protocol_handler_suite, test_batch_bad_tail)
+{
+    const DeviceConfig before = protocol_cfg();
+    const uint8_t interval = static_cast<uint8_t>(before.sample_interval_minutes + 3);
+    const uint8_t unix_time[8] = {0x00, 0x10, 0x5E, 0x67, 0, 0, 0, 0};
+
+    /* All good: both applied */
+    ConfigFrame good(before.combined_id);
+    good.add(MessageOp::SET_SAMPLING_INTERVAL, &interval, 1).add(MessageOp::REBOOT, nullptr, 0);
+    zassert_equal(decode(good), DecodeResult::OK_AND_REBOOT_NEED);
+    zassert_equal(protocol_cfg().sample_interval_minutes, interval);
+    protocol_cfg() = before;
+
+    ConfigFrame tails[5] = {ConfigFrame(before.combined_id), ConfigFrame(before.combined_id),
+                            ConfigFrame(before.combined_id), ConfigFrame(before.combined_id),
+                            ConfigFrame(before.combined_id)};
+    const DecodeResult expected[5] = {DecodeResult::UNKNOWN_COMMAND, DecodeResult::INVALID_LENGTH,
+                                      DecodeResult::INVALID_LENGTH, DecodeResult::INVALID_LENGTH,
+                                      DecodeResult::INVALID_LENGTH};
+
+    tails[0].add(MessageOp::SET_SAMPLING_INTERVAL, &interval, 1).raw({0x42, 0});
+    tails[1].add(MessageOp::SET_SAMPLING_INTERVAL, &interval, 1)
+        .raw({static_cast<uint8_t>(MessageOp::SET_UNIX_TIME), 0x80});
+    tails[2].add(MessageOp::SET_SAMPLING_INTERVAL, &interval, 1).add(MessageOp::SET_UNIX_TIME, unix_time, 7);
+    /* Stray byte after the last command */
+    tails[3].add(MessageOp::SET_SAMPLING_INTERVAL, &interval, 1).add(MessageOp::REBOOT, nullptr, 0);
+    tails[3].data[tails[3].len++] = 0;
+    /* Count says one more command than there is */
+    tails[4].add(MessageOp::SET_SAMPLING_INTERVAL, &interval, 1);
+    tails[4].data[FrameLayout::CMD_COUNT]++;
+
+    for (size_t i = 0; i < ARRAY_SIZE(tails); ++i)
+    {
+        zassert_equal(decode(tails[i]), expected[i], "tail %u", static_cast<unsigned>(i));
+        zassert_equal(protocol_cfg().sample_interval_minutes, before.sample_interval_minutes,
+                      "tail %u: head applied", static_cast<unsigned>(i));
+    }
+}
+
+/* =========================================================
+ * SET_TDMA_SLOT
+ * ========================================================= */
+ZTEST(protocol_handler_suite, test_tdma_slot_applied)
+{
+    uint8_t slot[9];
+
+    /* Slot ending exactly at the interval end */
+    tdma_payload(slot, 10, 3, 500, 10 * 60 * 1000 - 500);
+    ConfigFrame frame(protocol_cfg().combined_id);
+    frame.add(MessageOp::SET_TDMA_SLOT, slot, sizeof(slot));
+
+    zassert_equal(decode(frame), DecodeResult::OK);
+    zassert_equal(protocol_cfg().tdma_slots[0].interval_minutes, 10);
+    zassert_equal(protocol_cfg().tdma_slots[0].slot_index, 3);
+    zassert_equal(protocol_cfg().tdma_slots[0].offset_ms, 10 * 60 * 1000 - 500);
+}
+
+/* A valid command, then a bad slot: the batch is rejected whole */
+ZTEST(protocol_handler_suite, test_tdma_slot_invalid_applies_nothing)
+{
+    const DeviceConfig before = protocol_cfg();
+
+    const uint8_t interval = static_cast<uint8_t>(before.sample_interval_minutes + 5);
+    uint8_t slot[9];
+
+    const struct
+    {
+        uint16_t width_ms;
+        uint32_t offset_ms;
+    } bad[] = {
+        {500, 10 * 60 * 1000 - 499}, // ends past the interval
+        {0x200, 0xFFFFFF00},         // offset + width wraps in 32 bits
+        {1000, 0xFFFFFFFF},
+    };
+
+    for (const auto &b : bad)
+    {
+        tdma_payload(slot, 10, 1, b.width_ms, b.offset_ms);
+        ConfigFrame frame(before.combined_id);
+        frame.add(MessageOp::SET_SAMPLING_INTERVAL, &interval, 1)
+            .add(MessageOp::SET_TDMA_SLOT, slot, sizeof(slot));
+
+        zassert_equal(decode(frame), DecodeResult::INVALID_VALUE,
+                      "offset %u width %u", b.offset_ms, b.width_ms);
+        zassert_equal(protocol_cfg().sample_interval_minutes, before.sample_interval_minutes,
+                      "first command applied");
+        zassert_mem_equal(protocol_cfg().tdma_slots, before.tdma_slots, sizeof(before.tdma_slots));
+    }
+
+    /* No interval grid at all */
+    tdma_payload(slot, 0, 1, 0, 0);
+    ConfigFrame frame(before.combined_id);
+    frame.add(MessageOp::SET_SAMPLING_INTERVAL, &interval, 1).add(MessageOp::SET_TDMA_SLOT, slot, sizeof(slot));
+    zassert_equal(decode(frame), DecodeResult::INVALID_VALUE);
+    zassert_equal(protocol_cfg().sample_interval_minutes, before.sample_interval_minutes);
+}
@@ -0,0 +1,59 @@
+#include <zephyr/ztest.h>
+
+#include "config_manager.hpp"
+#include "slot_scheduler.hpp"
+#include "time_manager.hpp"
+
+using namespace loragro;
+
+static constexpr uint32_t INTERVAL_MIN = 10;
+static constexpr int64_t INTERVAL_MS = INTERVAL_MIN * 60 * 1000;
+static constexpr uint32_t SLOT_OFFSET_MS = 9 * 60 * 1000;
+
+/* Gateway assigned slot 9 min into a 10 min interval */
+static DeviceConfig scheduler_cfg()
+{
+    DeviceConfig cfg = ConfigManager::instance().get();
+    cfg.tdma_slots[0] = TdmaSlot{INTERVAL_MIN, 4, 1000, SLOT_OFFSET_MS};
+    cfg.tdma_slots[1] = TdmaSlot{};
+    return cfg;
+}
+
+/* Wall clock set to into_ms past an interval start, returns local now */
+static int64_t sync_into_interval(uint64_t into_ms)
+{
+    const int64_t now = TimeManager::monotonic_ms();
+    const uint64_t interval_start = 1700000000000ULL / INTERVAL_MS * INTERVAL_MS;
+    TimeManager::sync_unix_time_ms(interval_start + into_ms, now, false);
+    return now;
+}
+
+ZTEST_SUITE(slot_scheduler_suite, NULL, NULL, NULL, NULL, NULL);
+
+/* Before the offset the slot of this very interval is the next one */
+ZTEST(slot_scheduler_suite, test_first_slot_before_offset)
+{
+    const DeviceConfig cfg = scheduler_cfg();
+    SlotScheduler sched(cfg);
+
+    const int64_t now = sync_into_interval(1000);
+    const int64_t wait = sched.next_wake_local_ms(INTERVAL_MIN) - now;
+    zassert_true(wait > SLOT_OFFSET_MS - 1000 - 1000 && wait < INTERVAL_MS,
+                 "slot of this interval skipped, wake in %lld ms", wait);
+
+    /* Stride 2 skips exactly one slot */
+    const int64_t wait2 = sched.next_wake_local_ms(INTERVAL_MIN, 2) - now;
+    zassert_within(wait2 - wait, INTERVAL_MS, 10, "stride 2: %lld ms after stride 1", wait2 - wait);
+}
+
+/* Past the slot start the next interval's slot is next */
+ZTEST(slot_scheduler_suite, test_next_slot_after_offset)
+{
+    const DeviceConfig cfg = scheduler_cfg();
+    SlotScheduler sched(cfg);
+
+    const int64_t now = sync_into_interval(SLOT_OFFSET_MS + 1000);
+    const int64_t wait = sched.next_wake_local_ms(INTERVAL_MIN) - now;
+    zassert_true(wait > INTERVAL_MS - 1000 - 1000 && wait < INTERVAL_MS,
+                 "wake in %lld ms", wait);
+}
@@ -0,0 +1,256 @@
+#include <zephyr/ztest.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/lora.h>
+
+#include "lora/lora_protocol.hpp"
+#include "lora/sx1262_fake.hpp"
+
+using namespace loragro;
+
+static const struct device *const lora_dev = DEVICE_DT_GET(DT_ALIAS(lora0));
+
+/* Long enough for SF7 TX + ACK + the largest jitter used below */
+#define RECV_TIMEOUT K_MSEC(1000)
+
+static struct sx1262_fake_channel perfect_link()
+{
+    struct sx1262_fake_channel ch{};
+    ch.rssi_dbm = -42;
+    ch.snr_db = 10;
+    return ch;
+}
+
+static void send_data_frame(uint8_t ctr)
+{
+    uint8_t frame[12]{};
+    write_u16_le(frame, 0, 0x0801);
+    frame[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::DATA);
+    frame[FrameLayout::FRAME_CTR] = ctr;
+
+    zassert_equal(lora_send(lora_dev, frame, sizeof(frame)), static_cast<int>(sizeof(frame)));
+}
+
+static void *lora_fake_setup(void)
+{
+    zassert_true(device_is_ready(lora_dev));
+
+    /* SF7 keeps the simulated waits short */
+    struct lora_modem_config cfg{};
+    cfg.frequency = 868100000;
+    cfg.bandwidth = BW_125_KHZ;
+    cfg.datarate = SF_7;
+    cfg.coding_rate = CR_4_5;
+    cfg.preamble_len = 8;
+    cfg.tx_power = 14;
+    cfg.tx = true;
+    zassert_equal(lora_config(lora_dev, &cfg), 0);
+
+    return NULL;
+}
+
+static void lora_fake_before(void *f)
+{
+    ARG_UNUSED(f);
+
+    struct sx1262_fake_channel ch = perfect_link();
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+    sx1262_fake_seed(lora_dev, 42);
+    sx1262_fake_reset_stats(lora_dev);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_devicetree_defaults)
+{
+    /* Overlay values reach the binding, before() replaces them for every other case */
+    zassert_equal(DT_PROP(DT_ALIAS(lora0), uplink_loss_permille), 100);
+    zassert_equal(DT_PROP(DT_ALIAS(lora0), rssi_dbm), -110);
+    zassert_equal(DT_PROP(DT_ALIAS(lora0), config_period), 0);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_perfect_link_acks)
+{
+    uint8_t buf[32];
+    int16_t rssi = 0;
+    int8_t snr = 0;
+
+    send_data_frame(7);
+    const int len = lora_recv(lora_dev, buf, sizeof(buf), RECV_TIMEOUT, &rssi, &snr);
+
+    zassert_equal(len, FrameLayout::ACK_FRAME_SIZE + FrameLayout::AUTH_SIZE);
+    zassert_equal(buf[FrameLayout::FRAME_TYPE], static_cast<uint8_t>(FrameType::ACK));
+    zassert_equal(buf[FrameLayout::FRAME_CTR], 7);
+    zassert_equal(rssi, -42);
+    zassert_equal(snr, 10);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_invalid_model_rejected)
+{
+    struct sx1262_fake_channel ch = perfect_link();
+    ch.ack_loss_permille = 1001;
+
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), -EINVAL);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_uplink_loss)
+{
+    struct sx1262_fake_channel ch = perfect_link();
+    ch.uplink_loss_permille = 1000;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    uint8_t buf[32];
+    send_data_frame(1);
+    zassert_equal(lora_recv(lora_dev, buf, sizeof(buf), K_MSEC(200), NULL, NULL), -EAGAIN);
+
+    struct sx1262_fake_stats stats;
+    sx1262_fake_get_stats(lora_dev, &stats);
+    zassert_equal(stats.uplinks, 1);
+    zassert_equal(stats.uplinks_lost, 1);
+    zassert_equal(stats.acks_sent, 0);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_ack_loss)
+{
+    struct sx1262_fake_channel ch = perfect_link();
+    ch.ack_loss_permille = 1000;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    uint8_t buf[32];
+    send_data_frame(3);
+    zassert_equal(lora_recv(lora_dev, buf, sizeof(buf), K_MSEC(200), NULL, NULL), -EAGAIN);
+
+    struct sx1262_fake_stats stats;
+    sx1262_fake_get_stats(lora_dev, &stats);
+    zassert_equal(stats.uplinks_lost, 0);
+    zassert_equal(stats.acks_lost, 1);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_loss_rate_and_seed)
+{
+    struct sx1262_fake_channel ch = perfect_link();
+    ch.uplink_loss_permille = 300;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    for (int i = 0; i < 1000; ++i)
+        send_data_frame(static_cast<uint8_t>(i));
+
+    struct sx1262_fake_stats first;
+    sx1262_fake_get_stats(lora_dev, &first);
+    zassert_within(first.uplinks_lost, 300, 50, "Lost %u of 1000", first.uplinks_lost);
+
+    /* Same seed, same losses */
+    sx1262_fake_seed(lora_dev, 42);
+    sx1262_fake_reset_stats(lora_dev);
+    for (int i = 0; i < 1000; ++i)
+        send_data_frame(static_cast<uint8_t>(i));
+
+    struct sx1262_fake_stats second;
+    sx1262_fake_get_stats(lora_dev, &second);
+    zassert_equal(second.uplinks_lost, first.uplinks_lost);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_duplicate_delivery)
+{
+    struct sx1262_fake_channel ch = perfect_link();
+    ch.duplicate_permille = 1000;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    uint8_t first[32];
+    uint8_t second[32];
+
+    send_data_frame(9);
+    const int len = lora_recv(lora_dev, first, sizeof(first), RECV_TIMEOUT, NULL, NULL);
+    zassert_true(len > 0);
+
+    /* The copy comes without waiting */
+    const int64_t start = k_uptime_get();
+    zassert_equal(lora_recv(lora_dev, second, sizeof(second), RECV_TIMEOUT, NULL, NULL), len);
+    zassert_true(k_uptime_get() - start < 10);
+    zassert_mem_equal(first, second, len);
+
+    struct sx1262_fake_stats stats;
+    sx1262_fake_get_stats(lora_dev, &stats);
+    zassert_equal(stats.duplicates, 1);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_latency_jitter)
+{
+    struct sx1262_fake_channel ch = perfect_link();
+    ch.latency_jitter_ms = 200;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    int64_t min_ms = INT64_MAX;
+    int64_t max_ms = 0;
+    uint8_t buf[32];
+
+    for (int i = 0; i < 10; ++i)
+    {
+        const int64_t start = k_uptime_get();
+        send_data_frame(static_cast<uint8_t>(i));
+        zassert_true(lora_recv(lora_dev, buf, sizeof(buf), RECV_TIMEOUT, NULL, NULL) > 0);
+
+        const int64_t took = k_uptime_get() - start;
+        min_ms = MIN(min_ms, took);
+        max_ms = MAX(max_ms, took);
+    }
+
+    zassert_true(max_ms - min_ms > 20, "ACK delay spread only %lld ms", max_ms - min_ms);
+    zassert_true(max_ms - min_ms <= 201);
+}
+
+ZTEST(sx1262_fake_channel_suite, test_rssi_distribution)
+{
+    struct sx1262_fake_channel ch = perfect_link();
+    ch.rssi_dbm = -110;
+    ch.rssi_stddev_db = 4;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    int32_t sum = 0;
+    int16_t lo = INT16_MAX;
+    int16_t hi = INT16_MIN;
+    uint8_t buf[32];
+
+    for (int i = 0; i < 50; ++i)
+    {
+        int16_t rssi = 0;
+        send_data_frame(static_cast<uint8_t>(i));
+        zassert_true(lora_recv(lora_dev, buf, sizeof(buf), RECV_TIMEOUT, &rssi, NULL) > 0);
+
+        sum += rssi;
+        lo = MIN(lo, rssi);
+        hi = MAX(hi, rssi);
+    }
+
+    zassert_within(sum / 50, -110, 2);
+    zassert_true(hi - lo >= 4, "No spread in RSSI");
+}
+
+ZTEST(sx1262_fake_channel_suite, test_config_follows_ack_window)
+{
+    struct sx1262_fake_channel ch = perfect_link();
+    ch.config_period = 1;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    uint8_t buf[64];
+
+    send_data_frame(1);
+    zassert_true(lora_recv(lora_dev, buf, sizeof(buf), RECV_TIMEOUT, NULL, NULL) > 0);
+    zassert_equal(buf[FrameLayout::FRAME_TYPE], static_cast<uint8_t>(FrameType::ACK));
+
+    /* RX window after the ACK */
+    zassert_true(lora_recv(lora_dev, buf, sizeof(buf), K_MSEC(200), NULL, NULL) > 0);
+    zassert_equal(buf[FrameLayout::FRAME_TYPE], static_cast<uint8_t>(FrameType::CONFIG));
+
+    /* Lost downlink */
+    ch.downlink_loss_permille = 1000;
+    zassert_equal(sx1262_fake_set_channel(lora_dev, &ch), 0);
+
+    send_data_frame(2);
+    zassert_true(lora_recv(lora_dev, buf, sizeof(buf), RECV_TIMEOUT, NULL, NULL) > 0);
+    zassert_equal(lora_recv(lora_dev, buf, sizeof(buf), K_MSEC(200), NULL, NULL), -EAGAIN);
+
+    struct sx1262_fake_stats stats;
+    sx1262_fake_get_stats(lora_dev, &stats);
+    zassert_equal(stats.downlinks_sent, 1);
+    zassert_equal(stats.downlinks_lost, 1);
+}
+
+ZTEST_SUITE(sx1262_fake_channel_suite, NULL, lora_fake_setup, lora_fake_before, NULL, NULL);
@@ -0,0 +1,162 @@
+#include <zephyr/ztest.h>
+#include "modbus/modbus_rtu.hpp"
+#include "modbus/modbus_sim_slave.hpp"
+#include "sensors/soil_3in1_sim_probe.hpp"
+#include "sensors/soil_probe_bus.hpp"
+
+static constexpr uint32_t BAUD = 19200;
+
+struct modbus_suite_fixture
+{
+    loragro::ModbusSimSlave *bus;
+    loragro::ModbusRtuClient *client;
+    loragro::Soil3in1SimProbe *probe1;
+    loragro::Soil3in1SimProbe *probe2;
+};
+
+static struct modbus_suite_fixture g_fixture;
+
+static void *modbus_suite_setup(void)
+{
+    static loragro::ModbusSimSlave bus(BAUD);
+    static loragro::ModbusRtuClient client(bus, BAUD);
+    static loragro::Soil3in1SimProbe probe1;
+    static loragro::Soil3in1SimProbe probe2;
+
+    zassert_equal(bus.add_slave(1, &loragro::Soil3in1SimProbe::read, &probe1), 0);
+    zassert_equal(bus.add_slave(2, &loragro::Soil3in1SimProbe::read, &probe2), 0);
+
+    g_fixture = {&bus, &client, &probe1, &probe2};
+    return &g_fixture;
+}
+
+static void modbus_suite_before(void *f)
+{
+    static_cast<modbus_suite_fixture *>(f)->bus->reset_stats();
+}
+
+ZTEST_SUITE(modbus_suite, NULL, modbus_suite_setup, modbus_suite_before, NULL, NULL);
+
+ZTEST(modbus_suite, test_crc_and_timing)
+{
+    /* Read holding register 0 of slave 1: 01 03 00 00 00 01 | 84 0A */
+    static constexpr uint8_t req[] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x01};
+    zassert_equal(loragro::modbus::crc16(req, sizeof(req)), 0x0A84);
+
+    /* 3.5 chars of 11 bits, fixed above 19200 baud */
+    zassert_equal(loragro::modbus::t35_us(9600), 4010);
+    zassert_equal(loragro::modbus::t35_us(19200), 2005);
+    zassert_equal(loragro::modbus::t35_us(115200), 1750);
+    zassert_equal(loragro::modbus::t15_us(115200), 750);
+}
+
+ZTEST_F(modbus_suite, test_batch_read_single_round_trip)
+{
+    uint16_t regs[loragro::soil3in1::BLOCK_COUNT];
+    int ret = fixture->client->read_holding_registers(1, loragro::soil3in1::BLOCK_START,
+                                                      loragro::soil3in1::BLOCK_COUNT, regs);
+    zassert_equal(ret, 0, "read failed: %d", ret);
+
+    /* Moisture, temperature and EC with one request */
+    zassert_equal(fixture->bus->requests(), 1);
+    zassert_true(regs[0] >= 400 && regs[0] <= 800, "moisture %u", regs[0]);
+    zassert_true(regs[1] >= 180 && regs[1] <= 320, "temperature %u", regs[1]);
+    zassert_true(regs[2] >= 600 && regs[2] <= 1800, "EC %u", regs[2]);
+
+    /* 8 B request + 11 B response at 19200 baud */
+    zassert_equal(fixture->bus->line_us(), loragro::modbus::frame_us(BAUD, 8) +
+                                               loragro::modbus::frame_us(BAUD, 11));
+}
+
+ZTEST_F(modbus_suite, test_multiple_addresses)
+{
+    uint16_t reg;
+    const uint32_t reads2 = fixture->probe2->reads();
+
+    zassert_equal(fixture->client->read_holding_registers(2, loragro::soil3in1::REG_MOISTURE, 1, &reg), 0);
+    zassert_equal(fixture->probe2->reads(), reads2 + 1, "wrong slave answered");
+
+    /* Nobody at address 3 */
+    zassert_equal(fixture->client->read_holding_registers(3, 0, 1, &reg), -ETIMEDOUT);
+
+    /* Broadcast cannot be read */
+    zassert_equal(fixture->client->read_holding_registers(0, 0, 1, &reg), -EINVAL);
+}
+
+ZTEST_F(modbus_suite, test_errors)
+{
+    uint16_t regs[4];
+    const uint32_t failures = fixture->client->failures();
+
+    /* Register 3 is not mapped */
+    zassert_equal(fixture->client->read_holding_registers(1, 0, 4, regs), -EREMOTEIO);
+    zassert_equal(fixture->client->last_exception(), loragro::modbus::ILLEGAL_DATA_ADDRESS);
+
+    fixture->bus->corrupt_next();
+    zassert_equal(fixture->client->read_holding_registers(1, 0, 3, regs), -EBADMSG);
+
+    fixture->bus->drop_next();
+    zassert_equal(fixture->client->read_holding_registers(1, 0, 3, regs), -ETIMEDOUT);
+
+    zassert_equal(fixture->client->failures(), failures + 3);
+
+    /* Bus recovers */
+    zassert_equal(fixture->client->read_holding_registers(1, 0, 3, regs), 0);
+}
+
+ZTEST(modbus_suite, test_probe_bus_enumeration_and_profile)
+{
+    /* Separate bus: probes at 1, 2 and 5, address 5 without DT depth */
+    static loragro::ModbusSimSlave bus(BAUD);
+    static loragro::ModbusRtuClient client(bus, BAUD);
+    static loragro::Soil3in1SimProbe probes[] = {
+        loragro::Soil3in1SimProbe(10), loragro::Soil3in1SimProbe(40), loragro::Soil3in1SimProbe()};
+    static constexpr loragro::SoilProbeHint hints[] = {{1, 10}, {2, 40}};
+
+    bus.add_slave(1, &loragro::Soil3in1SimProbe::read, &probes[0]);
+    bus.add_slave(2, &loragro::Soil3in1SimProbe::read, &probes[1]);
+    bus.add_slave(5, &loragro::Soil3in1SimProbe::read, &probes[2]);
+
+    static loragro::SoilProbeBus<4> soil(client, 1, 8, hints, ARRAY_SIZE(hints));
+    zassert_equal(soil.init(), 0);
+    zassert_equal(soil.probe_count(), 3);
+    zassert_equal(soil.probe_addr(2), 5);
+    zassert_equal(soil.depth_cm(1), 40);
+    zassert_equal(soil.depth_cm(2), 0);
+
+    /* Whole bus in one session, one request per probe */
+    bus.reset_stats();
+    zassert_equal(soil.sample(), 0);
+    zassert_equal(bus.sessions(), 1);
+    zassert_equal(bus.requests(), 3);
+    zassert_equal(soil.count(), 3 * loragro::SensorID::PROBE_TYPE_COUNT);
+
+    const loragro::Measurement *m = soil.measurements();
+    zassert_equal(m[4].sensor_id, loragro::SensorID::soil_probe(1, loragro::SensorID::PROBE_DEPTH));
+    zassert_equal(m[4].value.val1, 40);
+    zassert_equal(loragro::SensorID::probe_index(m[11].sensor_id), 2);
+    zassert_equal(loragro::SensorID::probe_type(m[11].sensor_id), loragro::SensorID::PROBE_EC);
+
+    /* A silent probe drops out of this sample only */
+    bus.drop_next();
+    zassert_equal(soil.sample(), 0);
+    zassert_equal(soil.count(), 2 * loragro::SensorID::PROBE_TYPE_COUNT);
+    zassert_equal(loragro::SensorID::probe_index(soil.measurements()[0].sensor_id), 1);
+}
+
+ZTEST(modbus_suite, test_probe_bus_rescans_empty_bus)
+{
+    static loragro::ModbusSimSlave bus(BAUD);
+    static loragro::ModbusRtuClient client(bus, BAUD);
+    static loragro::Soil3in1SimProbe probe(20);
+
+    static loragro::SoilProbeBus<4> soil(client, 1, 4);
+    zassert_equal(soil.init(), -ENODEV, "empty bus must fail init");
+    zassert_equal(soil.probe_count(), 0);
+
+    /* Probe powered up later: next init() scans again */
+    bus.add_slave(3, &loragro::Soil3in1SimProbe::read, &probe);
+    zassert_equal(soil.init(), 0);
+    zassert_equal(soil.probe_count(), 1);
+    zassert_equal(soil.probe_addr(0), 3);
+}
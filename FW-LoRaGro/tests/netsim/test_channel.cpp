@@ -0,0 +1,110 @@
+#include <zephyr/ztest.h>
+
+#include "netsim/channel.hpp"
+
+using loragro::netsim::Airframe;
+using loragro::netsim::Channel;
+using loragro::netsim::RxOutcome;
+
+/* No shadowing, RSSI is exactly what the test asks for */
+static Airframe make_frame(int64_t start_us, int64_t end_us, uint8_t sf, float rssi_dbm)
+{
+    return Airframe{start_us, end_us, 0, sf, rssi_dbm, nullptr, 0, false};
+}
+
+ZTEST(netsim_channel_suite, test_single_frame_received)
+{
+    Channel ch(6, 0, 1);
+
+    const uint32_t a = ch.begin_uplink(make_frame(0, 1000, 9, -100.0f));
+    zassert_equal(ch.end_uplink(a), RxOutcome::OK);
+}
+
+ZTEST(netsim_channel_suite, test_below_sensitivity)
+{
+    Channel ch(6, 0, 1);
+
+    const uint32_t a = ch.begin_uplink(make_frame(0, 1000, 7, Channel::sensitivity_dbm(7) - 1.0f));
+    const uint32_t b = ch.begin_uplink(make_frame(2000, 3000, 12, Channel::sensitivity_dbm(7) - 1.0f));
+
+    zassert_equal(ch.end_uplink(a), RxOutcome::BELOW_SENSITIVITY);
+    zassert_equal(ch.end_uplink(b), RxOutcome::OK, "SF12 hears 13 dB deeper than SF7");
+}
+
+ZTEST(netsim_channel_suite, test_capture_effect)
+{
+    Channel ch(6, 0, 1);
+
+    /* 10 dB apart: the strong frame survives, the weak one is lost */
+    const uint32_t strong = ch.begin_uplink(make_frame(0, 1000, 9, -90.0f));
+    const uint32_t weak = ch.begin_uplink(make_frame(500, 1500, 9, -100.0f));
+
+    zassert_equal(ch.end_uplink(strong), RxOutcome::OK);
+    zassert_equal(ch.end_uplink(weak), RxOutcome::COLLISION);
+}
+
+ZTEST(netsim_channel_suite, test_equal_power_collision)
+{
+    Channel ch(6, 0, 1);
+
+    const uint32_t a = ch.begin_uplink(make_frame(0, 1000, 9, -100.0f));
+    const uint32_t b = ch.begin_uplink(make_frame(999, 2000, 9, -101.0f));
+
+    zassert_equal(ch.end_uplink(a), RxOutcome::COLLISION);
+    zassert_equal(ch.end_uplink(b), RxOutcome::COLLISION);
+}
+
+ZTEST(netsim_channel_suite, test_interference_sums_up)
+{
+    Channel ch(6, 0, 1);
+
+    /* 7 dB over each interferer, but two of them together are only 4 dB below */
+    const uint32_t a = ch.begin_uplink(make_frame(0, 3000, 9, -93.0f));
+    const uint32_t b = ch.begin_uplink(make_frame(100, 1000, 9, -100.0f));
+    const uint32_t c = ch.begin_uplink(make_frame(2000, 2900, 9, -100.0f));
+
+    zassert_equal(ch.end_uplink(b), RxOutcome::COLLISION);
+    zassert_equal(ch.end_uplink(c), RxOutcome::COLLISION);
+    zassert_equal(ch.end_uplink(a), RxOutcome::COLLISION);
+}
+
+ZTEST(netsim_channel_suite, test_spreading_factors_orthogonal)
+{
+    Channel ch(6, 0, 1);
+
+    const uint32_t a = ch.begin_uplink(make_frame(0, 1000, 9, -100.0f));
+    const uint32_t b = ch.begin_uplink(make_frame(0, 1000, 10, -100.0f));
+
+    zassert_equal(ch.end_uplink(a), RxOutcome::OK);
+    zassert_equal(ch.end_uplink(b), RxOutcome::OK);
+}
+
+ZTEST(netsim_channel_suite, test_gateway_half_duplex)
+{
+    Channel ch(6, 0, 1);
+
+    zassert_true(ch.reserve_downlink(500, 800));
+    zassert_false(ch.reserve_downlink(700, 900), "Gateway sends one downlink at a time");
+    zassert_true(ch.reserve_downlink(800, 900));
+
+    const uint32_t a = ch.begin_uplink(make_frame(0, 1000, 9, -100.0f));
+    const uint32_t b = ch.begin_uplink(make_frame(1000, 2000, 9, -100.0f));
+
+    zassert_equal(ch.end_uplink(a), RxOutcome::GATEWAY_BUSY);
+    zassert_equal(ch.end_uplink(b), RxOutcome::OK);
+}
+
+ZTEST(netsim_channel_suite, test_resolved_frames_pruned)
+{
+    Channel ch(6, 0, 1);
+
+    for (int64_t t = 0; t < 100000; t += 1000)
+    {
+        const uint32_t i = ch.begin_uplink(make_frame(t, t + 500, 9, -100.0f));
+        zassert_equal(ch.end_uplink(i), RxOutcome::OK);
+    }
+
+    zassert_true(ch.tracked() <= 1, "Tracked %u frames", (unsigned)ch.tracked());
+}
+
+ZTEST_SUITE(netsim_channel_suite, NULL, NULL, NULL, NULL, NULL);
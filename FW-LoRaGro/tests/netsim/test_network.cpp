@@ -0,0 +1,68 @@
+#include <zephyr/ztest.h>
+
+#include "netsim/network.hpp"
+
+using loragro::netsim::Network;
+using loragro::netsim::SimParams;
+using loragro::netsim::SimStats;
+
+static SimParams small_network()
+{
+    SimParams p = SimParams::defaults();
+    p.nodes = 20;
+    p.sf = 7;
+    p.interval_min = 5;
+    p.hours = 3;
+    p.measurements = 9;
+    p.assign_slots = true;
+    p.resync_min = 60;
+    p.radius_m = 500;
+    p.shadowing_db = 0;
+    p.boot_spread_s = 60;
+    p.seed = 7;
+    return p;
+}
+
+ZTEST(netsim_network_suite, test_light_load_delivers)
+{
+    Network net(small_network());
+    net.run();
+
+    const SimStats &s = net.stats();
+
+    zassert_true(s.cycles > 20 * 30, "Only %u cycles", (unsigned)s.cycles);
+    zassert_equal(s.uplinks_auth_failed, 0);
+    zassert_equal(s.acks_rejected, 0, "Gateway ACKs must pass Auth::verify_ack()");
+    zassert_equal(s.uplinks_below_sensitivity, 0);
+    zassert_true(s.measurements_delivered * 100 >= s.measurements_generated * 95,
+                 "Delivered %u of %u", (unsigned)s.measurements_delivered,
+                 (unsigned)s.measurements_generated);
+}
+
+ZTEST(netsim_network_suite, test_slots_and_sync)
+{
+    Network net(small_network());
+    net.run();
+
+    const SimStats &s = net.stats();
+
+    zassert_equal(s.slots_assigned, 20);
+    zassert_equal(s.slot_overflow, 0);
+    zassert_true(s.downlinks_ok >= 20, "Every node applies its first CONFIG");
+    zassert_true(s.responses_ok > 0);
+
+    for (uint32_t i = 0; i < net.node_count(); ++i)
+        zassert_true(net.node(i).synced, "Node %u never synced", i);
+}
+
+ZTEST(netsim_network_suite, test_deterministic)
+{
+    Network a(small_network());
+    Network b(small_network());
+
+    zassert_equal(a.run(), b.run());
+    zassert_equal(a.stats().measurements_delivered, b.stats().measurements_delivered);
+    zassert_equal(a.stats().charge_nAh, b.stats().charge_nAh);
+}
+
+ZTEST_SUITE(netsim_network_suite, NULL, NULL, NULL, NULL, NULL);
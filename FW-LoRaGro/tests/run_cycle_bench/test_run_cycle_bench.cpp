@@ -0,0 +1,226 @@
+#include <zephyr/ztest.h>
+
+#include "app.hpp"
+#include "cycle_profiler.hpp"
+#include "slot_scheduler.hpp"
+#include "regs/scd41_regs.h"
+
+using loragro::CyclePhase;
+using loragro::CycleProfiler;
+using loragro::PhaseStats;
+
+/*
+ * Whole App::run_cycle() on the fake driver set, CONFIG_BENCH_CYCLES
+ * times, per-phase timing from the CycleProfiler.
+ *
+ * Results go to the console as CSV rows prefixed with "bench," for CI
+ * to pick up; the limits below make the test (and twister) fail on a
+ * regression:
+ *
+ *   compute phases   simulated time per cycle <= CONFIG_BENCH_SIM_COMPUTE_MAX_US,
+ *                    native_sim runs code in zero time, so anything
+ *                    above is a new sleep or busy wait
+ *   sleep phases     simulated time per cycle <= the phase's expected
+ *                    sleeps + CONFIG_BENCH_SIM_SLEEP_SLACK_US (bus gaps,
+ *                    sensor command times)
+ *   radio phases     TX + ACK wait + RX per cycle <= TDMA slot width
+ *   in the slot      encode, sign, radio and downlink per cycle <= TDMA
+ *                    slot width; sampling runs before the slot, the
+ *                    scheduler wakes early by the measured TX lead
+ *   host CPU         mean per cycle <= budget * CONFIG_BENCH_HOST_BUDGET_PERCENT,
+ *                    with CONFIG_LORAGRO_CYCLE_PROFILER_HOST_CLOCK and
+ *                    a non-zero percentage
+ */
+
+enum class Bound : uint8_t
+{
+    COMPUTE, // no simulated time
+    SLEEP,   // expected sleeps, sim_ms
+    RADIO,   // bounded by the slot
+};
+
+struct PhaseLimit
+{
+    CyclePhase phase;
+    Bound bound;
+    bool in_slot;     // runs after the wake-up lead, inside the TDMA slot
+    uint32_t sim_ms;  // expected simulated sleeps per cycle (SLEEP only)
+    uint32_t host_us; // mean host CPU budget per cycle
+};
+
+/*
+ * Host budgets are rough guesses, not yet calibrated on a native_sim
+ * run: CONFIG_BENCH_HOST_BUDGET_PERCENT is 0 (report only) until they
+ * are set from the host_mean_us column of a recorded run.
+ */
+static constexpr PhaseLimit limits[] = {
+    {CyclePhase::CONFIG_LOAD, Bound::COMPUTE, false, 0, 2000},
+    {CyclePhase::RAIL_ON, Bound::SLEEP, false, 10, 500}, // rail settle
+    {CyclePhase::INIT, Bound::SLEEP, false, SCD41_WAKE_UP_MS, 5000},
+    /* SCD41 single shot; BME280 and probes overlap it */
+    {CyclePhase::SAMPLE, Bound::SLEEP, false,
+     SCD41_SINGLE_SHOT_MS + SCD41_READ_MEASUREMENT_MS + SCD41_POWER_DOWN_MS, 5000},
+    {CyclePhase::ENCODE, Bound::COMPUTE, true, 0, 1000},
+    {CyclePhase::SIGN, Bound::COMPUTE, true, 0, 1000},
+    {CyclePhase::TX, Bound::RADIO, true, 0, 1000},
+    {CyclePhase::ACK_WAIT, Bound::RADIO, true, 0, 20000},
+    {CyclePhase::RX, Bound::RADIO, true, 0, 50000},
+    {CyclePhase::DOWNLINK, Bound::COMPUTE, true, 0, 2000},
+    {CyclePhase::FLASH_SAVE, Bound::COMPUTE, false, 0, 5000},
+    {CyclePhase::SLEEP_CALC, Bound::COMPUTE, false, 0, 2000},
+};
+
+BUILD_ASSERT(ARRAY_SIZE(limits) == loragro::CYCLE_PHASE_COUNT, "Every phase needs a limit");
+
+static loragro::App app;
+
+static uint64_t mean(uint64_t total, uint32_t n)
+{
+    return n ? total / n : 0;
+}
+
+static int64_t sim_limit_us(const PhaseLimit &l)
+{
+    switch (l.bound)
+    {
+    case Bound::COMPUTE:
+        return CONFIG_BENCH_SIM_COMPUTE_MAX_US;
+    case Bound::SLEEP:
+        return static_cast<int64_t>(l.sim_ms) * 1000 + CONFIG_BENCH_SIM_SLEEP_SLACK_US;
+    default:
+        return -1;
+    }
+}
+
+static bool host_gated()
+{
+    return IS_ENABLED(CONFIG_LORAGRO_CYCLE_PROFILER_HOST_CLOCK) && CONFIG_BENCH_HOST_BUDGET_PERCENT > 0;
+}
+
+static uint32_t host_limit_us(uint32_t budget_us)
+{
+    return static_cast<uint32_t>(static_cast<uint64_t>(budget_us) * CONFIG_BENCH_HOST_BUDGET_PERCENT / 100);
+}
+
+static void *bench_setup(void)
+{
+    zassert_ok(app.init(), "App init failed");
+
+    /* Cold cycle: first NVS write, bus scan, wake-up without a slot */
+    app.run_cycle();
+
+    CycleProfiler::instance().reset();
+    for (int i = 0; i < CONFIG_BENCH_CYCLES; ++i)
+        app.run_cycle();
+
+    return nullptr;
+}
+
+ZTEST(run_cycle_bench_suite, test_report)
+{
+    const CycleProfiler &prof = CycleProfiler::instance();
+    const bool host = host_gated();
+
+    zassert_equal(prof.cycles(), CONFIG_BENCH_CYCLES, "Profiled %u cycles", prof.cycles());
+
+    printk("bench,phase,calls,cycles,sim_mean_us,sim_max_us,host_mean_us,host_max_us,"
+           "sim_limit_us,host_limit_us\n");
+
+    for (const PhaseLimit &l : limits)
+    {
+        const PhaseStats &s = prof.stats(l.phase);
+
+        printk("bench,%s,%u,%u,%llu,%u,%llu,%u,%lld,%u\n",
+               CycleProfiler::name(l.phase), s.calls, s.cycles,
+               mean(s.total_us, s.cycles), s.max_us,
+               mean(s.host_total_ns, s.cycles) / 1000, s.host_max_ns / 1000,
+               (long long)sim_limit_us(l), host ? host_limit_us(l.host_us) : 0);
+    }
+
+    const PhaseStats &a = prof.awake();
+    printk("bench,awake,%u,%u,%llu,%u,%llu,%u,-1,0\n",
+           a.calls, a.cycles, mean(a.total_us, a.cycles), a.max_us,
+           mean(a.host_total_ns, a.cycles) / 1000, a.host_max_ns / 1000);
+}
+
+ZTEST(run_cycle_bench_suite, test_every_phase_ran)
+{
+    const CycleProfiler &prof = CycleProfiler::instance();
+
+    for (const PhaseLimit &l : limits)
+    {
+        /* CONFIG comes every config-period cycles, not every cycle */
+        if (l.phase == CyclePhase::DOWNLINK)
+        {
+            zassert_true(prof.stats(l.phase).cycles > 0, "No downlink in %u cycles", prof.cycles());
+            continue;
+        }
+
+        zassert_equal(prof.stats(l.phase).cycles, prof.cycles(),
+                      "%s ran in %u of %u cycles", CycleProfiler::name(l.phase),
+                      prof.stats(l.phase).cycles, prof.cycles());
+    }
+
+    /* Perfect link: one TX per frame plus the RESPONSE, nothing retried */
+    const PhaseStats &tx = prof.stats(CyclePhase::TX);
+    const PhaseStats &ack = prof.stats(CyclePhase::ACK_WAIT);
+    zassert_true(tx.calls >= ack.calls &&
+                     tx.calls <= ack.calls + prof.stats(CyclePhase::DOWNLINK).cycles,
+                 "%u TX for %u confirmed frames", tx.calls, ack.calls);
+}
+
+ZTEST(run_cycle_bench_suite, test_sim_time_bounded)
+{
+    const CycleProfiler &prof = CycleProfiler::instance();
+
+    for (const PhaseLimit &l : limits)
+    {
+        if (l.bound == Bound::RADIO)
+            continue;
+
+        zassert_true(prof.stats(l.phase).max_us <= sim_limit_us(l),
+                     "%s took %u us simulated, limit %lld us", CycleProfiler::name(l.phase),
+                     prof.stats(l.phase).max_us, (long long)sim_limit_us(l));
+    }
+}
+
+ZTEST(run_cycle_bench_suite, test_radio_fits_slot)
+{
+    const CycleProfiler &prof = CycleProfiler::instance();
+    const loragro::DeviceConfig &cfg = loragro::ConfigManager::instance().get();
+    const uint32_t interval_ms = static_cast<uint32_t>(cfg.sample_interval_minutes) * 60U * 1000U;
+    const uint64_t slot_us = static_cast<uint64_t>(loragro::SlotScheduler::slot_width_ms(cfg, interval_ms)) * 1000U;
+
+    /* Sums of per-phase maxima, upper bounds of the worst cycle */
+    uint64_t radio_max_us = 0;
+    uint64_t in_slot_max_us = 0;
+    for (const PhaseLimit &l : limits)
+    {
+        if (l.bound == Bound::RADIO)
+            radio_max_us += prof.stats(l.phase).max_us;
+        if (l.in_slot)
+            in_slot_max_us += prof.stats(l.phase).max_us;
+    }
+
+    zassert_true(radio_max_us <= slot_us, "Radio %llu us, slot %llu us", radio_max_us, slot_us);
+    zassert_true(in_slot_max_us <= slot_us, "In slot %llu us, slot %llu us", in_slot_max_us, slot_us);
+}
+
+ZTEST(run_cycle_bench_suite, test_host_cpu_budget)
+{
+    if (!host_gated())
+        ztest_test_skip();
+
+    const CycleProfiler &prof = CycleProfiler::instance();
+
+    for (const PhaseLimit &l : limits)
+    {
+        const PhaseStats &s = prof.stats(l.phase);
+        const uint64_t mean_us = mean(s.host_total_ns, s.cycles) / 1000;
+
+        zassert_true(mean_us <= host_limit_us(l.host_us), "%s: %llu us host CPU per cycle, budget %u us",
+                     CycleProfiler::name(l.phase), mean_us, host_limit_us(l.host_us));
+    }
+}
+
+ZTEST_SUITE(run_cycle_bench_suite, NULL, bench_setup, NULL, NULL, NULL);
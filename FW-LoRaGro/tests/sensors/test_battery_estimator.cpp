@@ -0,0 +1,116 @@
+#include <zephyr/ztest.h>
+
+#include "battery_estimator.hpp"
+#include "energy_ledger.hpp"
+
+using loragro::BatteryEstimator;
+using loragro::EnergyComponent;
+
+static loragro::DeviceConfig make_cfg()
+{
+    loragro::DeviceConfig cfg{};
+    cfg.sample_interval_minutes = 15;
+    cfg.sample_interval_min_low_battery = 240;
+    cfg.battery_cutoff_mv = 3300;
+    cfg.battery_critical_mv = 3600;
+    cfg.battery_capacity_mah = 2600;
+    cfg.battery_target_days = 365;
+    cfg.lora.tx_power = 14;
+    return cfg;
+}
+
+static loragro::EnergyReport make_report(uint32_t awake_nAh)
+{
+    loragro::EnergyReport r{};
+    r.charge_nAh[static_cast<size_t>(EnergyComponent::SLEEP)] = 500;
+    r.total_nAh = awake_nAh + 500;
+    r.cycle = 1;
+    return r;
+}
+
+ZTEST(battery_estimator_suite, test_soc_curve)
+{
+    zassert_equal(BatteryEstimator::soc_from_ocv(4300), 1000);
+    zassert_equal(BatteryEstimator::soc_from_ocv(3840), 500);
+    zassert_equal(BatteryEstimator::soc_from_ocv(3200), 0);
+
+    /* Monotonic between curve points */
+    zassert_true(BatteryEstimator::soc_from_ocv(3900) > BatteryEstimator::soc_from_ocv(3880));
+}
+
+ZTEST(battery_estimator_suite, test_load_compensation_and_filter)
+{
+    const loragro::DeviceConfig cfg = make_cfg();
+    BatteryEstimator est(cfg);
+
+    zassert_false(est.valid());
+
+    /* 10 mA over R_int lifts the reading to OCV */
+    const int32_t sag = 10000 * CONFIG_LORAGRO_BATTERY_R_INT_MOHM / 1000000;
+    est.update(3900, 10000);
+    zassert_equal(est.ocv_mv(), 3900 + sag);
+
+    /* One outlier only moves the filtered value by 1/8 */
+    est.update(3500, 10000);
+    zassert_within(est.ocv_mv(), 3900 + sag - 50, 2, "OCV %d", est.ocv_mv());
+}
+
+ZTEST(battery_estimator_suite, test_stride_follows_cycle_energy)
+{
+    const loragro::DeviceConfig cfg = make_cfg();
+    BatteryEstimator est(cfg);
+
+    est.update(4000, 0);
+
+    /* No cycle energy measured yet, keep base interval */
+    zassert_equal(est.interval_stride(), 1);
+
+    /* Budget = 2600 mAh / 365 d ~ 296 uA, 10 uAh per 15 min is well below */
+    est.account_cycle(make_report(10000));
+    zassert_equal(est.interval_stride(), 1);
+
+    /* 1000 uAh per cycle needs ~3.4 h period at 296 uA */
+    BatteryEstimator heavy(cfg);
+    heavy.update(4000, 0);
+    heavy.account_cycle(make_report(1000000));
+    zassert_equal(heavy.interval_stride(), 14, "stride %u", heavy.interval_stride());
+    zassert_true(heavy.hours_to_cutoff(14) > 0);
+}
+
+ZTEST(battery_estimator_suite, test_taper_below_critical)
+{
+    const loragro::DeviceConfig cfg = make_cfg();
+    BatteryEstimator full(cfg);
+    BatteryEstimator low(cfg);
+
+    full.update(4000, 0);
+    low.update(3350, 0);
+
+    full.account_cycle(make_report(200000));
+    low.account_cycle(make_report(200000));
+
+    zassert_true(low.interval_stride() > full.interval_stride(),
+                 "low %u full %u", low.interval_stride(), full.interval_stride());
+    zassert_true(low.interval_stride() <= low.max_stride());
+
+    BatteryEstimator dead(cfg);
+    dead.update(3200, 0);
+    dead.account_cycle(make_report(200000));
+    zassert_equal(dead.interval_stride(), dead.max_stride());
+}
+
+ZTEST(battery_estimator_suite, test_tx_power_cap)
+{
+    loragro::DeviceConfig cfg = make_cfg();
+    BatteryEstimator est(cfg);
+
+    est.update(4100, 0);
+    zassert_equal(est.tx_power_cap_dbm(), 14);
+
+    /* Close to cutoff the TX burst would brown out, power is backed off */
+    BatteryEstimator weak(cfg);
+    weak.update(cfg.battery_cutoff_mv + 105, 0);
+    zassert_true(weak.tx_power_cap_dbm() < 14);
+}
+
+ZTEST_SUITE(battery_estimator_suite, NULL, NULL, NULL, NULL, NULL);
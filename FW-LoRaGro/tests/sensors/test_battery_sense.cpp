@@ -56,4 +56,27 @@ ZTEST_F(battery_sense_suite, test_sample_ramp)
         zassert_true(mv > 1000, "Too low iter %d: %d mV", i, mv);
         zassert_true(mv < 5000, "Too high iter %d: %d mV", i, mv);
     }
-}
\ No newline at end of file
+}
+
+/* Soil and battery come out of the same (averaged) scan */
+ZTEST_F(battery_sense_suite, test_shared_scan)
+{
+    loragro::AdcChannelGroup &adc = loragro::AdcChannelGroup::instance(DEVICE_DT_GET(ADC_NODE));
+
+    int soil = adc.slot(DT_IO_CHANNELS_INPUT_BY_IDX(DT_PATH(zephyr_user), 0));
+    int battery = adc.slot(BATTERY_ADC_CHANNEL);
+    zassert_true(soil >= 0 && battery >= 0, "slots %d %d", soil, battery);
+    zassert_not_equal(soil, battery, "channels share a slot");
+    zassert_true(soil < ADC_GROUP_SIZE && battery < ADC_GROUP_SIZE, "slot past the average row");
+
+    int ret = adc.scan();
+    zassert_equal(ret, 0, "scan() failed: %d", ret);
+
+    /* The next sample reuses it */
+    int16_t raw = adc.raw(battery);
+    ret = fixture->bat->sample();
+    zassert_equal(ret, 0, "sample() failed: %d", ret);
+    zassert_equal(adc.raw(battery), raw, "sample() converted again");
+    zassert_true(raw > 0 && static_cast<uint32_t>(raw) <= loragro::AdcChannelGroup::MAX_RAW,
+                 "raw out of range: %d", raw);
+}
@@ -0,0 +1,159 @@
+#include <zephyr/ztest.h>
+#include <math.h>
+
+#include "bme280/bme280_forced.hpp"
+#include "bme280/bme280_sim.hpp"
+#include "sensors/bme280_adapter.hpp"
+#include "data_types.hpp"
+
+using namespace loragro;
+
+/* Floating point humidity formula from the datasheet, reference only */
+static double humidity_reference(const bme280::Calibration &c, int32_t adc_H, int32_t t_fine)
+{
+    double h = t_fine - 76800.0;
+    h = (adc_H - (c.dig_H4 * 64.0 + c.dig_H5 / 16384.0 * h)) *
+        (c.dig_H2 / 65536.0 * (1.0 + c.dig_H6 / 67108864.0 * h * (1.0 + c.dig_H3 / 67108864.0 * h)));
+    h = h * (1.0 - c.dig_H1 * h / 524288.0);
+    return h < 0.0 ? 0.0 : (h > 100.0 ? 100.0 : h);
+}
+
+static bme280::Calibration sim_calibration(Bme280Sim &sim)
+{
+    uint8_t c00[bme280::CALIB_00_LEN];
+    uint8_t c26[bme280::CALIB_26_LEN];
+    sim.read(bme280::REG_CALIB_00, c00, sizeof(c00));
+    sim.read(bme280::REG_CALIB_26, c26, sizeof(c26));
+    return bme280::Calibration::parse(c00, c26);
+}
+
+ZTEST_SUITE(bme280_forced_suite, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(bme280_forced_suite, test_calibration_parse)
+{
+    Bme280Sim sim;
+    bme280::Calibration c = sim_calibration(sim);
+
+    zassert_equal(c.dig_T1, 27504);
+    zassert_equal(c.dig_T3, -1000);
+    zassert_equal(c.dig_P9, 6000);
+    zassert_equal(c.dig_H1, Bme280Sim::NVM_H1);
+    zassert_equal(c.dig_H2, Bme280Sim::NVM_H2);
+    zassert_equal(c.dig_H4, Bme280Sim::NVM_H4, "H4 nibble packing: %d", c.dig_H4);
+    zassert_equal(c.dig_H5, Bme280Sim::NVM_H5, "H5 nibble packing: %d", c.dig_H5);
+    zassert_equal(c.dig_H6, Bme280Sim::NVM_H6);
+}
+
+/* BMP280/BME280 datasheet example: adc_T 519888 -> 25.08 degC, adc_P 415148 -> 100653.27 Pa */
+ZTEST(bme280_forced_suite, test_compensation_datasheet_vector)
+{
+    Bme280Sim sim;
+    bme280::Calibration c = sim_calibration(sim);
+
+    int32_t t_fine = 0;
+    zassert_equal(bme280::compensate_temperature(c, 519888, t_fine), 2508);
+    zassert_equal(t_fine, 128422);
+
+    const double pa = bme280::compensate_pressure(c, 415148, t_fine) / 256.0;
+    zassert_true(fabs(pa - 100653.27) < 0.1, "pressure %d.%02d Pa",
+                 (int)pa, (int)((pa - (int)pa) * 100));
+
+    for (int32_t adc_H = 20000; adc_H <= 40000; adc_H += 2500)
+    {
+        const double rh = bme280::compensate_humidity(c, adc_H, t_fine) / 1024.0;
+        zassert_true(fabs(rh - humidity_reference(c, adc_H, t_fine)) < 0.01,
+                     "adc_H %d: integer result off the reference", adc_H);
+    }
+}
+
+ZTEST(bme280_forced_suite, test_forced_conversion_timing)
+{
+    Bme280Sim sim;
+    Bme280Forced drv(sim, {bme280::OSRS_X1, bme280::OSRS_X1, bme280::OSRS_X1});
+    Bme280Sample s;
+
+    zassert_equal(drv.init(), 0);
+
+    /* 1.25 + 2.3 + 2.875 + 2.875 ms */
+    zassert_equal(drv.measurement_time_us(), 9300);
+    int wait_ms = drv.start();
+    zassert_equal(wait_ms, 10);
+
+    zassert_equal(drv.read(s), -EBUSY, "data read while measuring");
+
+    k_msleep(wait_ms);
+    zassert_equal(drv.read(s), 0);
+    zassert_true(s.has_pressure && s.has_humidity);
+    zassert_equal(sim.conversions(), 1);
+}
+
+ZTEST(bme280_forced_suite, test_one_burst_read_per_sample)
+{
+    Bme280Sim sim;
+    Bme280Forced drv(sim);
+    Bme280Sample s;
+
+    zassert_equal(drv.init(), 0);
+
+    sim.reset_stats();
+    k_msleep(drv.start());
+    zassert_equal(drv.read(s), 0);
+
+    zassert_equal(sim.writes(), 2, "ctrl_hum + ctrl_meas");
+    zassert_equal(sim.reads(), 1, "status and data in one transaction");
+}
+
+ZTEST(bme280_forced_suite, test_calibration_cached_across_rail_cycles)
+{
+    Bme280Sim sim;
+    Bme280Forced drv(sim);
+
+    zassert_equal(drv.init(), 0);
+    zassert_true(drv.calibrated());
+
+    /* Rail cycle: only the chip ID is read */
+    sim.reset_stats();
+    zassert_equal(drv.init(), 0);
+    zassert_equal(sim.reads(), 1);
+    zassert_equal(sim.bytes_read(), 1);
+
+    /* MCU reset: RAM copy gone, restored from NVS instead of the chip */
+    drv.drop_calibration_cache();
+    sim.reset_stats();
+    zassert_equal(drv.init(), 0);
+    zassert_equal(sim.bytes_read(), 1, "calibration re-read from chip");
+    zassert_equal(drv.calibration().dig_P1, 36477);
+}
+
+ZTEST(bme280_forced_suite, test_adapter_units_and_skipped_channels)
+{
+    Bme280Sim sim;
+    sim.set_raw(Bme280Sim::DEFAULT_ADC_T, Bme280Sim::DEFAULT_ADC_P, Bme280Sim::DEFAULT_ADC_H);
+
+    Bme280Forced drv(sim, {bme280::OSRS_X2, bme280::OSRS_X16, bme280::OSRS_X1});
+    Bme280Adapter env(drv, SensorID::ENV_TEMP, SensorID::ENV_RH, SensorID::ENV_PRESS);
+
+    zassert_equal(env.init(), 0);
+    zassert_equal(env.sample(), 0);
+    zassert_equal(env.count(), 3);
+
+    const Measurement *m = env.get_measurements();
+    zassert_equal(m[0].sensor_id, SensorID::ENV_TEMP);
+    zassert_equal(m[0].value.val1, 25);
+    zassert_equal(m[0].value.val2, 80000);
+    zassert_equal(m[1].sensor_id, SensorID::ENV_RH);
+    zassert_equal(m[1].value.val1, 54);
+    zassert_equal(m[2].sensor_id, SensorID::ENV_PRESS);
+    zassert_equal(m[2].value.val1, 100, "kPa");
+    zassert_true(m[2].value.val2 > 650000 && m[2].value.val2 < 660000);
+
+    /* Temperature only: shorter conversion, one entry */
+    Bme280Forced temp_only(sim, {bme280::OSRS_X1, bme280::OSRS_SKIP, bme280::OSRS_SKIP});
+    Bme280Adapter env_t(temp_only, SensorID::ENV_TEMP, SensorID::ENV_RH, SensorID::ENV_PRESS);
+
+    zassert_true(temp_only.measurement_time_us() < drv.measurement_time_us());
+    zassert_equal(env_t.init(), 0);
+    zassert_equal(env_t.sample(), 0);
+    zassert_equal(env_t.count(), 1);
+    zassert_equal(env_t.get_measurements()[0].sensor_id, SensorID::ENV_TEMP);
+}
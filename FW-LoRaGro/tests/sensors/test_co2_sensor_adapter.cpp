@@ -1,6 +1,9 @@
 #include <zephyr/ztest.h>
 
 #include "sensors/co2_sensor_adapter.hpp"
+#include "sample_manager.hpp"
+#include "co2_asc.hpp"
+#include "scd41/scd41_fake_bus.hpp"
 #include "data_types.hpp"
 
 static const struct device *const co2_sensor_dev =
@@ -15,8 +18,9 @@ static struct co2_sensor_adapter_suite_fixture g_fixture;
 
 static void *co2_sensor_adapter_suite_setup(void)
 {
+    static loragro::Scd41FakeBus co2_bus(co2_sensor_dev);
     static loragro::CO2SensorAdapter co2_sensor(
-        co2_sensor_dev,
+        co2_bus,
         loragro::SensorID::CO2_CONC,
         loragro::SensorID::CO2_TEMP,
         loragro::SensorID::CO2_RH);
@@ -37,6 +41,9 @@ ZTEST_F(co2_sensor_adapter_suite, test_co2_init)
 
 ZTEST_F(co2_sensor_adapter_suite, test_co2_sample)
 {
+    /* Previous reading left the sensor powered down */
+    zassert_equal(fixture->co2_sensor->init(), 0);
+
     int ret = fixture->co2_sensor->sample();
     zassert_equal(ret, 0, "sample() failed: %d", ret);
 
@@ -47,4 +54,149 @@ ZTEST_F(co2_sensor_adapter_suite, test_co2_sample)
     zassert_true(co2 >= 400 && co2 <= 5000, "CO2 out of range: %d ppm", co2);
     zassert_true(temp >= 0 && temp <= 50, "Temp out of range: %d C", temp);
     zassert_true(hum >= 0 && hum <= 100, "Humidity out of range: %d%%", hum);
-}
\ No newline at end of file
+}
+static int32_t scd41_stat(int attr)
+{
+    struct sensor_value val = {};
+    sensor_attr_get(co2_sensor_dev, SENSOR_CHAN_CO2, (enum sensor_attribute)attr, &val);
+    return val.val1;
+}
+
+ZTEST_F(co2_sensor_adapter_suite, test_co2_single_shot_timing)
+{
+    loragro::CO2SensorAdapter *co2 = fixture->co2_sensor;
+
+    zassert_equal(co2->init(), 0);
+
+    int64_t t0 = k_uptime_get();
+    int ready_in = co2->start();
+    zassert_equal(ready_in, SCD41_SINGLE_SHOT_MS, "start() must report the conversion time");
+
+    /* Conversion still running, data not ready */
+    zassert_equal(sensor_sample_fetch(co2_sensor_dev), -EBUSY);
+
+    zassert_equal(co2->sample(), 0);
+    zassert_true(k_uptime_get() - t0 >= SCD41_SINGLE_SHOT_MS, "read before conversion done");
+
+    /* Sensor is powered down after the reading */
+    zassert_equal(sensor_sample_fetch(co2_sensor_dev), -EIO);
+}
+
+ZTEST_F(co2_sensor_adapter_suite, test_co2_onchip_asc_off_once)
+{
+    loragro::CO2SensorAdapter *co2 = fixture->co2_sensor;
+
+    /* Every init() is a rail cycle, the EEPROM is written only the first time */
+    for (int i = 0; i < 3; ++i)
+        zassert_equal(co2->init(), 0);
+
+    struct sensor_value val = {};
+    zassert_equal(sensor_attr_get(co2_sensor_dev, SENSOR_CHAN_CO2,
+                                  (enum sensor_attribute)SCD41_ATTR_ASC_ENABLED, &val),
+                  0);
+    zassert_equal(val.val1, 0, "on-chip ASC must be disabled");
+    zassert_equal(scd41_stat(SCD41_FAKE_ATTR_EEPROM_WRITES), 1);
+}
+
+/* Benchmark: sensor awake time per CO2 reading, datasheet floor is 5 s + wake-up */
+ZTEST_F(co2_sensor_adapter_suite, test_co2_awake_ms_per_reading)
+{
+    loragro::CO2SensorAdapter *co2 = fixture->co2_sensor;
+    const int cycles = 5;
+
+    zassert_equal(co2->init(), 0);
+    int32_t awake0 = scd41_stat(SCD41_FAKE_ATTR_AWAKE_MS);
+    int32_t readings0 = scd41_stat(SCD41_FAKE_ATTR_READINGS);
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        zassert_equal(co2->init(), 0);
+        zassert_true(co2->start() > 0);
+        zassert_equal(co2->sample(), 0);
+    }
+
+    int32_t readings = scd41_stat(SCD41_FAKE_ATTR_READINGS) - readings0;
+    int32_t per_reading = (scd41_stat(SCD41_FAKE_ATTR_AWAKE_MS) - awake0) / readings;
+
+    TC_PRINT("SCD41 awake %d ms per reading (%d readings)\n", per_reading, readings);
+    zassert_equal(readings, cycles);
+    zassert_true(per_reading <= SCD41_SINGLE_SHOT_MS + SCD41_WAKE_UP_MS + 10,
+                 "awake %d ms per reading", per_reading);
+}
+
+/* Fast sensor that takes a fixed time to sample */
+class SlowReadSensor : public loragro::Sensor<1>
+{
+public:
+    int init() override { return 0; }
+    int sample() override
+    {
+        k_msleep(SAMPLE_MS);
+        measurements_[0].sensor_id = loragro::SensorID::AMB_LIGHT;
+        return 0;
+    }
+    int is_connected() override { return 0; }
+    const char *getName() const override { return "slow read"; }
+
+    static constexpr int SAMPLE_MS = 200;
+};
+
+ZTEST_F(co2_sensor_adapter_suite, test_co2_conversion_overlaps_other_sensors)
+{
+    static loragro::SampleManager mgr;
+    static SlowReadSensor other[3];
+    static bool registered;
+
+    if (!registered)
+    {
+        mgr.add_sensor(fixture->co2_sensor);
+        for (auto &s : other)
+            mgr.add_sensor(&s);
+        registered = true;
+    }
+
+    zassert_equal(mgr.init_all(), 0);
+
+    int64_t t0 = k_uptime_get();
+    zassert_equal(mgr.sample_all(), 0);
+    int64_t took = k_uptime_get() - t0;
+
+    TC_PRINT("sample_all with SCD41 + 3 x %d ms sensors: %lld ms\n", SlowReadSensor::SAMPLE_MS, (long long)took);
+    zassert_equal(mgr.batch_size(), 3 + ARRAY_SIZE(other));
+    zassert_true(took < SCD41_SINGLE_SHOT_MS + SlowReadSensor::SAMPLE_MS,
+                 "conversion not overlapped: %lld ms", (long long)took);
+}
+
+ZTEST(co2_sensor_adapter_suite, test_co2_asc_window)
+{
+    loragro::Co2Asc asc;
+    const uint32_t step_s = 15 * 60;
+    uint32_t t = 0;
+
+    /* One window whose freshest air reads 40 ppm high */
+    for (; t <= loragro::Co2Asc::PERIOD_S; t += step_s)
+    {
+        int32_t raw = (t % (24 * 3600) == 0) ? 440 : 900;
+        zassert_equal(asc.apply(raw, t), raw, "no correction before the first window ends");
+    }
+
+    zassert_equal(asc.windows(), 1);
+    zassert_equal(asc.offset_ppm(), -40);
+    zassert_equal(asc.apply(440, t), 400);
+
+    /* Steps are limited per window */
+    for (t += step_s; asc.windows() < 2; t += step_s)
+        asc.apply(100, t);
+
+    zassert_equal(asc.offset_ppm(), -40 + loragro::Co2Asc::MAX_STEP_PPM);
+}
+
+/* Datasheet examples: CRC of 0xBEEF, word conversion */
+ZTEST(co2_sensor_adapter_suite, test_scd41_framing)
+{
+    const uint8_t word[] = {0xBE, 0xEF};
+    zassert_equal(loragro::scd41::crc8(word, sizeof(word)), 0x92);
+
+    zassert_equal(loragro::scd41::temp_milli_c(0x6667), 25002);
+    zassert_equal(loragro::scd41::rh_milli(0x5EB9), 37001);
+}
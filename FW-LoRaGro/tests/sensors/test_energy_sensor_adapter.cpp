@@ -0,0 +1,83 @@
+#include <zephyr/ztest.h>
+
+#include "sensors/energy_sensor_adapter.hpp"
+#include "energy_ledger.hpp"
+#include "data_types.hpp"
+
+using loragro::EnergyComponent;
+using loragro::EnergyLedger;
+
+ZTEST(energy_ledger_suite, test_charge_model)
+{
+    /* 45 mA for 1 s = 12.5 uAh */
+    zassert_equal(EnergyLedger::charge_nAh(45000, 1000000), 12500);
+
+    /* 3 uA sleep for 2 h does not overflow */
+    zassert_equal(EnergyLedger::charge_nAh(3, 2ULL * 3600 * 1000000), 6000);
+}
+
+ZTEST(energy_ledger_suite, test_cycle_accounting)
+{
+    EnergyLedger &ledger = EnergyLedger::instance();
+
+    ledger.begin_cycle();
+
+    ledger.start(EnergyComponent::RADIO_TX);
+    k_sleep(K_MSEC(100));
+    ledger.stop(EnergyComponent::RADIO_TX);
+
+    {
+        loragro::EnergyScope scope(EnergyComponent::RADIO_TX);
+        k_sleep(K_MSEC(100));
+    }
+
+    /* Left open on purpose, end_cycle() has to close it */
+    ledger.start(EnergyComponent::SENSOR_RAIL);
+    k_sleep(K_MSEC(50));
+
+    ledger.end_cycle();
+
+    const loragro::EnergyReport &r = ledger.last_report();
+    const size_t tx = static_cast<size_t>(EnergyComponent::RADIO_TX);
+    const size_t rail = static_cast<size_t>(EnergyComponent::SENSOR_RAIL);
+    const size_t mcu = static_cast<size_t>(EnergyComponent::MCU_ACTIVE);
+
+    zassert_true(ledger.valid());
+    zassert_equal(r.events[tx], 2, "TX events: %u", r.events[tx]);
+    zassert_within(r.active_us[tx], 200000, 2000, "TX time: %u us", r.active_us[tx]);
+    zassert_within(r.active_us[rail], 50000, 2000, "Rail time: %u us", r.active_us[rail]);
+    zassert_true(r.active_us[mcu] >= r.active_us[tx] + r.active_us[rail]);
+
+    zassert_equal(r.charge_nAh[tx],
+                  EnergyLedger::charge_nAh(CONFIG_LORAGRO_ENERGY_RADIO_TX_UA, r.active_us[tx]));
+}
+
+ZTEST(energy_ledger_suite, test_sensor_reports_previous_cycle)
+{
+    EnergyLedger &ledger = EnergyLedger::instance();
+
+    ledger.begin_cycle();
+    {
+        loragro::EnergyScope scope(EnergyComponent::RADIO_RX);
+        k_sleep(K_MSEC(200));
+    }
+    ledger.end_cycle();
+
+    const loragro::EnergyReport &r = ledger.last_report();
+    const size_t rx = static_cast<size_t>(EnergyComponent::RADIO_RX);
+
+    loragro::EnergySensorAdapter energy;
+    zassert_equal(energy.init(), 0);
+    zassert_equal(energy.sample(), 0);
+
+    const loragro::Measurement *m = energy.measurements();
+    zassert_equal(energy.count(), 4);
+    zassert_equal(m[0].sensor_id, loragro::SensorID::ENERGY_TOTAL);
+    zassert_true(loragro::SensorID::is_telemetry(m[1].sensor_id));
+
+    /* 10 nAh units */
+    zassert_equal(m[0].value.val1, static_cast<int32_t>(r.total_nAh / 10));
+    zassert_equal(m[1].value.val2, static_cast<int32_t>(r.charge_nAh[rx] / 10));
+}
+
+ZTEST_SUITE(energy_ledger_suite, NULL, NULL, NULL, NULL, NULL);
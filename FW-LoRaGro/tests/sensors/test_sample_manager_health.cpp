@@ -0,0 +1,209 @@
+#include <zephyr/ztest.h>
+
+#include "sample_manager.hpp"
+#include "sensors/sensor.hpp"
+#include "sensor_health.hpp"
+#include "data_types.hpp"
+
+using namespace loragro;
+
+/* Sensor whose init / sample results are scripted by the test */
+class ScriptedSensor : public Sensor<1>
+{
+public:
+    explicit ScriptedSensor(uint8_t id) { measurements_[0].sensor_id = id; }
+
+    int init() override
+    {
+        inits++;
+        return init_err;
+    }
+
+    int sample() override
+    {
+        samples++;
+        measurements_[0].value.val1 = 1;
+        return sample_err;
+    }
+
+    int is_connected() override { return 0; }
+    const char *getName() const override { return "scripted"; }
+
+    int init_err = 0;
+    int sample_err = 0;
+    int inits = 0;
+    int samples = 0;
+};
+
+static bool batch_has(const BatchView &batch, uint8_t id)
+{
+    for (size_t i = 0; i < batch.count; ++i)
+    {
+        if (batch.data[i].sensor_id == id)
+            return true;
+    }
+    return false;
+}
+
+static int run_cycle(SampleManager &mgr)
+{
+    mgr.init_all();
+    return mgr.sample_all();
+}
+
+ZTEST_SUITE(sample_manager_health_suite, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(sample_manager_health_suite, test_backoff_schedule)
+{
+    const uint8_t expected[] = {0, 1, 3, 7, 15, 31};
+
+    for (uint8_t n = 1; n <= ARRAY_SIZE(expected); ++n)
+        zassert_equal(SensorHealth::backoff_cycles(n), MIN(expected[n - 1], SensorHealth::MAX_BACKOFF_CYCLES));
+
+    zassert_equal(SensorHealth::backoff_cycles(200), SensorHealth::MAX_BACKOFF_CYCLES);
+}
+
+ZTEST(sample_manager_health_suite, test_failing_sensor_does_not_drop_batch)
+{
+    SampleManager mgr;
+    ScriptedSensor good_a(SensorID::ENV_TEMP);
+    ScriptedSensor bad(SensorID::SOIL_EC);
+    ScriptedSensor good_b(SensorID::AMB_LIGHT);
+
+    mgr.add_sensor(&good_a);
+    mgr.add_sensor(&bad);
+    mgr.add_sensor(&good_b);
+
+    bad.sample_err = -ETIMEDOUT;
+    zassert_equal(run_cycle(mgr), 0);
+
+    BatchView batch = mgr.get_batch();
+    zassert_true(batch_has(batch, SensorID::ENV_TEMP));
+    zassert_true(batch_has(batch, SensorID::AMB_LIGHT));
+    zassert_false(batch_has(batch, SensorID::SOIL_EC));
+
+    /* Health entry: bit 1 failed this cycle */
+    const Measurement &h = batch.data[batch.count - 1];
+    zassert_equal(h.sensor_id, SensorID::DIAG_SENSOR_HEALTH);
+    zassert_equal(h.value.val1, BIT(1));
+    zassert_equal(h.value.val2, 0);
+
+    zassert_equal(mgr.health(1).last_error, -ETIMEDOUT);
+    zassert_equal(mgr.health(1).consecutive_failures, 1);
+}
+
+ZTEST(sample_manager_health_suite, test_init_failure_isolated_and_backed_off)
+{
+    SampleManager mgr;
+    ScriptedSensor bad(SensorID::CO2_CONC);
+    ScriptedSensor good(SensorID::ENV_TEMP);
+
+    mgr.add_sensor(&bad);
+    mgr.add_sensor(&good);
+    bad.init_err = -EIO;
+
+    /* Attempts at cycles 0, 1, 3, 7: skip 0, 1, 3 cycles between them */
+    int attempts_at[4];
+    int attempts = 0;
+    for (int cycle = 0; cycle < 8; ++cycle)
+    {
+        int before = bad.inits;
+        zassert_equal(run_cycle(mgr), 0);
+        if (bad.inits != before && attempts < 4)
+            attempts_at[attempts++] = cycle;
+
+        zassert_true(batch_has(mgr.get_batch(), SensorID::ENV_TEMP), "cycle %d lost data", cycle);
+    }
+
+    zassert_equal(attempts, 4);
+    zassert_equal(attempts_at[0], 0);
+    zassert_equal(attempts_at[1], 1);
+    zassert_equal(attempts_at[2], 3);
+    zassert_equal(attempts_at[3], 7);
+    zassert_equal(bad.samples, 0, "sample() on a sensor whose init failed");
+
+    /* Backing off: reported as quarantined, not touched */
+    zassert_equal(run_cycle(mgr), 0);
+    zassert_equal(mgr.quarantined_mask(), BIT(0));
+    zassert_equal(mgr.failed_mask(), 0);
+}
+
+ZTEST(sample_manager_health_suite, test_recovery_clears_health)
+{
+    SampleManager mgr;
+    ScriptedSensor flaky(SensorID::ENV_RH);
+
+    mgr.add_sensor(&flaky);
+
+    flaky.sample_err = -EIO;
+    zassert_equal(run_cycle(mgr), -EIO, "empty batch reports the error");
+    zassert_equal(run_cycle(mgr), -EIO);
+    zassert_true(mgr.health(0).quarantined());
+
+    flaky.sample_err = 0;
+    while (mgr.health(0).quarantined())
+        run_cycle(mgr);
+
+    zassert_equal(run_cycle(mgr), 0);
+    zassert_equal(mgr.health(0).consecutive_failures, 0);
+    zassert_equal(mgr.health(0).failures_total, 2);
+
+    /* Healthy batch carries no health entry */
+    BatchView batch = mgr.get_batch();
+    zassert_equal(batch.count, 1);
+    zassert_equal(batch.data[0].sensor_id, SensorID::ENV_RH);
+}
+
+/* Sensor with more entries than a batch has room for twice */
+class BulkSensor : public Sensor<200>
+{
+public:
+    explicit BulkSensor(uint8_t id)
+    {
+        for (auto &m : measurements_)
+            m.sensor_id = id;
+    }
+
+    int init() override { return 0; }
+    int sample() override { return 0; }
+    int is_connected() override { return 0; }
+    const char *getName() const override { return "bulk"; }
+};
+
+/* One entry, conversion started in phase 1 and read out in phase 3 */
+class SlowSensor : public ScriptedSensor
+{
+public:
+    using ScriptedSensor::ScriptedSensor;
+    int start() override { return 5; }
+};
+
+ZTEST(sample_manager_health_suite, test_full_batch_keeps_health_entry)
+{
+    SampleManager mgr;
+    ScriptedSensor bad(SensorID::SOIL_EC);
+    BulkSensor bulk_a(SensorID::ENV_TEMP);
+    BulkSensor bulk_b(SensorID::ENV_RH);
+    SlowSensor slow(SensorID::CO2_CONC);
+
+    mgr.add_sensor(&bad);
+    mgr.add_sensor(&bulk_a);
+    mgr.add_sensor(&bulk_b);
+    mgr.add_sensor(&slow);
+    bad.sample_err = -EIO;
+
+    zassert_equal(run_cycle(mgr), -ENOMEM);
+
+    /* bulk_b does not fit as a whole and is left out, not cut off */
+    BatchView batch = mgr.get_batch();
+    zassert_equal(batch.count, 200 + 1 + 1);
+    zassert_false(batch_has(batch, SensorID::ENV_RH));
+
+    /* The slow conversion is still collected after the overflow */
+    zassert_equal(slow.samples, 1);
+    zassert_equal(batch.data[batch.count - 2].sensor_id, SensorID::CO2_CONC);
+
+    const Measurement &h = batch.data[batch.count - 1];
+    zassert_equal(h.sensor_id, SensorID::DIAG_SENSOR_HEALTH);
+    zassert_equal(h.value.val1, BIT(0));
+}
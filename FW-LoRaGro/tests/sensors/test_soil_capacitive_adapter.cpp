@@ -48,3 +48,56 @@ ZTEST_F(soil_capacitive_adapter_suite, test_sample)
         zassert_true(mv < 100, "Measurement out of range, too high: %d", mv);
     }
 }
+
+/* Piecewise linear reference, the former search based conversion */
+static int reference_percent(const loragro::SoilLutPoint *lut, size_t n, int32_t mv)
+{
+    if (mv >= lut[0].mv)
+        return lut[0].moisture;
+    if (mv <= lut[n - 1].mv)
+        return lut[n - 1].moisture;
+
+    for (size_t i = 0; i < n - 1; i++)
+    {
+        if (mv <= lut[i].mv && mv >= lut[i + 1].mv)
+        {
+            return lut[i].moisture + (lut[i + 1].moisture - lut[i].moisture) *
+                                         (lut[i].mv - mv) / (lut[i].mv - lut[i + 1].mv);
+        }
+    }
+    return 0;
+}
+
+ZTEST(soil_capacitive_adapter_suite, test_uniform_lut_matches_curve)
+{
+    using namespace SoilSensorConstants;
+
+    for (int32_t mv = -100; mv <= 4200; mv += 7)
+    {
+        const int expected = reference_percent(SOIL_LUT, SOIL_LUT_SIZE, mv);
+        const int actual = loragro::DEFAULT_SOIL_CALIBRATION.percent(mv);
+        zassert_within(actual, expected, 1, "mv %d: lut %d, curve %d", mv, actual, expected);
+    }
+}
+
+ZTEST(soil_capacitive_adapter_suite, test_runtime_calibration)
+{
+    static constexpr loragro::SoilLutPoint probe_curve[] = {
+        {2800, 0},
+        {2000, 50},
+        {1000, 100},
+    };
+    zassert_true(loragro::SoilCalibration::points_valid(probe_curve, 3));
+
+    const loragro::SoilCalibration calib(probe_curve, 3);
+    zassert_equal(calib.percent(3500), 0);
+    zassert_equal(calib.percent(2000), 50);
+    zassert_equal(calib.percent(500), 100);
+    zassert_within(calib.percent(1500), 75, 1);
+
+    /* Rising mV or moisture above 100 % is rejected */
+    static constexpr loragro::SoilLutPoint unordered[] = {{1000, 0}, {2000, 100}};
+    static constexpr loragro::SoilLutPoint overrange[] = {{2000, 0}, {1000, 120}};
+    zassert_false(loragro::SoilCalibration::points_valid(unordered, 2));
+    zassert_false(loragro::SoilCalibration::points_valid(overrange, 2));
+}
@@ -0,0 +1,152 @@
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/lora.h>
+#include <zephyr/logging/log.h>
+
+#include "config_manager.hpp"
+#include "lora/lora_protocol.hpp"
+#include "lora/sx1262_bsim.hpp"
+#include "netsim/sim_gateway.hpp"
+
+LOG_MODULE_REGISTER(bsim_gateway, LOG_LEVEL_DBG);
+
+using namespace loragro;
+using namespace loragro::netsim;
+
+static const struct device *const lora_dev = DEVICE_DT_GET(DT_ALIAS(lora0));
+
+/* Outlives the gateway, SimGateway keeps a reference */
+static SimParams params = SimParams::defaults();
+
+static const char *uplink_kind_name(SimGateway::UplinkKind kind)
+{
+    switch (kind)
+    {
+    case SimGateway::UplinkKind::DATA:
+        return "DATA";
+    case SimGateway::UplinkKind::DUPLICATE:
+        return "DUPLICATE";
+    case SimGateway::UplinkKind::RESPONSE:
+        return "RESPONSE";
+    default:
+        return "INVALID";
+    }
+}
+
+/* =========================================================
+ * Downlinks, timed for the node's RX windows
+ * ========================================================= */
+
+static void send_ack(SimGateway &gw, uint32_t peer, const uint8_t *frame, uint8_t len,
+                     const SimGateway::Uplink &up)
+{
+    /* Interface::send_confirmed() sleeps one uplink airtime before it listens */
+    const uint32_t uplink_ms = sx1262_bsim_airtime_us(lora_dev, len) / 1000;
+    k_sleep(K_MSEC(uplink_ms + CONFIG_BSIM_GW_TURNAROUND_MS));
+
+    uint8_t ack[FrameLayout::ACK_FRAME_SIZE + FrameLayout::AUTH_SIZE];
+    const size_t ack_len = gw.build_ack(peer, frame, up.counter, ack);
+
+    int ret = lora_send(lora_dev, ack, ack_len);
+    if (ret < 0)
+        LOG_ERR("ACK TX failed (%d)", ret);
+}
+
+static void send_config(SimGateway &gw, uint32_t peer)
+{
+    /* App::run_cycle() opens its RX window right after the last ACK */
+    k_sleep(K_MSEC(CONFIG_BSIM_GW_TURNAROUND_MS));
+
+    uint8_t cfg[64];
+    const uint64_t unix_ms = SimGateway::EPOCH_MS + static_cast<uint64_t>(k_uptime_get());
+    const size_t cfg_len = gw.build_config(peer, unix_ms, cfg, sizeof(cfg));
+    if (cfg_len == 0)
+    {
+        LOG_ERR("CONFIG for peer %u not built", peer + 1);
+        return;
+    }
+
+    int ret = lora_send(lora_dev, cfg, cfg_len);
+    if (ret < 0)
+        LOG_ERR("CONFIG TX failed (%d)", ret);
+}
+
+/* =========================================================
+ * Main
+ * ========================================================= */
+
+int main(void)
+{
+    if (!device_is_ready(lora_dev))
+    {
+        LOG_ERR("LoRa device not ready");
+        return -ENODEV;
+    }
+
+    /* Nodes boot with the defaults, so the gateway derives their keys from them */
+    ConfigManager &cfg_mgr = ConfigManager::instance();
+    cfg_mgr.load_defaults();
+    const DeviceConfig base = cfg_mgr.get();
+    const uint8_t gateway_id = extract_gateway(base.combined_id);
+
+    params.sf = static_cast<uint32_t>(base.lora.datarate);
+    params.interval_min = base.sample_interval_minutes;
+
+    static SimGateway gw(params);
+    for (uint16_t node = 1; node <= CONFIG_BSIM_GW_PEERS; ++node)
+    {
+        DeviceConfig peer_cfg = base;
+        peer_cfg.combined_id = make_combined_id(gateway_id, node);
+        gw.add_peer(peer_cfg);
+    }
+
+    lora_modem_config modem = base.lora;
+    modem.tx = false;
+    int ret = lora_config(lora_dev, &modem);
+    if (ret < 0)
+    {
+        LOG_ERR("LoRa config failed (%d)", ret);
+        return ret;
+    }
+
+    LOG_INF("Gateway %u: %u peers, SF%u, slots %s", gateway_id, CONFIG_BSIM_GW_PEERS,
+            params.sf, params.assign_slots ? "assigned" : "node_id");
+
+    uint8_t buf[256];
+
+    while (true)
+    {
+        int16_t rssi = 0;
+        int8_t snr = 0;
+
+        const int len = lora_recv(lora_dev, buf, sizeof(buf) - 1, K_FOREVER, &rssi, &snr);
+        if (len < static_cast<int>(FrameLayout::HEADER_SIZE))
+            continue;
+
+        const uint16_t id = read_u16_le(buf, 0);
+        const uint16_t node = extract_node(id);
+        if (extract_gateway(id) != gateway_id || node == 0 || node > CONFIG_BSIM_GW_PEERS)
+        {
+            LOG_WRN("Frame from unknown ID 0x%04x", id);
+            continue;
+        }
+
+        const uint32_t peer = node - 1U;
+        const int64_t now_us = k_ticks_to_us_floor64(k_uptime_ticks());
+        const SimGateway::Uplink up = gw.receive(peer, buf, static_cast<uint8_t>(len), now_us);
+
+        LOG_INF("GW node=%u kind=%s ctr=%u entries=%u rssi=%d snr=%d",
+                node, uplink_kind_name(up.kind), up.counter, up.entries, rssi, snr);
+
+        if (up.kind != SimGateway::UplinkKind::DATA && up.kind != SimGateway::UplinkKind::DUPLICATE)
+            continue;
+
+        /* Half duplex: while these go out, nothing else is heard */
+        send_ack(gw, peer, buf, static_cast<uint8_t>(len), up);
+
+        if (up.last_frame && gw.downlink_pending(peer))
+            send_config(gw, peer);
+    }
+
+    return 0;
+}
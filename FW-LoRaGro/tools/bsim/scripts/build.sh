@@ -0,0 +1,23 @@
+#!/bin/bash
+# Builds the node (Fino-LoRaGro + node.overlay/node.conf) and gateway
+# images for nrf52_bsim and installs them into ${BSIM_OUT_PATH}/bin,
+# next to bs_2G4_phy_v1, as run_scenario.sh expects them.
+#
+# usage: scripts/build.sh [build_dir]
+
+set -euo pipefail
+
+: "${BSIM_OUT_PATH:?source the BabbleSim environment first (BSIM_OUT_PATH)}"
+
+HERE=$(cd "$(dirname "$0")/.." && pwd)
+FW=$(cd "$HERE/../.." && pwd)
+BUILD=${1:-$HERE/build}
+
+west build -p auto -b nrf52_bsim -d "$BUILD/node" "$FW/Fino-LoRaGro" -- \
+    -DEXTRA_DTC_OVERLAY_FILE="$HERE/node.overlay" \
+    -DEXTRA_CONF_FILE="$HERE/node.conf"
+
+west build -p auto -b nrf52_bsim -d "$BUILD/gateway" "$HERE/gateway"
+
+cp "$BUILD/node/zephyr/zephyr.exe" "$BSIM_OUT_PATH/bin/bs_nrf52_bsim_loragro_node"
+cp "$BUILD/gateway/zephyr/zephyr.exe" "$BSIM_OUT_PATH/bin/bs_nrf52_bsim_loragro_gateway"
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""Per-node delivery ratio and latency of a LoRaGro BabbleSim run.
+
+Reads the sx1262_bsim TX / RX trace of every device (the bsim console
+prefixes each line with d_NN, device 0 is the gateway):
+
+  delivered   DATA frame (node ID, frame counter) heard by the gateway
+  acked       the node received the ACK of that frame
+  latency     first TX of a frame to its ACK, on the node's own clock,
+              so it includes every retry and back-off
+  attempts    TX count of a frame, 1 = no retry
+  config      CONFIG frames the node received
+
+Frames first sent in the last --tail-s seconds of a node's log are left
+out, their cycle may not have finished when the simulation stopped.
+
+usage: report.py [--min-delivery R] [--max-latency-ms MS] [--csv] d_*.log
+
+Exit status 1 when a threshold is missed, for regression runs.
+"""
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+
+PREFIX = re.compile(r"^d_(\d+): @(\d+):(\d+):(\d+(?:\.\d+)?)\s")
+TRACE = re.compile(
+    r"sx1262_bsim: (TX|RX) id=0x([0-9a-fA-F]+) type=0x([0-9a-fA-F]+) ctr=(\d+) len=(\d+)")
+
+GATEWAY = 0
+DATA = 0x01
+CONFIG = 0x02
+ACK = 0xA5
+
+
+class Unwrap:
+    """8-bit frame counter to a running counter, as SimGateway does."""
+
+    def __init__(self):
+        self.last = {}
+
+    def __call__(self, key, ctr8):
+        last = self.last.get(key, ctr8)
+        value = (last & ~0xFF) | ctr8
+        if value + 0x80 < last:
+            value += 0x100
+        elif value > last + 0x80 and value >= 0x100:
+            value -= 0x100
+        self.last[key] = max(last, value)
+        return value
+
+
+def parse(paths):
+    events = []
+    end = defaultdict(float)  # dev -> last console time, any line
+    for path in paths:
+        with open(path, errors="replace") as f:
+            for line in f:
+                p = PREFIX.match(line)
+                if not p:
+                    continue
+                dev = int(p.group(1))
+                t = int(p.group(2)) * 3600 + int(p.group(3)) * 60 + float(p.group(4))
+                end[dev] = max(end[dev], t)
+
+                m = TRACE.search(line, p.end())
+                if not m:
+                    continue
+                direction, cid, ftype, ctr, length = m.groups()
+                events.append((dev, t, direction, int(cid, 16), int(ftype, 16), int(ctr), int(length)))
+    events.sort(key=lambda e: (e[0], e[1]))
+    return events, end
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(round(p / 100.0 * (len(values) - 1))))]
+
+
+def analyse(events, end, tail_s):
+    unwrap_node = Unwrap()
+    unwrap_gw = Unwrap()
+
+    heard = set()                   # (id, counter) at the gateway
+    frames = defaultdict(dict)      # dev -> counter -> frame
+    ids = {}                        # dev -> combined id
+    configs = defaultdict(int)      # dev -> CONFIG received
+
+    for dev, t, direction, cid, ftype, ctr, _ in events:
+        if dev == GATEWAY:
+            if direction == "RX" and ftype == DATA:
+                heard.add((cid, unwrap_gw(cid, ctr)))
+            continue
+
+        if direction == "TX" and ftype == DATA:
+            ids[dev] = cid
+            counter = unwrap_node(dev, ctr)
+            frame = frames[dev].setdefault(counter, {"first": t, "attempts": 0, "ack": None})
+            frame["attempts"] += 1
+        elif direction == "RX" and ftype == ACK and ids.get(dev) == cid and frames[dev]:
+            # An ACK only ever answers the frame in flight, the newest one
+            latest = max(frames[dev])
+            if frames[dev][latest]["ack"] is None and ctr == (latest & 0xFF):
+                frames[dev][latest]["ack"] = t
+        elif direction == "RX" and ftype == CONFIG and ids.get(dev, cid) == cid:
+            configs[dev] += 1
+
+    rows = []
+    for dev in sorted(frames):
+        cutoff = end[dev] - tail_s
+        done = {c: f for c, f in frames[dev].items() if f["first"] <= cutoff}
+        if not done:
+            continue
+
+        cid = ids[dev]
+        latencies = [(f["ack"] - f["first"]) * 1000.0 for f in done.values() if f["ack"] is not None]
+        rows.append({
+            "device": dev,
+            "id": cid,
+            "frames": len(done),
+            "delivered": sum(1 for c in done if (cid, c) in heard),
+            "acked": len(latencies),
+            "attempts": sum(f["attempts"] for f in done.values()),
+            "lat_mean": sum(latencies) / len(latencies) if latencies else 0.0,
+            "lat_p95": percentile(latencies, 95),
+            "lat_max": max(latencies) if latencies else 0.0,
+            "latencies": latencies,
+            "config": configs[dev],
+        })
+    return rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("logs", nargs="+", help="device logs (d_NN.log)")
+    ap.add_argument("--min-delivery", type=float, default=None,
+                    help="fail when the network delivery ratio is below this (0..1)")
+    ap.add_argument("--max-latency-ms", type=float, default=None,
+                    help="fail when the network p95 ACK latency is above this")
+    ap.add_argument("--tail-s", type=float, default=30.0,
+                    help="ignore frames first sent this close to the end of a log")
+    ap.add_argument("--csv", action="store_true", help="one CSV row per node")
+    args = ap.parse_args()
+
+    events, end = parse(args.logs)
+    rows = analyse(events, end, args.tail_s)
+    if not rows:
+        print("no DATA frames in the logs", file=sys.stderr)
+        return 1
+
+    frames = sum(r["frames"] for r in rows)
+    delivered = sum(r["delivered"] for r in rows)
+    acked = sum(r["acked"] for r in rows)
+    attempts = sum(r["attempts"] for r in rows)
+    latencies = [l for r in rows for l in r["latencies"]]
+    delivery = delivered / frames
+    p95 = percentile(latencies, 95)
+
+    if args.csv:
+        print("device,id,frames,delivered,delivery_ratio,acked,attempts,"
+              "latency_mean_ms,latency_p95_ms,latency_max_ms,config_rx")
+        for r in rows:
+            print("%d,0x%04x,%d,%d,%.4f,%d,%d,%.1f,%.1f,%.1f,%d" % (
+                r["device"], r["id"], r["frames"], r["delivered"], r["delivered"] / r["frames"],
+                r["acked"], r["attempts"], r["lat_mean"], r["lat_p95"], r["lat_max"], r["config"]))
+    else:
+        print("dev  id      frames  delivered  ratio    acked  tx/frame  "
+              "latency ms (mean / p95 / max)  config")
+        for r in rows:
+            print("%3d  0x%04x  %6d  %9d  %6.2f%%  %5d  %8.2f  %8.0f / %6.0f / %6.0f  %6d" % (
+                r["device"], r["id"], r["frames"], r["delivered"],
+                100.0 * r["delivered"] / r["frames"], r["acked"], r["attempts"] / r["frames"],
+                r["lat_mean"], r["lat_p95"], r["lat_max"], r["config"]))
+        print("network: %d nodes, %d frames, delivery %.2f %%, acked %.2f %%, "
+              "%.2f TX per frame, p95 latency %.0f ms" % (
+                  len(rows), frames, 100.0 * delivery, 100.0 * acked / frames,
+                  attempts / frames, p95))
+
+    failed = False
+    if args.min_delivery is not None and delivery < args.min_delivery:
+        print("FAIL: delivery %.4f below %.4f" % (delivery, args.min_delivery), file=sys.stderr)
+        failed = True
+    if args.max_latency_ms is not None and p95 > args.max_latency_ms:
+        print("FAIL: p95 latency %.0f ms above %.0f ms" % (p95, args.max_latency_ms), file=sys.stderr)
+        failed = True
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
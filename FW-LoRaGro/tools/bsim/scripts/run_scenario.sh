@@ -0,0 +1,74 @@
+#!/bin/bash
+# One gateway (device 0) and N FiNo nodes (devices 1..N) on the 2G4 phy,
+# then report.py over the device logs.
+#
+# usage: scripts/run_scenario.sh [-n nodes] [-m minutes] [-a attenuation_db]
+#                                [-p power_up_spread_s] [-r seed] [-s sim_id]
+#                                [-o out_dir] [-- report.py options]
+#
+# example, fail when delivery drops below 95 %:
+#   scripts/run_scenario.sh -n 8 -m 120 -- --min-delivery 0.95
+
+set -euo pipefail
+
+: "${BSIM_OUT_PATH:?source the BabbleSim environment first (BSIM_OUT_PATH)}"
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+
+NODES=4
+MINUTES=60
+ATTENUATION=60
+SPREAD_S=60
+SEED=1
+SIM_ID=loragro_$$
+OUT=""
+
+while getopts "n:m:a:p:r:s:o:" opt; do
+    case $opt in
+        n) NODES=$OPTARG ;;
+        m) MINUTES=$OPTARG ;;
+        a) ATTENUATION=$OPTARG ;;
+        p) SPREAD_S=$OPTARG ;;
+        r) SEED=$OPTARG ;;
+        s) SIM_ID=$OPTARG ;;
+        o) OUT=$OPTARG ;;
+        *) sed -n '2,12p' "$0" >&2; exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+[ "${1:-}" = "--" ] && shift
+
+OUT=${OUT:-$PWD/bsim_$SIM_ID}
+mkdir -p "$OUT"
+
+BIN="$BSIM_OUT_PATH/bin"
+for exe in bs_nrf52_bsim_loragro_gateway bs_nrf52_bsim_loragro_node bs_2G4_phy_v1; do
+    if [ ! -x "$BIN/$exe" ]; then
+        echo "$BIN/$exe missing, run scripts/build.sh first" >&2
+        exit 1
+    fi
+done
+
+cd "$BIN"
+
+pids=()
+./bs_nrf52_bsim_loragro_gateway -s="$SIM_ID" -d=0 -rs="$SEED" > "$OUT/d_00.log" 2>&1 &
+pids+=($!)
+
+# Nodes power up spread over SPREAD_S, like a field installation
+RANDOM=$SEED
+for ((d = 1; d <= NODES; d++)); do
+    offset_us=$(( (RANDOM * 32768 + RANDOM) % (SPREAD_S * 1000000 + 1) ))
+    ./bs_nrf52_bsim_loragro_node -s="$SIM_ID" -d=$d -rs=$((SEED + d)) \
+        -start_offset=$offset_us > "$OUT/$(printf 'd_%02d' $d).log" 2>&1 &
+    pids+=($!)
+done
+
+./bs_2G4_phy_v1 -s="$SIM_ID" -D=$((NODES + 1)) -sim_length=$((MINUTES * 60 * 1000000)) \
+    -argschannel -at="$ATTENUATION" > "$OUT/phy.log" 2>&1
+
+for pid in "${pids[@]}"; do
+    wait "$pid" || true
+done
+
+python3 "$HERE/report.py" "$@" "$OUT"/d_*.log
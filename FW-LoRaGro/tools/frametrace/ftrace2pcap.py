@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Convert a LoRaGro frame trace console dump to pcap.
+
+Reads the FTRACE-BEGIN / FTRACE / FTRACE-END lines FrameTrace::dump()
+prints (any prefix before "FTRACE" is ignored, so raw console logs,
+bsim d_NN.log files and RTT captures all work) and writes a pcap with
+link type USER0 (147). Every packet is the 16-byte record header
+followed by the captured frame bytes; loragro.lua dissects both.
+
+Timestamps: records taken after the first time sync carry the low 32
+bits of unix time in ms and are widened with the unix time of their
+dump header. Records from before the sync carry uptime; they are
+placed at --epoch + uptime (default 0, i.e. 1970-01-01).
+
+A node dumps its flash trace on every boot, so the same record can
+appear in several dumps; identical records are written once unless
+--keep-duplicates is given.
+
+usage: ftrace2pcap.py [-o trace.pcap] [--epoch UNIX_S] [log ...]
+"""
+
+import argparse
+import struct
+import sys
+
+LINKTYPE_USER0 = 147
+HEADER = struct.Struct("<IHBBBbhHh")  # FrameTraceRecord without data[]
+SYNCED = 0x80
+KIND_MASK = 0x0F
+KINDS = {1: "TX", 2: "RX", 3: "ACK"}
+
+
+class Record:
+    def __init__(self, raw, record_size):
+        (self.time_ms, self.seq, self.kind, self.len, self.cap_len,
+         self.snr, self.rssi, self.airtime_ms, self.result) = HEADER.unpack_from(raw)
+        self.raw = raw[:HEADER.size + self.cap_len]
+        self.record_size = record_size
+        self.unix_ms = None
+
+    @property
+    def synced(self):
+        return bool(self.kind & SYNCED)
+
+
+def widen(low32, ref_ms):
+    """Largest value <= ref_ms + 1 day whose low 32 bits are low32."""
+    limit = ref_ms + 86400000
+    value = (limit & ~0xFFFFFFFF) | low32
+    if value > limit:
+        value -= 1 << 32
+    return value
+
+
+def parse(lines):
+    records = []
+    dump = None  # (record size, snaplen, uptime ms, unix ms)
+    errors = 0
+
+    for lineno, line in enumerate(lines, 1):
+        pos = line.find("FTRACE")
+        if pos < 0:
+            continue
+        fields = line[pos:].split()
+        tag = fields[0]
+
+        if tag == "FTRACE-BEGIN":
+            version, size, snaplen, uptime_ms, unix_ms = (int(f) for f in fields[1:6])
+            if version != 1:
+                raise SystemExit("line %d: trace format %d not supported" % (lineno, version))
+            dump = (size, snaplen, uptime_ms, unix_ms)
+        elif tag == "FTRACE-END":
+            if len(fields) > 2 and int(fields[2]):
+                print("dump ending at line %d lost %s records to ring overrun" % (lineno, fields[2]),
+                      file=sys.stderr)
+            dump = None
+        elif tag == "FTRACE" and dump and len(fields) > 1:
+            try:
+                raw = bytes.fromhex(fields[1])
+            except ValueError:
+                errors += 1
+                continue
+            if len(raw) < HEADER.size:
+                errors += 1
+                continue
+            rec = Record(raw, dump[0])
+            if len(rec.raw) < HEADER.size + rec.cap_len:
+                errors += 1  # console line cut
+                continue
+            if rec.synced and dump[3]:
+                rec.unix_ms = widen(rec.time_ms, dump[3])
+            records.append(rec)
+
+    if errors:
+        print("skipped %d damaged FTRACE lines" % errors, file=sys.stderr)
+    return records
+
+
+def write_pcap(out, records, epoch_s):
+    out.write(struct.pack("<IHHiIII", 0xA1B2C3D4, 2, 4, 0, 0, 65535, LINKTYPE_USER0))
+    for rec in records:
+        ms = rec.unix_ms if rec.unix_ms is not None else epoch_s * 1000 + rec.time_ms
+        out.write(struct.pack("<IIII", ms // 1000, (ms % 1000) * 1000,
+                              len(rec.raw), HEADER.size + rec.len))
+        out.write(rec.raw)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("logs", nargs="*", help="console logs (default: stdin)")
+    ap.add_argument("-o", "--output", default="trace.pcap", help="pcap file to write")
+    ap.add_argument("--epoch", type=int, default=0,
+                    help="unix time (s) added to records taken before time sync")
+    ap.add_argument("--keep-duplicates", action="store_true",
+                    help="keep records repeated by later dumps")
+    ap.add_argument("--summary", action="store_true", help="print one line per record")
+    args = ap.parse_args()
+
+    lines = []
+    if args.logs:
+        for path in args.logs:
+            with open(path, errors="replace") as f:
+                lines.extend(f)
+    else:
+        lines = sys.stdin.readlines()
+
+    records = parse(lines)
+    if not args.keep_duplicates:
+        seen = set()
+        unique = []
+        for rec in records:
+            if rec.raw not in seen:
+                seen.add(rec.raw)
+                unique.append(rec)
+        records = unique
+
+    if not records:
+        print("no FTRACE records found", file=sys.stderr)
+        return 1
+
+    with open(args.output, "wb") as out:
+        write_pcap(out, records, args.epoch)
+
+    if args.summary:
+        for rec in records:
+            print("%5d %-3s %s len=%3d result=%6d rssi=%4d snr=%3d air=%4d ms" % (
+                rec.seq, KINDS.get(rec.kind & KIND_MASK, "?"),
+                "unix" if rec.synced else "up  ", rec.len, rec.result, rec.rssi, rec.snr,
+                rec.airtime_ms))
+
+    print("%d records -> %s" % (len(records), args.output), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
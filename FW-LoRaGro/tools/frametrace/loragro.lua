@@ -0,0 +1,271 @@
+-- LoRaGro frame trace dissector for Wireshark
+--
+-- Packets written by ftrace2pcap.py (link type USER0): the 16-byte
+-- FrameTraceRecord header followed by the captured LoRaGro frame.
+--
+-- Install: copy to the personal Lua plugins folder
+-- (Help > About Wireshark > Folders), or run
+--   wireshark -X lua_script:loragro.lua trace.pcap
+--
+-- Plain arithmetic instead of bit operators, for Lua 5.2 builds.
+--
+-- Display filter examples:
+--   loragro.trace.kind == 1           TX only
+--   loragro.trace.result < 0          failed TX, empty windows, bad ACKs
+--   loragro.type == 0x02              CONFIG downlinks
+--   loragro.node == 12
+
+local trace = Proto("loragro.trace", "LoRaGro Frame Trace")
+local lg = Proto("loragro", "LoRaGro")
+
+local kinds = { [1] = "TX", [2] = "RX", [3] = "ACK window" }
+
+local frame_types = {
+    [0x01] = "DATA",
+    [0x02] = "CONFIG",
+    [0xA5] = "ACK",
+    [0x5A] = "RESPONSE",
+}
+
+-- MessageOp, lora_protocol.hpp
+local ops = {
+    [0] = "SET_COMBINED_ID",
+    [1] = "SET_SAMPLING_INTERVAL",
+    [2] = "REBOOT",
+    [3] = "SET_UNIX_TIME",
+    [4] = "SET_LORA_CONFIG",
+    [5] = "SET_UNIX_TIME_MS",
+    [6] = "SET_TDMA_SLOT",
+    [7] = "SET_SOIL_CALIB",
+}
+
+-- DecodeResult, lora_protocol.hpp
+local results = {
+    [0] = "OK",
+    [1] = "OK_AND_REBOOT_NEED",
+    [2] = "PROTOCOL_MISMATCH",
+    [3] = "INVALID_LENGTH",
+    [4] = "UNKNOWN_COMMAND",
+    [5] = "EXECUTED_REBOOT",
+    [6] = "DIFFERENT_ID",
+    [7] = "FLASH_FAILED",
+    [8] = "AUTH_FAILED",
+    [9] = "INVALID_VALUE",
+}
+
+-- SensorID, domain_types.hpp
+local sensors = {
+    [0x00] = "ENV_TEMP", [0x01] = "ENV_RH", [0x02] = "ENV_PRESS",
+    [0x10] = "AMB_LIGHT",
+    [0x20] = "CO2_TEMP", [0x21] = "CO2_RH", [0x22] = "CO2_CONC",
+    [0x30] = "SOIL_TEMP", [0x31] = "SOIL_MOISTURE", [0x32] = "SOIL_EC",
+    [0x33] = "SOIL_ANALOG_MOISTURE", [0x3F] = "SOIL_PROFILE",
+    [0x40] = "BATTERY_VOLTAGE",
+    [0x50] = "ENERGY_TOTAL", [0x51] = "ENERGY_RADIO",
+    [0x52] = "ENERGY_SENSORS", [0x53] = "ENERGY_SYSTEM",
+}
+
+local SOIL_PROFILE = 0x3F
+local AUTH_SIZE = 4
+local MEASUREMENT_SIZE = 5
+local SOIL_RECORD_SIZE = 4
+
+-- errno values the Interface reports (Zephyr numbering)
+local errnos = {
+    [-5] = "EIO", [-11] = "EAGAIN", [-22] = "EINVAL", [-90] = "EMSGSIZE",
+    [-116] = "ETIMEDOUT", [-19] = "ENODEV", [-16] = "EBUSY",
+}
+
+local t = {
+    time = ProtoField.uint32("loragro.trace.time_ms", "Time (ms)", base.DEC),
+    seq = ProtoField.uint16("loragro.trace.seq", "Sequence", base.DEC),
+    kind = ProtoField.uint8("loragro.trace.kind", "Kind", base.DEC, kinds, 0x0F),
+    synced = ProtoField.bool("loragro.trace.synced", "Unix time", 8, nil, 0x80),
+    len = ProtoField.uint8("loragro.trace.len", "On-air length", base.DEC),
+    cap_len = ProtoField.uint8("loragro.trace.cap_len", "Captured", base.DEC),
+    snr = ProtoField.int8("loragro.trace.snr", "SNR (dB)", base.DEC),
+    rssi = ProtoField.int16("loragro.trace.rssi", "RSSI (dBm)", base.DEC),
+    airtime = ProtoField.uint16("loragro.trace.airtime_ms", "Airtime (ms)", base.DEC),
+    result = ProtoField.int16("loragro.trace.result", "Result", base.DEC),
+}
+trace.fields = { t.time, t.seq, t.kind, t.synced, t.len, t.cap_len, t.snr, t.rssi, t.airtime, t.result }
+
+local f = {
+    id = ProtoField.uint16("loragro.id", "Combined ID", base.HEX),
+    gateway = ProtoField.uint16("loragro.gateway", "Gateway", base.DEC, nil, 0xF800),
+    node = ProtoField.uint16("loragro.node", "Node", base.DEC, nil, 0x07FF),
+    type = ProtoField.uint8("loragro.type", "Frame type", base.HEX, frame_types),
+    ctr = ProtoField.uint8("loragro.ctr", "Frame counter", base.DEC),
+    count = ProtoField.uint8("loragro.data.count", "Measurements", base.DEC),
+    timestamp = ProtoField.absolute_time("loragro.data.timestamp", "Timestamp", base.UTC),
+    sensor = ProtoField.uint8("loragro.data.sensor", "Sensor", base.HEX, sensors),
+    v1 = ProtoField.int16("loragro.data.v1", "Value 1", base.DEC),
+    v2 = ProtoField.int16("loragro.data.v2", "Value 2", base.DEC),
+    probes = ProtoField.uint8("loragro.soil.probes", "Probes", base.DEC),
+    depth = ProtoField.uint8("loragro.soil.depth_cm", "Depth (cm)", base.DEC),
+    moisture = ProtoField.uint8("loragro.soil.moisture", "Moisture (0.5 %)", base.DEC),
+    soil_temp = ProtoField.int8("loragro.soil.temp", "Temperature (0.5 C)", base.DEC),
+    ec = ProtoField.uint8("loragro.soil.ec", "EC (10 uS/cm)", base.DEC),
+    cmd_count = ProtoField.uint8("loragro.config.count", "Commands", base.DEC),
+    version = ProtoField.uint8("loragro.config.version", "Protocol version", base.DEC),
+    op = ProtoField.uint8("loragro.config.op", "Command", base.DEC, ops),
+    op_len = ProtoField.uint16("loragro.config.len", "Length", base.DEC),
+    op_data = ProtoField.bytes("loragro.config.data", "Payload"),
+    response = ProtoField.uint8("loragro.response", "Result", base.DEC, results),
+    tag = ProtoField.bytes("loragro.tag", "CMAC tag"),
+}
+lg.fields = {
+    f.id, f.gateway, f.node, f.type, f.ctr, f.count, f.timestamp, f.sensor, f.v1, f.v2,
+    f.probes, f.depth, f.moisture, f.soil_temp, f.ec, f.cmd_count, f.version,
+    f.op, f.op_len, f.op_data, f.response, f.tag,
+}
+
+local function dissect_data(buf, tree, pos, stop)
+    if pos + 5 > stop then return end
+    tree:add(f.count, buf(pos, 1))
+    tree:add_le(f.timestamp, buf(pos + 1, 4))
+    pos = pos + 5
+
+    while pos < stop do
+        local id = buf(pos, 1):uint()
+        if id == SOIL_PROFILE then
+            if pos + 2 > stop then break end
+            local n = buf(pos + 1, 1):uint()
+            local size = 2 + n * SOIL_RECORD_SIZE
+            local sub = tree:add(lg, buf(pos, math.min(size, stop - pos)), "Soil profile")
+            sub:add(f.sensor, buf(pos, 1))
+            sub:add(f.probes, buf(pos + 1, 1))
+            local p = pos + 2
+            for _ = 1, n do
+                if p + SOIL_RECORD_SIZE > stop then break end
+                local probe = sub:add(lg, buf(p, SOIL_RECORD_SIZE),
+                                      string.format("Probe at %d cm", buf(p, 1):uint()))
+                probe:add(f.depth, buf(p, 1))
+                probe:add(f.moisture, buf(p + 1, 1))
+                probe:add(f.soil_temp, buf(p + 2, 1))
+                probe:add(f.ec, buf(p + 3, 1))
+                p = p + SOIL_RECORD_SIZE
+            end
+            pos = pos + size
+        else
+            if pos + MEASUREMENT_SIZE > stop then break end
+            local sub = tree:add(lg, buf(pos, MEASUREMENT_SIZE),
+                                 string.format("%s: %d, %d", sensors[id] or string.format("0x%02x", id),
+                                               buf(pos + 1, 2):le_int(), buf(pos + 3, 2):le_int()))
+            sub:add(f.sensor, buf(pos, 1))
+            sub:add_le(f.v1, buf(pos + 1, 2))
+            sub:add_le(f.v2, buf(pos + 3, 2))
+            pos = pos + MEASUREMENT_SIZE
+        end
+    end
+end
+
+-- Unsigned LEB128, at most 2 bytes (read_varint)
+local function varint(buf, pos, stop)
+    if pos >= stop then return nil, 0 end
+    local b0 = buf(pos, 1):uint()
+    if b0 < 0x80 then return b0, 1 end
+    if pos + 1 >= stop then return nil, 0 end
+    return (b0 % 0x80) + buf(pos + 1, 1):uint() * 0x80, 2
+end
+
+local function dissect_config(buf, tree, pos, stop)
+    if pos + 2 > stop then return end
+    local n = buf(pos, 1):uint()
+    tree:add(f.cmd_count, buf(pos, 1))
+    tree:add(f.version, buf(pos + 1, 1))
+    pos = pos + 2
+
+    for _ = 1, n do
+        if pos >= stop then break end
+        local op = buf(pos, 1):uint()
+        local len, used = varint(buf, pos + 1, stop)
+        if not len then break end
+        local size = math.min(1 + used + len, stop - pos)
+        local sub = tree:add(lg, buf(pos, size), ops[op] or string.format("op %d", op))
+        sub:add(f.op, buf(pos, 1))
+        sub:add(f.op_len, buf(pos + 1, used), len)
+        if len > 0 and pos + 1 + used < stop then
+            sub:add(f.op_data, buf(pos + 1 + used, math.min(len, stop - pos - 1 - used)))
+        end
+        pos = pos + 1 + used + len
+    end
+end
+
+function lg.dissector(buf, pinfo, tree, on_air_len)
+    if buf:len() < 4 then return end
+    pinfo.cols.protocol = "LoRaGro"
+
+    local full = (on_air_len == nil) or (buf:len() >= on_air_len)
+    local sub = tree:add(lg, buf())
+    local ftype = buf(2, 1):uint()
+    local id = buf(0, 2):le_uint()
+
+    local idt = sub:add_le(f.id, buf(0, 2))
+    idt:add_le(f.gateway, buf(0, 2))
+    idt:add_le(f.node, buf(0, 2))
+    sub:add(f.type, buf(2, 1))
+    sub:add(f.ctr, buf(3, 1))
+
+    local name = frame_types[ftype] or string.format("0x%02x", ftype)
+    pinfo.cols.info:append(string.format(" %s gw %d node %d ctr %d", name, math.floor(id / 0x800), id % 0x800,
+                                         buf(3, 1):uint()))
+
+    -- The CMAC tag closes a complete frame, a cut capture has none
+    local stop = buf:len()
+    if full and stop >= 4 + AUTH_SIZE then
+        stop = stop - AUTH_SIZE
+        sub:add(f.tag, buf(stop, AUTH_SIZE))
+    end
+
+    if ftype == 0x01 then
+        dissect_data(buf, sub, 4, stop)
+    elseif ftype == 0x02 then
+        dissect_config(buf, sub, 4, stop)
+    elseif ftype == 0x5A and stop > 4 then
+        sub:add(f.response, buf(4, 1))
+        pinfo.cols.info:append(" " .. (results[buf(4, 1):uint()] or "?"))
+    end
+
+    if not full then
+        sub:add_expert_info(PI_UNDECODED, PI_NOTE,
+                            string.format("Captured %d of %d bytes (snaplen)", buf:len(), on_air_len))
+    end
+end
+
+function trace.dissector(buf, pinfo, tree)
+    if buf:len() < 16 then return 0 end
+    pinfo.cols.protocol = "LoRaGro trace"
+
+    local kind = buf(6, 1):uint() % 0x10
+    local len = buf(7, 1):uint()
+    local cap_len = buf(8, 1):uint()
+    local result = buf(14, 2):le_int()
+
+    local sub = tree:add(trace, buf(0, 16))
+    sub:add_le(t.time, buf(0, 4))
+    sub:add_le(t.seq, buf(4, 2))
+    sub:add(t.kind, buf(6, 1))
+    sub:add(t.synced, buf(6, 1))
+    sub:add(t.len, buf(7, 1))
+    sub:add(t.cap_len, buf(8, 1))
+    sub:add(t.snr, buf(9, 1))
+    sub:add_le(t.rssi, buf(10, 2))
+    sub:add_le(t.airtime, buf(12, 2))
+    local rt = sub:add_le(t.result, buf(14, 2))
+    if result < 0 then
+        rt:append_text(" (" .. (errnos[result] or "errno") .. ")")
+        rt:add_expert_info(PI_RESPONSE_CODE, PI_WARN, "Failed")
+    end
+
+    pinfo.cols.info = string.format("%-10s rssi %d snr %d air %d ms result %d",
+                                    kinds[kind] or "?", buf(10, 2):le_int(), buf(9, 1):int(),
+                                    buf(12, 2):le_uint(), result)
+
+    if cap_len > 0 and buf:len() > 16 then
+        lg.dissector(buf(16, math.min(cap_len, buf:len() - 16)):tvb(), pinfo, tree, len)
+    end
+    return buf:len()
+end
+
+DissectorTable.get("wtap_encap"):add(wtap.USER0, trace)
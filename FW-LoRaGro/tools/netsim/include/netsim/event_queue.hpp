@@ -0,0 +1,73 @@
+/**
+ * Discrete event queue
+ *
+ * Simulated time in microseconds, no relation to the kernel clock:
+ * the simulator never sleeps, it jumps from one event to the next.
+ * Events at the same instant run in the order they were scheduled.
+ */
+#pragma once
+
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+namespace loragro::netsim
+{
+    enum class EventType : uint8_t
+    {
+        NODE_WAKE,       // cycle start, sampling
+        NODE_TX,         // DATA frame (re)transmission
+        NODE_ACK_RX,     // ACK fully received at the node
+        NODE_ACK_END,    // ACK window closed
+        NODE_DOWNLINK,   // CONFIG frame fully received at the node
+        NODE_RX_END,     // RX window closed
+        NODE_CYCLE_END,  // radio off, sleep math
+        GATEWAY_RX_END,  // uplink finished at the gateway, arg = air index
+    };
+
+    struct Event
+    {
+        int64_t at_us;
+        uint64_t seq;
+        EventType type;
+        uint32_t node;
+        uint32_t arg; // node token or air index, see EventType
+    };
+
+    class EventQueue
+    {
+    public:
+        void push(int64_t at_us, EventType type, uint32_t node, uint32_t arg = 0)
+        {
+            queue_.push(Event{at_us, seq_++, type, node, arg});
+        }
+
+        bool empty() const { return queue_.empty(); }
+
+        /* Removes the earliest event and advances now() to it */
+        Event pop()
+        {
+            Event e = queue_.top();
+            queue_.pop();
+            now_us_ = e.at_us;
+            return e;
+        }
+
+        int64_t now_us() const { return now_us_; }
+        uint64_t processed() const { return seq_ - queue_.size(); }
+
+    private:
+        struct Later
+        {
+            bool operator()(const Event &a, const Event &b) const
+            {
+                return a.at_us != b.at_us ? a.at_us > b.at_us : a.seq > b.seq;
+            }
+        };
+
+        std::priority_queue<Event, std::vector<Event>, Later> queue_;
+        int64_t now_us_{0};
+        uint64_t seq_{0};
+    };
+
+} // namespace loragro::netsim
@@ -0,0 +1,98 @@
+/**
+ * Discrete event LoRa network simulator
+ *
+ * N FiNo nodes and one gateway on one channel. Each node runs the
+ * App::run_cycle() sequence on simulated time:
+ *
+ *   wake -> sample (sample_ms) -> FrameCodec::begin
+ *        -> per frame: build + Auth::sign_frame, TX, sleep one airtime,
+ *           ACK window, retry after 200 ms up to max_retries
+ *           (Interface::send_confirmed)
+ *        -> one RX window for CONFIG, Auth::verify_frame,
+ *           ProtocolHandler::decode, RESPONSE
+ *        -> BatteryEstimator + TDMA grid (PowerManagement::handle_sleep)
+ *
+ * The firmware classes are the real ones, linked from common; only the
+ * radio, the clock and the gateway are simulated. Time jumps from event
+ * to event, so a day of a few thousand nodes takes seconds.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "netsim/channel.hpp"
+#include "netsim/event_queue.hpp"
+#include "netsim/sim_gateway.hpp"
+#include "netsim/sim_node.hpp"
+#include "netsim/sim_params.hpp"
+#include "netsim/sim_stats.hpp"
+
+namespace loragro::netsim
+{
+    class Network
+    {
+    public:
+        explicit Network(const SimParams &params);
+
+        /* Simulate params.hours, returns number of processed events */
+        uint64_t run();
+
+        void report() const;
+
+        const SimStats &stats() const { return stats_; }
+        const SimNode &node(uint32_t i) const { return *nodes_[i]; }
+        uint32_t node_count() const { return static_cast<uint32_t>(nodes_.size()); }
+
+        /* Gateway processing from RX done to ACK TX start, on top of the node's post-TX sleep */
+        static constexpr int64_t GW_TURNAROUND_US = 5000;
+        static constexpr float GW_TX_DBM = 14.0f;
+
+        /* Interface::send_confirmed() back-off after a missed ACK */
+        static constexpr int64_t RETRY_BACKOFF_US = 200000;
+
+        /* SlotScheduler::MIN_SLEEP_MS */
+        static constexpr int64_t MIN_SLEEP_US = 100000;
+
+    private:
+        void create_nodes();
+        void dispatch(const Event &e);
+
+        /* Node side */
+        void node_wake(SimNode &n);
+        void node_tx(SimNode &n);
+        void node_ack_rx(SimNode &n);
+        void node_ack_end(SimNode &n);
+        void node_downlink(SimNode &n);
+        void node_rx_end(SimNode &n);
+        void node_cycle_end(SimNode &n);
+
+        void begin_batch(SimNode &n);
+        bool prepare_frame(SimNode &n);
+        void attempt_failed(SimNode &n);
+        void next_frame(SimNode &n, int64_t at_us);
+        void open_rx_window(SimNode &n, int64_t at_us);
+        void schedule_wake(SimNode &n, uint8_t stride);
+
+        /* Gateway side */
+        void gateway_rx_end(uint32_t air);
+
+        void transmit(SimNode &n, const uint8_t *data, uint8_t len);
+        void account(SimNode &n, EnergyComponent c, int64_t us);
+
+        static int64_t airtime_us(const DeviceConfig &cfg, size_t len);
+        static uint32_t interface_airtime_ms(const DeviceConfig &cfg, size_t len);
+
+        const SimParams params_;
+        const int64_t end_us_;
+
+        EventQueue queue_;
+        Channel channel_;
+        SimGateway gateway_;
+        std::vector<std::unique_ptr<SimNode>> nodes_;
+
+        SimStats stats_{};
+    };
+
+} // namespace loragro::netsim
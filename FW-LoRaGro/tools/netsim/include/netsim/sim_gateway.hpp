@@ -0,0 +1,110 @@
+/**
+ * Simulated gateway
+ *
+ * Keeps one peer per node with a gateway side Auth over a copy of the
+ * node's DeviceConfig (same combined_id, so the same derived key):
+ *
+ *   DATA      - 32-bit counter reconstructed from the 8-bit frame
+ *               counter, CMAC checked, retries detected as duplicates
+ *   ACK       - [id][0xA5][ctr] + CMAC over the full counter, the
+ *               format Interface::is_valid_ack() accepts
+ *   CONFIG    - SET_UNIX_TIME_MS (+ SET_TDMA_SLOT) signed with the
+ *               peer's own downlink counter, sent after the ACK of the
+ *               last DATA frame of a cycle
+ *   RESPONSE  - confirms the pending CONFIG
+ *
+ * Slot assignment is first come, first served: the n-th node heard
+ * gets slot n, SlotScheduler::slot_width_ms() wide, until the interval
+ * is full. Nodes beyond that stay on their node_id slot.
+ *
+ * The RESPONSE is accepted without its tag because App::run_cycle()
+ * hands send_response() the frame length without the 4 tag bytes.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "config_manager.hpp"
+#include "lora/lora_auth.hpp"
+#include "lora/lora_protocol.hpp"
+#include "netsim/sim_params.hpp"
+
+namespace loragro::netsim
+{
+    class SimGateway
+    {
+    public:
+        enum class UplinkKind : uint8_t
+        {
+            DATA,
+            DUPLICATE,
+            RESPONSE,
+            INVALID,
+        };
+
+        struct Uplink
+        {
+            UplinkKind kind;
+            uint32_t counter; // full 32-bit frame counter (DATA)
+            uint8_t entries;  // measurement entries (DATA)
+            bool last_frame;  // frame not full, node opens its RX window next
+            uint8_t result;   // DecodeResult (RESPONSE)
+        };
+
+        explicit SimGateway(const SimParams &params);
+
+        void add_peer(const DeviceConfig &node_cfg);
+
+        Uplink receive(uint32_t node, const uint8_t *data, uint8_t len, int64_t now_us);
+
+        /* ACK for a received DATA frame, returns its length */
+        size_t build_ack(uint32_t node, const uint8_t *frame, uint32_t counter, uint8_t *out) const;
+
+        /* CONFIG waiting for the node's next RX window */
+        bool downlink_pending(uint32_t node) const { return peers_[node]->pending; }
+        size_t config_len(uint32_t node) const;
+        size_t build_config(uint32_t node, uint64_t unix_ms, uint8_t *out, size_t max_len);
+
+        uint32_t slots_assigned() const { return next_slot_; }
+        uint32_t slot_overflow() const { return slot_overflow_; }
+
+        /* Wall clock the simulated gateway stamps into SET_UNIX_TIME_MS */
+        static constexpr uint64_t EPOCH_MS = 1767225600000ULL; // 2026-01-01 00:00 UTC
+
+    private:
+        struct Peer
+        {
+            explicit Peer(const DeviceConfig &node_cfg) : cfg(downlink_view(node_cfg)), auth(cfg) {}
+
+            /* Downlink counter starts at 1, the first value a node with no RX history accepts */
+            static DeviceConfig downlink_view(DeviceConfig node_cfg)
+            {
+                node_cfg.tx_security_counter = 0;
+                return node_cfg;
+            }
+
+            DeviceConfig cfg;
+            Auth auth;
+
+            uint32_t last_counter{0};
+            bool seen{false};
+            bool pending{false};
+            bool has_slot{false};
+            TdmaSlot slot{};
+            int64_t last_sync_us{0};
+        };
+
+        void assign_slot(Peer &peer);
+
+        static uint32_t reconstruct_counter(uint32_t last, uint8_t ctr8);
+
+        const SimParams &params_;
+        std::vector<std::unique_ptr<Peer>> peers_;
+
+        uint16_t next_slot_{0};
+        uint32_t slot_overflow_{0};
+    };
+
+} // namespace loragro::netsim
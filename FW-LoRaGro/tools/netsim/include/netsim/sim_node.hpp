@@ -0,0 +1,158 @@
+/**
+ * One simulated FiNo node
+ *
+ * Holds the same firmware objects App owns (Auth, FrameCodec,
+ * ProtocolHandler, BatteryEstimator) next to the node's own
+ * DeviceConfig. FrameCodec and ProtocolHandler read the config from
+ * the ConfigManager singleton, so every call into them is wrapped in
+ * a NodeConfigScope that swaps this node's config in and out.
+ *
+ * Clock model (all true times are simulation time):
+ *
+ *   local = (true - boot) * (1 + ppm / 1e6)       uptime of the node
+ *   wall  = local                                 before the first sync
+ *   wall  = sync_wall + (local - sync_local)      after a CONFIG with time
+ *
+ * TimeManager is process wide, so the sync state of each node lives
+ * here instead; the TDMA grid is evaluated on this per-node clock the
+ * same way SlotScheduler::next_wake_local_ms() does on the real one.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "config_manager.hpp"
+#include "battery_estimator.hpp"
+#include "energy_ledger.hpp"
+#include "data_types.hpp"
+#include "lora/lora_auth.hpp"
+#include "lora/lora_frame_codec.hpp"
+#include "lora/lora_protocol_handler.hpp"
+
+namespace loragro::netsim
+{
+    /* Swaps a node's config into the ConfigManager singleton for one call */
+    class NodeConfigScope
+    {
+    public:
+        explicit NodeConfigScope(DeviceConfig &cfg) : cfg_(cfg)
+        {
+            ConfigManager::instance().get() = cfg_;
+        }
+
+        ~NodeConfigScope()
+        {
+            cfg_ = ConfigManager::instance().get();
+        }
+
+        NodeConfigScope(const NodeConfigScope &) = delete;
+        NodeConfigScope &operator=(const NodeConfigScope &) = delete;
+
+    private:
+        DeviceConfig &cfg_;
+    };
+
+    enum class NodeState : uint8_t
+    {
+        SLEEP,
+        SAMPLING,
+        WAIT_ACK,
+        RX_WINDOW,
+        RESPONSE,
+    };
+
+    struct SimNode
+    {
+        static constexpr size_t MAX_MEASUREMENTS = 64;
+        static constexpr size_t FRAME_BUF_SIZE = 255;
+
+        SimNode(uint32_t idx, const DeviceConfig &dev_cfg)
+            : index(idx),
+              cfg(dev_cfg),
+              auth(cfg),
+              codec(ConfigManager::instance()),
+              handler(ConfigManager::instance()),
+              battery(cfg)
+        {
+        }
+
+        SimNode(const SimNode &) = delete;
+        SimNode &operator=(const SimNode &) = delete;
+
+        /* ---- Clock ---- */
+
+        int64_t local_us(int64_t true_us) const
+        {
+            return static_cast<int64_t>(static_cast<double>(true_us - boot_us) * rate);
+        }
+
+        int64_t true_us_at(int64_t local) const
+        {
+            return boot_us + static_cast<int64_t>(static_cast<double>(local) / rate);
+        }
+
+        int64_t wall_ms(int64_t true_us) const
+        {
+            const int64_t local = local_us(true_us);
+            return synced ? sync_wall_ms + (local - sync_local_us) / 1000 : local / 1000;
+        }
+
+        int64_t local_us_for_wall_ms(int64_t wall) const
+        {
+            return synced ? sync_local_us + (wall - sync_wall_ms) * 1000 : wall * 1000;
+        }
+
+        /* ---- Firmware objects ---- */
+
+        const uint32_t index;
+        DeviceConfig cfg;
+        Auth auth;
+        FrameCodec codec;
+        ProtocolHandler handler;
+        BatteryEstimator battery;
+
+        /* ---- Placement and clock ---- */
+
+        float path_loss_db{0.0f};
+        int64_t boot_us{0};
+        double rate{1.0};
+
+        bool synced{false};
+        int64_t sync_local_us{0};
+        int64_t sync_wall_ms{0};
+
+        /* ---- Cycle ---- */
+
+        uint32_t cycle{0}; // tags gateway events, a late ACK never hits the next cycle
+        uint32_t token{0}; // bumped to drop pending node timers
+        NodeState state{NodeState::SLEEP};
+
+        int64_t wake_us{0};
+        int64_t sleep_start_us{0};
+        int8_t tx_dbm{0};
+        uint8_t max_payload{0};
+
+        std::array<Measurement, MAX_MEASUREMENTS> batch{};
+        std::array<uint8_t, FRAME_BUF_SIZE> frame{}; // built and signed right before its first TX
+        uint8_t frame_len{0};
+        uint8_t sent_frames{0};
+        uint8_t attempt{0};
+
+        int64_t window_open_us{0};
+        int64_t window_close_us{0};
+
+        std::array<uint8_t, FrameLayout::ACK_FRAME_SIZE + FrameLayout::AUTH_SIZE> ack{};
+        int64_t ack_start_us{0};
+        std::array<uint8_t, 64> downlink{};
+        uint8_t downlink_len{0};
+        int64_t downlink_start_us{0};
+        std::array<uint8_t, FrameLayout::RESPONSE_FRAME_SIZE + FrameLayout::AUTH_SIZE> response{};
+
+        /* ---- Energy, EnergyLedger components of the running cycle ---- */
+
+        std::array<uint64_t, ENERGY_COMPONENT_COUNT> active_us{};
+        uint64_t charge_nAh{0}; // completed cycles, sleep included
+    };
+
+} // namespace loragro::netsim
@@ -0,0 +1,68 @@
+/**
+ * Network simulator parameters
+ *
+ * Defaults come from Kconfig (CONFIG_NETSIM_*), every field can be
+ * overridden on the native_sim command line, so one build sweeps a
+ * whole configuration space:
+ *
+ *   zephyr.exe -nodes=2000 -sf=9 -interval=15 -hours=48
+ *
+ * Run zephyr.exe --help for the full list.
+ */
+#pragma once
+
+#include <cstdint>
+#include <zephyr/sys/util.h>
+
+namespace loragro::netsim
+{
+    struct SimParams
+    {
+        /* Network */
+        uint32_t nodes;
+        uint32_t sf;           // 7..12, BW 125 kHz
+        uint32_t interval_min; // sample interval of every node
+        uint32_t hours;        // simulated time
+        uint32_t measurements; // entries per node and cycle
+        bool assign_slots;     // gateway hands out compact SET_TDMA_SLOT slots
+        uint32_t resync_min;   // gateway re-sends time sync after this, 0 = never
+
+        /* Channel */
+        uint32_t radius_m;     // nodes placed uniformly on a disc around the gateway
+        uint32_t capture_db;   // SIR a frame needs to survive overlapping frames
+        uint32_t shadowing_db; // per frame log-normal fading, standard deviation
+
+        /* Node */
+        uint32_t clock_ppm;     // residual crystal error, uniform +-clock_ppm
+        uint32_t boot_spread_s; // nodes power up uniformly within this window
+        uint32_t sample_ms;     // wake -> first TX (sensor conversion time)
+        uint32_t battery_mv;    // battery voltage fed to BatteryEstimator
+
+        uint32_t seed;
+        bool csv; // one machine readable line instead of the report
+
+        /* constexpr: parsed into before any constructor runs (PRE_BOOT_1) */
+        static constexpr SimParams defaults()
+        {
+            return SimParams{
+                CONFIG_NETSIM_NODES,
+                CONFIG_NETSIM_SF,
+                CONFIG_NETSIM_INTERVAL_MIN,
+                CONFIG_NETSIM_HOURS,
+                CONFIG_NETSIM_MEASUREMENTS,
+                IS_ENABLED(CONFIG_NETSIM_ASSIGN_SLOTS),
+                CONFIG_NETSIM_RESYNC_MIN,
+                CONFIG_NETSIM_RADIUS_M,
+                CONFIG_NETSIM_CAPTURE_DB,
+                CONFIG_NETSIM_SHADOWING_DB,
+                CONFIG_NETSIM_CLOCK_PPM,
+                CONFIG_NETSIM_BOOT_SPREAD_S,
+                CONFIG_NETSIM_SAMPLE_MS,
+                CONFIG_NETSIM_BATTERY_MV,
+                CONFIG_NETSIM_SEED,
+                false,
+            };
+        }
+    };
+
+} // namespace loragro::netsim
@@ -0,0 +1,54 @@
+/**
+ * Network simulator counters
+ *
+ * Frame level counters count every transmission including retries,
+ * measurement level counters count each entry once, so
+ *
+ *   delivery ratio = measurements_delivered / measurements_generated
+ *   collision rate = uplinks_collided / uplinks
+ *   energy / meas  = charge_nAh / measurements_delivered
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace loragro::netsim
+{
+    struct SimStats
+    {
+        /* Nodes */
+        uint64_t cycles;
+        uint64_t measurements_generated;
+        uint64_t frames_scrapped;   // did not fit into max_tx_frames_per_cycle
+        uint64_t frames_failed;     // no ACK after max_retries
+        uint64_t charge_nAh;        // all nodes, sleep included
+        uint64_t stride_skipped;    // intervals skipped by BatteryEstimator stride
+
+        /* Uplinks at the gateway */
+        uint64_t uplinks;
+        uint64_t uplink_airtime_us;
+        uint64_t uplinks_ok;
+        uint64_t uplinks_below_sensitivity;
+        uint64_t uplinks_gateway_busy;
+        uint64_t uplinks_collided;
+        uint64_t uplinks_auth_failed;
+        uint64_t duplicates;        // retry of a frame that was already received
+        uint64_t measurements_delivered;
+
+        /* ACKs */
+        uint64_t acks_sent;
+        uint64_t acks_gateway_busy; // gateway already transmitting
+        uint64_t acks_lost;         // below node sensitivity
+        uint64_t acks_missed;       // outside the node's ACK window
+        uint64_t acks_rejected;     // Interface::is_valid_ack() failed
+        uint64_t acks_ok;           // verified by the node
+
+        /* CONFIG downlinks */
+        uint64_t downlinks_sent;
+        uint64_t downlinks_ok;      // verified and decoded by the node
+        uint64_t responses_ok;      // RESPONSE received by the gateway
+        uint64_t slots_assigned;
+        uint64_t slot_overflow;     // node left on its node_id slot, interval full
+    };
+
+} // namespace loragro::netsim
@@ -0,0 +1,27 @@
+#!/bin/bash
+# Capacity sweep: node count x spreading factor, one CSV row per run.
+#
+# usage: scripts/sweep.sh [build_dir] [hours] > sweep.csv
+
+BUILD=${1:-build}
+HOURS=${2:-24}
+EXE="$BUILD/zephyr/zephyr.exe"
+
+if [ ! -x "$EXE" ]; then
+    echo "Build first: west build -b native_sim -d $BUILD FW-LoRaGro/tools/netsim" >&2
+    exit 1
+fi
+
+header=1
+for sf in 7 8 9 10 11 12; do
+    for nodes in 50 100 200 500 1000 2000 4000; do
+        for slots in true false; do
+            out=$("$EXE" -nodes=$nodes -sf=$sf -hours=$HOURS -slots=$slots -csv | grep -E '^[a-z0-9]+,')
+            if [ $header -eq 1 ]; then
+                echo "$out" | head -n1
+                header=0
+            fi
+            echo "$out" | tail -n1
+        done
+    done
+done
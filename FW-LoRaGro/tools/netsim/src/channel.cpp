@@ -0,0 +1,148 @@
+#include "netsim/channel.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace loragro::netsim
+{
+    Channel::Channel(uint32_t capture_db, uint32_t shadowing_db, uint32_t seed)
+        : capture_db_(static_cast<float>(capture_db)),
+          shadowing_db_(static_cast<float>(shadowing_db)),
+          rng_(seed)
+    {
+    }
+
+    /* =========================================================
+     * Link budget
+     * ========================================================= */
+
+    float Channel::path_loss_db(float distance_m)
+    {
+        const float d = std::max(distance_m, 1.0f);
+        return PATH_LOSS_1M_DB + 10.0f * PATH_LOSS_EXPONENT * log10f(d);
+    }
+
+    float Channel::sensitivity_dbm(uint8_t sf)
+    {
+        /* SX1262 datasheet, BW 125 kHz */
+        switch (sf)
+        {
+        case 7:
+            return -124.0f;
+        case 8:
+            return -127.0f;
+        case 9:
+            return -130.0f;
+        case 10:
+            return -133.0f;
+        case 11:
+            return -135.5f;
+        case 12:
+        default:
+            return -137.0f;
+        }
+    }
+
+    float Channel::rssi_dbm(float tx_dbm, float path_loss_db)
+    {
+        return tx_dbm - path_loss_db + shadowing_db_ * fading_(rng_);
+    }
+
+    bool Channel::downlink_ok(float tx_dbm, float path_loss_db, uint8_t sf)
+    {
+        return rssi_dbm(tx_dbm, path_loss_db) >= sensitivity_dbm(sf);
+    }
+
+    double Channel::uniform()
+    {
+        return unit_(rng_);
+    }
+
+    /* =========================================================
+     * Uplinks
+     * ========================================================= */
+
+    uint32_t Channel::begin_uplink(const Airframe &frame)
+    {
+        air_.push_back(frame);
+        air_.back().resolved = false;
+        return base_ + static_cast<uint32_t>(air_.size() - 1);
+    }
+
+    RxOutcome Channel::end_uplink(uint32_t index)
+    {
+        Airframe &f = air_[index - base_];
+        f.resolved = true;
+
+        RxOutcome outcome = RxOutcome::OK;
+
+        if (f.rssi_dbm < sensitivity_dbm(f.sf))
+        {
+            outcome = RxOutcome::BELOW_SENSITIVITY;
+        }
+        else if (std::any_of(gateway_tx_.begin(), gateway_tx_.end(), [&](const Span &s)
+                             { return s.start_us < f.end_us && s.end_us > f.start_us; }))
+        {
+            /* Half duplex, the gateway was sending an ACK or CONFIG */
+            outcome = RxOutcome::GATEWAY_BUSY;
+        }
+        else
+        {
+            double interference_mw = 0.0;
+            for (const Airframe &other : air_)
+            {
+                if (&other == &f || other.sf != f.sf)
+                    continue;
+                if (other.start_us < f.end_us && other.end_us > f.start_us)
+                    interference_mw += pow(10.0, other.rssi_dbm / 10.0);
+            }
+
+            if (interference_mw > 0.0 &&
+                f.rssi_dbm - 10.0 * log10(interference_mw) < capture_db_)
+            {
+                outcome = RxOutcome::COLLISION;
+            }
+        }
+
+        prune(f.end_us);
+        return outcome;
+    }
+
+    /* =========================================================
+     * Downlinks
+     * ========================================================= */
+
+    bool Channel::reserve_downlink(int64_t start_us, int64_t end_us)
+    {
+        for (const Span &s : gateway_tx_)
+        {
+            if (s.start_us < end_us && s.end_us > start_us)
+                return false;
+        }
+
+        gateway_tx_.push_back(Span{start_us, end_us});
+        return true;
+    }
+
+    /* Drop what can no longer overlap an unresolved uplink or a future one */
+    void Channel::prune(int64_t now_us)
+    {
+        int64_t horizon = now_us;
+        for (const Airframe &f : air_)
+        {
+            if (!f.resolved)
+                horizon = std::min(horizon, f.start_us);
+        }
+
+        while (!air_.empty() && air_.front().resolved && air_.front().end_us < horizon)
+        {
+            air_.pop_front();
+            base_++;
+        }
+
+        gateway_tx_.erase(std::remove_if(gateway_tx_.begin(), gateway_tx_.end(), [&](const Span &s)
+                                         { return s.end_us < horizon; }),
+                          gateway_tx_.end());
+    }
+
+} // namespace loragro::netsim
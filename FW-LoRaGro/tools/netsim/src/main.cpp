@@ -0,0 +1,87 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/printk.h>
+
+#include <cmdline.h>
+#include <nsi_main.h>
+#include <posix_native_task.h>
+
+#include "netsim/network.hpp"
+
+LOG_MODULE_REGISTER(netsim, LOG_LEVEL_DBG);
+
+using namespace loragro::netsim;
+
+static SimParams params = SimParams::defaults();
+
+/* =========================================================
+ * Command line (native_sim), parsed before the kernel starts
+ * ========================================================= */
+
+#define NETSIM_OPT_U32(opt, field, help)                                                      \
+    {false, false, false, const_cast<char *>(opt), const_cast<char *>("value"), 'u', \
+     &params.field, nullptr, const_cast<char *>(help)}
+
+#define NETSIM_OPT_BOOL(opt, field, help)                                                       \
+    {false, false, false, const_cast<char *>(opt), const_cast<char *>("true|false"), 'b', \
+     &params.field, nullptr, const_cast<char *>(help)}
+
+#define NETSIM_OPT_SWITCH(opt, field, help)                                                 \
+    {false, false, true, const_cast<char *>(opt), const_cast<char *>(opt), 'b', \
+     &params.field, nullptr, const_cast<char *>(help)}
+
+static void netsim_add_options()
+{
+    static struct args_struct_t options[] = {
+        NETSIM_OPT_U32("nodes", nodes, "Number of nodes"),
+        NETSIM_OPT_U32("sf", sf, "Spreading factor 7..12 (BW 125 kHz)"),
+        NETSIM_OPT_U32("interval", interval_min, "Sample interval in minutes"),
+        NETSIM_OPT_U32("hours", hours, "Simulated time in hours"),
+        NETSIM_OPT_U32("measurements", measurements, "Measurements per node and cycle"),
+        NETSIM_OPT_BOOL("slots", assign_slots, "Gateway assigns compact TDMA slots"),
+        NETSIM_OPT_U32("resync", resync_min, "Time resync period in minutes, 0 = never"),
+        NETSIM_OPT_U32("radius", radius_m, "Deployment radius around the gateway in m"),
+        NETSIM_OPT_U32("capture", capture_db, "Capture threshold in dB"),
+        NETSIM_OPT_U32("shadowing", shadowing_db, "Shadowing standard deviation in dB"),
+        NETSIM_OPT_U32("ppm", clock_ppm, "Node clock error, uniform +-ppm"),
+        NETSIM_OPT_U32("boot-spread", boot_spread_s, "Power-up spread in seconds"),
+        NETSIM_OPT_U32("sample-ms", sample_ms, "Wake to first TX in ms"),
+        NETSIM_OPT_U32("battery-mv", battery_mv, "Battery voltage in mV"),
+        NETSIM_OPT_U32("seed", seed, "Random seed"),
+        NETSIM_OPT_SWITCH("csv", csv, "Print a CSV header and result line only"),
+        ARG_TABLE_ENDMARKER};
+
+    native_add_command_line_opts(options);
+}
+
+NATIVE_TASK(netsim_add_options, PRE_BOOT_1, 10);
+
+/* =========================================================
+ * Main
+ * ========================================================= */
+
+int main(void)
+{
+    if (params.sf < 7 || params.sf > 12 || params.nodes == 0 || params.interval_min == 0 ||
+        params.interval_min > UINT8_MAX || params.hours == 0)
+    {
+        LOG_ERR("Invalid parameters (sf 7..12, nodes > 0, interval 1..255, hours > 0)");
+        nsi_exit(1);
+        return -EINVAL;
+    }
+
+    if (!params.csv)
+        printk("Simulating %u nodes for %u h\n", params.nodes, params.hours);
+
+    Network net(params);
+
+    const uint64_t events = net.run();
+
+    net.report();
+
+    if (!params.csv)
+        printk("%llu events processed\n", (unsigned long long)events);
+
+    nsi_exit(0);
+    return 0;
+}
@@ -0,0 +1,676 @@
+#include "netsim/network.hpp"
+#include "slot_scheduler.hpp"
+#include "time_manager.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+namespace loragro::netsim
+{
+    /* Sensor IDs a FiNo with BME280, BH1750, SCD41, analog soil probe and battery sense reports */
+    static constexpr uint8_t node_sensor_ids[] = {
+        SensorID::ENV_TEMP,
+        SensorID::ENV_RH,
+        SensorID::ENV_PRESS,
+        SensorID::AMB_LIGHT,
+        SensorID::CO2_CONC,
+        SensorID::CO2_TEMP,
+        SensorID::CO2_RH,
+        SensorID::SOIL_ANALOG_MOISTURE,
+        SensorID::BATTERY_VOLTAGE,
+    };
+
+    Network::Network(const SimParams &params)
+        : params_(params),
+          end_us_(static_cast<int64_t>(params.hours) * 3600 * 1000000),
+          channel_(params.capture_db, params.shadowing_db, params.seed),
+          gateway_(params_)
+    {
+        create_nodes();
+    }
+
+    /* =========================================================
+     * Setup
+     * ========================================================= */
+
+    void Network::create_nodes()
+    {
+        ConfigManager &cfg_mgr = ConfigManager::instance();
+        cfg_mgr.load_defaults();
+
+        DeviceConfig base = cfg_mgr.get();
+        base.lora.datarate = static_cast<lora_datarate>(params_.sf);
+        base.sample_interval_minutes = static_cast<uint8_t>(params_.interval_min);
+
+        nodes_.reserve(params_.nodes);
+        for (uint32_t i = 0; i < params_.nodes; ++i)
+        {
+            /* 11-bit node field, every 2047 nodes continue under the next gateway ID */
+            DeviceConfig cfg = base;
+            cfg.combined_id = make_combined_id(1 + i / 2047, 1 + i % 2047);
+
+            auto n = std::make_unique<SimNode>(i, cfg);
+
+            const float distance_m = params_.radius_m * sqrtf(static_cast<float>(channel_.uniform()));
+            n->path_loss_db = Channel::path_loss_db(std::max(distance_m, 10.0f));
+            n->rate = 1.0 + (2.0 * channel_.uniform() - 1.0) * params_.clock_ppm * 1e-6;
+            n->boot_us = static_cast<int64_t>(channel_.uniform() * params_.boot_spread_s * 1e6);
+
+            gateway_.add_peer(n->cfg);
+            queue_.push(n->boot_us, EventType::NODE_WAKE, i, n->token);
+            nodes_.push_back(std::move(n));
+        }
+    }
+
+    /* =========================================================
+     * Main loop
+     * ========================================================= */
+
+    uint64_t Network::run()
+    {
+        while (!queue_.empty())
+        {
+            const Event e = queue_.pop();
+            if (e.at_us >= end_us_)
+                break;
+
+            dispatch(e);
+        }
+
+        /* Sleep since the last cycle up to the end of the run */
+        const uint32_t sleep_ua = EnergyLedger::current_ua(EnergyComponent::SLEEP);
+        stats_.charge_nAh = 0;
+        for (const auto &n : nodes_)
+        {
+            stats_.charge_nAh += n->charge_nAh;
+            if (n->state == NodeState::SLEEP && n->sleep_start_us < end_us_)
+                stats_.charge_nAh += EnergyLedger::charge_nAh(sleep_ua, end_us_ - n->sleep_start_us);
+        }
+
+        stats_.slots_assigned = gateway_.slots_assigned();
+        stats_.slot_overflow = gateway_.slot_overflow();
+
+        return queue_.processed();
+    }
+
+    void Network::dispatch(const Event &e)
+    {
+        if (e.type == EventType::GATEWAY_RX_END)
+        {
+            gateway_rx_end(e.arg);
+            return;
+        }
+
+        SimNode &n = *nodes_[e.node];
+
+        switch (e.type)
+        {
+        case EventType::NODE_ACK_RX:
+            if (e.arg == n.cycle)
+                node_ack_rx(n);
+            else
+                stats_.acks_missed++;
+            return;
+        case EventType::NODE_DOWNLINK:
+            if (e.arg == n.cycle)
+                node_downlink(n);
+            return;
+        default:
+            break;
+        }
+
+        /* Node timers, superseded ones are dropped */
+        if (e.arg != n.token)
+            return;
+
+        switch (e.type)
+        {
+        case EventType::NODE_WAKE:
+            node_wake(n);
+            break;
+        case EventType::NODE_TX:
+            node_tx(n);
+            break;
+        case EventType::NODE_ACK_END:
+            node_ack_end(n);
+            break;
+        case EventType::NODE_RX_END:
+            node_rx_end(n);
+            break;
+        case EventType::NODE_CYCLE_END:
+            node_cycle_end(n);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /* =========================================================
+     * Node: wake, sample, start the batch
+     * ========================================================= */
+
+    void Network::node_wake(SimNode &n)
+    {
+        const int64_t now = queue_.now_us();
+
+        /* EnergyLedger::begin_cycle(), the sleep belongs to this cycle's report */
+        if (n.cycle > 0)
+            account(n, EnergyComponent::SLEEP, now - n.sleep_start_us);
+
+        n.cycle++;
+        n.token++;
+        n.state = NodeState::SAMPLING;
+        n.wake_us = now;
+
+        /* App::run_cycle(): radio limited by the battery, key derived once */
+        n.tx_dbm = MIN(n.cfg.lora.tx_power, n.battery.tx_power_cap_dbm());
+        n.max_payload = SlotScheduler::get_max_payload(n.cfg);
+        n.auth.init_key();
+
+        begin_batch(n);
+
+        n.sent_frames = 0;
+        n.attempt = 0;
+        queue_.push(now + static_cast<int64_t>(params_.sample_ms) * 1000, EventType::NODE_TX, n.index, n.token);
+    }
+
+    void Network::begin_batch(SimNode &n)
+    {
+        const size_t count = MIN(params_.measurements, SimNode::MAX_MEASUREMENTS);
+        const uint32_t timestamp = static_cast<uint32_t>(n.wall_ms(queue_.now_us()) / 1000);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Measurement &m = n.batch[i];
+            m.sensor_id = node_sensor_ids[i % ARRAY_SIZE(node_sensor_ids)];
+            m.value.val1 = static_cast<int32_t>(1000 * (20 + i));
+            m.value.val2 = 0;
+            m.timestamp = timestamp;
+        }
+
+        stats_.cycles++;
+        stats_.measurements_generated += count;
+
+        NodeConfigScope scope(n.cfg);
+        n.codec.begin(BatchView{n.batch.data(), count});
+    }
+
+    /* One pass of the App::run_cycle() frame loop: build, sign, hand to send_confirmed() */
+    bool Network::prepare_frame(SimNode &n)
+    {
+        if (!n.codec.has_frame_to_send())
+            return false;
+
+        if (n.sent_frames > n.cfg.max_tx_frames_per_cycle)
+        {
+            stats_.frames_scrapped++;
+            return false;
+        }
+
+        n.frame.fill(0);
+
+        int len;
+        {
+            NodeConfigScope scope(n.cfg);
+            len = n.codec.build_frame(n.frame.data(), n.max_payload - FrameLayout::AUTH_SIZE);
+        }
+        if (len <= 0)
+            return false;
+
+        /* Signing touches cfg.tx_security_counter through Auth, outside the scope */
+        n.auth.sign_frame(n.frame.data(), len, n.max_payload);
+
+        n.frame_len = static_cast<uint8_t>(len + FrameLayout::AUTH_SIZE);
+        n.sent_frames++;
+        return true;
+    }
+
+    /* =========================================================
+     * Node: confirmed uplink (Interface::send_confirmed)
+     * ========================================================= */
+
+    void Network::node_tx(SimNode &n)
+    {
+        const int64_t now = queue_.now_us();
+
+        if (n.attempt == 0 && !prepare_frame(n))
+        {
+            open_rx_window(n, now);
+            return;
+        }
+
+        transmit(n, n.frame.data(), n.frame_len);
+
+        /* lora_send() returns at TX done, then the node sleeps one more airtime */
+        const int64_t tx_end = now + airtime_us(n.cfg, n.frame_len);
+        const uint32_t ack_timeout_ms = static_cast<uint32_t>(
+            interface_airtime_ms(n.cfg, FrameLayout::ACK_FRAME_SIZE) * n.cfg.air_time_margin_factor);
+
+        n.state = NodeState::WAIT_ACK;
+        n.window_open_us = tx_end + static_cast<int64_t>(interface_airtime_ms(n.cfg, n.frame_len)) * 1000;
+        n.window_close_us = n.window_open_us + static_cast<int64_t>(ack_timeout_ms) * 1000;
+
+        queue_.push(n.window_close_us, EventType::NODE_ACK_END, n.index, n.token);
+    }
+
+    void Network::node_ack_rx(SimNode &n)
+    {
+        const int64_t now = queue_.now_us();
+
+        if (n.state != NodeState::WAIT_ACK || n.ack_start_us < n.window_open_us || now > n.window_close_us)
+        {
+            stats_.acks_missed++;
+            return;
+        }
+
+        account(n, EnergyComponent::RADIO_RX, now - n.window_open_us);
+        n.token++;
+
+        /* Interface::is_valid_ack() */
+        const uint8_t expected_ctr = n.frame[FrameLayout::FRAME_CTR];
+        const bool valid = n.ack[FrameLayout::FRAME_TYPE] == static_cast<uint8_t>(FrameType::ACK) &&
+                           read_u16_le(n.ack.data(), 0) == n.cfg.combined_id &&
+                           n.ack[FrameLayout::FRAME_CTR] == expected_ctr &&
+                           n.auth.verify_ack(n.ack.data(), FrameLayout::ACK_FRAME_SIZE, expected_ctr,
+                                             n.ack.data() + FrameLayout::ACK_FRAME_SIZE) == 0;
+        if (!valid)
+        {
+            /* wait_for_ack() returns on the first packet, a bad one fails the attempt */
+            stats_.acks_rejected++;
+            attempt_failed(n);
+            return;
+        }
+
+        stats_.acks_ok++;
+        next_frame(n, now);
+    }
+
+    void Network::node_ack_end(SimNode &n)
+    {
+        account(n, EnergyComponent::RADIO_RX, n.window_close_us - n.window_open_us);
+        n.token++;
+        attempt_failed(n);
+    }
+
+    void Network::attempt_failed(SimNode &n)
+    {
+        const int64_t retry_at = queue_.now_us() + RETRY_BACKOFF_US;
+
+        if (++n.attempt < n.cfg.max_retries)
+        {
+            queue_.push(retry_at, EventType::NODE_TX, n.index, n.token);
+            return;
+        }
+
+        stats_.frames_failed++;
+        next_frame(n, retry_at);
+    }
+
+    void Network::next_frame(SimNode &n, int64_t at_us)
+    {
+        n.token++;
+        n.attempt = 0;
+        queue_.push(at_us, EventType::NODE_TX, n.index, n.token);
+    }
+
+    /* One RX window per cycle, sized for a full frame (Interface::compute_rx_timeout) */
+    void Network::open_rx_window(SimNode &n, int64_t at_us)
+    {
+        const uint32_t rx_timeout_ms = static_cast<uint32_t>(
+            interface_airtime_ms(n.cfg, n.max_payload) * n.cfg.air_time_margin_factor);
+
+        n.token++;
+        n.state = NodeState::RX_WINDOW;
+        n.window_open_us = at_us;
+        n.window_close_us = at_us + static_cast<int64_t>(rx_timeout_ms) * 1000;
+        queue_.push(n.window_close_us, EventType::NODE_RX_END, n.index, n.token);
+    }
+
+    /* =========================================================
+     * Node: CONFIG downlink and RESPONSE
+     * ========================================================= */
+
+    void Network::node_downlink(SimNode &n)
+    {
+        const int64_t now = queue_.now_us();
+
+        if (n.state != NodeState::RX_WINDOW || n.downlink_start_us < n.window_open_us || now > n.window_close_us)
+            return;
+
+        account(n, EnergyComponent::RADIO_RX, now - n.window_open_us);
+        n.token++;
+
+        const uint8_t received = n.downlink_len;
+        const uint8_t *tag = n.downlink.data() + (received - FrameLayout::AUTH_SIZE);
+        const uint8_t frame_ctr = n.downlink[FrameLayout::FRAME_CTR];
+
+        if (n.auth.verify_frame(n.downlink.data(), received - FrameLayout::AUTH_SIZE, frame_ctr, tag) != 0)
+        {
+            queue_.push(now, EventType::NODE_CYCLE_END, n.index, n.token);
+            return;
+        }
+
+        DecodeResult result;
+        {
+            NodeConfigScope scope(n.cfg);
+            result = n.handler.decode(n.downlink.data(), received);
+        }
+
+        if (result == DecodeResult::OK)
+        {
+            /* SET_UNIX_TIME_MS is stamped with the end of the gateway TX */
+            stats_.downlinks_ok++;
+            n.synced = true;
+            n.sync_local_us = n.local_us(now);
+            n.sync_wall_ms = now / 1000;
+        }
+
+        int len;
+        {
+            NodeConfigScope scope(n.cfg);
+            len = n.codec.build_frame(n.response.data(), n.max_payload - FrameLayout::AUTH_SIZE, result);
+        }
+
+        if (len <= 0 || n.auth.sign_frame(n.response.data(), len, n.max_payload) < 0)
+        {
+            queue_.push(now, EventType::NODE_CYCLE_END, n.index, n.token);
+            return;
+        }
+
+        /* App::run_cycle() passes the length without the tag to send_response() */
+        transmit(n, n.response.data(), static_cast<uint8_t>(len));
+        n.state = NodeState::RESPONSE;
+        queue_.push(now + airtime_us(n.cfg, len), EventType::NODE_CYCLE_END, n.index, n.token);
+    }
+
+    void Network::node_rx_end(SimNode &n)
+    {
+        account(n, EnergyComponent::RADIO_RX, n.window_close_us - n.window_open_us);
+        n.token++;
+        queue_.push(queue_.now_us(), EventType::NODE_CYCLE_END, n.index, n.token);
+    }
+
+    /* =========================================================
+     * Node: end of cycle (EnergyLedger::end_cycle + handle_sleep)
+     * ========================================================= */
+
+    void Network::node_cycle_end(SimNode &n)
+    {
+        const int64_t now = queue_.now_us();
+        const int64_t sample_us = static_cast<int64_t>(params_.sample_ms) * 1000;
+
+        account(n, EnergyComponent::MCU_ACTIVE, now - n.wake_us);
+        account(n, EnergyComponent::SENSOR_RAIL, sample_us);
+        account(n, EnergyComponent::SAMPLING, sample_us);
+
+        EnergyReport report{};
+        for (size_t c = 0; c < ENERGY_COMPONENT_COUNT; ++c)
+        {
+            const uint64_t us = n.active_us[c];
+            report.active_us[c] = static_cast<uint32_t>(MIN(us, UINT32_MAX));
+            report.charge_nAh[c] = EnergyLedger::charge_nAh(
+                EnergyLedger::current_ua(static_cast<EnergyComponent>(c)), us);
+            report.total_nAh += report.charge_nAh[c];
+        }
+        report.cycle = n.cycle;
+
+        n.charge_nAh += report.total_nAh;
+        n.active_us.fill(0);
+
+        /* PowerManagement::handle_sleep(): battery model decides the stride */
+        n.battery.update(static_cast<int32_t>(params_.battery_mv),
+                         EnergyLedger::current_ua(EnergyComponent::MCU_ACTIVE) +
+                             EnergyLedger::current_ua(EnergyComponent::SAMPLING));
+        n.battery.account_cycle(report);
+
+        const uint8_t stride = (n.battery.ocv_mv() < n.cfg.battery_cutoff_mv)
+                                   ? n.battery.max_stride()
+                                   : n.battery.interval_stride();
+        stats_.stride_skipped += stride - 1;
+
+        n.state = NodeState::SLEEP;
+        n.sleep_start_us = now;
+        n.token++;
+        schedule_wake(n, stride);
+    }
+
+    /* Same grid as SlotScheduler::next_wake_local_ms(), on the node's simulated clock */
+    void Network::schedule_wake(SimNode &n, uint8_t stride)
+    {
+        const int64_t now = queue_.now_us();
+        const uint32_t interval_min = n.cfg.sample_interval_minutes;
+        const int64_t interval_ms = static_cast<int64_t>(interval_min) * 60 * 1000;
+
+        const SlotScheduler scheduler(n.cfg);
+        const TdmaSlot *assigned = scheduler.assigned_slot(interval_min);
+        const uint32_t width_ms = assigned ? assigned->width_ms
+                                           : SlotScheduler::slot_width_ms(n.cfg, static_cast<uint32_t>(interval_ms));
+        const int64_t raw_offset_ms = assigned ? assigned->offset_ms
+                                               : static_cast<int64_t>(scheduler.slot_index(interval_min)) * width_ms;
+        const int64_t offset_ms = raw_offset_ms % interval_ms;
+
+        /* Wake-up lead equals the sampling time, so the first frame leaves at slot start + guard */
+        const int64_t guard_us = static_cast<int64_t>(TimeManager::guard_ms(static_cast<uint32_t>(interval_ms))) * 1000;
+        const int64_t lead_us = static_cast<int64_t>(params_.sample_ms) * 1000;
+
+        const int64_t now_local = n.local_us(now);
+        const int64_t now_wall = n.wall_ms(now);
+
+        int64_t cycle = (now_wall >= offset_ms) ? (now_wall - offset_ms) / interval_ms : 0;
+        cycle += MAX(stride, 1) - 1;
+
+        int64_t wake_local = 0;
+        do
+        {
+            cycle++;
+            const int64_t slot_wall = cycle * interval_ms + offset_ms;
+            wake_local = n.local_us_for_wall_ms(slot_wall) + guard_us - lead_us;
+        } while (wake_local < now_local + MIN_SLEEP_US);
+
+        queue_.push(n.true_us_at(wake_local), EventType::NODE_WAKE, n.index, n.token);
+    }
+
+    /* =========================================================
+     * Gateway
+     * ========================================================= */
+
+    void Network::transmit(SimNode &n, const uint8_t *data, uint8_t len)
+    {
+        const int64_t now = queue_.now_us();
+        const int64_t air = airtime_us(n.cfg, len);
+        const uint8_t sf = static_cast<uint8_t>(n.cfg.lora.datarate);
+
+        const uint32_t index = channel_.begin_uplink(Airframe{
+            now, now + air, n.index, sf,
+            channel_.rssi_dbm(n.tx_dbm, n.path_loss_db),
+            data, len, false});
+
+        stats_.uplinks++;
+        stats_.uplink_airtime_us += air;
+        account(n, EnergyComponent::RADIO_TX, air);
+
+        queue_.push(now + air, EventType::GATEWAY_RX_END, n.index, index);
+    }
+
+    void Network::gateway_rx_end(uint32_t air)
+    {
+        const int64_t now = queue_.now_us();
+        const Airframe f = channel_.frame(air);
+
+        switch (channel_.end_uplink(air))
+        {
+        case RxOutcome::OK:
+            stats_.uplinks_ok++;
+            break;
+        case RxOutcome::BELOW_SENSITIVITY:
+            stats_.uplinks_below_sensitivity++;
+            return;
+        case RxOutcome::GATEWAY_BUSY:
+            stats_.uplinks_gateway_busy++;
+            return;
+        case RxOutcome::COLLISION:
+            stats_.uplinks_collided++;
+            return;
+        }
+
+        SimNode &n = *nodes_[f.node];
+        const SimGateway::Uplink up = gateway_.receive(f.node, f.data, f.len, now);
+
+        switch (up.kind)
+        {
+        case SimGateway::UplinkKind::INVALID:
+            stats_.uplinks_auth_failed++;
+            return;
+        case SimGateway::UplinkKind::RESPONSE:
+            if (up.result == static_cast<uint8_t>(DecodeResult::OK))
+                stats_.responses_ok++;
+            return;
+        case SimGateway::UplinkKind::DUPLICATE:
+            stats_.duplicates++;
+            break;
+        case SimGateway::UplinkKind::DATA:
+            stats_.measurements_delivered += up.entries;
+            break;
+        }
+
+        /* ACK lands where the node listens: after its post-TX sleep of one airtime */
+        const size_t ack_len = FrameLayout::ACK_FRAME_SIZE + FrameLayout::AUTH_SIZE;
+        const int64_t ack_start = now + static_cast<int64_t>(interface_airtime_ms(n.cfg, f.len)) * 1000 +
+                                  GW_TURNAROUND_US;
+        const int64_t ack_end = ack_start + airtime_us(n.cfg, ack_len);
+
+        if (!channel_.reserve_downlink(ack_start, ack_end))
+        {
+            stats_.acks_gateway_busy++;
+            return;
+        }
+
+        stats_.acks_sent++;
+        gateway_.build_ack(f.node, f.data, up.counter, n.ack.data());
+        n.ack_start_us = ack_start;
+
+        if (channel_.downlink_ok(GW_TX_DBM, n.path_loss_db, f.sf))
+            queue_.push(ack_end, EventType::NODE_ACK_RX, f.node, n.cycle);
+        else
+            stats_.acks_lost++;
+
+        /* CONFIG right behind the ACK of the last frame, inside the node's RX window */
+        if (!up.last_frame || !gateway_.downlink_pending(f.node))
+            return;
+
+        const size_t dl_len = gateway_.config_len(f.node);
+        const int64_t dl_start = ack_end + GW_TURNAROUND_US;
+        const int64_t dl_end = dl_start + airtime_us(n.cfg, dl_len);
+
+        if (!channel_.reserve_downlink(dl_start, dl_end))
+            return;
+
+        const uint64_t unix_ms = SimGateway::EPOCH_MS + static_cast<uint64_t>(dl_end / 1000);
+        n.downlink_len = static_cast<uint8_t>(
+            gateway_.build_config(f.node, unix_ms, n.downlink.data(), n.downlink.size()));
+        if (n.downlink_len == 0)
+            return;
+
+        stats_.downlinks_sent++;
+        n.downlink_start_us = dl_start;
+
+        if (channel_.downlink_ok(GW_TX_DBM, n.path_loss_db, f.sf))
+            queue_.push(dl_end, EventType::NODE_DOWNLINK, f.node, n.cycle);
+    }
+
+    /* =========================================================
+     * Helpers
+     * ========================================================= */
+
+    void Network::account(SimNode &n, EnergyComponent c, int64_t us)
+    {
+        if (us > 0)
+            n.active_us[static_cast<size_t>(c)] += static_cast<uint64_t>(us);
+    }
+
+    int64_t Network::airtime_us(const DeviceConfig &cfg, size_t len)
+    {
+        return static_cast<int64_t>(SlotScheduler::calculate_airtime_s(cfg, static_cast<uint8_t>(len)) * 1e6f);
+    }
+
+    /* Interface::calculate_airtime_ms() truncates to whole ms, the timeouts inherit that */
+    uint32_t Network::interface_airtime_ms(const DeviceConfig &cfg, size_t len)
+    {
+        return static_cast<uint32_t>(SlotScheduler::calculate_airtime_s(cfg, static_cast<uint8_t>(len)) * 1000.0f);
+    }
+
+    /* =========================================================
+     * Report
+     * ========================================================= */
+
+    static double ratio(uint64_t num, uint64_t den)
+    {
+        return den ? static_cast<double>(num) / static_cast<double>(den) : 0.0;
+    }
+
+    void Network::report() const
+    {
+        const SimStats &s = stats_;
+        const double hours = static_cast<double>(params_.hours);
+        const uint32_t interval_ms = params_.interval_min * 60 * 1000;
+        const uint32_t width_ms = nodes_.empty() ? 0 : SlotScheduler::slot_width_ms(nodes_[0]->cfg, interval_ms);
+
+        const double load = ratio(s.uplink_airtime_us, static_cast<uint64_t>(end_us_));
+        const double delivery = ratio(s.measurements_delivered, s.measurements_generated);
+        const double collisions = ratio(s.uplinks_collided, s.uplinks);
+        const double ack_loss = 1.0 - ratio(s.acks_ok, s.acks_sent + s.acks_gateway_busy);
+        const double nAh_per_meas = ratio(s.charge_nAh, s.measurements_delivered);
+        const double avg_ua = nodes_.empty() ? 0.0 : s.charge_nAh / (hours * nodes_.size() * 1000.0);
+
+        if (params_.csv)
+        {
+            printk("nodes,sf,interval_min,hours,assign_slots,generated,delivered,delivery_ratio,"
+                   "collision_rate,ack_loss,channel_load,nAh_per_meas,avg_ua\n");
+            printk("%u,%u,%u,%u,%u,%llu,%llu,%.4f,%.4f,%.4f,%.4f,%.2f,%.2f\n",
+                   params_.nodes, params_.sf, params_.interval_min, params_.hours, params_.assign_slots,
+                   (unsigned long long)s.measurements_generated, (unsigned long long)s.measurements_delivered,
+                   delivery, collisions, ack_loss, load, nAh_per_meas, avg_ua);
+            return;
+        }
+
+        printk("\n=== LoRaGro network simulation ===\n");
+        printk("%u nodes, SF%u / 125 kHz, %u min interval, %u h, %u measurements per cycle\n",
+               params_.nodes, params_.sf, params_.interval_min, params_.hours, params_.measurements);
+        printk("TDMA: %u ms slots, %u per interval, %llu assigned, %llu left on node_id slots\n",
+               width_ms, width_ms ? interval_ms / width_ms : 0,
+               (unsigned long long)s.slots_assigned, (unsigned long long)s.slot_overflow);
+
+        printk("\n-- Channel --\n");
+        printk("load (uplink airtime / time) %.4f\n", load);
+        printk("uplinks      %llu (ok %.2f %%, collided %.2f %%, gateway busy %.2f %%, below sensitivity %.2f %%)\n",
+               (unsigned long long)s.uplinks, 100.0 * ratio(s.uplinks_ok, s.uplinks), 100.0 * collisions,
+               100.0 * ratio(s.uplinks_gateway_busy, s.uplinks),
+               100.0 * ratio(s.uplinks_below_sensitivity, s.uplinks));
+        printk("duplicates   %llu, auth failed %llu\n",
+               (unsigned long long)s.duplicates, (unsigned long long)s.uplinks_auth_failed);
+        printk("ACKs         %llu sent, %.2f %% lost (gateway busy %llu, link %llu, missed window %llu, "
+               "rejected %llu)\n",
+               (unsigned long long)s.acks_sent, 100.0 * ack_loss, (unsigned long long)s.acks_gateway_busy,
+               (unsigned long long)s.acks_lost, (unsigned long long)s.acks_missed,
+               (unsigned long long)s.acks_rejected);
+        printk("CONFIG       %llu sent, %llu applied, %llu confirmed\n",
+               (unsigned long long)s.downlinks_sent, (unsigned long long)s.downlinks_ok,
+               (unsigned long long)s.responses_ok);
+
+        printk("\n-- Delivery --\n");
+        printk("measurements %llu of %llu delivered (%.2f %%), %.1f per hour\n",
+               (unsigned long long)s.measurements_delivered, (unsigned long long)s.measurements_generated,
+               100.0 * delivery, s.measurements_delivered / hours);
+        printk("frames       %llu failed after retries, %llu scrapped (max_tx_frames_per_cycle)\n",
+               (unsigned long long)s.frames_failed, (unsigned long long)s.frames_scrapped);
+
+        printk("\n-- Energy --\n");
+        printk("per delivered measurement %.2f nAh (%.1f uJ at 3.7 V)\n",
+               nAh_per_meas, nAh_per_meas * 3.6 * 3.7);
+        printk("average node current      %.2f uA, %llu intervals skipped by battery stride\n",
+               avg_ua, (unsigned long long)s.stride_skipped);
+    }
+
+} // namespace loragro::netsim
@@ -0,0 +1,189 @@
+#include "netsim/sim_gateway.hpp"
+#include "slot_scheduler.hpp"
+
+#include <cstring>
+
+namespace loragro::netsim
+{
+    /* DATA frame: header, entry count, timestamp */
+    static constexpr size_t DATA_HEADER_SIZE = FrameLayout::HEADER_SIZE + 1 + 4;
+    static constexpr size_t MEASUREMENT_SIZE = 5;
+
+    static constexpr size_t SET_UNIX_TIME_MS_LEN = 8;
+    static constexpr size_t SET_TDMA_SLOT_LEN = 9;
+
+    SimGateway::SimGateway(const SimParams &params)
+        : params_(params)
+    {
+    }
+
+    void SimGateway::add_peer(const DeviceConfig &node_cfg)
+    {
+        peers_.push_back(std::make_unique<Peer>(node_cfg));
+    }
+
+    uint32_t SimGateway::reconstruct_counter(uint32_t last, uint8_t ctr8)
+    {
+        uint32_t candidate = (last & 0xFFFFFF00u) | ctr8;
+
+        /* Lower byte wrapped since the last frame */
+        if (candidate + 0x80 < last)
+            candidate += 0x100;
+
+        return candidate;
+    }
+
+    /* =========================================================
+     * Uplink
+     * ========================================================= */
+
+    SimGateway::Uplink SimGateway::receive(uint32_t node, const uint8_t *data, uint8_t len, int64_t now_us)
+    {
+        Uplink up{UplinkKind::INVALID, 0, 0, false, 0};
+        Peer &peer = *peers_[node];
+
+        if (len < FrameLayout::HEADER_SIZE || read_u16_le(data, 0) != peer.cfg.combined_id)
+            return up;
+
+        const uint8_t type = data[FrameLayout::FRAME_TYPE];
+
+        if (type == static_cast<uint8_t>(FrameType::RESPONSE))
+        {
+            if (len < FrameLayout::RESPONSE_FRAME_SIZE)
+                return up;
+
+            up.kind = UplinkKind::RESPONSE;
+            up.result = data[FrameLayout::RESPONSE_FRAME_SIZE - 1];
+
+            if (up.result == static_cast<uint8_t>(DecodeResult::OK))
+            {
+                peer.pending = false;
+                peer.last_sync_us = now_us;
+            }
+            return up;
+        }
+
+        if (type != static_cast<uint8_t>(FrameType::DATA) || len < DATA_HEADER_SIZE + FrameLayout::AUTH_SIZE)
+            return up;
+
+        const size_t body_len = len - FrameLayout::AUTH_SIZE;
+        const uint32_t counter = reconstruct_counter(peer.last_counter, data[FrameLayout::FRAME_CTR]);
+
+        uint8_t tag[16];
+        if (peer.auth.compute_cmac(data, body_len, counter, tag) != 0 ||
+            memcmp(tag, data + body_len, FrameLayout::AUTH_SIZE) != 0)
+            return up;
+
+        up.counter = counter;
+        up.entries = data[FrameLayout::HEADER_SIZE];
+
+        /* FrameCodec fills frames greedily, a frame with room left is the last one */
+        const size_t usable = SlotScheduler::get_max_payload(peer.cfg) - FrameLayout::AUTH_SIZE;
+        up.last_frame = body_len + MEASUREMENT_SIZE + FrameLayout::AUTH_SIZE <= usable;
+
+        if (peer.seen && counter <= peer.last_counter)
+        {
+            up.kind = UplinkKind::DUPLICATE;
+            return up;
+        }
+
+        up.kind = UplinkKind::DATA;
+        peer.last_counter = counter;
+
+        if (!peer.seen)
+        {
+            peer.seen = true;
+            peer.pending = true;
+            if (params_.assign_slots)
+                assign_slot(peer);
+        }
+        else if (params_.resync_min != 0 && !peer.pending &&
+                 now_us - peer.last_sync_us >= static_cast<int64_t>(params_.resync_min) * 60 * 1000000)
+        {
+            peer.pending = true;
+        }
+
+        return up;
+    }
+
+    size_t SimGateway::build_ack(uint32_t node, const uint8_t *frame, uint32_t counter, uint8_t *out) const
+    {
+        Peer &peer = *peers_[node];
+
+        write_u16_le(out, 0, peer.cfg.combined_id);
+        out[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::ACK);
+        out[FrameLayout::FRAME_CTR] = frame[FrameLayout::FRAME_CTR];
+
+        uint8_t tag[16];
+        peer.auth.compute_cmac(out, FrameLayout::ACK_FRAME_SIZE, counter, tag);
+        memcpy(out + FrameLayout::ACK_FRAME_SIZE, tag, FrameLayout::AUTH_SIZE);
+
+        return FrameLayout::ACK_FRAME_SIZE + FrameLayout::AUTH_SIZE;
+    }
+
+    /* =========================================================
+     * CONFIG downlink
+     * ========================================================= */
+
+    void SimGateway::assign_slot(Peer &peer)
+    {
+        const uint32_t interval_ms = params_.interval_min * 60 * 1000;
+        const uint32_t width_ms = SlotScheduler::slot_width_ms(peer.cfg, interval_ms);
+        const uint32_t offset_ms = static_cast<uint32_t>(next_slot_) * width_ms;
+
+        if (width_ms > UINT16_MAX || offset_ms + width_ms > interval_ms)
+        {
+            slot_overflow_++;
+            return;
+        }
+
+        peer.slot = TdmaSlot{static_cast<uint8_t>(params_.interval_min), next_slot_,
+                             static_cast<uint16_t>(width_ms), offset_ms};
+        peer.has_slot = true;
+        next_slot_++;
+    }
+
+    size_t SimGateway::config_len(uint32_t node) const
+    {
+        size_t len = FrameLayout::FIRST_CMD + 2 + SET_UNIX_TIME_MS_LEN;
+        if (peers_[node]->has_slot)
+            len += 2 + SET_TDMA_SLOT_LEN;
+        return len + FrameLayout::AUTH_SIZE;
+    }
+
+    size_t SimGateway::build_config(uint32_t node, uint64_t unix_ms, uint8_t *out, size_t max_len)
+    {
+        Peer &peer = *peers_[node];
+
+        size_t pos = 0;
+        write_u16_le(out, pos, peer.cfg.combined_id);
+        pos += 2;
+        out[pos++] = static_cast<uint8_t>(FrameType::CONFIG);
+        out[pos++] = 0; // frame counter, set by sign_frame()
+        out[pos++] = peer.has_slot ? 2 : 1;
+        out[pos++] = PROTOCOL_VERSION;
+
+        out[pos++] = static_cast<uint8_t>(MessageOp::SET_UNIX_TIME_MS);
+        pos += write_varint(out, pos, SET_UNIX_TIME_MS_LEN);
+        write_u32_le(out, pos, static_cast<uint32_t>(unix_ms));
+        write_u32_le(out, pos + 4, static_cast<uint32_t>(unix_ms >> 32));
+        pos += SET_UNIX_TIME_MS_LEN;
+
+        if (peer.has_slot)
+        {
+            out[pos++] = static_cast<uint8_t>(MessageOp::SET_TDMA_SLOT);
+            pos += write_varint(out, pos, SET_TDMA_SLOT_LEN);
+            out[pos] = peer.slot.interval_minutes;
+            write_u16_le(out, pos + 1, peer.slot.slot_index);
+            write_u16_le(out, pos + 3, peer.slot.width_ms);
+            write_u32_le(out, pos + 5, peer.slot.offset_ms);
+            pos += SET_TDMA_SLOT_LEN;
+        }
+
+        if (peer.auth.sign_frame(out, pos, max_len) != 0)
+            return 0;
+
+        return pos + FrameLayout::AUTH_SIZE;
+    }
+
+} // namespace loragro::netsim
@@ -0,0 +1,49 @@
+/**
+ * Precomputed ACK for one node
+ *
+ * The ACK tag is CMAC(key, counter_be32 || [id][0xA5][ctr8]), 8 bytes,
+ * so CMAC is a single padded last block:
+ *
+ *   tag = AES(key, (M || 0x80 || 0 ...) ^ K2)
+ *
+ * Everything but the counter bytes is fixed per node. The template
+ * keeps that block with the padding, the ID, the frame type and K2
+ * already folded in, plus the ACK header. An ACK then costs 5 XORs
+ * and one AES block, with no CMAC state, buffering or padding work
+ * on the RX path.
+ *
+ * The counter leads the CMAC input (Auth::compute_cmac()), so the
+ * varying bytes sit in the first and only block; there is no longer
+ * fixed prefix whose chaining value could be kept.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gapp/cmac.hpp"
+#include "lora/lora_protocol.hpp"
+
+namespace loragro::gapp
+{
+    /* ACK on the air: header + tag */
+    inline constexpr size_t ACK_SIZE = FrameLayout::ACK_FRAME_SIZE + FrameLayout::AUTH_SIZE;
+
+    class AckTemplate
+    {
+    public:
+        void init(const Cmac &cmac, uint16_t combined_id);
+
+        /* cipher: the node key schedule the template was built with */
+        void build(const Aes128 &cipher, uint32_t counter, uint8_t out[ACK_SIZE]) const;
+
+    private:
+        /* Byte offsets inside the CMAC block */
+        static constexpr size_t COUNTER_POS = 0;
+        static constexpr size_t HEADER_POS = 4;
+
+        uint8_t block_[Aes128::BLOCK_SIZE]{};
+        uint8_t header_[FrameLayout::ACK_FRAME_SIZE]{};
+    };
+
+} // namespace loragro::gapp
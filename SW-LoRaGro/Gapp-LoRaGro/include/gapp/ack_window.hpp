@@ -0,0 +1,43 @@
+/**
+ * Node ACK receive window, seen from the gateway
+ *
+ * After a confirmed uplink the node (Interface::send_confirmed())
+ * sleeps one airtime of the frame it sent, then opens its receiver
+ * for ACK airtime * air_time_margin_factor. The ACK preamble has to
+ * start inside that window:
+ *
+ *   uplink end          open                       close
+ *   |-- frame airtime --|-- ACK airtime * margin --|
+ *
+ * Airtimes use the node's own formula (Interface::calculate_airtime_ms(),
+ * whole milliseconds, ACK airtime over the 4-byte ACK header), so the
+ * gateway meets the window the node actually opens, not the exact
+ * Semtech figure.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace loragro::gapp
+{
+    struct RadioParams
+    {
+        uint8_t sf{12};
+        uint32_t bandwidth_hz{125000};
+        uint8_t preamble_len{8};
+        float air_time_margin_factor{1.4f}; // DeviceConfig default
+    };
+
+    struct AckWindow
+    {
+        uint32_t open_us;  // relative to the end of the uplink
+        uint32_t close_us; // last moment the ACK may start
+    };
+
+    /* Interface::calculate_airtime_ms() */
+    uint32_t node_airtime_ms(const RadioParams &radio, size_t payload_len);
+
+    AckWindow ack_window(const RadioParams &radio, size_t uplink_len);
+
+} // namespace loragro::gapp
@@ -0,0 +1,39 @@
+/**
+ * AES-128 block encryption (FIPS-197)
+ *
+ * Encrypt direction only, which is all CMAC and the node key
+ * derivation need. The key schedule is expanded once in the
+ * constructor, so one instance per node key turns every CMAC into
+ * plain block encryptions.
+ *
+ * Same results as TinyCrypt's tc_aes_encrypt() on the nodes, without
+ * pulling TinyCrypt into the host build.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace loragro::gapp
+{
+    class Aes128
+    {
+    public:
+        static constexpr size_t BLOCK_SIZE = 16;
+        static constexpr size_t KEY_SIZE = 16;
+
+        Aes128() = default;
+        explicit Aes128(const uint8_t key[KEY_SIZE]) { set_key(key); }
+
+        void set_key(const uint8_t key[KEY_SIZE]);
+
+        /* out may alias in */
+        void encrypt(const uint8_t in[BLOCK_SIZE], uint8_t out[BLOCK_SIZE]) const;
+
+    private:
+        static constexpr size_t ROUNDS = 10;
+
+        uint32_t round_keys_[4 * (ROUNDS + 1)]{};
+    };
+
+} // namespace loragro::gapp
@@ -0,0 +1,58 @@
+/**
+ * AES-CMAC (RFC 4493)
+ *
+ * Key schedule and the K1/K2 subkeys are computed once per key. A tag
+ * is either computed in one go (compute()) or through a State that
+ * is fed incrementally; a State can be copied, so the chaining value
+ * after a fixed prefix can be kept and resumed for every message
+ * sharing that prefix.
+ *
+ * LoRaGro frames are authenticated as CMAC(key, counter_be32 || frame)
+ * with the full 32-bit frame counter, see Auth::compute_cmac(); only
+ * the first AUTH_TAG_SIZE bytes of the tag travel on the air.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gapp/aes128.hpp"
+
+namespace loragro::gapp
+{
+    class Cmac
+    {
+    public:
+        static constexpr size_t TAG_SIZE = Aes128::BLOCK_SIZE;
+
+        struct State
+        {
+            uint8_t x[Aes128::BLOCK_SIZE]{};   // chaining value
+            uint8_t buf[Aes128::BLOCK_SIZE]{}; // pending bytes, last block kept back
+            size_t pending{0};
+        };
+
+        Cmac() = default;
+        explicit Cmac(const uint8_t key[Aes128::KEY_SIZE]) { set_key(key); }
+
+        void set_key(const uint8_t key[Aes128::KEY_SIZE]);
+
+        void update(State &st, const uint8_t *data, size_t len) const;
+        void finish(const State &st, uint8_t out[TAG_SIZE]) const;
+
+        void compute(const uint8_t *data, size_t len, uint8_t out[TAG_SIZE]) const;
+
+        /* CMAC(counter_be32 || data), the tag Auth::compute_cmac() produces */
+        void compute_framed(uint32_t counter, const uint8_t *data, size_t len, uint8_t out[TAG_SIZE]) const;
+
+        const Aes128 &cipher() const { return aes_; }
+        const uint8_t *k1() const { return k1_; }
+        const uint8_t *k2() const { return k2_; }
+
+    private:
+        Aes128 aes_;
+        uint8_t k1_[Aes128::BLOCK_SIZE]{};
+        uint8_t k2_[Aes128::BLOCK_SIZE]{};
+    };
+
+} // namespace loragro::gapp
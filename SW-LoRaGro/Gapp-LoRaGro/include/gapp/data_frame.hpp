@@ -0,0 +1,75 @@
+/**
+ * DATA frame decoder
+ *
+ * Reverse of FrameCodec::build_frame() (without the tag):
+ *
+ *   [combined_id:2][DATA][ctr][count][timestamp:4] entries ...
+ *
+ *   plain entry   [sensor_id][v1:i16][v2:i16]   as FrameCodec writes them
+ *   soil profile  [SOIL_PROFILE][n] n * [probe][depth][moisture][temp][EC]
+ *
+ * A soil profile counts as one entry on the wire and is expanded into
+ * one entry per probe quantity, with the probe bus sensor ID of the
+ * record's probe index (not its position: failed probes are left out,
+ * split profiles continue in the next frame) and the value as integer
+ * part (v1) and thousandths (v2):
+ *
+ *   depth cm, moisture %, temperature C, EC uS/cm
+ *
+ * SensorID values mirror common/include/sensors/domain_types.hpp,
+ * which pulls in Zephyr headers and is not usable on the host.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "lora/lora_protocol.hpp"
+
+namespace loragro::gapp
+{
+    namespace wire
+    {
+        inline constexpr uint8_t SOIL_PROFILE = 0x3F;
+        inline constexpr uint8_t SOIL_PROBE = 0x80;
+        inline constexpr uint8_t SOIL_PROBE_MAX = 32;
+
+        inline constexpr uint8_t PROBE_DEPTH = 0;
+        inline constexpr uint8_t PROBE_MOISTURE = 1;
+        inline constexpr uint8_t PROBE_TEMPERATURE = 2;
+        inline constexpr uint8_t PROBE_EC = 3;
+
+        constexpr uint8_t soil_probe(uint8_t probe, uint8_t type)
+        {
+            return SOIL_PROBE | ((probe & 0x1F) << 2) | (type & 0x03);
+        }
+
+        inline constexpr size_t DATA_HEADER_SIZE = FrameLayout::HEADER_SIZE + 1 + 4;
+        inline constexpr size_t MEASUREMENT_SIZE = 5;
+        inline constexpr size_t SOIL_PROFILE_RECORD_SIZE = 5;
+    }
+
+    struct DataEntry
+    {
+        uint8_t sensor_id;
+        int16_t v1;
+        int16_t v2;
+    };
+
+    struct DataFrame
+    {
+        /* A 255-byte frame with nothing but soil profiles */
+        static constexpr size_t MAX_ENTRIES = 256;
+
+        uint16_t combined_id;
+        uint32_t counter;   // full frame counter, set by the caller
+        uint32_t timestamp; // node time of the first entry, seconds
+        size_t count;
+        std::array<DataEntry, MAX_ENTRIES> entries;
+    };
+
+    /* len without the tag; 0 or -EINVAL / -EPROTO */
+    int decode_data_frame(const uint8_t *frame, size_t len, DataFrame &out);
+
+} // namespace loragro::gapp
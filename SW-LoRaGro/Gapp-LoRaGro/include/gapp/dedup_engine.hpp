@@ -0,0 +1,137 @@
+/**
+ * Multi-gateway deduplication and best-reception selection
+ *
+ * Overlapping gateways hear the same DATA frame. Every gateway ingest
+ * thread inserts its reception, keyed by (combined_id, reconstructed
+ * 32-bit counter). The first insert owns the frame (forwards the
+ * data); all of them merge their RSSI / SNR, and the gateway with the
+ * best reception sends the ACK:
+ *
+ *   RX on gateway g -> insert() -> first? forward measurements
+ *                   -> wait collect time (well before the node's
+ *                      ACK window opens)
+ *                   -> lookup().best_gateway == g ? send ACK
+ *
+ * Table: open addressing, linear probing, two atomic words per slot,
+ * no locks anywhere:
+ *
+ *   key   [valid:1][pending:1][epoch:14][combined_id:16][counter:32], 0 = never used
+ *   best  [check:24][score:16][gateway:8][copies:16]
+ *
+ * A slot is claimed with one CAS on key; receptions are merged with a
+ * CAS loop on best. check is a hash of the full key, so a best word
+ * left over from an earlier owner of the slot is recognised and
+ * overwritten instead of merged into.
+ *
+ * Time bound: epoch is now / window, an entry is live during its own
+ * epoch and the next (one to two windows). Expired slots are reused
+ * in place. An entry stamped in an epoch ahead of the caller's (clocks
+ * of two gateways a little apart) counts as live. Size the table for twice the frames of one window at
+ * half load; an insert that finds no free slot within MAX_PROBE is
+ * not deduplicated and counts as overflow.
+ *
+ * Two threads inserting the same new frame at an epoch boundary can
+ * disagree on which slot is expired and both claim one. A claim is
+ * pending until its claimer has rescanned the whole probe run; of two
+ * claims at least one sees the other. A committed twin wins, of two
+ * pending ones the one earlier on the run wins and tombstones the
+ * other before it can commit. The loser merges into the winner, so
+ * exactly one insert reports first. Duplicates do not merge into a
+ * pending claim, they probe again until it is settled.
+ *
+ * Score orders by SNR, then RSSI; ties go to the lower gateway ID.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "gapp/spsc_queue.hpp"
+
+namespace loragro::gapp
+{
+    class DedupEngine
+    {
+    public:
+        struct Config
+        {
+            size_t capacity{1 << 18}; // rounded up to a power of two
+            uint32_t window_ms{5000};
+            std::function<void()> before_claim{}; // tests: runs right before a slot is claimed
+        };
+
+        struct Reception
+        {
+            uint16_t combined_id;
+            uint32_t counter;
+            uint8_t gateway;
+            int16_t rssi;
+            int8_t snr;
+        };
+
+        struct Result
+        {
+            bool first;    // this reception created the entry
+            bool stored;   // false: probe run full, not deduplicated
+            uint16_t copies;
+            uint8_t best_gateway;
+            int16_t best_rssi;
+            int8_t best_snr;
+        };
+
+        struct Stats
+        {
+            uint64_t inserts; // firsts + duplicates + overflows
+            uint64_t firsts;
+            uint64_t duplicates;
+            uint64_t overflows;
+            uint64_t twins; // concurrent double claims resolved
+        };
+
+        static constexpr size_t MAX_PROBE = 64;
+
+        explicit DedupEngine(const Config &cfg);
+
+        DedupEngine(const DedupEngine &) = delete;
+        DedupEngine &operator=(const DedupEngine &) = delete;
+
+        /* Any thread */
+        Result insert(const Reception &rx, uint64_t now_ms);
+
+        /* Current best reception of a live entry */
+        bool lookup(uint16_t combined_id, uint32_t counter, uint64_t now_ms, Result &out) const;
+
+        Stats stats() const;
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        struct alignas(16) Slot
+        {
+            std::atomic<uint64_t> key{0};
+            std::atomic<uint64_t> best{0};
+        };
+
+        enum class Merge : uint8_t
+        {
+            DONE,
+            SLOT_LOST, // key changed under the merge, redo the insert
+        };
+
+        uint16_t epoch(uint64_t now_ms) const;
+        Merge merge(Slot &slot, uint64_t key, const Reception &rx, Result &out);
+
+        const uint32_t window_ms_;
+        const size_t mask_;
+        const std::function<void()> before_claim_;
+        const std::unique_ptr<Slot[]> slots_;
+
+        alignas(CACHE_LINE) std::atomic<uint64_t> firsts_{0};
+        std::atomic<uint64_t> duplicates_{0};
+        std::atomic<uint64_t> overflows_{0};
+        std::atomic<uint64_t> twins_{0};
+    };
+
+} // namespace loragro::gapp
@@ -0,0 +1,120 @@
+/**
+ * Time-series chunk codec (Gorilla, Pelkonen et al. 2015)
+ *
+ * One chunk holds the points of one series, (t, value) pairs with t in
+ * seconds. Bits are packed MSB first into 64-bit words:
+ *
+ *   first point   t:64  value:64
+ *   timestamps    delta-of-delta, the first delta against 0
+ *                   0                  '0'
+ *                   [-63, 64]          '10'   + 7 bits
+ *                   [-255, 256]        '110'  + 9 bits
+ *                   [-2047, 2048]      '1110' + 12 bits
+ *                   else               '1111' + 64 bits
+ *   values        XOR with the previous value
+ *                   equal              '0'
+ *                   inside the window  '10' + meaningful bits
+ *                   new window         '11' + leading:5 + length-1:6 + bits
+ *
+ * The window is the leading / trailing zero count of the last XOR
+ * that opened one. A node sampling at a fixed interval costs one bit
+ * per timestamp; slowly changing readings a few bits per value.
+ *
+ * The chunk does not store its point count; the caller keeps it next
+ * to the words (see tsdb.hpp).
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace loragro::gapp
+{
+    class BitWriter
+    {
+    public:
+        /* n = 1..64, low n bits of v */
+        void write(uint64_t v, unsigned n);
+
+        const uint64_t *words() const { return words_.data(); }
+        size_t word_count() const { return words_.size(); }
+        size_t bits() const { return bits_; }
+
+        void clear()
+        {
+            words_.clear();
+            bits_ = 0;
+        }
+
+    private:
+        std::vector<uint64_t> words_;
+        size_t bits_{0};
+    };
+
+    class BitReader
+    {
+    public:
+        BitReader(const uint64_t *words, size_t word_count) : words_(words), end_(word_count * 64) {}
+
+        /* n = 1..64; false past the end */
+        bool read(unsigned n, uint64_t &v);
+
+    private:
+        const uint64_t *words_;
+        size_t end_;
+        size_t pos_{0};
+    };
+
+    class ChunkEncoder
+    {
+    public:
+        void append(int64_t t, double value);
+
+        uint32_t count() const { return count_; }
+        int64_t t_min() const { return t_min_; }
+        int64_t t_max() const { return t_max_; }
+
+        const uint64_t *words() const { return out_.words(); }
+        size_t word_count() const { return out_.word_count(); }
+
+        void clear();
+
+        /* Upper bound of the encoded size, bytes */
+        static size_t max_bytes(uint32_t points);
+
+    private:
+        BitWriter out_;
+        uint32_t count_{0};
+        int64_t t_min_{0};
+        int64_t t_max_{0};
+        int64_t t_prev_{0};
+        int64_t delta_prev_{0};
+        uint64_t v_prev_{0};
+        uint8_t leading_{0xFF}; // 0xFF: no window yet
+        uint8_t trailing_{0};
+    };
+
+    class ChunkDecoder
+    {
+    public:
+        ChunkDecoder(const uint64_t *words, size_t word_count, uint32_t count) : in_(words, word_count), left_(count) {}
+
+        /* false at the end of the chunk or on a truncated chunk */
+        bool next(int64_t &t, double &value);
+
+    private:
+        bool read_dod(int64_t &dod);
+        bool read_xor(uint64_t &x);
+
+        BitReader in_;
+        uint32_t left_;
+        bool started_{false};
+        int64_t t_prev_{0};
+        int64_t delta_prev_{0};
+        uint64_t v_prev_{0};
+        uint8_t leading_{0};
+        uint8_t trailing_{0};
+    };
+
+} // namespace loragro::gapp
@@ -0,0 +1,164 @@
+/**
+ * Gateway ingest pipeline
+ *
+ *   radio RX thread --submit()--> SPSC ring per worker --> worker thread
+ *                    shard = extract_node(combined_id) % workers
+ *
+ *   worker: NodeSecurity of the combined ID (provisioned on first frame)
+ *           -> CMAC check, counter reconstruction
+ *           -> signed ACK handed to the AckSink (new frames and retries)
+ *           -> DATA decode handed to the FrameSink (new frames only)
+ *
+ * Sharding by node ID keeps every node on one worker, so per-node
+ * security state needs no locking and frames of one node stay in
+ * order. The RX thread is the only producer of every ring; a full
+ * ring drops the frame (the node retries) instead of stalling the
+ * radio.
+ *
+ * Every ACK carries the node's receive window (ack_window.hpp) in
+ * the pipeline's clock; an ACK ready after the window opened counts
+ * as late.
+ *
+ * With a shared DedupEngine (one pipeline per gateway, same engine),
+ * every new frame is inserted with the gateway's reception. Only the
+ * first gateway to insert hands the frame to its FrameSink; the ACK
+ * carries the best reception so far, the final sender is picked with
+ * DedupEngine::lookup() before the window opens.
+ *
+ * Sinks run on the worker threads and must not block.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "gapp/ack_window.hpp"
+#include "gapp/data_frame.hpp"
+#include "gapp/dedup_engine.hpp"
+#include "gapp/node_security.hpp"
+#include "gapp/spsc_queue.hpp"
+
+namespace loragro::gapp
+{
+    struct RxFrame
+    {
+        uint64_t rx_end_ns; // end of reception, IngestPipeline::now_ns()
+        int16_t rssi;
+        int8_t snr;
+        uint8_t len;
+        uint8_t data[255];
+    };
+
+    struct AckOut
+    {
+        uint16_t combined_id;
+        uint32_t counter;
+        bool retry;         // ACK for a frame already accepted
+        uint16_t copies;    // gateways that heard it so far (dedup only)
+        uint8_t best_gateway;
+        uint64_t rx_end_ns;
+        uint64_t ready_ns;  // ACK signed
+        uint64_t open_ns;   // node RX window
+        uint64_t close_ns;
+        uint8_t data[ACK_SIZE];
+    };
+
+    class IngestPipeline
+    {
+    public:
+        struct Config
+        {
+            unsigned workers{4};
+            size_t queue_depth{1024};
+            RadioParams radio{};
+            DedupEngine *dedup{nullptr}; // shared across gateways, optional
+            uint8_t gateway_id{0};
+        };
+
+        struct Stats
+        {
+            uint64_t received;    // submitted by the RX thread
+            uint64_t dropped;     // worker ring full
+            uint64_t accepted;    // new DATA frames
+            uint64_t duplicates;  // valid retries
+            uint64_t relayed;     // new here, first heard by another gateway
+            uint64_t auth_failed; // wrong tag
+            uint64_t malformed;   // short, not DATA, undecodable
+            uint64_t acks;
+            uint64_t late_acks;   // ready after the node's window opened
+        };
+
+        using AckSink = std::function<void(unsigned worker, const AckOut &ack)>;
+        using FrameSink = std::function<void(unsigned worker, const DataFrame &frame, const RxFrame &rx)>;
+
+        IngestPipeline(const Config &cfg, AckSink on_ack, FrameSink on_frame = {});
+        ~IngestPipeline();
+
+        IngestPipeline(const IngestPipeline &) = delete;
+        IngestPipeline &operator=(const IngestPipeline &) = delete;
+
+        void start();
+
+        /* Drains the rings, then joins the workers */
+        void stop();
+
+        /* RX thread only */
+        bool submit(const RxFrame &frame);
+
+        unsigned shard_of(uint16_t combined_id) const { return extract_node(combined_id) % workers_.size(); }
+
+        Stats stats() const;
+
+        /* Steady clock the pipeline stamps with */
+        static uint64_t now_ns();
+
+    private:
+        /* 11-bit node field of the combined ID */
+        static constexpr size_t NODE_ID_COUNT = 2048;
+
+        struct alignas(CACHE_LINE) Counters
+        {
+            std::atomic<uint64_t> accepted{0};
+            std::atomic<uint64_t> duplicates{0};
+            std::atomic<uint64_t> relayed{0};
+            std::atomic<uint64_t> auth_failed{0};
+            std::atomic<uint64_t> malformed{0};
+            std::atomic<uint64_t> acks{0};
+            std::atomic<uint64_t> late_acks{0};
+        };
+
+        struct Worker
+        {
+            Worker(size_t queue_depth, size_t node_slots) : queue(queue_depth) { nodes.reserve(node_slots); }
+
+            SpscQueue<RxFrame> queue;
+            /* Full combined ID: the same node ID under two gateways is two
+             * nodes with their own key and counters */
+            std::unordered_map<uint16_t, NodeSecurity> nodes;
+            std::unique_ptr<DataFrame> decoded{std::make_unique<DataFrame>()};
+            Counters counters;
+            std::thread thread;
+        };
+
+        void run(unsigned index);
+        void process(unsigned index, const RxFrame &rx);
+
+        Config cfg_;
+        AckSink on_ack_;
+        FrameSink on_frame_;
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::atomic<bool> running_{false};
+
+        /* RX thread side */
+        alignas(CACHE_LINE) std::atomic<uint64_t> received_{0};
+        std::atomic<uint64_t> dropped_{0};
+    };
+
+} // namespace loragro::gapp
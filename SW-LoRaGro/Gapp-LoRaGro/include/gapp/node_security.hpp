@@ -0,0 +1,70 @@
+/**
+ * Per-node security state on the gateway
+ *
+ * Gateway side of Auth for one node:
+ *
+ *   key      - derived from the combined ID like Auth::derive_device_key(),
+ *              AES(master, [id_hi][id_lo][0 ...]), once per node
+ *   counter  - 32-bit uplink counter reconstructed from the 8-bit
+ *              FRAME_CTR against the last accepted one
+ *   DATA     - CMAC(counter || frame) checked against the 4-byte tag;
+ *              a valid frame at or below the last counter is a retry
+ *   ACK      - [id][0xA5][ctr] + CMAC over the full counter, what
+ *              Interface::is_valid_ack() / Auth::verify_ack() accept,
+ *              from the node's AckTemplate (one AES block per ACK)
+ *
+ * Not thread safe: the ingest pipeline shards nodes over workers, so
+ * each NodeSecurity only ever sees one thread.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gapp/ack_template.hpp"
+#include "gapp/cmac.hpp"
+#include "lora/lora_protocol.hpp"
+
+namespace loragro::gapp
+{
+    void derive_device_key(uint16_t combined_id, uint8_t key[Aes128::KEY_SIZE]);
+
+    /* Counter continuation, same rule as the simulated gateway */
+    uint32_t reconstruct_counter(uint32_t last, uint8_t ctr8);
+
+    class NodeSecurity
+    {
+    public:
+        /* Derives the key, forgets the counter history */
+        void provision(uint16_t combined_id);
+
+        bool provisioned() const { return provisioned_; }
+        uint16_t combined_id() const { return combined_id_; }
+        uint32_t last_counter() const { return last_counter_; }
+
+        /*
+         * Checks a signed uplink (len includes the tag). Returns 0 for a
+         * new frame, -EALREADY for a valid retry of an accepted one,
+         * -EBADMSG for a wrong tag, -EINVAL for a short frame. counter
+         * is set whenever the tag is valid.
+         */
+        int verify_uplink(const uint8_t *frame, size_t len, uint32_t &counter);
+
+        /* Signed ACK for a verified uplink counter, returns ACK_SIZE */
+        size_t build_ack(uint32_t counter, uint8_t *out) const;
+
+        /* Node side signing, for tests and the load generator */
+        size_t sign(uint8_t *frame, size_t len, uint32_t counter) const;
+
+        const Cmac &cmac() const { return cmac_; }
+
+    private:
+        Cmac cmac_;
+        AckTemplate ack_;
+        uint16_t combined_id_{0};
+        uint32_t last_counter_{0};
+        bool seen_{false};
+        bool provisioned_{false};
+    };
+
+} // namespace loragro::gapp
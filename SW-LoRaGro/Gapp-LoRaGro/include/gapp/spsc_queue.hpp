@@ -0,0 +1,102 @@
+/**
+ * Bounded lock-free single-producer / single-consumer ring
+ *
+ * One thread pushes, one other thread pops, no locks and no
+ * allocation after construction. Head and tail are free-running
+ * indices on their own cache lines; each side keeps a cached copy of
+ * the other side's index and only reloads it (acquire) when the ring
+ * looks full or empty, so the common case touches no shared line.
+ *
+ * Capacity is rounded up to a power of two. try_push() returns false
+ * when full; the caller decides whether to drop or retry.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace loragro::gapp
+{
+    inline constexpr size_t CACHE_LINE = 64;
+
+    template <typename T>
+    class SpscQueue
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "slots are copied, not constructed");
+
+    public:
+        explicit SpscQueue(size_t capacity)
+            : mask_(round_up(capacity) - 1),
+              slots_(std::make_unique<T[]>(mask_ + 1))
+        {
+        }
+
+        SpscQueue(const SpscQueue &) = delete;
+        SpscQueue &operator=(const SpscQueue &) = delete;
+
+        /* Producer */
+        bool try_push(const T &item)
+        {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cache_ > mask_)
+            {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cache_ > mask_)
+                    return false;
+            }
+
+            slots_[tail & mask_] = item;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /* Consumer */
+        bool try_pop(T &item)
+        {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_cache_)
+            {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (head == tail_cache_)
+                    return false;
+            }
+
+            item = slots_[head & mask_];
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /* Either side, approximate while the other side runs */
+        size_t size() const
+        {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        static size_t round_up(size_t n)
+        {
+            size_t p = 2;
+            while (p < n)
+                p <<= 1;
+            return p;
+        }
+
+        const size_t mask_;
+        const std::unique_ptr<T[]> slots_;
+
+        /* Consumer line: its index and its view of the producer */
+        alignas(CACHE_LINE) std::atomic<size_t> head_{0};
+        size_t tail_cache_{0};
+
+        /* Producer line */
+        alignas(CACHE_LINE) std::atomic<size_t> tail_{0};
+        size_t head_cache_{0};
+    };
+
+} // namespace loragro::gapp
@@ -0,0 +1,161 @@
+/**
+ * Gateway time-series store for decoded measurements
+ *
+ * One append-only series per (combined_id, sensor_id). Points are
+ * (t seconds, value) and go into the series' open chunk (gorilla.hpp).
+ * A chunk is sealed when it is full or spans chunk_span_s: appended to
+ * the active segment file, a fixed size file mapped with mmap, and
+ * indexed in memory:
+ *
+ *   dir/seg-000001.lgts  [SegmentHeader][ChunkHeader][words]...
+ *                        [ChunkHeader][words]...
+ *   dir/seg-000002.lgts  ...
+ *
+ *   index  (sensor_id, combined_id) -> series -> sealed chunks
+ *                                               (segment, offset,
+ *                                                count, t_min, t_max)
+ *                                      + open chunk in memory
+ *
+ * The index is ordered by sensor first, so "sensor S of nodes A..B"
+ * is one contiguous run of series. A scan skips every chunk whose
+ * [t_min, t_max] misses the range and decodes only the others, so the
+ * span bounds what a short recent range decodes per series. The
+ * open chunks are scanned too, so points can be queried as soon as
+ * they are appended.
+ *
+ * open() rebuilds the index from the chunk headers of all segments. A
+ * chunk whose header or words do not check out (magic, bounds, CRC-32
+ * of the words) ends its segment: write-back of the mapping has no
+ * order, so after a crash either half of the last chunks may be
+ * missing.
+ * Points still in open chunks are lost unless flush() sealed them. Call
+ * it on shutdown and every few minutes.
+ *
+ * Files are in host byte order. Retention (dropping whole old segments)
+ * is left to the caller.
+ *
+ * Writers are serialised; scans run in parallel with each other and
+ * block writers only while they run.
+ */
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "gapp/data_frame.hpp"
+#include "gapp/gorilla.hpp"
+
+namespace loragro::gapp
+{
+    /* DataEntry value: integer part and thousandths (data_frame.hpp) */
+    inline double entry_value(const DataEntry &e)
+    {
+        return e.v1 + e.v2 / 1000.0;
+    }
+
+    class TimeSeriesStore
+    {
+    public:
+        struct Config
+        {
+            std::string dir;
+            size_t segment_bytes{64u << 20};
+            uint32_t chunk_points{1024}; // sealed when full
+            int64_t chunk_span_s{86400};  // or when the next point is this far from the first
+        };
+
+        struct Query
+        {
+            uint16_t first_id{0}; // combined IDs, inclusive
+            uint16_t last_id{0xFFFF};
+            std::bitset<256> sensors;
+            int64_t from{std::numeric_limits<int64_t>::min()}; // inclusive
+            int64_t to{std::numeric_limits<int64_t>::max()};
+        };
+
+        struct Stats
+        {
+            uint64_t points;
+            uint64_t series;
+            uint64_t chunks;       // sealed
+            uint64_t segments;
+            uint64_t sealed_bytes; // chunk headers + words
+            uint64_t open_bytes;   // open chunks, in memory
+        };
+
+        using PointSink = std::function<void(uint16_t combined_id, uint8_t sensor_id, int64_t t, double value)>;
+
+        explicit TimeSeriesStore(const Config &cfg);
+        ~TimeSeriesStore();
+
+        TimeSeriesStore(const TimeSeriesStore &) = delete;
+        TimeSeriesStore &operator=(const TimeSeriesStore &) = delete;
+
+        /* Creates the directory, maps the segments, rebuilds the index; 0 or -errno */
+        int open();
+
+        /* Seals the open chunks and syncs the segments; 0 or -errno */
+        int flush();
+
+        /* 0, -EBADF before open(), or -errno when a new segment fails */
+        int append(uint16_t combined_id, uint8_t sensor_id, int64_t t, double value);
+
+        /* Every entry at the frame timestamp */
+        int append(const DataFrame &frame);
+
+        /* Points in range, per series in append order; returns the count.
+         * The sink runs under the read lock and must not append. */
+        size_t scan(const Query &q, const PointSink &sink) const;
+
+        Stats stats() const;
+
+    private:
+        struct Segment;
+
+        struct ChunkRef
+        {
+            uint32_t segment;
+            uint32_t offset; // of the words
+            uint32_t words;
+            uint32_t count;
+            int64_t t_min;
+            int64_t t_max;
+        };
+
+        struct Series
+        {
+            std::vector<ChunkRef> chunks;
+            ChunkEncoder open;
+        };
+
+        static uint32_t key_of(uint8_t sensor_id, uint16_t combined_id)
+        {
+            return (static_cast<uint32_t>(sensor_id) << 16) | combined_id;
+        }
+
+        int load();
+        int append_locked(uint16_t combined_id, uint8_t sensor_id, int64_t t, double value);
+        int seal(uint32_t key, Series &series);
+        int add_segment();
+        void index_segment(uint32_t index);
+
+        Config cfg_;
+        bool opened_{false};
+
+        mutable std::shared_mutex mutex_;
+        std::map<uint32_t, Series> series_;
+        std::vector<std::unique_ptr<Segment>> segments_;
+        uint64_t points_{0};
+        uint64_t chunks_{0};
+        uint64_t sealed_bytes_{0};
+    };
+
+} // namespace loragro::gapp
@@ -0,0 +1,45 @@
+#include "gapp/ack_template.hpp"
+
+#include <cstring>
+
+namespace loragro::gapp
+{
+    static constexpr size_t MSG_LEN = 4 + FrameLayout::ACK_FRAME_SIZE;
+    static_assert(MSG_LEN < Aes128::BLOCK_SIZE, "ACK CMAC input must fit one padded block");
+
+    void AckTemplate::init(const Cmac &cmac, uint16_t combined_id)
+    {
+        write_u16_le(header_, 0, combined_id);
+        header_[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::ACK);
+        header_[FrameLayout::FRAME_CTR] = 0;
+
+        /* Counter bytes and ctr8 left zero, XORed in per ACK */
+        memset(block_, 0, sizeof(block_));
+        memcpy(block_ + HEADER_POS, header_, sizeof(header_));
+        block_[MSG_LEN] = 0x80;
+
+        for (size_t i = 0; i < Aes128::BLOCK_SIZE; ++i)
+            block_[i] ^= cmac.k2()[i];
+    }
+
+    void AckTemplate::build(const Aes128 &cipher, uint32_t counter, uint8_t out[ACK_SIZE]) const
+    {
+        const uint8_t ctr8 = static_cast<uint8_t>(counter);
+
+        uint8_t block[Aes128::BLOCK_SIZE];
+        memcpy(block, block_, sizeof(block));
+        block[COUNTER_POS] ^= static_cast<uint8_t>(counter >> 24);
+        block[COUNTER_POS + 1] ^= static_cast<uint8_t>(counter >> 16);
+        block[COUNTER_POS + 2] ^= static_cast<uint8_t>(counter >> 8);
+        block[COUNTER_POS + 3] ^= ctr8;
+        block[HEADER_POS + FrameLayout::FRAME_CTR] ^= ctr8;
+
+        uint8_t tag[Aes128::BLOCK_SIZE];
+        cipher.encrypt(block, tag);
+
+        memcpy(out, header_, sizeof(header_));
+        out[FrameLayout::FRAME_CTR] = ctr8;
+        memcpy(out + FrameLayout::ACK_FRAME_SIZE, tag, FrameLayout::AUTH_SIZE);
+    }
+
+} // namespace loragro::gapp
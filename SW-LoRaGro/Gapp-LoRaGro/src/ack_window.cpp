@@ -0,0 +1,35 @@
+#include "gapp/ack_window.hpp"
+
+#include <cmath>
+
+#include "lora/lora_protocol.hpp"
+
+namespace loragro::gapp
+{
+    uint32_t node_airtime_ms(const RadioParams &radio, size_t payload_len)
+    {
+        const float sf = radio.sf;
+        const float tsym = static_cast<float>(1UL << radio.sf) / static_cast<float>(radio.bandwidth_hz);
+
+        const float de = (radio.sf >= 11) ? 1.0f : 0.0f;
+        const float tpreamble = (radio.preamble_len + 4.25f) * tsym;
+        const float cr = 1.0f;
+
+        float tmp = (8.0f * payload_len - 4.0f * sf + 28.0f + 16.0f) / (4.0f * (sf - 2.0f * de));
+        if (tmp < 0.0f)
+            tmp = 0.0f;
+
+        const float payload_symb = 8.0f + std::ceil(tmp) * (cr + 4);
+        return static_cast<uint32_t>((tpreamble + payload_symb * tsym) * 1000.0f);
+    }
+
+    AckWindow ack_window(const RadioParams &radio, size_t uplink_len)
+    {
+        const uint32_t open_ms = node_airtime_ms(radio, uplink_len);
+        const uint32_t timeout_ms = static_cast<uint32_t>(
+            node_airtime_ms(radio, FrameLayout::ACK_FRAME_SIZE) * radio.air_time_margin_factor);
+
+        return AckWindow{open_ms * 1000, (open_ms + timeout_ms) * 1000};
+    }
+
+} // namespace loragro::gapp
@@ -0,0 +1,100 @@
+#include "gapp/cmac.hpp"
+
+#include <cstring>
+
+namespace loragro::gapp
+{
+    static constexpr size_t BS = Aes128::BLOCK_SIZE;
+
+    /* Doubling in GF(2^128), RFC 4493 section 2.3 */
+    static void dbl(const uint8_t in[BS], uint8_t out[BS])
+    {
+        const uint8_t msb = in[0] & 0x80;
+        for (size_t i = 0; i < BS - 1; ++i)
+            out[i] = static_cast<uint8_t>((in[i] << 1) | (in[i + 1] >> 7));
+        out[BS - 1] = static_cast<uint8_t>(in[BS - 1] << 1);
+        if (msb)
+            out[BS - 1] ^= 0x87;
+    }
+
+    void Cmac::set_key(const uint8_t key[Aes128::KEY_SIZE])
+    {
+        aes_.set_key(key);
+
+        uint8_t l[BS]{};
+        aes_.encrypt(l, l);
+        dbl(l, k1_);
+        dbl(k1_, k2_);
+    }
+
+    /* =========================================================
+     * Incremental
+     * ---------------------------------------------------------
+     * Full blocks are only chained once more data follows, the last
+     * block (complete or not) is left for finish().
+     * ========================================================= */
+    void Cmac::update(State &st, const uint8_t *data, size_t len) const
+    {
+        while (len > 0)
+        {
+            if (st.pending == BS)
+            {
+                for (size_t i = 0; i < BS; ++i)
+                    st.x[i] ^= st.buf[i];
+                aes_.encrypt(st.x, st.x);
+                st.pending = 0;
+            }
+
+            const size_t n = (BS - st.pending < len) ? BS - st.pending : len;
+            memcpy(st.buf + st.pending, data, n);
+            st.pending += n;
+            data += n;
+            len -= n;
+        }
+    }
+
+    void Cmac::finish(const State &st, uint8_t out[TAG_SIZE]) const
+    {
+        uint8_t last[BS];
+
+        if (st.pending == BS)
+        {
+            for (size_t i = 0; i < BS; ++i)
+                last[i] = st.buf[i] ^ k1_[i];
+        }
+        else
+        {
+            memcpy(last, st.buf, st.pending);
+            last[st.pending] = 0x80;
+            memset(last + st.pending + 1, 0, BS - st.pending - 1);
+            for (size_t i = 0; i < BS; ++i)
+                last[i] ^= k2_[i];
+        }
+
+        for (size_t i = 0; i < BS; ++i)
+            last[i] ^= st.x[i];
+        aes_.encrypt(last, out);
+    }
+
+    void Cmac::compute(const uint8_t *data, size_t len, uint8_t out[TAG_SIZE]) const
+    {
+        State st;
+        update(st, data, len);
+        finish(st, out);
+    }
+
+    void Cmac::compute_framed(uint32_t counter, const uint8_t *data, size_t len, uint8_t out[TAG_SIZE]) const
+    {
+        const uint8_t counter_be[4] = {
+            static_cast<uint8_t>(counter >> 24),
+            static_cast<uint8_t>(counter >> 16),
+            static_cast<uint8_t>(counter >> 8),
+            static_cast<uint8_t>(counter)};
+
+        State st;
+        update(st, counter_be, sizeof(counter_be));
+        update(st, data, len);
+        finish(st, out);
+    }
+
+} // namespace loragro::gapp
@@ -0,0 +1,90 @@
+#include "gapp/data_frame.hpp"
+
+#include <cerrno>
+
+namespace loragro::gapp
+{
+    /* Half units (0.5 %, 0.5 C) to integer part and thousandths */
+    static DataEntry half_unit_entry(uint8_t sensor_id, int value)
+    {
+        return DataEntry{sensor_id, static_cast<int16_t>(value / 2), static_cast<int16_t>((value % 2) * 500)};
+    }
+
+    static bool push(DataFrame &out, const DataEntry &e)
+    {
+        if (out.count >= DataFrame::MAX_ENTRIES)
+            return false;
+        out.entries[out.count++] = e;
+        return true;
+    }
+
+    int decode_data_frame(const uint8_t *frame, size_t len, DataFrame &out)
+    {
+        if (!frame || len < wire::DATA_HEADER_SIZE)
+            return -EINVAL;
+
+        if (frame[FrameLayout::FRAME_TYPE] != static_cast<uint8_t>(FrameType::DATA))
+            return -EPROTO;
+
+        out.combined_id = read_u16_le(frame, FrameLayout::COMBINED_ID_LSB);
+        out.timestamp = read_u32_le(frame, FrameLayout::HEADER_SIZE + 1);
+        out.count = 0;
+
+        const uint8_t wire_count = frame[FrameLayout::HEADER_SIZE];
+        size_t pos = wire::DATA_HEADER_SIZE;
+
+        for (uint8_t n = 0; n < wire_count; ++n)
+        {
+            if (pos >= len)
+                return -EPROTO;
+
+            const uint8_t id = frame[pos];
+
+            if (id == wire::SOIL_PROFILE)
+            {
+                if (pos + 2 > len)
+                    return -EPROTO;
+
+                const uint8_t probes = frame[pos + 1];
+                pos += 2;
+
+                if (pos + static_cast<size_t>(probes) * wire::SOIL_PROFILE_RECORD_SIZE > len)
+                    return -EPROTO;
+
+                for (uint8_t r = 0; r < probes; ++r, pos += wire::SOIL_PROFILE_RECORD_SIZE)
+                {
+                    /* The record names its probe, failed probes and split profiles leave gaps */
+                    const uint8_t *rec = &frame[pos];
+                    const uint8_t p = rec[0];
+                    if (p >= wire::SOIL_PROBE_MAX)
+                        return -EPROTO;
+
+                    const bool fits =
+                        push(out, DataEntry{wire::soil_probe(p, wire::PROBE_DEPTH), rec[1], 0}) &&
+                        push(out, half_unit_entry(wire::soil_probe(p, wire::PROBE_MOISTURE), rec[2])) &&
+                        push(out, half_unit_entry(wire::soil_probe(p, wire::PROBE_TEMPERATURE),
+                                                  static_cast<int8_t>(rec[3]))) &&
+                        push(out, DataEntry{wire::soil_probe(p, wire::PROBE_EC),
+                                            static_cast<int16_t>(rec[4] * 10), 0});
+                    if (!fits)
+                        return -EPROTO;
+                }
+                continue;
+            }
+
+            if (pos + wire::MEASUREMENT_SIZE > len)
+                return -EPROTO;
+
+            const DataEntry e{id,
+                              static_cast<int16_t>(read_u16_le(frame, pos + 1)),
+                              static_cast<int16_t>(read_u16_le(frame, pos + 3))};
+            if (!push(out, e))
+                return -EPROTO;
+
+            pos += wire::MEASUREMENT_SIZE;
+        }
+
+        return 0;
+    }
+
+} // namespace loragro::gapp
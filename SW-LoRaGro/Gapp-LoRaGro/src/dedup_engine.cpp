@@ -0,0 +1,326 @@
+#include "gapp/dedup_engine.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace loragro::gapp
+{
+    /* =========================================================
+     * Word layouts
+     * ========================================================= */
+    static constexpr uint64_t VALID = 1ULL << 63;
+    static constexpr uint64_t PENDING = 1ULL << 62;
+    static constexpr unsigned EPOCH_SHIFT = 48;
+    static constexpr uint64_t EPOCH_MASK = 0x3FFF;
+    static constexpr uint64_t IDENT_MASK = (1ULL << EPOCH_SHIFT) - 1;
+
+    /* Non-zero, not valid: reusable, does not end a probe run */
+    static constexpr uint64_t TOMBSTONE = 1;
+
+    static constexpr size_t NONE = SIZE_MAX;
+
+    static inline uint64_t mix64(uint64_t x)
+    {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    static inline uint64_t ident_of(uint16_t combined_id, uint32_t counter)
+    {
+        return (static_cast<uint64_t>(combined_id) << 32) | counter;
+    }
+
+    static inline uint64_t make_key(uint64_t ident, uint16_t epoch)
+    {
+        return VALID | (static_cast<uint64_t>(epoch) << EPOCH_SHIFT) | ident;
+    }
+
+    /* Own epoch or the one after; an epoch ahead of ours is another gateway's clock running early */
+    static inline bool is_live(uint64_t key, uint16_t now_epoch)
+    {
+        if (!(key & VALID))
+            return false;
+        const uint64_t age = (now_epoch - ((key >> EPOCH_SHIFT) & EPOCH_MASK)) & EPOCH_MASK;
+        return age <= 1 || age > EPOCH_MASK / 2;
+    }
+
+    /* best: [check:24][score:16][gateway:8][copies:16] */
+    static inline uint32_t check_of(uint64_t key)
+    {
+        return static_cast<uint32_t>(mix64(key) >> 40);
+    }
+
+    static inline uint16_t score_of(int16_t rssi, int8_t snr)
+    {
+        const int r = std::clamp(rssi + 200, 0, 255);
+        return static_cast<uint16_t>((static_cast<uint8_t>(snr + 128) << 8) | r);
+    }
+
+    static inline uint64_t pack_best(uint32_t check, uint16_t score, uint8_t gateway, uint16_t copies)
+    {
+        return (static_cast<uint64_t>(check) << 40) | (static_cast<uint64_t>(score) << 24) |
+               (static_cast<uint64_t>(gateway) << 16) | copies;
+    }
+
+    static inline void unpack_best(uint64_t best, DedupEngine::Result &out)
+    {
+        const uint16_t score = static_cast<uint16_t>(best >> 24);
+        out.copies = static_cast<uint16_t>(best);
+        out.best_gateway = static_cast<uint8_t>(best >> 16);
+        out.best_snr = static_cast<int8_t>((score >> 8) - 128);
+        out.best_rssi = static_cast<int16_t>((score & 0xFF) - 200);
+    }
+
+    static inline bool better(uint16_t score, uint8_t gateway, uint64_t best)
+    {
+        const uint16_t cur_score = static_cast<uint16_t>(best >> 24);
+        const uint8_t cur_gw = static_cast<uint8_t>(best >> 16);
+        return score > cur_score || (score == cur_score && gateway < cur_gw);
+    }
+
+    /* =========================================================
+     * Construction
+     * ========================================================= */
+    static size_t round_up(size_t n)
+    {
+        size_t p = DedupEngine::MAX_PROBE;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    DedupEngine::DedupEngine(const Config &cfg)
+        : window_ms_(cfg.window_ms ? cfg.window_ms : 1),
+          mask_(round_up(cfg.capacity) - 1),
+          before_claim_(cfg.before_claim),
+          slots_(std::make_unique<Slot[]>(mask_ + 1))
+    {
+    }
+
+    uint16_t DedupEngine::epoch(uint64_t now_ms) const
+    {
+        return static_cast<uint16_t>((now_ms / window_ms_) & EPOCH_MASK);
+    }
+
+    /* =========================================================
+     * Merge one reception into a claimed slot
+     * ========================================================= */
+    DedupEngine::Merge DedupEngine::merge(Slot &slot, uint64_t key, const Reception &rx, Result &out)
+    {
+        const uint32_t check = check_of(key);
+        const uint16_t score = score_of(rx.rssi, rx.snr);
+
+        uint64_t cur = slot.best.load(std::memory_order_acquire);
+        uint64_t next;
+        do
+        {
+            if ((cur >> 40) != check)
+            {
+                /* Left from an earlier owner of the slot, or not yet written by the claimer */
+                next = pack_best(check, score, rx.gateway, 1);
+            }
+            else
+            {
+                const uint16_t copies = static_cast<uint16_t>(cur);
+                const uint16_t bumped = copies == UINT16_MAX ? copies : copies + 1;
+                next = better(score, rx.gateway, cur)
+                           ? pack_best(check, score, rx.gateway, bumped)
+                           : (cur & ~0xFFFFULL) | bumped;
+            }
+        } while (!slot.best.compare_exchange_weak(cur, next, std::memory_order_acq_rel,
+                                                  std::memory_order_acquire));
+
+        /* Slot reused while merging: this copy went nowhere */
+        if (slot.key.load(std::memory_order_seq_cst) != key)
+            return Merge::SLOT_LOST;
+
+        unpack_best(next, out);
+        return Merge::DONE;
+    }
+
+    /* =========================================================
+     * Insert
+     * ========================================================= */
+    DedupEngine::Result DedupEngine::insert(const Reception &rx, uint64_t now_ms)
+    {
+        const uint16_t now_epoch = epoch(now_ms);
+        const uint64_t ident = ident_of(rx.combined_id, rx.counter);
+        const size_t home = static_cast<size_t>(mix64(ident));
+
+        Result out{};
+        out.stored = true;
+
+        for (;;)
+        {
+            /* Pass 1: live copy anywhere on the run, else the first reusable slot */
+            size_t candidate = NONE;
+            size_t candidate_pos = 0;
+            uint64_t candidate_key = 0;
+            bool restart = false;
+
+            for (size_t i = 0; i < MAX_PROBE; ++i)
+            {
+                Slot &slot = slots_[(home + i) & mask_];
+                const uint64_t k = slot.key.load(std::memory_order_seq_cst);
+
+                if (k != 0 && is_live(k, now_epoch))
+                {
+                    if ((k & IDENT_MASK) != ident)
+                        continue;
+
+                    /* Claim not settled yet, it may still give way to a twin */
+                    if (k & PENDING)
+                    {
+                        std::this_thread::yield();
+                        restart = true;
+                        break;
+                    }
+
+                    if (merge(slot, k, rx, out) == Merge::SLOT_LOST)
+                    {
+                        restart = true;
+                        break;
+                    }
+                    duplicates_.fetch_add(1, std::memory_order_relaxed);
+                    return out;
+                }
+
+                if (candidate == NONE)
+                {
+                    candidate = (home + i) & mask_;
+                    candidate_pos = i;
+                    candidate_key = k;
+                }
+
+                /* Never used: nothing of this key lies further on */
+                if (k == 0)
+                    break;
+            }
+
+            if (restart)
+                continue;
+
+            if (candidate == NONE)
+            {
+                overflows_.fetch_add(1, std::memory_order_relaxed);
+                out.first = true;
+                out.stored = false;
+                out.copies = 1;
+                out.best_gateway = rx.gateway;
+                out.best_rssi = rx.rssi;
+                out.best_snr = rx.snr;
+                return out;
+            }
+
+            /* Pass 2: claim, pending until pass 3 settles twins */
+            if (before_claim_)
+                before_claim_();
+
+            const uint64_t key = make_key(ident, now_epoch);
+            const uint64_t claim = key | PENDING;
+            Slot &mine = slots_[candidate];
+            if (!mine.key.compare_exchange_strong(candidate_key, claim, std::memory_order_seq_cst))
+                continue;
+
+            /* Pass 3: the whole run again. Of two claims at least one sees
+             * the other. A committed twin wins; of two pending ones the
+             * one earlier on the run wins and takes the other's slot away
+             * before it commits. */
+            bool yield = false;
+            for (size_t i = 0; i < MAX_PROBE && !yield; ++i)
+            {
+                if (i == candidate_pos)
+                    continue;
+
+                Slot &other = slots_[(home + i) & mask_];
+                uint64_t k = other.key.load(std::memory_order_seq_cst);
+                if (k == 0)
+                    break; // claims never lie past a never-used slot
+                if (!is_live(k, now_epoch) || (k & IDENT_MASK) != ident)
+                    continue;
+
+                if (!(k & PENDING) || i < candidate_pos)
+                {
+                    yield = true;
+                }
+                else if (other.key.compare_exchange_strong(k, TOMBSTONE, std::memory_order_seq_cst))
+                {
+                    twins_.fetch_add(1, std::memory_order_relaxed);
+                }
+                else if (is_live(k, now_epoch) && (k & IDENT_MASK) == ident)
+                {
+                    yield = true; // committed meanwhile
+                }
+            }
+
+            if (yield)
+            {
+                uint64_t expected = claim;
+                if (mine.key.compare_exchange_strong(expected, TOMBSTONE, std::memory_order_seq_cst))
+                    twins_.fetch_add(1, std::memory_order_relaxed);
+                continue; // pass 1 now finds the twin and merges
+            }
+
+            /* Fails only if a twin earlier on the run took the slot */
+            uint64_t expected = claim;
+            if (!mine.key.compare_exchange_strong(expected, key, std::memory_order_seq_cst))
+                continue;
+
+            if (merge(mine, key, rx, out) == Merge::SLOT_LOST)
+                continue;
+
+            firsts_.fetch_add(1, std::memory_order_relaxed);
+            out.first = true;
+            return out;
+        }
+    }
+
+    /* =========================================================
+     * Lookup
+     * ========================================================= */
+    bool DedupEngine::lookup(uint16_t combined_id, uint32_t counter, uint64_t now_ms, Result &out) const
+    {
+        const uint16_t now_epoch = epoch(now_ms);
+        const uint64_t ident = ident_of(combined_id, counter);
+        const size_t home = static_cast<size_t>(mix64(ident));
+
+        for (size_t i = 0; i < MAX_PROBE; ++i)
+        {
+            const Slot &slot = slots_[(home + i) & mask_];
+            const uint64_t k = slot.key.load(std::memory_order_seq_cst);
+
+            if (k == 0)
+                return false;
+            if (!is_live(k, now_epoch) || (k & IDENT_MASK) != ident)
+                continue;
+            if (k & PENDING)
+                return false;
+
+            const uint64_t best = slot.best.load(std::memory_order_acquire);
+            if ((best >> 40) != check_of(k))
+                return false; // claimed, first reception not merged yet
+
+            out = Result{};
+            out.stored = true;
+            unpack_best(best, out);
+            return true;
+        }
+        return false;
+    }
+
+    DedupEngine::Stats DedupEngine::stats() const
+    {
+        Stats s{};
+        s.firsts = firsts_.load(std::memory_order_relaxed);
+        s.duplicates = duplicates_.load(std::memory_order_relaxed);
+        s.overflows = overflows_.load(std::memory_order_relaxed);
+        s.twins = twins_.load(std::memory_order_relaxed);
+        s.inserts = s.firsts + s.duplicates + s.overflows;
+        return s;
+    }
+
+} // namespace loragro::gapp
@@ -0,0 +1,241 @@
+#include "gapp/gorilla.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace loragro::gapp
+{
+    /* =========================================================
+     * Bits
+     * ========================================================= */
+    void BitWriter::write(uint64_t v, unsigned n)
+    {
+        if (n < 64)
+            v &= (1ULL << n) - 1;
+
+        const unsigned used = bits_ & 63;
+        if (used == 0)
+            words_.push_back(0);
+
+        const unsigned room = 64 - used;
+        if (n <= room)
+        {
+            words_.back() |= v << (room - n);
+        }
+        else
+        {
+            words_.back() |= v >> (n - room);
+            words_.push_back(v << (64 - (n - room)));
+        }
+        bits_ += n;
+    }
+
+    bool BitReader::read(unsigned n, uint64_t &v)
+    {
+        if (pos_ + n > end_)
+            return false;
+
+        const size_t w = pos_ >> 6;
+        const unsigned used = pos_ & 63;
+        const unsigned avail = 64 - used;
+
+        v = (words_[w] << used) >> (64 - n);
+        if (n > avail)
+            v |= words_[w + 1] >> (64 - (n - avail));
+
+        pos_ += n;
+        return true;
+    }
+
+    /* =========================================================
+     * Encoder
+     * ========================================================= */
+    static constexpr unsigned MAX_LEADING = 31; // 5-bit field
+
+    static void write_dod(BitWriter &out, int64_t dod)
+    {
+        if (dod == 0)
+            out.write(0b0, 1);
+        else if (dod >= -63 && dod <= 64)
+        {
+            out.write(0b10, 2);
+            out.write(static_cast<uint64_t>(dod + 63), 7);
+        }
+        else if (dod >= -255 && dod <= 256)
+        {
+            out.write(0b110, 3);
+            out.write(static_cast<uint64_t>(dod + 255), 9);
+        }
+        else if (dod >= -2047 && dod <= 2048)
+        {
+            out.write(0b1110, 4);
+            out.write(static_cast<uint64_t>(dod + 2047), 12);
+        }
+        else
+        {
+            out.write(0b1111, 4);
+            out.write(static_cast<uint64_t>(dod), 64);
+        }
+    }
+
+    void ChunkEncoder::append(int64_t t, double value)
+    {
+        const uint64_t v = std::bit_cast<uint64_t>(value);
+
+        if (count_ == 0)
+        {
+            out_.write(static_cast<uint64_t>(t), 64);
+            out_.write(v, 64);
+            t_min_ = t_max_ = t_prev_ = t;
+            v_prev_ = v;
+            count_ = 1;
+            return;
+        }
+
+        const int64_t delta = t - t_prev_;
+        write_dod(out_, delta - delta_prev_);
+        delta_prev_ = delta;
+        t_prev_ = t;
+        t_min_ = std::min(t_min_, t);
+        t_max_ = std::max(t_max_, t);
+
+        const uint64_t x = v ^ v_prev_;
+        v_prev_ = v;
+        ++count_;
+
+        if (x == 0)
+        {
+            out_.write(0b0, 1);
+            return;
+        }
+
+        const unsigned leading = std::min<unsigned>(std::countl_zero(x), MAX_LEADING);
+        const unsigned trailing = std::countr_zero(x);
+
+        if (leading_ != 0xFF && leading >= leading_ && trailing >= trailing_)
+        {
+            out_.write(0b10, 2);
+            out_.write(x >> trailing_, 64 - leading_ - trailing_);
+            return;
+        }
+
+        const unsigned length = 64 - leading - trailing;
+        out_.write(0b11, 2);
+        out_.write(leading, 5);
+        out_.write(length - 1, 6);
+        out_.write(x >> trailing, length);
+        leading_ = static_cast<uint8_t>(leading);
+        trailing_ = static_cast<uint8_t>(trailing);
+    }
+
+    /* Keeps the buffer for the next chunk */
+    void ChunkEncoder::clear()
+    {
+        out_.clear();
+        count_ = 0;
+        delta_prev_ = 0;
+        leading_ = 0xFF;
+        trailing_ = 0;
+    }
+
+    size_t ChunkEncoder::max_bytes(uint32_t points)
+    {
+        /* Worst point after the first: '1111' + 64, then '11' + 5 + 6 + 64 */
+        const size_t bits = 128 + static_cast<size_t>(points ? points - 1 : 0) * (68 + 77);
+        return (bits + 63) / 64 * 8;
+    }
+
+    /* =========================================================
+     * Decoder
+     * ========================================================= */
+    bool ChunkDecoder::read_dod(int64_t &dod)
+    {
+        /* Indexed by the number of leading '1's of the prefix */
+        static constexpr unsigned BITS[] = {0, 7, 9, 12, 64};
+        static constexpr int64_t BIAS[] = {0, 63, 255, 2047, 0};
+
+        unsigned ones = 0;
+        uint64_t bit = 0;
+        while (ones < 4)
+        {
+            if (!in_.read(1, bit))
+                return false;
+            if (!bit)
+                break;
+            ++ones;
+        }
+
+        if (ones == 0)
+        {
+            dod = 0;
+            return true;
+        }
+
+        uint64_t raw = 0;
+        if (!in_.read(BITS[ones], raw))
+            return false;
+        dod = static_cast<int64_t>(raw) - BIAS[ones];
+        return true;
+    }
+
+    bool ChunkDecoder::read_xor(uint64_t &x)
+    {
+        uint64_t bit = 0;
+        if (!in_.read(1, bit))
+            return false;
+        if (!bit)
+        {
+            x = 0;
+            return true;
+        }
+
+        if (!in_.read(1, bit))
+            return false;
+        if (bit)
+        {
+            uint64_t leading = 0;
+            uint64_t length = 0;
+            if (!in_.read(5, leading) || !in_.read(6, length))
+                return false;
+            leading_ = static_cast<uint8_t>(leading);
+            trailing_ = static_cast<uint8_t>(64 - leading - (length + 1));
+        }
+
+        uint64_t bits = 0;
+        if (!in_.read(64 - leading_ - trailing_, bits))
+            return false;
+        x = bits << trailing_;
+        return true;
+    }
+
+    bool ChunkDecoder::next(int64_t &t, double &value)
+    {
+        if (left_ == 0)
+            return false;
+
+        if (!started_)
+        {
+            uint64_t raw_t = 0;
+            if (!in_.read(64, raw_t) || !in_.read(64, v_prev_))
+                return false;
+            t_prev_ = static_cast<int64_t>(raw_t);
+            started_ = true;
+        }
+        else
+        {
+            int64_t dod = 0;
+            uint64_t x = 0;
+            if (!read_dod(dod) || !read_xor(x))
+                return false;
+            delta_prev_ += dod;
+            t_prev_ += delta_prev_;
+            v_prev_ ^= x;
+        }
+
+        --left_;
+        t = t_prev_;
+        value = std::bit_cast<double>(v_prev_);
+        return true;
+    }
+
+} // namespace loragro::gapp
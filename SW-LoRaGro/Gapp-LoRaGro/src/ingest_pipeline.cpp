@@ -0,0 +1,221 @@
+#include "gapp/ingest_pipeline.hpp"
+
+#include <cerrno>
+#include <chrono>
+
+namespace loragro::gapp
+{
+    /* Empty polls before a worker backs off to short sleeps */
+    static constexpr unsigned SPIN_POLLS = 64;
+    static constexpr auto IDLE_SLEEP = std::chrono::microseconds(50);
+
+    /* Single writer per counter, no read-modify-write needed */
+    static void bump(std::atomic<uint64_t> &v)
+    {
+        v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t IngestPipeline::now_ns()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    IngestPipeline::IngestPipeline(const Config &cfg, AckSink on_ack, FrameSink on_frame)
+        : cfg_(cfg), on_ack_(std::move(on_ack)), on_frame_(std::move(on_frame))
+    {
+        const unsigned n = cfg_.workers ? cfg_.workers : 1;
+        const size_t node_slots = (NODE_ID_COUNT + n - 1) / n;
+
+        for (unsigned i = 0; i < n; ++i)
+            workers_.push_back(std::make_unique<Worker>(cfg_.queue_depth, node_slots));
+    }
+
+    IngestPipeline::~IngestPipeline()
+    {
+        stop();
+    }
+
+    /* =========================================================
+     * Lifecycle
+     * ========================================================= */
+    void IngestPipeline::start()
+    {
+        if (running_.exchange(true))
+            return;
+
+        for (unsigned i = 0; i < workers_.size(); ++i)
+            workers_[i]->thread = std::thread(&IngestPipeline::run, this, i);
+    }
+
+    void IngestPipeline::stop()
+    {
+        if (!running_.exchange(false))
+            return;
+
+        for (auto &w : workers_)
+        {
+            if (w->thread.joinable())
+                w->thread.join();
+        }
+    }
+
+    /* =========================================================
+     * RX thread
+     * ========================================================= */
+    bool IngestPipeline::submit(const RxFrame &frame)
+    {
+        bump(received_);
+
+        const uint16_t combined_id = frame.len >= 2 ? read_u16_le(frame.data, 0) : 0;
+        if (workers_[shard_of(combined_id)]->queue.try_push(frame))
+            return true;
+
+        bump(dropped_);
+        return false;
+    }
+
+    /* =========================================================
+     * Worker
+     * ========================================================= */
+    void IngestPipeline::run(unsigned index)
+    {
+        Worker &w = *workers_[index];
+        RxFrame rx;
+        unsigned idle = 0;
+
+        for (;;)
+        {
+            if (w.queue.try_pop(rx))
+            {
+                process(index, rx);
+                idle = 0;
+                continue;
+            }
+
+            /* Stop only once the ring is drained */
+            if (!running_.load(std::memory_order_acquire))
+            {
+                if (!w.queue.try_pop(rx))
+                    return;
+                process(index, rx);
+                continue;
+            }
+
+            if (++idle < SPIN_POLLS)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+    }
+
+    void IngestPipeline::process(unsigned index, const RxFrame &rx)
+    {
+        Worker &w = *workers_[index];
+        Counters &c = w.counters;
+
+        if (rx.len < wire::DATA_HEADER_SIZE + FrameLayout::AUTH_SIZE ||
+            rx.data[FrameLayout::FRAME_TYPE] != static_cast<uint8_t>(FrameType::DATA))
+        {
+            bump(c.malformed);
+            return;
+        }
+
+        const uint16_t combined_id = read_u16_le(rx.data, 0);
+        const auto [it, unknown] = w.nodes.try_emplace(combined_id);
+        NodeSecurity &node = it->second;
+        if (unknown)
+            node.provision(combined_id);
+
+        uint32_t counter = 0;
+        const int rc = node.verify_uplink(rx.data, rx.len, counter);
+        if (rc != 0 && rc != -EALREADY)
+        {
+            bump(c.auth_failed);
+            return;
+        }
+
+        /* ACK first, it is the only part with a deadline */
+        AckOut ack;
+        ack.combined_id = combined_id;
+        ack.counter = counter;
+        ack.retry = (rc == -EALREADY);
+        ack.copies = 1;
+        ack.best_gateway = cfg_.gateway_id;
+        node.build_ack(counter, ack.data);
+
+        /* Other gateways may have heard the same frame */
+        bool first = true;
+        if (cfg_.dedup && !ack.retry)
+        {
+            const DedupEngine::Reception reception{combined_id, counter, cfg_.gateway_id, rx.rssi, rx.snr};
+            const DedupEngine::Result dup = cfg_.dedup->insert(reception, rx.rx_end_ns / 1000000);
+            first = dup.first;
+            ack.copies = dup.copies;
+            ack.best_gateway = dup.best_gateway;
+        }
+
+        const AckWindow window = ack_window(cfg_.radio, rx.len);
+        ack.rx_end_ns = rx.rx_end_ns;
+        ack.open_ns = rx.rx_end_ns + static_cast<uint64_t>(window.open_us) * 1000;
+        ack.close_ns = rx.rx_end_ns + static_cast<uint64_t>(window.close_us) * 1000;
+        ack.ready_ns = now_ns();
+
+        bump(c.acks);
+        if (ack.ready_ns > ack.open_ns)
+            bump(c.late_acks);
+
+        if (on_ack_)
+            on_ack_(index, ack);
+
+        if (ack.retry)
+        {
+            bump(c.duplicates);
+            return;
+        }
+
+        if (!first)
+        {
+            bump(c.relayed);
+            return;
+        }
+
+        DataFrame &frame = *w.decoded;
+        if (decode_data_frame(rx.data, rx.len - FrameLayout::AUTH_SIZE, frame) != 0)
+        {
+            bump(c.malformed);
+            return;
+        }
+
+        frame.counter = counter;
+        bump(c.accepted);
+
+        if (on_frame_)
+            on_frame_(index, frame, rx);
+    }
+
+    /* =========================================================
+     * Stats
+     * ========================================================= */
+    IngestPipeline::Stats IngestPipeline::stats() const
+    {
+        Stats s{};
+        s.received = received_.load(std::memory_order_relaxed);
+        s.dropped = dropped_.load(std::memory_order_relaxed);
+
+        for (const auto &w : workers_)
+        {
+            const Counters &c = w->counters;
+            s.accepted += c.accepted.load(std::memory_order_relaxed);
+            s.duplicates += c.duplicates.load(std::memory_order_relaxed);
+            s.relayed += c.relayed.load(std::memory_order_relaxed);
+            s.auth_failed += c.auth_failed.load(std::memory_order_relaxed);
+            s.malformed += c.malformed.load(std::memory_order_relaxed);
+            s.acks += c.acks.load(std::memory_order_relaxed);
+            s.late_acks += c.late_acks.load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+} // namespace loragro::gapp
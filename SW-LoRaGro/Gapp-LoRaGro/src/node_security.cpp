@@ -0,0 +1,97 @@
+#include "gapp/node_security.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace loragro::gapp
+{
+    /* Auth::MASTER_KEY */
+    static constexpr uint8_t MASTER_KEY[Aes128::KEY_SIZE] = {
+        0x91, 0xA4, 0x3C, 0x7F, 0x55, 0x12, 0xB8, 0x66,
+        0x2E, 0xD3, 0x19, 0x44, 0xAB, 0xCD, 0x88, 0xEF};
+
+    void derive_device_key(uint16_t combined_id, uint8_t key[Aes128::KEY_SIZE])
+    {
+        static const Aes128 master(MASTER_KEY);
+
+        uint8_t input_block[Aes128::BLOCK_SIZE]{};
+        input_block[0] = static_cast<uint8_t>(combined_id >> 8);
+        input_block[1] = static_cast<uint8_t>(combined_id);
+
+        master.encrypt(input_block, key);
+    }
+
+    uint32_t reconstruct_counter(uint32_t last, uint8_t ctr8)
+    {
+        uint32_t candidate = (last & 0xFFFFFF00u) | ctr8;
+
+        /* Lower byte wrapped since the last frame */
+        if (candidate + 0x80 < last)
+            candidate += 0x100;
+
+        return candidate;
+    }
+
+    /* =========================================================
+     * Provisioning
+     * ========================================================= */
+    void NodeSecurity::provision(uint16_t combined_id)
+    {
+        uint8_t key[Aes128::KEY_SIZE];
+        derive_device_key(combined_id, key);
+        cmac_.set_key(key);
+        ack_.init(cmac_, combined_id);
+
+        combined_id_ = combined_id;
+        last_counter_ = 0;
+        seen_ = false;
+        provisioned_ = true;
+    }
+
+    /* =========================================================
+     * Uplink
+     * ========================================================= */
+    int NodeSecurity::verify_uplink(const uint8_t *frame, size_t len, uint32_t &counter)
+    {
+        if (!frame || len < FrameLayout::HEADER_SIZE + FrameLayout::AUTH_SIZE)
+            return -EINVAL;
+
+        const size_t body_len = len - FrameLayout::AUTH_SIZE;
+        const uint32_t candidate = reconstruct_counter(last_counter_, frame[FrameLayout::FRAME_CTR]);
+
+        uint8_t tag[Cmac::TAG_SIZE];
+        cmac_.compute_framed(candidate, frame, body_len, tag);
+        if (memcmp(tag, frame + body_len, FrameLayout::AUTH_SIZE) != 0)
+            return -EBADMSG;
+
+        counter = candidate;
+
+        if (seen_ && candidate <= last_counter_)
+            return -EALREADY;
+
+        seen_ = true;
+        last_counter_ = candidate;
+        return 0;
+    }
+
+    /* =========================================================
+     * ACK
+     * ========================================================= */
+    size_t NodeSecurity::build_ack(uint32_t counter, uint8_t *out) const
+    {
+        ack_.build(cmac_.cipher(), counter, out);
+        return ACK_SIZE;
+    }
+
+    size_t NodeSecurity::sign(uint8_t *frame, size_t len, uint32_t counter) const
+    {
+        frame[FrameLayout::FRAME_CTR] = static_cast<uint8_t>(counter);
+
+        uint8_t tag[Cmac::TAG_SIZE];
+        cmac_.compute_framed(counter, frame, len, tag);
+        memcpy(frame + len, tag, FrameLayout::AUTH_SIZE);
+
+        return len + FrameLayout::AUTH_SIZE;
+    }
+
+} // namespace loragro::gapp
@@ -0,0 +1,437 @@
+#include "gapp/tsdb.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace loragro::gapp
+{
+    /* =========================================================
+     * File layout
+     * ========================================================= */
+    static constexpr uint32_t SEGMENT_MAGIC = 0x5354474C; // "LGTS"
+    static constexpr uint32_t CHUNK_MAGIC = 0x4B4E4843;   // "CHNK"
+    static constexpr uint16_t FORMAT_VERSION = 2;
+
+    struct SegmentHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t header_size;
+        uint32_t chunk_header_size;
+        uint32_t reserved;
+        uint64_t size; // file size
+        uint64_t reserved2;
+    };
+    static_assert(sizeof(SegmentHeader) == 32);
+
+    struct ChunkHeader
+    {
+        uint32_t magic;
+        uint16_t combined_id;
+        uint8_t sensor_id;
+        uint8_t reserved;
+        uint32_t count;
+        uint32_t words; // 64-bit words that follow
+        int64_t t_min;
+        int64_t t_max;
+        uint32_t crc; // CRC-32 of the words
+        uint32_t reserved2;
+    };
+    static_assert(sizeof(ChunkHeader) == 40 && sizeof(ChunkHeader) % 8 == 0);
+
+    /* CRC-32 (IEEE 802.3, reflected 0xEDB88320) */
+    static constexpr auto CRC32_TABLE = [] {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }();
+
+    static uint32_t crc32(const uint8_t *data, size_t len)
+    {
+        uint32_t c = 0xFFFFFFFFu;
+        for (size_t i = 0; i < len; ++i)
+            c = CRC32_TABLE[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    /* Offsets are 32-bit in the index */
+    static constexpr size_t MAX_SEGMENT_BYTES = UINT32_MAX & ~size_t{7};
+
+    struct TimeSeriesStore::Segment
+    {
+        uint32_t number{0};
+        int fd{-1};
+        uint8_t *base{nullptr};
+        size_t size{0};
+        size_t used{0};
+
+        ~Segment()
+        {
+            if (base)
+                munmap(base, size);
+            if (fd >= 0)
+                ::close(fd);
+        }
+    };
+
+    static std::string segment_path(const std::string &dir, uint32_t number)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "seg-%06u.lgts", number);
+        return (std::filesystem::path(dir) / name).string();
+    }
+
+    /* seg-NNNNNN.lgts -> NNNNNN, 0 when not a segment */
+    static uint32_t segment_number(const std::string &name)
+    {
+        unsigned n = 0;
+        char tail[8] = {};
+        if (std::sscanf(name.c_str(), "seg-%u.%7s", &n, tail) != 2 || strcmp(tail, "lgts") != 0)
+            return 0;
+        return n;
+    }
+
+    /* =========================================================
+     * Open / close
+     * ========================================================= */
+    TimeSeriesStore::TimeSeriesStore(const Config &cfg) : cfg_(cfg) {}
+
+    TimeSeriesStore::~TimeSeriesStore()
+    {
+        if (opened_)
+            flush();
+    }
+
+    int TimeSeriesStore::open()
+    {
+        std::unique_lock lock(mutex_);
+
+        if (opened_)
+            return -EALREADY;
+
+        const int rc = load();
+        if (rc != 0)
+        {
+            series_.clear();
+            segments_.clear();
+            points_ = chunks_ = sealed_bytes_ = 0;
+            return rc;
+        }
+
+        opened_ = true;
+        return 0;
+    }
+
+    int TimeSeriesStore::load()
+    {
+        const size_t min_bytes = sizeof(SegmentHeader) + sizeof(ChunkHeader) + ChunkEncoder::max_bytes(cfg_.chunk_points);
+        if (cfg_.dir.empty() || cfg_.chunk_points == 0 || cfg_.chunk_span_s <= 0 || cfg_.segment_bytes < min_bytes ||
+            cfg_.segment_bytes > MAX_SEGMENT_BYTES)
+            return -EINVAL;
+        cfg_.segment_bytes &= ~size_t{7};
+
+        std::error_code ec;
+        std::filesystem::create_directories(cfg_.dir, ec);
+        if (ec)
+            return -ec.value();
+
+        std::vector<uint32_t> numbers;
+        for (const auto &entry : std::filesystem::directory_iterator(cfg_.dir, ec))
+        {
+            const uint32_t n = segment_number(entry.path().filename().string());
+            if (n && entry.is_regular_file())
+                numbers.push_back(n);
+        }
+        if (ec)
+            return -ec.value();
+        std::sort(numbers.begin(), numbers.end());
+
+        for (uint32_t n : numbers)
+        {
+            auto seg = std::make_unique<Segment>();
+            seg->number = n;
+            seg->fd = ::open(segment_path(cfg_.dir, n).c_str(), O_RDWR | O_CLOEXEC);
+            if (seg->fd < 0)
+                return -errno;
+
+            struct stat st;
+            if (fstat(seg->fd, &st) != 0)
+                return -errno;
+            if (static_cast<size_t>(st.st_size) < sizeof(SegmentHeader) ||
+                static_cast<size_t>(st.st_size) > MAX_SEGMENT_BYTES)
+                return -EBADMSG;
+
+            seg->size = static_cast<size_t>(st.st_size);
+            void *p = mmap(nullptr, seg->size, PROT_READ | PROT_WRITE, MAP_SHARED, seg->fd, 0);
+            if (p == MAP_FAILED)
+                return -errno;
+            seg->base = static_cast<uint8_t *>(p);
+
+            SegmentHeader hdr;
+            memcpy(&hdr, seg->base, sizeof(hdr));
+            if (hdr.magic != SEGMENT_MAGIC || hdr.version != FORMAT_VERSION ||
+                hdr.header_size != sizeof(SegmentHeader) || hdr.chunk_header_size != sizeof(ChunkHeader) ||
+                hdr.size != seg->size)
+                return -EBADMSG;
+
+            segments_.push_back(std::move(seg));
+            index_segment(static_cast<uint32_t>(segments_.size() - 1));
+        }
+
+        return segments_.empty() ? add_segment() : 0;
+    }
+
+    /* Chunks up to the first one whose header or words do not check out */
+    void TimeSeriesStore::index_segment(uint32_t index)
+    {
+        Segment &seg = *segments_[index];
+        size_t pos = sizeof(SegmentHeader);
+
+        while (pos + sizeof(ChunkHeader) <= seg.size)
+        {
+            ChunkHeader hdr;
+            memcpy(&hdr, seg.base + pos, sizeof(hdr));
+
+            const size_t bytes = static_cast<size_t>(hdr.words) * 8;
+            if (hdr.magic != CHUNK_MAGIC || hdr.count == 0 || hdr.words == 0 ||
+                bytes > seg.size - pos - sizeof(ChunkHeader) ||
+                crc32(seg.base + pos + sizeof(ChunkHeader), bytes) != hdr.crc)
+                break;
+
+            series_[key_of(hdr.sensor_id, hdr.combined_id)].chunks.push_back(
+                ChunkRef{index, static_cast<uint32_t>(pos + sizeof(ChunkHeader)), hdr.words, hdr.count,
+                         hdr.t_min, hdr.t_max});
+
+            points_ += hdr.count;
+            ++chunks_;
+            sealed_bytes_ += sizeof(ChunkHeader) + bytes;
+            pos += sizeof(ChunkHeader) + bytes;
+        }
+
+        seg.used = pos;
+    }
+
+    int TimeSeriesStore::add_segment()
+    {
+        auto seg = std::make_unique<Segment>();
+        seg->number = segments_.empty() ? 1 : segments_.back()->number + 1;
+        seg->size = cfg_.segment_bytes;
+
+        seg->fd = ::open(segment_path(cfg_.dir, seg->number).c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (seg->fd < 0)
+            return -errno;
+
+        /* Sparse: blocks are allocated as chunks land */
+        if (ftruncate(seg->fd, static_cast<off_t>(seg->size)) != 0)
+            return -errno;
+
+        void *p = mmap(nullptr, seg->size, PROT_READ | PROT_WRITE, MAP_SHARED, seg->fd, 0);
+        if (p == MAP_FAILED)
+            return -errno;
+        seg->base = static_cast<uint8_t *>(p);
+
+        const SegmentHeader hdr{SEGMENT_MAGIC, FORMAT_VERSION, sizeof(SegmentHeader), sizeof(ChunkHeader),
+                                0, seg->size, 0};
+        memcpy(seg->base, &hdr, sizeof(hdr));
+        seg->used = sizeof(hdr);
+
+        segments_.push_back(std::move(seg));
+        return 0;
+    }
+
+    int TimeSeriesStore::flush()
+    {
+        std::unique_lock lock(mutex_);
+
+        if (!opened_)
+            return -EBADF;
+
+        for (auto &[key, series] : series_)
+        {
+            const int rc = seal(key, series);
+            if (rc != 0)
+                return rc;
+        }
+
+        for (const auto &seg : segments_)
+        {
+            if (msync(seg->base, seg->used, MS_SYNC) != 0)
+                return -errno;
+        }
+        return 0;
+    }
+
+    /* =========================================================
+     * Ingest
+     * ========================================================= */
+    int TimeSeriesStore::seal(uint32_t key, Series &series)
+    {
+        ChunkEncoder &chunk = series.open;
+        if (chunk.count() == 0)
+            return 0;
+
+        const size_t bytes = chunk.word_count() * 8;
+        const size_t need = sizeof(ChunkHeader) + bytes;
+
+        if (segments_.back()->used + need > segments_.back()->size)
+        {
+            const int rc = add_segment();
+            if (rc != 0)
+                return rc;
+        }
+
+        Segment &seg = *segments_.back();
+        uint8_t *at = seg.base + seg.used;
+
+        /* Pages of a shared mapping reach the file in any order; a chunk
+         * whose words did not all land fails the CRC on open */
+        memcpy(at + sizeof(ChunkHeader), chunk.words(), bytes);
+        const ChunkHeader hdr{CHUNK_MAGIC,
+                              static_cast<uint16_t>(key),
+                              static_cast<uint8_t>(key >> 16),
+                              0,
+                              chunk.count(),
+                              static_cast<uint32_t>(chunk.word_count()),
+                              chunk.t_min(),
+                              chunk.t_max(),
+                              crc32(reinterpret_cast<const uint8_t *>(chunk.words()), bytes),
+                              0};
+        memcpy(at, &hdr, sizeof(hdr));
+
+        series.chunks.push_back(ChunkRef{static_cast<uint32_t>(segments_.size() - 1),
+                                         static_cast<uint32_t>(seg.used + sizeof(ChunkHeader)), hdr.words,
+                                         hdr.count, hdr.t_min, hdr.t_max});
+        seg.used += need;
+        ++chunks_;
+        sealed_bytes_ += need;
+
+        chunk.clear();
+        return 0;
+    }
+
+    int TimeSeriesStore::append_locked(uint16_t combined_id, uint8_t sensor_id, int64_t t, double value)
+    {
+        if (!opened_)
+            return -EBADF;
+
+        const uint32_t key = key_of(sensor_id, combined_id);
+        Series &series = series_[key];
+
+        if (series.open.count() && t - series.open.t_min() >= cfg_.chunk_span_s)
+        {
+            const int rc = seal(key, series);
+            if (rc != 0)
+                return rc;
+        }
+
+        series.open.append(t, value);
+        ++points_;
+
+        if (series.open.count() >= cfg_.chunk_points)
+            return seal(key, series);
+        return 0;
+    }
+
+    int TimeSeriesStore::append(uint16_t combined_id, uint8_t sensor_id, int64_t t, double value)
+    {
+        std::unique_lock lock(mutex_);
+        return append_locked(combined_id, sensor_id, t, value);
+    }
+
+    int TimeSeriesStore::append(const DataFrame &frame)
+    {
+        std::unique_lock lock(mutex_);
+
+        for (size_t i = 0; i < frame.count; ++i)
+        {
+            const DataEntry &e = frame.entries[i];
+            const int rc = append_locked(frame.combined_id, e.sensor_id, frame.timestamp, entry_value(e));
+            if (rc != 0)
+                return rc;
+        }
+        return 0;
+    }
+
+    /* =========================================================
+     * Query
+     * ========================================================= */
+    size_t TimeSeriesStore::scan(const Query &q, const PointSink &sink) const
+    {
+        std::shared_lock lock(mutex_);
+
+        if (q.first_id > q.last_id || q.from > q.to)
+            return 0;
+
+        size_t emitted = 0;
+        const auto decode = [&](ChunkDecoder dec, uint16_t id, uint8_t sensor) {
+            int64_t t = 0;
+            double v = 0;
+            while (dec.next(t, v))
+            {
+                if (t < q.from || t > q.to)
+                    continue;
+                sink(id, sensor, t, v);
+                ++emitted;
+            }
+        };
+
+        for (unsigned sensor = 0; sensor < q.sensors.size(); ++sensor)
+        {
+            if (!q.sensors.test(sensor))
+                continue;
+
+            const auto end = series_.upper_bound(key_of(static_cast<uint8_t>(sensor), q.last_id));
+            for (auto it = series_.lower_bound(key_of(static_cast<uint8_t>(sensor), q.first_id)); it != end; ++it)
+            {
+                const uint16_t id = static_cast<uint16_t>(it->first);
+                const Series &series = it->second;
+
+                for (const ChunkRef &c : series.chunks)
+                {
+                    if (c.t_max < q.from || c.t_min > q.to)
+                        continue;
+                    const auto *words = reinterpret_cast<const uint64_t *>(segments_[c.segment]->base + c.offset);
+                    decode(ChunkDecoder(words, c.words, c.count), id, static_cast<uint8_t>(sensor));
+                }
+
+                const ChunkEncoder &open = series.open;
+                if (open.count() && open.t_max() >= q.from && open.t_min() <= q.to)
+                    decode(ChunkDecoder(open.words(), open.word_count(), open.count()), id,
+                           static_cast<uint8_t>(sensor));
+            }
+        }
+        return emitted;
+    }
+
+    TimeSeriesStore::Stats TimeSeriesStore::stats() const
+    {
+        std::shared_lock lock(mutex_);
+
+        Stats s{};
+        s.points = points_;
+        s.series = series_.size();
+        s.chunks = chunks_;
+        s.segments = segments_.size();
+        s.sealed_bytes = sealed_bytes_;
+        for (const auto &[key, series] : series_)
+            s.open_bytes += series.open.word_count() * 8;
+        return s;
+    }
+
+} // namespace loragro::gapp
@@ -0,0 +1,33 @@
+/**
+ * Minimal test helpers for the host gateway
+ *
+ * Each suite is one executable registered with ctest; CHECK() logs the
+ * failing expression and the suite exits non-zero at the end.
+ */
+#pragma once
+
+#include <cstdio>
+
+namespace loragro::gapp::test
+{
+    inline int failures = 0;
+
+    inline int result(const char *suite)
+    {
+        if (failures)
+            std::printf("%s: %d check(s) failed\n", suite, failures);
+        else
+            std::printf("%s: ok\n", suite);
+        return failures ? 1 : 0;
+    }
+}
+
+#define CHECK(expr)                                                               \
+    do                                                                            \
+    {                                                                             \
+        if (!(expr))                                                              \
+        {                                                                         \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            ++loragro::gapp::test::failures;                                      \
+        }                                                                         \
+    } while (0)
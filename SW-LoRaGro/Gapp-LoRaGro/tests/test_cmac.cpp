@@ -0,0 +1,185 @@
+/*
+ * AES-128 (FIPS-197) and AES-CMAC (RFC 4493) known answers, the
+ * incremental API against one-shot, the LoRaGro framing
+ * (counter || frame) with derived node keys, and the precomputed ACK
+ * template against a full CMAC.
+ */
+#include <cstring>
+#include <vector>
+
+#include "check.hpp"
+#include "gapp/cmac.hpp"
+#include "gapp/node_security.hpp"
+
+using namespace loragro;
+using namespace loragro::gapp;
+
+static std::vector<uint8_t> hex(const char *s)
+{
+    std::vector<uint8_t> out;
+    for (; s[0] && s[1]; s += 2)
+    {
+        unsigned v = 0;
+        std::sscanf(s, "%2x", &v);
+        out.push_back(static_cast<uint8_t>(v));
+    }
+    return out;
+}
+
+static bool equal(const uint8_t *a, const std::vector<uint8_t> &b)
+{
+    return memcmp(a, b.data(), b.size()) == 0;
+}
+
+/* FIPS-197 appendix C.1 */
+static void test_aes_known_answer()
+{
+    const auto key = hex("000102030405060708090a0b0c0d0e0f");
+    const auto pt = hex("00112233445566778899aabbccddeeff");
+
+    uint8_t ct[16];
+    Aes128(key.data()).encrypt(pt.data(), ct);
+    CHECK(equal(ct, hex("69c4e0d86a7b0430d8cdb78070b4c55a")));
+}
+
+/* RFC 4493 section 4 */
+static const char *RFC_KEY = "2b7e151628aed2a6abf7158809cf4f3c";
+static const char *RFC_MSG = "6bc1bee22e409f96e93d7e117393172a"
+                             "ae2d8a571e03ac9c9eb76fac45af8e51"
+                             "30c81c46a35ce411e5fbc1191a0a52ef"
+                             "f69f2445df4f9b17ad2b417be66c3710";
+
+static void test_cmac_subkeys()
+{
+    const Cmac cmac(hex(RFC_KEY).data());
+    CHECK(equal(cmac.k1(), hex("fbeed618357133667c85e08f7236a8de")));
+    CHECK(equal(cmac.k2(), hex("f7ddac306ae266ccf90bc11ee46d513b")));
+}
+
+static void test_cmac_rfc4493()
+{
+    const Cmac cmac(hex(RFC_KEY).data());
+    const auto msg = hex(RFC_MSG);
+
+    const struct
+    {
+        size_t len;
+        const char *tag;
+    } vectors[] = {
+        {0, "bb1d6929e95937287fa37d129b756746"},
+        {16, "070a16b46b4d4144f79bdd9dd04a287c"},
+        {40, "dfa66747de9ae63030ca32611497c827"},
+        {64, "51f0bebf7e3b9d92fc49741779363cfe"},
+    };
+
+    for (const auto &v : vectors)
+    {
+        uint8_t tag[Cmac::TAG_SIZE];
+        cmac.compute(msg.data(), v.len, tag);
+        CHECK(equal(tag, hex(v.tag)));
+    }
+}
+
+static void test_cmac_incremental()
+{
+    const Cmac cmac(hex(RFC_KEY).data());
+    const auto msg = hex(RFC_MSG);
+
+    for (size_t len = 0; len <= msg.size(); ++len)
+    {
+        uint8_t expected[Cmac::TAG_SIZE];
+        cmac.compute(msg.data(), len, expected);
+
+        /* Odd chunks */
+        Cmac::State st;
+        for (size_t pos = 0; pos < len;)
+        {
+            const size_t n = (len - pos < 7) ? len - pos : 7;
+            cmac.update(st, msg.data() + pos, n);
+            pos += n;
+        }
+        uint8_t tag[Cmac::TAG_SIZE];
+        cmac.finish(st, tag);
+        CHECK(memcmp(tag, expected, sizeof(tag)) == 0);
+
+        /* Prefix state copied and resumed */
+        Cmac::State prefix;
+        const size_t split = len / 2;
+        cmac.update(prefix, msg.data(), split);
+        Cmac::State resumed = prefix;
+        cmac.update(resumed, msg.data() + split, len - split);
+        cmac.finish(resumed, tag);
+        CHECK(memcmp(tag, expected, sizeof(tag)) == 0);
+    }
+}
+
+/* compute_framed() is CMAC over the big-endian counter, then the frame */
+static void test_framed()
+{
+    const Cmac cmac(hex(RFC_KEY).data());
+    const uint8_t frame[] = {0x01, 0x08, 0xA5, 0x2A};
+
+    uint8_t joined[8] = {0x12, 0x34, 0x56, 0x78};
+    memcpy(joined + 4, frame, sizeof(frame));
+
+    uint8_t expected[Cmac::TAG_SIZE];
+    uint8_t tag[Cmac::TAG_SIZE];
+    cmac.compute(joined, sizeof(joined), expected);
+    cmac.compute_framed(0x12345678, frame, sizeof(frame), tag);
+    CHECK(memcmp(tag, expected, sizeof(tag)) == 0);
+}
+
+/* Keys differ per combined ID and are the master key encryption of [hi][lo][0..] */
+static void test_key_derivation()
+{
+    uint8_t a[16];
+    uint8_t b[16];
+    derive_device_key(make_combined_id(1, 1), a);
+    derive_device_key(make_combined_id(1, 2), b);
+    CHECK(memcmp(a, b, sizeof(a)) != 0);
+
+    uint8_t again[16];
+    derive_device_key(make_combined_id(1, 1), again);
+    CHECK(memcmp(a, again, sizeof(a)) == 0);
+}
+
+/* Template ACK == header + CMAC(counter || header) computed from scratch */
+static void test_ack_template()
+{
+    const uint16_t ids[] = {make_combined_id(0, 1), make_combined_id(1, 0x7FF), make_combined_id(31, 1234)};
+    const uint32_t counters[] = {0, 1, 2, 0xFF, 0x100, 0x12345678, 0xFFFFFFFF};
+
+    for (uint16_t id : ids)
+    {
+        NodeSecurity node;
+        node.provision(id);
+
+        for (uint32_t counter : counters)
+        {
+            uint8_t expected[ACK_SIZE];
+            write_u16_le(expected, 0, id);
+            expected[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::ACK);
+            expected[FrameLayout::FRAME_CTR] = static_cast<uint8_t>(counter);
+
+            uint8_t tag[Cmac::TAG_SIZE];
+            node.cmac().compute_framed(counter, expected, FrameLayout::ACK_FRAME_SIZE, tag);
+            memcpy(expected + FrameLayout::ACK_FRAME_SIZE, tag, FrameLayout::AUTH_SIZE);
+
+            uint8_t ack[ACK_SIZE];
+            CHECK(node.build_ack(counter, ack) == ACK_SIZE);
+            CHECK(memcmp(ack, expected, ACK_SIZE) == 0);
+        }
+    }
+}
+
+int main()
+{
+    test_aes_known_answer();
+    test_cmac_subkeys();
+    test_cmac_rfc4493();
+    test_cmac_incremental();
+    test_framed();
+    test_key_derivation();
+    test_ack_template();
+    return test::result("cmac");
+}
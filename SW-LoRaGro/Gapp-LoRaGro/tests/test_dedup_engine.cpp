@@ -0,0 +1,308 @@
+/*
+ * Multi-gateway deduplication: first / duplicate, best reception and
+ * its tie-break, expiry and slot reuse across windows, probe overflow,
+ * concurrent inserts of the same frames from several gateway threads,
+ * a forced double claim at an epoch boundary, and two ingest pipelines
+ * sharing one engine.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "gapp/dedup_engine.hpp"
+#include "gapp/ingest_pipeline.hpp"
+
+using namespace loragro;
+using namespace loragro::gapp;
+
+static constexpr uint32_t WINDOW_MS = 1000;
+
+static DedupEngine::Reception reception(uint16_t id, uint32_t counter, uint8_t gateway, int16_t rssi, int8_t snr)
+{
+    return DedupEngine::Reception{id, counter, gateway, rssi, snr};
+}
+
+static void test_first_and_duplicate()
+{
+    DedupEngine dedup({1024, WINDOW_MS});
+    const uint16_t id = make_combined_id(1, 7);
+
+    auto r = dedup.insert(reception(id, 42, 1, -110, -5), 10);
+    CHECK(r.first && r.stored);
+    CHECK(r.copies == 1 && r.best_gateway == 1);
+    CHECK(r.best_rssi == -110 && r.best_snr == -5);
+
+    r = dedup.insert(reception(id, 42, 2, -90, 3), 20);
+    CHECK(!r.first && r.stored);
+    CHECK(r.copies == 2 && r.best_gateway == 2);
+    CHECK(r.best_rssi == -90 && r.best_snr == 3);
+
+    /* Worse reception is counted, does not replace the best */
+    r = dedup.insert(reception(id, 42, 3, -80, -2), 30);
+    CHECK(!r.first && r.copies == 3 && r.best_gateway == 2);
+
+    /* Another counter, another node: new frames */
+    CHECK(dedup.insert(reception(id, 43, 1, -100, 0), 40).first);
+    CHECK(dedup.insert(reception(make_combined_id(1, 8), 42, 1, -100, 0), 40).first);
+
+    DedupEngine::Result best{};
+    CHECK(dedup.lookup(id, 42, 50, best));
+    CHECK(best.copies == 3 && best.best_gateway == 2);
+    CHECK(!dedup.lookup(id, 44, 50, best));
+
+    const auto s = dedup.stats();
+    CHECK(s.inserts == 5 && s.firsts == 3 && s.duplicates == 2 && s.overflows == 0);
+}
+
+/* SNR first, then RSSI, then the lower gateway ID */
+static void test_best_selection()
+{
+    DedupEngine dedup({1024, WINDOW_MS});
+    const uint16_t id = make_combined_id(2, 1);
+
+    dedup.insert(reception(id, 1, 5, -100, 2), 0);
+    dedup.insert(reception(id, 1, 4, -120, 2), 0); // same SNR, weaker
+    dedup.insert(reception(id, 1, 9, -95, 2), 0);  // same SNR, stronger
+    dedup.insert(reception(id, 1, 3, -95, 2), 0);  // tie, lower gateway
+
+    DedupEngine::Result best{};
+    CHECK(dedup.lookup(id, 1, 0, best));
+    CHECK(best.best_gateway == 3 && best.best_rssi == -95 && best.copies == 4);
+
+    dedup.insert(reception(id, 1, 7, -125, 8), 0); // weak but clean
+    CHECK(dedup.lookup(id, 1, 0, best));
+    CHECK(best.best_gateway == 7 && best.best_snr == 8);
+
+    /* Clamped RSSI still orders */
+    dedup.insert(reception(id, 2, 1, -250, 0), 0);
+    dedup.insert(reception(id, 2, 2, -199, 0), 0);
+    CHECK(dedup.lookup(id, 2, 0, best));
+    CHECK(best.best_gateway == 2);
+}
+
+/* Live in its own window and the next, then the slot is reused */
+static void test_expiry()
+{
+    DedupEngine dedup({1024, WINDOW_MS});
+    const uint16_t id = make_combined_id(3, 3);
+
+    CHECK(dedup.insert(reception(id, 9, 1, -100, 0), 900).first);
+    CHECK(!dedup.insert(reception(id, 9, 2, -100, 0), 1900).first);
+
+    DedupEngine::Result best{};
+    CHECK(dedup.lookup(id, 9, 1999, best));
+    CHECK(!dedup.lookup(id, 9, 2000, best));
+
+    /* A much later frame with the same counter (node reset) is new */
+    const auto r = dedup.insert(reception(id, 9, 2, -100, 0), 2000);
+    CHECK(r.first && r.copies == 1 && r.best_gateway == 2);
+}
+
+/* A full probe run forwards without deduplicating */
+static void test_overflow()
+{
+    DedupEngine dedup({DedupEngine::MAX_PROBE, WINDOW_MS});
+    CHECK(dedup.capacity() == DedupEngine::MAX_PROBE);
+
+    for (uint32_t c = 0; c < DedupEngine::MAX_PROBE; ++c)
+        CHECK(dedup.insert(reception(1, c, 1, -100, 0), 0).stored);
+
+    const auto r = dedup.insert(reception(1, 1000, 1, -100, 0), 0);
+    CHECK(r.first && !r.stored);
+    CHECK(dedup.stats().overflows == 1);
+
+    /* Two windows later everything expired */
+    CHECK(dedup.insert(reception(1, 1000, 1, -100, 0), 2 * WINDOW_MS).stored);
+}
+
+/* Gateway threads insert the same frames in different orders */
+static void test_concurrent()
+{
+    constexpr unsigned GATEWAYS = 4;
+    constexpr uint32_t FRAMES = 20000;
+
+    DedupEngine dedup({1 << 16, WINDOW_MS});
+
+    const auto rssi_of = [](uint32_t f, unsigned g) { return static_cast<int16_t>(-140 + (f * 7 + g * 13) % 60); };
+
+    std::vector<std::vector<uint8_t>> firsts(GATEWAYS, std::vector<uint8_t>(FRAMES));
+    std::atomic<unsigned> ready{0};
+    std::vector<std::thread> threads;
+
+    for (unsigned g = 0; g < GATEWAYS; ++g)
+    {
+        threads.emplace_back([&, g] {
+            ready.fetch_add(1);
+            while (ready.load() < GATEWAYS)
+                std::this_thread::yield();
+
+            for (uint32_t i = 0; i < FRAMES; ++i)
+            {
+                const uint32_t f = (g & 1) ? FRAMES - 1 - i : i;
+                const auto rx = reception(static_cast<uint16_t>(f % 2000), f, static_cast<uint8_t>(g),
+                                          rssi_of(f, g), 0);
+                firsts[g][f] = dedup.insert(rx, 100 + f / 1000).first;
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    uint32_t wrong_first = 0;
+    uint32_t wrong_best = 0;
+    for (uint32_t f = 0; f < FRAMES; ++f)
+    {
+        unsigned n = 0;
+        for (unsigned g = 0; g < GATEWAYS; ++g)
+            n += firsts[g][f];
+        wrong_first += (n != 1);
+
+        uint8_t expected = 0;
+        for (unsigned g = 1; g < GATEWAYS; ++g)
+        {
+            if (rssi_of(f, g) > rssi_of(f, expected))
+                expected = static_cast<uint8_t>(g);
+        }
+
+        DedupEngine::Result best{};
+        const bool found = dedup.lookup(static_cast<uint16_t>(f % 2000), f, 100 + f / 1000, best);
+        wrong_best += !(found && best.copies == GATEWAYS && best.best_gateway == expected);
+    }
+    CHECK(wrong_first == 0);
+    CHECK(wrong_best == 0);
+
+    const auto s = dedup.stats();
+    CHECK(s.firsts == FRAMES);
+    CHECK(s.duplicates == FRAMES * (GATEWAYS - 1));
+}
+
+/*
+ * Two gateways a window apart insert the same new frame. The table is
+ * full of frames from two windows before the later clock: live for the
+ * earlier gateway, expired for the later one, so they pick different
+ * slots. The earlier gateway's whole insert runs between the later
+ * one's probe and its claim.
+ */
+static void test_forced_interleaving()
+{
+    const uint16_t id = make_combined_id(4, 4);
+    uint32_t wrong_first = 0;
+    uint32_t wrong_copies = 0;
+
+    for (uint32_t counter = 0; counter < 32; ++counter)
+    {
+        for (const bool later_claims_first : {false, true})
+        {
+            const uint64_t early_ms = WINDOW_MS;
+            const uint64_t late_ms = 2 * WINDOW_MS;
+
+            bool armed = false;
+            DedupEngine *engine = nullptr;
+            DedupEngine::Result nested{};
+
+            DedupEngine::Config cfg{DedupEngine::MAX_PROBE, WINDOW_MS};
+            cfg.before_claim = [&] {
+                if (!armed)
+                    return;
+                armed = false;
+                nested = later_claims_first ? engine->insert(reception(id, counter, 2, -90, 0), late_ms)
+                                            : engine->insert(reception(id, counter, 1, -100, 0), early_ms);
+            };
+            DedupEngine dedup(cfg);
+            engine = &dedup;
+
+            for (uint32_t c = 0; c < DedupEngine::MAX_PROBE - 1; ++c)
+                dedup.insert(reception(make_combined_id(5, 5), c, 3, -100, 0), 0);
+
+            armed = true;
+            const auto outer = later_claims_first ? dedup.insert(reception(id, counter, 1, -100, 0), early_ms)
+                                                  : dedup.insert(reception(id, counter, 2, -90, 0), late_ms);
+            wrong_first += (outer.first + nested.first != 1);
+
+            DedupEngine::Result best{};
+            wrong_copies += !(dedup.lookup(id, counter, late_ms, best) && best.copies == 2 && best.best_gateway == 2);
+            wrong_first += dedup.stats().firsts != DedupEngine::MAX_PROBE;
+        }
+    }
+    CHECK(wrong_first == 0);
+    CHECK(wrong_copies == 0);
+}
+
+/* Two gateways' pipelines, one engine: each frame forwarded once */
+static void test_two_pipelines()
+{
+    constexpr uint16_t NODES = 20;
+    constexpr uint32_t FRAMES = 5;
+
+    DedupEngine dedup({4096, 5000});
+    std::atomic<uint32_t> forwarded{0};
+    std::atomic<uint32_t> acks{0};
+
+    const auto make = [&](uint8_t gateway) {
+        IngestPipeline::Config cfg;
+        cfg.workers = 2;
+        cfg.dedup = &dedup;
+        cfg.gateway_id = gateway;
+        return std::make_unique<IngestPipeline>(
+            cfg,
+            [&](unsigned, const AckOut &) { acks.fetch_add(1); },
+            [&](unsigned, const DataFrame &, const RxFrame &) { forwarded.fetch_add(1); });
+    };
+    auto a = make(1);
+    auto b = make(2);
+
+    std::vector<NodeSecurity> nodes(NODES);
+    for (uint16_t n = 0; n < NODES; ++n)
+        nodes[n].provision(make_combined_id(1, n + 1));
+
+    a->start();
+    b->start();
+
+    RxFrame rx{};
+    for (uint32_t f = 0; f < FRAMES; ++f)
+    {
+        for (const NodeSecurity &node : nodes)
+        {
+            const uint8_t header[] = {0, 0, static_cast<uint8_t>(FrameType::DATA), 0, 0, 0, 0, 0, 0};
+            memcpy(rx.data, header, sizeof(header));
+            write_u16_le(rx.data, 0, node.combined_id());
+            rx.len = static_cast<uint8_t>(node.sign(rx.data, sizeof(header), 2 + f));
+            rx.rx_end_ns = IngestPipeline::now_ns();
+
+            rx.rssi = -100;
+            CHECK(a->submit(rx));
+            rx.rssi = -90;
+            CHECK(b->submit(rx));
+        }
+    }
+
+    a->stop();
+    b->stop();
+
+    const auto sa = a->stats();
+    const auto sb = b->stats();
+    CHECK(forwarded.load() == NODES * FRAMES);
+    CHECK(sa.accepted + sb.accepted == NODES * FRAMES);
+    CHECK(sa.relayed + sb.relayed == NODES * FRAMES);
+    CHECK(acks.load() == 2 * NODES * FRAMES);
+
+    /* Gateway 2 heard every frame better */
+    DedupEngine::Result best{};
+    CHECK(dedup.lookup(nodes[0].combined_id(), 2, IngestPipeline::now_ns() / 1000000, best));
+    CHECK(best.copies == 2 && best.best_gateway == 2 && best.best_rssi == -90);
+}
+
+int main()
+{
+    test_first_and_duplicate();
+    test_best_selection();
+    test_expiry();
+    test_overflow();
+    test_concurrent();
+    test_forced_interleaving();
+    test_two_pipelines();
+    return loragro::gapp::test::result("dedup_engine");
+}
@@ -0,0 +1,314 @@
+/*
+ * Gateway ingest: DATA decoding (split and partial soil profiles),
+ * per-node uplink verification and ACK signing as the node checks
+ * them, the node ACK window, the
+ * threaded pipeline end to end (sharding, retries, forged frames), and
+ * replays of two nodes sharing a node ID under different gateways.
+ */
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "check.hpp"
+#include "gapp/ingest_pipeline.hpp"
+
+using namespace loragro;
+using namespace loragro::gapp;
+
+static constexpr uint8_t GATEWAY_ID = 1;
+
+/* Node side: FrameCodec layout, two plain entries and a two-probe soil profile */
+static size_t build_frame(const NodeSecurity &node, uint32_t counter, uint8_t *out)
+{
+    size_t pos = 0;
+    write_u16_le(out, pos, node.combined_id());
+    pos += 2;
+    out[pos++] = static_cast<uint8_t>(FrameType::DATA);
+    out[pos++] = 0;
+    out[pos++] = 3; // wire entries
+    write_u32_le(out, pos, 1000 + counter);
+    pos += 4;
+
+    out[pos++] = 0x00; // ENV_TEMP
+    write_i16_le(out, pos, 21);
+    write_i16_le(out, pos + 2, 500);
+    pos += 4;
+
+    out[pos++] = 0x40; // BATTERY_VOLTAGE
+    write_i16_le(out, pos, 3);
+    write_i16_le(out, pos + 2, -7);
+    pos += 4;
+
+    const uint8_t profile[] = {wire::SOIL_PROFILE, 2,
+                               0, 10, 61, static_cast<uint8_t>(-5), 12,
+                               1, 30, 80, 36, 0};
+    memcpy(out + pos, profile, sizeof(profile));
+    pos += sizeof(profile);
+
+    return node.sign(out, pos, counter);
+}
+
+/* Auth::verify_ack() on the node */
+static bool node_accepts_ack(const NodeSecurity &node, const uint8_t *ack, uint32_t counter, uint8_t ctr8)
+{
+    if (read_u16_le(ack, 0) != node.combined_id() ||
+        ack[FrameLayout::FRAME_TYPE] != static_cast<uint8_t>(FrameType::ACK) ||
+        ack[FrameLayout::FRAME_CTR] != ctr8)
+        return false;
+
+    uint8_t tag[Cmac::TAG_SIZE];
+    node.cmac().compute_framed(counter, ack, FrameLayout::ACK_FRAME_SIZE, tag);
+    return memcmp(tag, ack + FrameLayout::ACK_FRAME_SIZE, FrameLayout::AUTH_SIZE) == 0;
+}
+
+static void test_decode()
+{
+    NodeSecurity node;
+    node.provision(make_combined_id(GATEWAY_ID, 7));
+
+    uint8_t frame[255];
+    const size_t len = build_frame(node, 5, frame);
+
+    DataFrame df;
+    CHECK(decode_data_frame(frame, len - FrameLayout::AUTH_SIZE, df) == 0);
+    CHECK(df.combined_id == node.combined_id());
+    CHECK(df.timestamp == 1005);
+    CHECK(df.count == 2 + 2 * 4);
+
+    CHECK(df.entries[0].sensor_id == 0x00 && df.entries[0].v1 == 21 && df.entries[0].v2 == 500);
+    CHECK(df.entries[1].sensor_id == 0x40 && df.entries[1].v1 == 3 && df.entries[1].v2 == -7);
+
+    /* Probe 0: depth 10 cm, 30.5 %, -2.5 C, 120 uS/cm */
+    CHECK(df.entries[2].sensor_id == wire::soil_probe(0, wire::PROBE_DEPTH) && df.entries[2].v1 == 10);
+    CHECK(df.entries[3].v1 == 30 && df.entries[3].v2 == 500);
+    CHECK(df.entries[4].v1 == -2 && df.entries[4].v2 == -500);
+    CHECK(df.entries[5].sensor_id == wire::soil_probe(0, wire::PROBE_EC) && df.entries[5].v1 == 120);
+
+    /* Probe 1: 18 C */
+    CHECK(df.entries[8].sensor_id == wire::soil_probe(1, wire::PROBE_TEMPERATURE) && df.entries[8].v1 == 18);
+
+    /* Truncated */
+    CHECK(decode_data_frame(frame, len - FrameLayout::AUTH_SIZE - 3, df) == -EPROTO);
+    CHECK(decode_data_frame(frame, 5, df) == -EINVAL);
+}
+
+/* Probe 1 failed this cycle, probe 3 did not fit and went in the next frame */
+static void test_decode_split_profile()
+{
+    uint8_t frame[64] = {};
+    write_u16_le(frame, 0, make_combined_id(GATEWAY_ID, 7));
+    frame[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::DATA);
+    frame[FrameLayout::HEADER_SIZE] = 1;
+
+    const uint8_t head[] = {wire::SOIL_PROFILE, 2,
+                            0, 10, 60, 40, 10,
+                            2, 50, 70, 30, 20};
+    memcpy(frame + wire::DATA_HEADER_SIZE, head, sizeof(head));
+
+    DataFrame df;
+    CHECK(decode_data_frame(frame, wire::DATA_HEADER_SIZE + sizeof(head), df) == 0);
+    CHECK(df.count == 2 * 4);
+    CHECK(df.entries[0].sensor_id == wire::soil_probe(0, wire::PROBE_DEPTH) && df.entries[0].v1 == 10);
+    CHECK(df.entries[4].sensor_id == wire::soil_probe(2, wire::PROBE_DEPTH) && df.entries[4].v1 == 50);
+    CHECK(df.entries[7].sensor_id == wire::soil_probe(2, wire::PROBE_EC) && df.entries[7].v1 == 200);
+
+    const uint8_t tail[] = {wire::SOIL_PROFILE, 1,
+                            3, 80, 50, 28, 5};
+    memcpy(frame + wire::DATA_HEADER_SIZE, tail, sizeof(tail));
+    CHECK(decode_data_frame(frame, wire::DATA_HEADER_SIZE + sizeof(tail), df) == 0);
+    CHECK(df.count == 4);
+    CHECK(df.entries[0].sensor_id == wire::soil_probe(3, wire::PROBE_DEPTH) && df.entries[0].v1 == 80);
+    CHECK(df.entries[1].sensor_id == wire::soil_probe(3, wire::PROBE_MOISTURE) && df.entries[1].v1 == 25);
+
+    /* Index past the probe bus range */
+    frame[wire::DATA_HEADER_SIZE + 2] = wire::SOIL_PROBE_MAX;
+    CHECK(decode_data_frame(frame, wire::DATA_HEADER_SIZE + sizeof(tail), df) == -EPROTO);
+}
+
+static void test_verify_uplink()
+{
+    NodeSecurity node;
+    node.provision(make_combined_id(GATEWAY_ID, 9));
+    NodeSecurity gw;
+    gw.provision(make_combined_id(GATEWAY_ID, 9));
+
+    uint8_t frame[255];
+    uint32_t counter = 0;
+
+    size_t len = build_frame(node, 2, frame);
+    CHECK(gw.verify_uplink(frame, len, counter) == 0 && counter == 2);
+
+    /* Retry of the same frame */
+    CHECK(gw.verify_uplink(frame, len, counter) == -EALREADY && counter == 2);
+
+    /* Forged tag */
+    frame[len - 1] ^= 0x01;
+    CHECK(gw.verify_uplink(frame, len, counter) == -EBADMSG);
+
+    /* Lower byte wraps: 0xFE -> 0x101 */
+    len = build_frame(node, 0xFE, frame);
+    CHECK(gw.verify_uplink(frame, len, counter) == 0 && counter == 0xFE);
+    len = build_frame(node, 0x101, frame);
+    CHECK(gw.verify_uplink(frame, len, counter) == 0 && counter == 0x101);
+
+    /* ACK the node accepts, and not for another counter */
+    uint8_t ack[ACK_SIZE];
+    CHECK(gw.build_ack(counter, ack) == ACK_SIZE);
+    CHECK(node_accepts_ack(node, ack, 0x101, 0x01));
+    CHECK(!node_accepts_ack(node, ack, 0x100, 0x01));
+}
+
+static void test_ack_window()
+{
+    RadioParams sf12;
+    CHECK(node_airtime_ms(sf12, FrameLayout::ACK_FRAME_SIZE) == 827);
+
+    const AckWindow w = ack_window(sf12, 43);
+    CHECK(w.open_us == node_airtime_ms(sf12, 43) * 1000);
+    CHECK(w.close_us - w.open_us == 1157 * 1000);
+
+    RadioParams sf7;
+    sf7.sf = 7;
+    CHECK(ack_window(sf7, 43).open_us < w.open_us);
+}
+
+static void test_pipeline()
+{
+    constexpr unsigned WORKERS = 3;
+    constexpr uint16_t NODES = 50;
+    constexpr uint32_t FRAMES = 10;
+
+    std::vector<std::vector<AckOut>> acks(WORKERS);
+    std::vector<std::vector<std::pair<uint16_t, uint32_t>>> frames(WORKERS);
+
+    IngestPipeline::Config cfg;
+    cfg.workers = WORKERS;
+    cfg.queue_depth = 4096;
+
+    IngestPipeline pipe(
+        cfg,
+        [&](unsigned w, const AckOut &a) { acks[w].push_back(a); },
+        [&](unsigned w, const DataFrame &f, const RxFrame &) { frames[w].emplace_back(f.combined_id, f.counter); });
+
+    std::vector<NodeSecurity> nodes(NODES);
+    for (uint16_t n = 0; n < NODES; ++n)
+        nodes[n].provision(make_combined_id(GATEWAY_ID, n + 1));
+
+    pipe.start();
+
+    RxFrame rx{};
+    for (uint32_t f = 0; f < FRAMES; ++f)
+    {
+        for (const NodeSecurity &node : nodes)
+        {
+            rx.len = static_cast<uint8_t>(build_frame(node, 2 + f, rx.data));
+            rx.rx_end_ns = IngestPipeline::now_ns();
+            CHECK(pipe.submit(rx));
+
+            /* Frames 0 and 5 are retried, frame 3 also arrives forged */
+            if (f % 5 == 0)
+                CHECK(pipe.submit(rx));
+            if (f % 7 == 3)
+            {
+                RxFrame bad = rx;
+                bad.data[wire::DATA_HEADER_SIZE] ^= 0xFF;
+                CHECK(pipe.submit(bad));
+            }
+        }
+    }
+
+    /* Not a DATA frame */
+    rx.data[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::RESPONSE);
+    CHECK(pipe.submit(rx));
+
+    pipe.stop();
+
+    const auto s = pipe.stats();
+    const uint64_t retries = NODES * 2;
+    const uint64_t forged = NODES;
+    CHECK(s.received == NODES * FRAMES + retries + forged + 1);
+    CHECK(s.dropped == 0);
+    CHECK(s.accepted == NODES * FRAMES);
+    CHECK(s.duplicates == retries);
+    CHECK(s.auth_failed == forged);
+    CHECK(s.malformed == 1);
+    CHECK(s.acks == NODES * FRAMES + retries);
+
+    /* Sharding: a node only ever on its worker, counters in order */
+    std::map<uint16_t, uint32_t> last;
+    for (unsigned w = 0; w < WORKERS; ++w)
+    {
+        for (const auto &[id, counter] : frames[w])
+        {
+            CHECK(pipe.shard_of(id) == w);
+            CHECK(counter > last[id]);
+            last[id] = counter;
+        }
+
+        for (const AckOut &a : acks[w])
+        {
+            const NodeSecurity &node = nodes[extract_node(a.combined_id) - 1];
+            CHECK(node_accepts_ack(node, a.data, a.counter, static_cast<uint8_t>(a.counter)));
+            CHECK(a.ready_ns >= a.rx_end_ns && a.open_ns > a.rx_end_ns && a.close_ns > a.open_ns);
+        }
+    }
+    CHECK(last.size() == NODES);
+}
+
+/* Node 7 of gateway 1 and node 7 of gateway 2 land on the same worker
+ * and keep their own counters: replays of either are never new frames */
+static void test_colliding_node_ids()
+{
+    std::vector<std::pair<uint16_t, uint32_t>> frames;
+
+    IngestPipeline::Config cfg;
+    cfg.workers = 2;
+
+    IngestPipeline pipe(
+        cfg,
+        [](unsigned, const AckOut &) {},
+        [&](unsigned, const DataFrame &f, const RxFrame &) { frames.emplace_back(f.combined_id, f.counter); });
+
+    NodeSecurity a;
+    NodeSecurity b;
+    a.provision(make_combined_id(1, 7));
+    b.provision(make_combined_id(2, 7));
+    CHECK(pipe.shard_of(a.combined_id()) == pipe.shard_of(b.combined_id()));
+
+    const auto frame = [](const NodeSecurity &node, uint32_t counter) {
+        RxFrame rx{};
+        rx.len = static_cast<uint8_t>(build_frame(node, counter, rx.data));
+        rx.rx_end_ns = IngestPipeline::now_ns();
+        return rx;
+    };
+
+    pipe.start();
+    CHECK(pipe.submit(frame(a, 5)));
+    CHECK(pipe.submit(frame(b, 3)));
+    CHECK(pipe.submit(frame(a, 5))); // replayed after the other node's frame
+    CHECK(pipe.submit(frame(a, 4)));
+    CHECK(pipe.submit(frame(b, 3)));
+    CHECK(pipe.submit(frame(a, 6)));
+    pipe.stop();
+
+    const std::vector<std::pair<uint16_t, uint32_t>> expected = {
+        {a.combined_id(), 5}, {b.combined_id(), 3}, {a.combined_id(), 6}};
+    CHECK(frames == expected);
+
+    const auto s = pipe.stats();
+    CHECK(s.accepted == 3);
+    CHECK(s.duplicates == 3);
+    CHECK(s.auth_failed == 0);
+}
+
+int main()
+{
+    test_decode();
+    test_decode_split_profile();
+    test_verify_uplink();
+    test_ack_window();
+    test_pipeline();
+    test_colliding_node_ids();
+    return loragro::gapp::test::result("ingest_pipeline");
+}
@@ -0,0 +1,96 @@
+/*
+ * SPSC ring: capacity rounding, full / empty edges, wrap-around, and
+ * a producer and consumer thread passing a sequence through a small
+ * ring without loss, duplication or reordering.
+ */
+#include <thread>
+
+#include "check.hpp"
+#include "gapp/spsc_queue.hpp"
+
+using namespace loragro::gapp;
+
+static void test_capacity()
+{
+    CHECK(SpscQueue<int>(1).capacity() == 2);
+    CHECK(SpscQueue<int>(5).capacity() == 8);
+    CHECK(SpscQueue<int>(1024).capacity() == 1024);
+}
+
+static void test_full_empty()
+{
+    SpscQueue<int> q(4);
+    int v = 0;
+
+    CHECK(!q.try_pop(v));
+
+    for (int i = 0; i < 4; ++i)
+        CHECK(q.try_push(i));
+    CHECK(!q.try_push(99));
+    CHECK(q.size() == 4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(q.try_pop(v));
+        CHECK(v == i);
+    }
+    CHECK(!q.try_pop(v));
+    CHECK(q.size() == 0);
+}
+
+static void test_wrap()
+{
+    SpscQueue<int> q(4);
+    int v = 0;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        CHECK(q.try_push(i));
+        CHECK(q.try_push(i + 1));
+        CHECK(q.try_pop(v) && v == i);
+        CHECK(q.try_pop(v) && v == i + 1);
+    }
+}
+
+static void test_threads()
+{
+    constexpr uint64_t COUNT = 1000000;
+    SpscQueue<uint64_t> q(64);
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < COUNT;)
+        {
+            if (q.try_push(i))
+                ++i;
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t v = 0;
+    bool in_order = true;
+    while (expected < COUNT)
+    {
+        if (!q.try_pop(v))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        in_order &= (v == expected);
+        ++expected;
+    }
+
+    producer.join();
+    CHECK(in_order);
+    CHECK(!q.try_pop(v));
+}
+
+int main()
+{
+    test_capacity();
+    test_full_empty();
+    test_wrap();
+    test_threads();
+    return loragro::gapp::test::result("spsc_queue");
+}
@@ -0,0 +1,386 @@
+/*
+ * Time-series store: the chunk codec bit-exact on awkward inputs and
+ * compact on regular ones, appends from decoded frames, range scans
+ * over node / sensor / time, open chunks visible to scans, flush and
+ * reopen, segment roll-over, and a torn chunk header or corrupt chunk
+ * words at the end of a segment.
+ */
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "check.hpp"
+#include "gapp/tsdb.hpp"
+
+using namespace loragro;
+using namespace loragro::gapp;
+
+namespace fs = std::filesystem;
+
+struct TempDir
+{
+    TempDir()
+    {
+        char name[] = "/tmp/gapp_tsdb_XXXXXX";
+        path = mkdtemp(name) ? name : "";
+    }
+    ~TempDir()
+    {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+    std::string path;
+};
+
+/* =========================================================
+ * Codec
+ * ========================================================= */
+static bool same(double a, double b)
+{
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static void roundtrip(const std::vector<std::pair<int64_t, double>> &points)
+{
+    ChunkEncoder enc;
+    for (const auto &[t, v] : points)
+        enc.append(t, v);
+    CHECK(enc.count() == points.size());
+
+    ChunkDecoder dec(enc.words(), enc.word_count(), enc.count());
+    size_t n = 0;
+    int64_t t = 0;
+    double v = 0;
+    bool exact = true;
+    while (dec.next(t, v))
+    {
+        exact &= n < points.size() && t == points[n].first && same(v, points[n].second);
+        ++n;
+    }
+    CHECK(exact);
+    CHECK(n == points.size());
+}
+
+static void test_codec_roundtrip()
+{
+    /* Every timestamp bucket, both signs, and the 64-bit escape */
+    std::vector<std::pair<int64_t, double>> points;
+    int64_t t = 1700000000;
+    const int64_t deltas[] = {60, 60, 60, 61, 0, 124, 60, 316, 60, 2108, 60, -5, 1000000, 60, -40000000000LL, 60};
+    for (int64_t d : deltas)
+    {
+        t += d;
+        points.emplace_back(t, 21.5);
+    }
+    roundtrip(points);
+
+    /* Values that stress the XOR window */
+    const double values[] = {0.0, -0.0, 1.0, 1.0, 21.437, 21.438, -3.001, 1e300, -1e-300,
+                             std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(),
+                             std::numeric_limits<double>::denorm_min(), 65535.999, 0.5, 0.5};
+    points.clear();
+    for (size_t i = 0; i < std::size(values); ++i)
+        points.emplace_back(static_cast<int64_t>(i) * 600, values[i]);
+    roundtrip(points);
+
+    /* Random walk, random jitter */
+    std::mt19937 rng(7);
+    points.clear();
+    t = 0;
+    int v1 = 20;
+    for (int i = 0; i < 5000; ++i)
+    {
+        t += 600 + static_cast<int>(rng() % 7) - 3;
+        v1 += static_cast<int>(rng() % 3) - 1;
+        points.emplace_back(t, v1 + static_cast<int>(rng() % 1000) / 1000.0);
+    }
+    roundtrip(points);
+
+    /* One point */
+    roundtrip({{42, 3.5}});
+}
+
+/* Fixed interval, constant value: 2 bits per point after the first */
+static void test_codec_compact()
+{
+    ChunkEncoder enc;
+    for (int i = 0; i < 1000; ++i)
+        enc.append(1700000000 + i * 600, 48.5);
+    CHECK(enc.word_count() * 8 <= 16 + (999 * 2 + 7) / 8 + 8);
+    CHECK(enc.word_count() * 8 <= ChunkEncoder::max_bytes(1000));
+
+    /* A truncated chunk stops instead of reading past the words */
+    ChunkDecoder dec(enc.words(), 2, enc.count());
+    int64_t t = 0;
+    double v = 0;
+    size_t n = 0;
+    while (dec.next(t, v))
+        ++n;
+    CHECK(n == 1);
+}
+
+/* =========================================================
+ * Store
+ * ========================================================= */
+using Row = std::tuple<uint16_t, uint8_t, int64_t, double>;
+
+static std::vector<Row> scan_all(const TimeSeriesStore &db, const TimeSeriesStore::Query &q)
+{
+    std::vector<Row> rows;
+    const size_t n = db.scan(q, [&](uint16_t id, uint8_t s, int64_t t, double v) { rows.emplace_back(id, s, t, v); });
+    CHECK(n == rows.size());
+    return rows;
+}
+
+static DataFrame make_frame(uint16_t id, uint32_t timestamp, int16_t moisture)
+{
+    DataFrame f{};
+    f.combined_id = id;
+    f.timestamp = timestamp;
+    f.count = 2;
+    f.entries[0] = DataEntry{wire::soil_probe(0, wire::PROBE_MOISTURE), moisture, 500};
+    f.entries[1] = DataEntry{0x00, 21, 250};
+    return f;
+}
+
+static void test_store_config()
+{
+    TempDir dir;
+    TimeSeriesStore unopened({dir.path});
+    CHECK(unopened.append(1, 1, 0, 1.0) == -EBADF);
+
+    TimeSeriesStore bad({dir.path, 4096, 1024});
+    CHECK(bad.open() == -EINVAL);
+
+    TimeSeriesStore none({""});
+    CHECK(none.open() == -EINVAL);
+}
+
+static void test_store_scan()
+{
+    constexpr uint16_t NODES = 50;
+    constexpr uint32_t SAMPLES = 300;
+    const uint8_t moisture = wire::soil_probe(0, wire::PROBE_MOISTURE);
+
+    TempDir dir;
+    TimeSeriesStore db({dir.path, 1u << 20, 64});
+    CHECK(db.open() == 0);
+    CHECK(db.open() == -EALREADY);
+
+    for (uint32_t i = 0; i < SAMPLES; ++i)
+    {
+        for (uint16_t n = 1; n <= NODES; ++n)
+            CHECK(db.append(make_frame(make_combined_id(1, n), 1000 + i * 600, static_cast<int16_t>(30 + i % 5))) == 0);
+    }
+
+    auto s = db.stats();
+    CHECK(s.points == NODES * SAMPLES * 2);
+    CHECK(s.series == NODES * 2);
+    CHECK(s.chunks == NODES * 2 * (SAMPLES / 64));
+    CHECK(s.open_bytes > 0);
+
+    /* Moisture of nodes 10..19, samples 100..199 (sealed and open chunks) */
+    TimeSeriesStore::Query q;
+    q.first_id = make_combined_id(1, 10);
+    q.last_id = make_combined_id(1, 19);
+    q.sensors.set(moisture);
+    q.from = 1000 + 100 * 600;
+    q.to = 1000 + 199 * 600;
+
+    auto rows = scan_all(db, q);
+    CHECK(rows.size() == 10 * 100);
+
+    bool ok = true;
+    for (size_t k = 0; k < rows.size(); ++k)
+    {
+        const auto &[id, sensor, t, v] = rows[k];
+        const uint32_t i = 100 + k % 100;
+        ok &= id == make_combined_id(1, static_cast<uint16_t>(10 + k / 100)) && sensor == moisture &&
+              t == 1000 + static_cast<int64_t>(i) * 600 && v == 30 + i % 5 + 0.5;
+    }
+    CHECK(ok);
+
+    /* Tail still in the open chunks */
+    q.from = 1000 + (SAMPLES - 1) * 600;
+    q.to = q.from;
+    CHECK(scan_all(db, q).size() == 10);
+
+    /* Both sensors, all nodes, everything */
+    TimeSeriesStore::Query all;
+    all.sensors.set(moisture);
+    all.sensors.set(0x00);
+    CHECK(scan_all(db, all).size() == NODES * SAMPLES * 2);
+
+    /* Empty ranges */
+    q.from = 0;
+    q.to = 999;
+    CHECK(scan_all(db, q).empty());
+    q.sensors.reset();
+    q.sensors.set(0x42);
+    q.to = INT64_MAX;
+    CHECK(scan_all(db, q).empty());
+}
+
+/* A chunk is also sealed once it spans chunk_span_s */
+static void test_store_span()
+{
+    TempDir dir;
+    TimeSeriesStore::Config cfg{dir.path, 1u << 20, 64};
+    cfg.chunk_span_s = 3600;
+
+    TimeSeriesStore db(cfg);
+    CHECK(db.open() == 0);
+    for (int i = 0; i < 10; ++i)
+        CHECK(db.append(1, 1, i * 1000, 1.0) == 0);
+
+    /* 0..3000, 4000..7000 sealed; 8000, 9000 open */
+    CHECK(db.stats().chunks == 2);
+
+    TimeSeriesStore::Query q;
+    q.sensors.set(1);
+    q.from = 3000;
+    q.to = 8000;
+    CHECK(scan_all(db, q).size() == 6);
+}
+
+/* flush() seals the open chunks; a reopened store sees every point */
+static void test_store_reopen()
+{
+    TempDir dir;
+    const TimeSeriesStore::Config cfg{dir.path, 1u << 20, 64};
+
+    TimeSeriesStore::Query all;
+    all.sensors.set();
+
+    std::vector<Row> before;
+    {
+        TimeSeriesStore db(cfg);
+        CHECK(db.open() == 0);
+        for (int i = 0; i < 1000; ++i)
+            CHECK(db.append(static_cast<uint16_t>(i % 7), static_cast<uint8_t>(i % 3), i * 10, i * 0.25) == 0);
+        CHECK(db.flush() == 0);
+        CHECK(db.stats().open_bytes == 0);
+        before = scan_all(db, all);
+    }
+    CHECK(before.size() == 1000);
+
+    TimeSeriesStore db(cfg);
+    CHECK(db.open() == 0);
+    CHECK(db.stats().points == 1000);
+    CHECK(scan_all(db, all) == before);
+
+    /* Appends continue after the reopened chunks */
+    CHECK(db.append(0, 0, 20000, 1.0) == 0);
+    CHECK(scan_all(db, all).size() == 1001);
+}
+
+/* Segment and chunk header, as laid out in tsdb.cpp */
+static constexpr long SEGMENT_HEADER = 32;
+static constexpr long CHUNK_HEADER = 40;
+
+static constexpr uint32_t SEGMENT_POINTS = 16;
+
+static TimeSeriesStore::Config small_segments(const std::string &dir)
+{
+    return {dir, SEGMENT_HEADER + CHUNK_HEADER + ChunkEncoder::max_bytes(SEGMENT_POINTS), SEGMENT_POINTS};
+}
+
+/* 2000 points of one series over many segments; the last segment file */
+static fs::path fill_segments(const TimeSeriesStore::Config &cfg)
+{
+    TimeSeriesStore::Query all;
+    all.sensors.set();
+
+    {
+        TimeSeriesStore db(cfg);
+        CHECK(db.open() == 0);
+        for (int i = 0; i < 2000; ++i)
+            CHECK(db.append(1, 1, i, std::sin(i * 0.01)) == 0);
+        CHECK(db.flush() == 0);
+        CHECK(db.stats().segments > 2);
+        CHECK(scan_all(db, all).size() == 2000);
+    }
+
+    std::vector<fs::path> files;
+    for (const auto &e : fs::directory_iterator(cfg.dir))
+        files.push_back(e.path());
+    std::sort(files.begin(), files.end());
+    return files.back();
+}
+
+static void damage(const fs::path &file, long offset)
+{
+    FILE *f = std::fopen(file.c_str(), "r+b");
+    CHECK(f != nullptr);
+    std::fseek(f, offset, SEEK_SET);
+    uint32_t word = 0;
+    CHECK(std::fread(&word, sizeof(word), 1, f) == 1);
+    word ^= 0x5A5A5A5A;
+    std::fseek(f, offset, SEEK_SET);
+    std::fwrite(&word, sizeof(word), 1, f);
+    std::fclose(f);
+}
+
+/* Reopened after damage: the untouched prefix, then appends go on */
+static void check_recovered(const TimeSeriesStore::Config &cfg)
+{
+    TimeSeriesStore::Query all;
+    all.sensors.set();
+
+    TimeSeriesStore db(cfg);
+    CHECK(db.open() == 0);
+    const auto rows = scan_all(db, all);
+    CHECK(rows.size() < 2000 && rows.size() % SEGMENT_POINTS == 0);
+    CHECK(db.stats().points == rows.size());
+
+    bool prefix = true;
+    for (size_t i = 0; i < rows.size(); ++i)
+        prefix &= std::get<2>(rows[i]) == static_cast<int64_t>(i);
+    CHECK(prefix);
+
+    /* The dropped space is written again */
+    CHECK(db.append(1, 1, 5000, 1.0) == 0);
+    CHECK(db.flush() == 0);
+    CHECK(scan_all(db, all).size() == rows.size() + 1);
+}
+
+/* Small segments roll over; a torn last chunk header is dropped on open */
+static void test_store_segments()
+{
+    TempDir dir;
+    const auto cfg = small_segments(dir.path);
+
+    /* Break the magic of the first chunk in the last segment */
+    damage(fill_segments(cfg), SEGMENT_HEADER);
+    check_recovered(cfg);
+}
+
+/* Intact header over words that did not make it to the file */
+static void test_store_corrupt_words()
+{
+    TempDir dir;
+    const auto cfg = small_segments(dir.path);
+
+    damage(fill_segments(cfg), SEGMENT_HEADER + CHUNK_HEADER + 8);
+    check_recovered(cfg);
+}
+
+int main()
+{
+    test_codec_roundtrip();
+    test_codec_compact();
+    test_store_config();
+    test_store_scan();
+    test_store_span();
+    test_store_reopen();
+    test_store_segments();
+    test_store_corrupt_words();
+    return loragro::gapp::test::result("tsdb");
+}
@@ -0,0 +1,264 @@
+/*
+ * ACK turnaround benchmark
+ *
+ * Single worker view of the RX path: for each node count, signed DATA
+ * frames from randomly picked nodes (counters advancing per node) are
+ * verified and ACKed, and every step is timed:
+ *
+ *   verify      NodeSecurity::verify_uplink(), full CMAC over the frame
+ *   turnaround  verify + template ACK, end of reception to ACK ready
+ *   ack full    ACK tag computed from scratch (CMAC state, pad, K2)
+ *   ack tmpl    AckTemplate, one AES block
+ *
+ * verify and turnaround are timed per frame (percentiles); the two ACK
+ * paths are timed over the whole traffic (mean), since a clock read
+ * costs about as much as the difference between them.
+ *
+ * More nodes means more key schedules and templates competing for the
+ * cache, which is what the node counts sweep.
+ *
+ *   gapp_ackbench --nodes 1,100,1000,2047 --iterations 200000 --sf 7
+ *
+ * Exits with 1 when the p99 turnaround does not fit before the node's
+ * ACK window opens at the given SF (SF7 is the shortest window).
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gapp/ack_window.hpp"
+#include "gapp/data_frame.hpp"
+#include "gapp/node_security.hpp"
+
+using namespace loragro;
+using namespace loragro::gapp;
+
+struct BenchParams
+{
+    std::vector<uint32_t> nodes{1, 100, 1000, 2047};
+    uint32_t iterations{200000};
+    uint32_t sf{7};
+    uint32_t entries{6};
+    bool csv{false};
+};
+
+static bool parse(int argc, char **argv, BenchParams &p)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--csv") == 0)
+            p.csv = true;
+        else if (strcmp(argv[i], "--iterations") == 0 && has_value)
+            p.iterations = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else if (strcmp(argv[i], "--sf") == 0 && has_value)
+            p.sf = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else if (strcmp(argv[i], "--entries") == 0 && has_value)
+            p.entries = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else if (strcmp(argv[i], "--nodes") == 0 && has_value)
+        {
+            p.nodes.clear();
+            for (char *s = argv[++i]; *s;)
+            {
+                char *end = nullptr;
+                const unsigned long n = strtoul(s, &end, 0);
+                if (end == s)
+                    return false;
+                p.nodes.push_back(static_cast<uint32_t>(n));
+                s = (*end == ',') ? end + 1 : end;
+            }
+        }
+        else
+            return false;
+    }
+
+    for (uint32_t n : p.nodes)
+    {
+        if (n < 1 || n >= 2048)
+            return false;
+    }
+    return !p.nodes.empty() && p.iterations > 0 && p.sf >= 7 && p.sf <= 12 && p.entries >= 1 && p.entries <= 40;
+}
+
+static inline uint64_t now_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+/* ACK the way the gateway built it before the template: full CMAC */
+static void ack_full(const NodeSecurity &node, uint32_t counter, uint8_t *out)
+{
+    write_u16_le(out, 0, node.combined_id());
+    out[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::ACK);
+    out[FrameLayout::FRAME_CTR] = static_cast<uint8_t>(counter);
+
+    uint8_t tag[Cmac::TAG_SIZE];
+    node.cmac().compute_framed(counter, out, FrameLayout::ACK_FRAME_SIZE, tag);
+    memcpy(out + FrameLayout::ACK_FRAME_SIZE, tag, FrameLayout::AUTH_SIZE);
+}
+
+static void do_not_optimize(uint8_t v)
+{
+    asm volatile("" : : "r"(v) : "memory");
+}
+
+struct Percentiles
+{
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t max;
+};
+
+static Percentiles percentiles(std::vector<uint64_t> &v)
+{
+    std::sort(v.begin(), v.end());
+    const auto at = [&](double p) { return v[static_cast<size_t>(p * (v.size() - 1) + 0.5)]; };
+    return Percentiles{at(0.50), at(0.99), v.back()};
+}
+
+/* =========================================================
+ * One node count
+ * ========================================================= */
+struct RunResult
+{
+    Percentiles verify;
+    uint64_t ack_full_ns; // mean
+    uint64_t ack_template_ns;
+    Percentiles turnaround;
+    uint32_t failures;
+};
+
+static RunResult run(uint32_t node_count, const BenchParams &p, size_t frame_len)
+{
+    std::mt19937 rng(node_count);
+
+    std::vector<NodeSecurity> senders(node_count);
+    std::vector<uint32_t> counters(node_count, 1);
+    for (uint32_t i = 0; i < node_count; ++i)
+        senders[i].provision(make_combined_id(1, static_cast<uint16_t>(i + 1)));
+
+    /* Pre-signed traffic, random node order */
+    std::vector<uint8_t> frames(static_cast<size_t>(p.iterations) * frame_len);
+    std::vector<uint32_t> owner(p.iterations);
+    for (uint32_t i = 0; i < p.iterations; ++i)
+    {
+        const uint32_t n = rng() % node_count;
+        uint8_t *f = &frames[static_cast<size_t>(i) * frame_len];
+
+        write_u16_le(f, 0, senders[n].combined_id());
+        f[FrameLayout::FRAME_TYPE] = static_cast<uint8_t>(FrameType::DATA);
+        f[FrameLayout::HEADER_SIZE] = static_cast<uint8_t>(p.entries);
+        for (size_t b = FrameLayout::HEADER_SIZE + 1; b < frame_len - FrameLayout::AUTH_SIZE; ++b)
+            f[b] = static_cast<uint8_t>(rng());
+
+        senders[n].sign(f, frame_len - FrameLayout::AUTH_SIZE, ++counters[n]);
+        owner[i] = n;
+    }
+
+    std::vector<uint64_t> verify(p.iterations);
+    std::vector<uint64_t> turnaround(p.iterations);
+    std::vector<uint32_t> verified(p.iterations);
+    uint32_t failures = 0;
+
+    std::vector<NodeSecurity> gateway(node_count);
+    for (uint32_t i = 0; i < node_count; ++i)
+        gateway[i].provision(senders[i].combined_id());
+
+    /* Per frame: verify + template ACK, what a worker does on RX */
+    uint8_t ack[ACK_SIZE];
+    for (uint32_t i = 0; i < p.iterations; ++i)
+    {
+        NodeSecurity &node = gateway[owner[i]];
+        const uint8_t *f = &frames[static_cast<size_t>(i) * frame_len];
+
+        const uint64_t t0 = now_ns();
+        const int rc = node.verify_uplink(f, frame_len, verified[i]);
+        const uint64_t t1 = now_ns();
+        node.build_ack(verified[i], ack);
+        const uint64_t t2 = now_ns();
+
+        failures += (rc != 0);
+        verify[i] = t1 - t0;
+        turnaround[i] = t2 - t0;
+    }
+
+    /* ACK generation alone, batched so the clock does not dominate */
+    uint8_t sink = 0;
+    const uint64_t f0 = now_ns();
+    for (uint32_t i = 0; i < p.iterations; ++i)
+    {
+        ack_full(gateway[owner[i]], verified[i], ack);
+        sink ^= ack[ACK_SIZE - 1];
+    }
+    const uint64_t f1 = now_ns();
+    for (uint32_t i = 0; i < p.iterations; ++i)
+    {
+        gateway[owner[i]].build_ack(verified[i], ack);
+        sink ^= ack[ACK_SIZE - 1];
+    }
+    const uint64_t f2 = now_ns();
+    do_not_optimize(sink);
+
+    return RunResult{percentiles(verify), (f1 - f0) / p.iterations, (f2 - f1) / p.iterations,
+                     percentiles(turnaround), failures};
+}
+
+/* =========================================================
+ * Main
+ * ========================================================= */
+int main(int argc, char **argv)
+{
+    BenchParams p;
+    if (!parse(argc, argv, p))
+    {
+        std::printf("usage: gapp_ackbench [--nodes N,N,...] [--iterations N] [--sf 7..12] [--entries N] [--csv]\n");
+        return 2;
+    }
+
+    const size_t frame_len = wire::DATA_HEADER_SIZE + p.entries * wire::MEASUREMENT_SIZE + FrameLayout::AUTH_SIZE;
+
+    RadioParams radio;
+    radio.sf = static_cast<uint8_t>(p.sf);
+    const AckWindow window = ack_window(radio, frame_len);
+    const uint64_t budget_ns = static_cast<uint64_t>(window.open_us) * 1000;
+
+    if (p.csv)
+        std::printf("nodes,verify_p50_ns,ack_full_ns,ack_tmpl_ns,turnaround_p50_ns,turnaround_p99_ns,"
+                    "turnaround_max_ns,window_open_us,pass\n");
+    else
+        std::printf("SF%u, %zu byte frames, node ACK window opens %u us after RX end\n\n"
+                    "nodes   verify p50   ack full   ack tmpl   turnaround p50 / p99 / max     result\n",
+                    p.sf, frame_len, window.open_us);
+
+    bool ok = true;
+    for (uint32_t n : p.nodes)
+    {
+        const RunResult r = run(n, p, frame_len);
+        const bool pass = r.failures == 0 && r.turnaround.p99 < budget_ns;
+        ok &= pass;
+
+        if (p.csv)
+            std::printf("%u,%llu,%llu,%llu,%llu,%llu,%llu,%u,%d\n", n,
+                        (unsigned long long)r.verify.p50,
+                        (unsigned long long)r.ack_full_ns, (unsigned long long)r.ack_template_ns,
+                        (unsigned long long)r.turnaround.p50, (unsigned long long)r.turnaround.p99,
+                        (unsigned long long)r.turnaround.max, window.open_us, pass ? 1 : 0);
+        else
+            std::printf("%5u   %7llu ns   %5llu ns   %5llu ns   %6llu / %6llu / %8llu ns   %s\n", n,
+                        (unsigned long long)r.verify.p50,
+                        (unsigned long long)r.ack_full_ns, (unsigned long long)r.ack_template_ns,
+                        (unsigned long long)r.turnaround.p50, (unsigned long long)r.turnaround.p99,
+                        (unsigned long long)r.turnaround.max,
+                        pass ? "ok" : (r.failures ? "VERIFY FAILED" : "LATE"));
+    }
+
+    return ok ? 0 : 1;
+}
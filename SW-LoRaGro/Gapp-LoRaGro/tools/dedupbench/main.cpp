@@ -0,0 +1,300 @@
+/*
+ * Multi-gateway deduplication benchmark
+ *
+ * Several gateways hear the same uplinks. Each gateway is one thread
+ * inserting its receptions into one shared DedupEngine, the way the
+ * gateway ingest workers do:
+ *
+ *   frame f from node n at time t -> heard by each gateway with
+ *   probability --hear-percent (at least one), random RSSI / SNR
+ *
+ * Timestamps come from a synthetic clock at --rate frames/s, so entries
+ * expire and slots are reused the same way they would over the run's
+ * span of air time, only faster. Gateways share that clock the way
+ * real ones share GPS time: they run in steps of a quarter window with
+ * a barrier in between, and within a step odd gateways insert in
+ * reverse order so that both orders race on the same frames.
+ *
+ *   gapp_dedupbench --gateways 4 --frames 1000000 --rate 20000
+ *
+ * After each step every frame of it must have exactly one first insert,
+ * and the engine's best gateway must match the best reception computed
+ * offline (checked outside the timed part). Exits with 1 on a mismatch
+ * or an overflow.
+ */
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gapp/dedup_engine.hpp"
+#include "lora/lora_protocol.hpp"
+
+using namespace loragro;
+using namespace loragro::gapp;
+
+struct BenchParams
+{
+    uint32_t gateways{4};
+    uint32_t frames{1000000};
+    uint32_t nodes{2000};
+    uint32_t hear_percent{75};
+    uint32_t rate{20000};
+    uint32_t window_ms{5000};
+    size_t capacity{0}; // 0: four windows of frames, the sizing rule of dedup_engine.hpp
+    uint32_t seed{1};
+    bool csv{false};
+};
+
+static bool parse(int argc, char **argv, BenchParams &p)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value = i + 1 < argc;
+        const auto next = [&] { return static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0)); };
+
+        if (strcmp(argv[i], "--csv") == 0)
+            p.csv = true;
+        else if (strcmp(argv[i], "--gateways") == 0 && has_value)
+            p.gateways = next();
+        else if (strcmp(argv[i], "--frames") == 0 && has_value)
+            p.frames = next();
+        else if (strcmp(argv[i], "--nodes") == 0 && has_value)
+            p.nodes = next();
+        else if (strcmp(argv[i], "--hear-percent") == 0 && has_value)
+            p.hear_percent = next();
+        else if (strcmp(argv[i], "--rate") == 0 && has_value)
+            p.rate = next();
+        else if (strcmp(argv[i], "--window-ms") == 0 && has_value)
+            p.window_ms = next();
+        else if (strcmp(argv[i], "--capacity") == 0 && has_value)
+            p.capacity = next();
+        else if (strcmp(argv[i], "--seed") == 0 && has_value)
+            p.seed = next();
+        else
+            return false;
+    }
+    return p.gateways >= 1 && p.gateways <= 255 && p.frames > 0 && p.nodes >= 1 && p.nodes < 2048 &&
+           p.hear_percent >= 1 && p.hear_percent <= 100 && p.rate > 0 && p.window_ms > 0;
+}
+
+static inline uint64_t now_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+/* =========================================================
+ * Traffic
+ * ========================================================= */
+struct Frame
+{
+    uint16_t combined_id;
+    uint32_t counter;
+    uint64_t at_ms;
+    uint8_t best; // expected best gateway
+};
+
+struct Heard
+{
+    uint32_t frame;
+    int16_t rssi;
+    int8_t snr;
+};
+
+static bool better(int8_t snr, int16_t rssi, uint8_t g, int8_t best_snr, int16_t best_rssi, uint8_t best_g)
+{
+    if (snr != best_snr)
+        return snr > best_snr;
+    if (rssi != best_rssi)
+        return rssi > best_rssi;
+    return g < best_g;
+}
+
+/* heard[g]: receptions of gateway g; steps[g][s]: where step s starts in it */
+static void build(const BenchParams &p, uint32_t step_frames, std::vector<Frame> &frames,
+                  std::vector<std::vector<Heard>> &heard, std::vector<std::vector<size_t>> &steps)
+{
+    std::mt19937 rng(p.seed);
+    std::vector<uint32_t> counters(p.nodes, 1);
+
+    frames.resize(p.frames);
+    heard.assign(p.gateways, {});
+    steps.assign(p.gateways, {});
+
+    for (uint32_t f = 0; f < p.frames; ++f)
+    {
+        if (f % step_frames == 0)
+        {
+            for (uint32_t g = 0; g < p.gateways; ++g)
+                steps[g].push_back(heard[g].size());
+        }
+
+        const uint32_t n = rng() % p.nodes;
+        Frame &fr = frames[f];
+        fr.combined_id = make_combined_id(1, static_cast<uint16_t>(n + 1));
+        fr.counter = ++counters[n];
+        fr.at_ms = static_cast<uint64_t>(f) * 1000 / p.rate;
+
+        const uint32_t forced = rng() % p.gateways;
+        bool any = false;
+        int8_t best_snr = 0;
+        int16_t best_rssi = 0;
+        for (uint32_t g = 0; g < p.gateways; ++g)
+        {
+            if (g != forced && rng() % 100 >= p.hear_percent)
+                continue;
+
+            const Heard h{f, static_cast<int16_t>(-140 + static_cast<int>(rng() % 80)),
+                          static_cast<int8_t>(-20 + static_cast<int>(rng() % 30))};
+            heard[g].push_back(h);
+
+            if (!any || better(h.snr, h.rssi, static_cast<uint8_t>(g), best_snr, best_rssi, fr.best))
+            {
+                fr.best = static_cast<uint8_t>(g);
+                best_snr = h.snr;
+                best_rssi = h.rssi;
+                any = true;
+            }
+        }
+    }
+
+    for (uint32_t g = 0; g < p.gateways; ++g)
+    {
+        steps[g].push_back(heard[g].size());
+        if (g & 1)
+        {
+            for (size_t s = 0; s + 1 < steps[g].size(); ++s)
+                std::reverse(heard[g].begin() + steps[g][s], heard[g].begin() + steps[g][s + 1]);
+        }
+    }
+}
+
+/* =========================================================
+ * Main
+ * ========================================================= */
+int main(int argc, char **argv)
+{
+    BenchParams p;
+    if (!parse(argc, argv, p))
+    {
+        std::printf("usage: gapp_dedupbench [--gateways N] [--frames N] [--nodes N] [--hear-percent 1..100]\n"
+                    "                       [--rate N] [--window-ms N] [--capacity N] [--seed N] [--csv]\n");
+        return 2;
+    }
+
+    /* A quarter window of frames per step, so no entry expires while a gateway still needs it */
+    const uint32_t step_frames =
+        std::max<uint32_t>(1, static_cast<uint32_t>(static_cast<uint64_t>(p.rate) * p.window_ms / 4000));
+
+    std::vector<Frame> frames;
+    std::vector<std::vector<Heard>> heard;
+    std::vector<std::vector<size_t>> steps;
+    build(p, step_frames, frames, heard, steps);
+    const size_t step_count = steps[0].size() - 1;
+
+    const size_t capacity = p.capacity ? p.capacity : static_cast<size_t>(p.rate) * p.window_ms / 1000 * 4;
+    DedupEngine dedup({capacity, p.window_ms});
+
+    /* Per frame: first inserts seen, written by many threads */
+    std::vector<std::atomic<uint8_t>> firsts(p.frames);
+    uint32_t wrong_first = 0;
+    uint32_t wrong_best = 0;
+    uint64_t check_ns = 0;
+    size_t step = 0;
+
+    /* Last thread to arrive checks the step just inserted */
+    const auto check_step = [&]() noexcept {
+        const uint64_t c0 = now_ns();
+        const uint32_t begin = static_cast<uint32_t>(std::min<uint64_t>(p.frames, step * step_frames));
+        const uint32_t end = static_cast<uint32_t>(std::min<uint64_t>(p.frames, (step + 1) * step_frames));
+        for (uint32_t f = begin; f < end; ++f)
+        {
+            wrong_first += (firsts[f].load(std::memory_order_relaxed) != 1);
+
+            DedupEngine::Result r{};
+            if (!dedup.lookup(frames[f].combined_id, frames[f].counter, frames[f].at_ms, r) ||
+                r.best_gateway != frames[f].best)
+                ++wrong_best;
+        }
+        ++step;
+        check_ns += now_ns() - c0;
+    };
+    std::barrier sync(static_cast<std::ptrdiff_t>(p.gateways), check_step);
+
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (uint32_t g = 0; g < p.gateways; ++g)
+    {
+        threads.emplace_back([&, g] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+            for (size_t st = 0; st < step_count; ++st)
+            {
+                for (size_t i = steps[g][st]; i < steps[g][st + 1]; ++i)
+                {
+                    const Heard &h = heard[g][i];
+                    const Frame &fr = frames[h.frame];
+                    const DedupEngine::Reception rx{fr.combined_id, fr.counter, static_cast<uint8_t>(g), h.rssi,
+                                                    h.snr};
+                    if (dedup.insert(rx, fr.at_ms).first)
+                        firsts[h.frame].fetch_add(1, std::memory_order_relaxed);
+                }
+                sync.arrive_and_wait();
+            }
+        });
+    }
+
+    while (ready.load() < p.gateways)
+        std::this_thread::yield();
+    const uint64_t t0 = now_ns();
+    go.store(true, std::memory_order_release);
+    for (auto &t : threads)
+        t.join();
+    const uint64_t wall_ns = now_ns() - t0 - check_ns;
+
+    const auto s = dedup.stats();
+    const double seconds = wall_ns / 1e9;
+    const double inserts_per_s = s.inserts / seconds;
+    const double frames_per_s = p.frames / seconds;
+    const double ns_per_insert = s.inserts ? static_cast<double>(wall_ns) / s.inserts : 0;
+
+    const bool ok = wrong_first == 0 && wrong_best == 0 && s.overflows == 0;
+
+    if (p.csv)
+    {
+        std::printf("gateways,frames,inserts,firsts,duplicates,twins,overflows,inserts_per_s,frames_per_s,"
+                    "ns_per_insert,wrong_first,wrong_best,pass\n");
+        std::printf("%u,%u,%llu,%llu,%llu,%llu,%llu,%.0f,%.0f,%.1f,%u,%u,%d\n", p.gateways, p.frames,
+                    (unsigned long long)s.inserts, (unsigned long long)s.firsts,
+                    (unsigned long long)s.duplicates, (unsigned long long)s.twins,
+                    (unsigned long long)s.overflows, inserts_per_s, frames_per_s, ns_per_insert,
+                    wrong_first, wrong_best, ok ? 1 : 0);
+    }
+    else
+    {
+        std::printf("load:     %u gateways, %u nodes, %u frames at %u frames/s, %u%% heard per gateway\n",
+                    p.gateways, p.nodes, p.frames, p.rate, p.hear_percent);
+        std::printf("table:    %zu slots, %u ms window\n", dedup.capacity(), p.window_ms);
+        std::printf("inserts:  %llu (%llu first, %llu duplicate, %llu twin, %llu overflow)\n",
+                    (unsigned long long)s.inserts, (unsigned long long)s.firsts,
+                    (unsigned long long)s.duplicates, (unsigned long long)s.twins,
+                    (unsigned long long)s.overflows);
+        std::printf("rate:     %.0f inserts/s, %.0f frames/s, %.1f ns per insert\n", inserts_per_s, frames_per_s,
+                    ns_per_insert);
+        std::printf("check:    %u frames without exactly one first, %u with the wrong best gateway\n",
+                    wrong_first, wrong_best);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+/*
+ * Gateway load generator
+ *
+ * Plays the radio RX thread: signed DATA frames from --nodes nodes
+ * (FrameCodec layout, counters advancing per node) submitted to the
+ * IngestPipeline at --rate frames per second for --seconds, with a
+ * share of retries and forged frames. Prints the ACK generation
+ * latency (end of reception to signed ACK) and the pipeline counters.
+ *
+ *   gapp_loadgen --nodes 2000 --rate 10000 --seconds 10 --workers 4
+ *
+ * Exits with 1 when an ACK was late for its node's receive window,
+ * a frame was dropped, or p99 exceeds --max-p99-us.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gapp/ingest_pipeline.hpp"
+
+using namespace loragro;
+using namespace loragro::gapp;
+
+struct LoadParams
+{
+    uint32_t nodes{1000};
+    uint32_t rate{5000};
+    uint32_t seconds{5};
+    uint32_t workers{4};
+    uint32_t sf{12};
+    uint32_t entries{6};
+    uint32_t retry_percent{5};
+    uint32_t forged_percent{1};
+    uint32_t max_p99_us{0};
+    uint32_t seed{1};
+    bool csv{false};
+};
+
+static void usage()
+{
+    std::printf("usage: gapp_loadgen [--nodes N] [--rate FPS] [--seconds S] [--workers W] [--sf 7..12]\n"
+                "                    [--entries N] [--retry-percent P] [--forged-percent P]\n"
+                "                    [--max-p99-us US] [--seed N] [--csv]\n");
+}
+
+static bool parse(int argc, char **argv, LoadParams &p)
+{
+    const struct
+    {
+        const char *name;
+        uint32_t *field;
+    } opts[] = {
+        {"--nodes", &p.nodes},
+        {"--rate", &p.rate},
+        {"--seconds", &p.seconds},
+        {"--workers", &p.workers},
+        {"--sf", &p.sf},
+        {"--entries", &p.entries},
+        {"--retry-percent", &p.retry_percent},
+        {"--forged-percent", &p.forged_percent},
+        {"--max-p99-us", &p.max_p99_us},
+        {"--seed", &p.seed},
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--csv") == 0)
+        {
+            p.csv = true;
+            continue;
+        }
+
+        bool known = false;
+        for (const auto &o : opts)
+        {
+            if (strcmp(argv[i], o.name) == 0 && i + 1 < argc)
+            {
+                *o.field = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+                known = true;
+                break;
+            }
+        }
+        if (!known)
+            return false;
+    }
+
+    return p.nodes >= 1 && p.nodes < 2048 && p.rate > 0 && p.workers > 0 && p.sf >= 7 && p.sf <= 12 &&
+           p.entries >= 1 && p.entries <= 40;
+}
+
+/* =========================================================
+ * Simulated nodes
+ * ========================================================= */
+struct LoadNode
+{
+    NodeSecurity security;
+    uint32_t counter{1};
+};
+
+static uint8_t build_frame(LoadNode &n, uint32_t entries, std::mt19937 &rng, uint8_t *out)
+{
+    size_t pos = 0;
+    write_u16_le(out, pos, n.security.combined_id());
+    pos += 2;
+    out[pos++] = static_cast<uint8_t>(FrameType::DATA);
+    out[pos++] = 0;
+    out[pos++] = static_cast<uint8_t>(entries);
+    write_u32_le(out, pos, n.counter * 900);
+    pos += 4;
+
+    for (uint32_t e = 0; e < entries; ++e)
+    {
+        out[pos++] = static_cast<uint8_t>(e);
+        write_i16_le(out, pos, static_cast<int16_t>(rng() % 100));
+        write_i16_le(out, pos + 2, static_cast<int16_t>(rng() % 1000));
+        pos += 4;
+    }
+
+    return static_cast<uint8_t>(n.security.sign(out, pos, ++n.counter));
+}
+
+static uint64_t percentile(const std::vector<uint64_t> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    const size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[idx];
+}
+
+/* =========================================================
+ * Main
+ * ========================================================= */
+int main(int argc, char **argv)
+{
+    LoadParams p;
+    if (!parse(argc, argv, p))
+    {
+        usage();
+        return 2;
+    }
+
+    std::mt19937 rng(p.seed);
+
+    std::vector<LoadNode> nodes(p.nodes);
+    for (uint32_t i = 0; i < p.nodes; ++i)
+        nodes[i].security.provision(make_combined_id(1, static_cast<uint16_t>(i + 1)));
+
+    /* Per-worker latency and slack samples, only touched by that worker */
+    const uint64_t expected = static_cast<uint64_t>(p.rate) * p.seconds;
+    std::vector<std::vector<uint64_t>> latency(p.workers);
+    std::vector<std::vector<int64_t>> slack(p.workers);
+    for (uint32_t w = 0; w < p.workers; ++w)
+    {
+        latency[w].reserve(expected / p.workers * 2 + 1024);
+        slack[w].reserve(expected / p.workers * 2 + 1024);
+    }
+
+    IngestPipeline::Config cfg;
+    cfg.workers = p.workers;
+    cfg.queue_depth = 4096;
+    cfg.radio.sf = static_cast<uint8_t>(p.sf);
+
+    IngestPipeline pipe(cfg, [&](unsigned w, const AckOut &a) {
+        latency[w].push_back(a.ready_ns - a.rx_end_ns);
+        slack[w].push_back(static_cast<int64_t>(a.open_ns) - static_cast<int64_t>(a.ready_ns));
+    });
+
+    pipe.start();
+
+    /* Paced RX thread: sleep while ahead of schedule, catch up in bursts when behind */
+    const auto period = std::chrono::nanoseconds(1000000000ULL / p.rate);
+    const auto t0 = std::chrono::steady_clock::now();
+    auto next = t0;
+
+    RxFrame rx{};
+    uint32_t node_idx = 0;
+
+    for (uint64_t sent = 0; sent < expected; ++sent)
+    {
+        if (std::chrono::steady_clock::now() < next)
+            std::this_thread::sleep_until(next);
+        next += period;
+
+        const uint32_t roll = rng() % 100;
+        if (sent == 0 || roll >= p.retry_percent)
+        {
+            LoadNode &n = nodes[node_idx];
+            node_idx = (node_idx + 1) % p.nodes;
+            rx.len = build_frame(n, p.entries, rng, rx.data);
+        }
+
+        RxFrame out = rx;
+        if (roll >= 100 - p.forged_percent)
+            out.data[out.len - 1] ^= 0x5A;
+
+        out.rssi = static_cast<int16_t>(-60 - static_cast<int>(rng() % 60));
+        out.snr = static_cast<int8_t>(static_cast<int>(rng() % 20) - 10);
+        out.rx_end_ns = IngestPipeline::now_ns();
+        pipe.submit(out);
+    }
+
+    const double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    pipe.stop();
+
+    std::vector<uint64_t> all;
+    int64_t min_slack = INT64_MAX;
+    for (uint32_t w = 0; w < p.workers; ++w)
+    {
+        all.insert(all.end(), latency[w].begin(), latency[w].end());
+        for (int64_t s : slack[w])
+            min_slack = std::min(min_slack, s);
+    }
+    std::sort(all.begin(), all.end());
+
+    const auto s = pipe.stats();
+    const uint64_t p50 = percentile(all, 0.50) / 1000;
+    const uint64_t p99 = percentile(all, 0.99) / 1000;
+    const uint64_t max = all.empty() ? 0 : all.back() / 1000;
+    const double fps = s.received / elapsed_s;
+
+    if (p.csv)
+    {
+        std::printf("nodes,workers,sf,rate,fps,received,accepted,duplicates,auth_failed,dropped,acks,late,"
+                    "p50_us,p99_us,max_us,min_slack_us\n");
+        std::printf("%u,%u,%u,%u,%.0f,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%lld\n",
+                    p.nodes, p.workers, p.sf, p.rate, fps,
+                    (unsigned long long)s.received, (unsigned long long)s.accepted,
+                    (unsigned long long)s.duplicates, (unsigned long long)s.auth_failed,
+                    (unsigned long long)s.dropped, (unsigned long long)s.acks, (unsigned long long)s.late_acks,
+                    (unsigned long long)p50, (unsigned long long)p99, (unsigned long long)max,
+                    (long long)(all.empty() ? 0 : min_slack / 1000));
+    }
+    else
+    {
+        std::printf("load:     %u nodes, %u workers, SF%u, %u frames/s target, %.0f frames/s offered\n",
+                    p.nodes, p.workers, p.sf, p.rate, fps);
+        std::printf("frames:   %llu received, %llu accepted, %llu retries, %llu forged, %llu dropped\n",
+                    (unsigned long long)s.received, (unsigned long long)s.accepted,
+                    (unsigned long long)s.duplicates, (unsigned long long)s.auth_failed,
+                    (unsigned long long)s.dropped);
+        std::printf("ack:      %llu signed, %llu late, p50 %llu us, p99 %llu us, max %llu us\n",
+                    (unsigned long long)s.acks, (unsigned long long)s.late_acks,
+                    (unsigned long long)p50, (unsigned long long)p99, (unsigned long long)max);
+        std::printf("window:   opens %u us after RX end, min slack %lld us\n",
+                    ack_window(cfg.radio, wire::DATA_HEADER_SIZE + p.entries * wire::MEASUREMENT_SIZE +
+                                              FrameLayout::AUTH_SIZE)
+                        .open_us,
+                    (long long)(all.empty() ? 0 : min_slack / 1000));
+    }
+
+    const bool failed = s.late_acks != 0 || s.dropped != 0 || (p.max_p99_us != 0 && p99 > p.max_p99_us);
+    return failed ? 1 : 0;
+}
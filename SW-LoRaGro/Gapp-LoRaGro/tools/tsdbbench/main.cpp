@@ -0,0 +1,332 @@
+/*
+ * Time-series store benchmark
+ *
+ * Plays the FrameSink: --nodes nodes report every --interval seconds
+ * for --days days, one decoded DATA frame each, with a four-probe soil
+ * profile (depth, moisture, temperature, EC per probe) plus air
+ * temperature, humidity and battery voltage, values as the frame
+ * decoder produces them (integer part and thousandths). Then:
+ *
+ *   ingest   points/s through TimeSeriesStore::append(DataFrame)
+ *   size     bytes per point on disk after flush()
+ *   reopen   index rebuild from the segment files
+ *   queries  soil moisture (all probes) of nodes 1-200 over the last
+ *            7 days, one node's air temperature over the last day,
+ *            every sensor of every node over the last hour
+ *
+ *   gapp_tsdbbench --nodes 1000 --days 30 --interval 900
+ *
+ * Query results are checked against the generated counts. Exits with
+ * 1 on a wrong count or when ingest stays below --min-rate points/s.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gapp/tsdb.hpp"
+
+using namespace loragro;
+using namespace loragro::gapp;
+
+namespace fs = std::filesystem;
+
+struct BenchParams
+{
+    uint32_t nodes{500};
+    uint32_t days{7};
+    uint32_t interval{900}; // s
+    uint32_t chunk_points{1024};
+    uint32_t chunk_span{86400}; // s
+    uint32_t min_rate{0};
+    std::string dir;
+    bool keep{false};
+    bool csv{false};
+};
+
+static bool parse(int argc, char **argv, BenchParams &p)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value = i + 1 < argc;
+        const auto next = [&] { return static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0)); };
+
+        if (strcmp(argv[i], "--csv") == 0)
+            p.csv = true;
+        else if (strcmp(argv[i], "--keep") == 0)
+            p.keep = true;
+        else if (strcmp(argv[i], "--nodes") == 0 && has_value)
+            p.nodes = next();
+        else if (strcmp(argv[i], "--days") == 0 && has_value)
+            p.days = next();
+        else if (strcmp(argv[i], "--interval") == 0 && has_value)
+            p.interval = next();
+        else if (strcmp(argv[i], "--chunk-points") == 0 && has_value)
+            p.chunk_points = next();
+        else if (strcmp(argv[i], "--chunk-span") == 0 && has_value)
+            p.chunk_span = next();
+        else if (strcmp(argv[i], "--min-rate") == 0 && has_value)
+            p.min_rate = next();
+        else if (strcmp(argv[i], "--dir") == 0 && has_value)
+            p.dir = argv[++i];
+        else
+            return false;
+    }
+    return p.nodes >= 1 && p.nodes < 2048 && p.days >= 1 && p.interval >= 1 && p.chunk_points >= 1 && p.chunk_span >= 1;
+}
+
+static inline uint64_t now_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+/* =========================================================
+ * Sensors
+ * ========================================================= */
+/* SensorID values, common/include/sensors/domain_types.hpp */
+static constexpr uint8_t ENV_TEMP = 0x00;
+static constexpr uint8_t ENV_RH = 0x01;
+static constexpr uint8_t BATTERY_VOLTAGE = 0x40;
+static constexpr uint8_t PROBES = 4;
+static constexpr uint32_t ENTRIES = PROBES * 4 + 3;
+
+static constexpr int64_t EPOCH = 1767225600; // 2026-01-01
+
+/* Slow random walk in thousandths, rounded to the sensor's resolution */
+struct Walk
+{
+    int32_t milli;
+    int32_t step;
+    int32_t resolution;
+    int32_t lo;
+    int32_t hi;
+
+    DataEntry next(uint8_t sensor_id, std::mt19937 &rng)
+    {
+        milli = std::clamp(milli + static_cast<int32_t>(rng() % (2 * step + 1)) - step, lo, hi);
+        const int32_t q = milli / resolution * resolution;
+        return DataEntry{sensor_id, static_cast<int16_t>(q / 1000), static_cast<int16_t>(q % 1000)};
+    }
+};
+
+struct Node
+{
+    std::vector<Walk> walks;
+};
+
+static Node make_node(std::mt19937 &rng)
+{
+    Node n;
+    for (uint8_t p = 0; p < PROBES; ++p)
+    {
+        n.walks.push_back({10000 * (p + 1), 0, 1000, 0, 100000});                                 // depth cm, fixed
+        n.walks.push_back({static_cast<int32_t>(25000 + rng() % 20000), 500, 500, 0, 100000});    // moisture 0.5 %
+        n.walks.push_back({static_cast<int32_t>(12000 + rng() % 6000), 500, 500, -20000, 50000}); // temp 0.5 C
+        n.walks.push_back({300000, 10000, 10000, 0, 2000000});                                    // EC 10 uS/cm
+    }
+    n.walks.push_back({static_cast<int32_t>(15000 + rng() % 10000), 300, 10, -30000, 60000});     // air temp
+    n.walks.push_back({static_cast<int32_t>(60000 + rng() % 20000), 1000, 100, 0, 100000});       // humidity
+    n.walks.push_back({3600, 2, 1, 3000, 4200});                                                  // battery
+    return n;
+}
+
+static uint8_t sensor_of(uint32_t entry)
+{
+    if (entry < PROBES * 4)
+        return wire::soil_probe(static_cast<uint8_t>(entry / 4), static_cast<uint8_t>(entry % 4));
+    const uint8_t tail[] = {ENV_TEMP, ENV_RH, BATTERY_VOLTAGE};
+    return tail[entry - PROBES * 4];
+}
+
+/* =========================================================
+ * Queries
+ * ========================================================= */
+struct QueryResult
+{
+    const char *name;
+    size_t points;
+    size_t expected;
+    double ms;
+};
+
+static QueryResult run_query(const TimeSeriesStore &db, const char *name, const TimeSeriesStore::Query &q,
+                             size_t expected)
+{
+    double sum = 0;
+    const uint64_t t0 = now_ns();
+    const size_t n = db.scan(q, [&](uint16_t, uint8_t, int64_t, double v) { sum += v; });
+    const uint64_t t1 = now_ns();
+
+    /* Keep the sum alive */
+    if (sum == -1.0)
+        std::printf(" ");
+    return QueryResult{name, n, expected, (t1 - t0) / 1e6};
+}
+
+/* =========================================================
+ * Main
+ * ========================================================= */
+int main(int argc, char **argv)
+{
+    BenchParams p;
+    if (!parse(argc, argv, p))
+    {
+        std::printf("usage: gapp_tsdbbench [--nodes N] [--days N] [--interval s] [--chunk-points N]\n"
+                    "                      [--chunk-span s] [--min-rate points/s] [--dir path] [--keep] [--csv]\n");
+        return 2;
+    }
+
+    bool temp_dir = false;
+    if (p.dir.empty())
+    {
+        char name[] = "/tmp/gapp_tsdbbench_XXXXXX";
+        if (!mkdtemp(name))
+        {
+            std::printf("cannot create a temporary directory\n");
+            return 1;
+        }
+        p.dir = name;
+        temp_dir = true;
+    }
+
+    const uint32_t samples = static_cast<uint32_t>(static_cast<uint64_t>(p.days) * 86400 / p.interval);
+    const int64_t end = EPOCH + static_cast<int64_t>(samples - 1) * p.interval;
+
+    std::mt19937 rng(1);
+    std::vector<Node> nodes;
+    for (uint32_t n = 0; n < p.nodes; ++n)
+        nodes.push_back(make_node(rng));
+
+    /* ---- Ingest: every node once per interval, in time order ---- */
+    TimeSeriesStore::Config cfg;
+    cfg.dir = p.dir;
+    cfg.chunk_points = p.chunk_points;
+    cfg.chunk_span_s = p.chunk_span;
+
+    uint64_t ingest_ns = 0;
+    uint64_t flush_ns = 0;
+    uint64_t points = 0;
+    TimeSeriesStore::Stats written{};
+    {
+        TimeSeriesStore db(cfg);
+        const int rc = db.open();
+        if (rc != 0)
+        {
+            std::printf("open %s: %d\n", p.dir.c_str(), rc);
+            return 1;
+        }
+
+        auto frame = std::make_unique<DataFrame>();
+        for (uint32_t s = 0; s < samples; ++s)
+        {
+            for (uint32_t n = 0; n < p.nodes; ++n)
+            {
+                frame->combined_id = make_combined_id(1, static_cast<uint16_t>(n + 1));
+                frame->timestamp = static_cast<uint32_t>(EPOCH + static_cast<int64_t>(s) * p.interval);
+                frame->count = ENTRIES;
+                for (uint32_t e = 0; e < ENTRIES; ++e)
+                    frame->entries[e] = nodes[n].walks[e].next(sensor_of(e), rng);
+
+                const uint64_t t0 = now_ns();
+                if (db.append(*frame) != 0)
+                {
+                    std::printf("append failed\n");
+                    return 1;
+                }
+                ingest_ns += now_ns() - t0;
+                points += ENTRIES;
+            }
+        }
+
+        const uint64_t f0 = now_ns();
+        db.flush();
+        flush_ns = now_ns() - f0;
+        written = db.stats();
+    }
+
+    /* ---- Reopen ---- */
+    TimeSeriesStore db(cfg);
+    const uint64_t r0 = now_ns();
+    const int rc = db.open();
+    const uint64_t reopen_ns = now_ns() - r0;
+    if (rc != 0)
+    {
+        std::printf("reopen %s: %d\n", p.dir.c_str(), rc);
+        return 1;
+    }
+    const TimeSeriesStore::Stats st = db.stats();
+
+    /* ---- Queries ---- */
+    const auto samples_since = [&](int64_t from) {
+        const int64_t first = std::max<int64_t>(0, (from - EPOCH + p.interval - 1) / p.interval);
+        return static_cast<size_t>(samples - std::min<int64_t>(first, samples));
+    };
+
+    std::vector<QueryResult> results;
+
+    TimeSeriesStore::Query moisture;
+    moisture.first_id = make_combined_id(1, 1);
+    moisture.last_id = make_combined_id(1, static_cast<uint16_t>(std::min<uint32_t>(200, p.nodes)));
+    for (uint8_t probe = 0; probe < PROBES; ++probe)
+        moisture.sensors.set(wire::soil_probe(probe, wire::PROBE_MOISTURE));
+    moisture.from = end - 7 * 86400 + 1;
+    results.push_back(run_query(db, "moisture, nodes 1-200, 7 days", moisture,
+                                std::min<uint32_t>(200, p.nodes) * PROBES * samples_since(moisture.from)));
+
+    TimeSeriesStore::Query one;
+    one.first_id = one.last_id = make_combined_id(1, static_cast<uint16_t>((p.nodes + 1) / 2));
+    one.sensors.set(ENV_TEMP);
+    one.from = end - 86400 + 1;
+    results.push_back(run_query(db, "air temp, one node, 1 day", one, samples_since(one.from)));
+
+    TimeSeriesStore::Query recent;
+    recent.sensors.set();
+    recent.from = end - 3600 + 1;
+    results.push_back(run_query(db, "all sensors, all nodes, 1 hour", recent,
+                                static_cast<size_t>(p.nodes) * ENTRIES * samples_since(recent.from)));
+
+    /* ---- Report ---- */
+    const double rate = ingest_ns ? points / (ingest_ns / 1e9) : 0;
+    const double bytes_per_point = st.points ? static_cast<double>(st.sealed_bytes) / st.points : 0;
+
+    bool ok = st.points == points && written.points == points && rate >= p.min_rate;
+    for (const QueryResult &r : results)
+        ok &= r.points == r.expected;
+
+    if (p.csv)
+    {
+        std::printf("nodes,days,interval_s,points,series,chunks,segments,ingest_points_per_s,bytes_per_point,"
+                    "flush_ms,reopen_ms,q_moisture_ms,q_one_node_ms,q_last_hour_ms,pass\n");
+        std::printf("%u,%u,%u,%llu,%llu,%llu,%llu,%.0f,%.3f,%.1f,%.1f,%.3f,%.3f,%.3f,%d\n", p.nodes, p.days,
+                    p.interval, (unsigned long long)points, (unsigned long long)st.series,
+                    (unsigned long long)st.chunks, (unsigned long long)st.segments, rate, bytes_per_point,
+                    flush_ns / 1e6, reopen_ns / 1e6, results[0].ms, results[1].ms, results[2].ms, ok ? 1 : 0);
+    }
+    else
+    {
+        std::printf("data:     %u nodes x %u sensors, every %u s for %u days, %llu points\n", p.nodes, ENTRIES,
+                    p.interval, p.days, (unsigned long long)points);
+        std::printf("ingest:   %.0f points/s (%.0f frames/s)\n", rate, rate / ENTRIES);
+        std::printf("size:     %.3f bytes/point, %llu series, %llu chunks, %llu segments, flush %.1f ms\n",
+                    bytes_per_point, (unsigned long long)st.series, (unsigned long long)st.chunks,
+                    (unsigned long long)st.segments, flush_ns / 1e6);
+        std::printf("reopen:   %.1f ms\n", reopen_ns / 1e6);
+        for (const QueryResult &r : results)
+            std::printf("query:    %-32s %9zu points %9.3f ms%s\n", r.name, r.points, r.ms,
+                        r.points == r.expected ? "" : "  WRONG COUNT");
+    }
+
+    if (temp_dir && !p.keep)
+    {
+        std::error_code ec;
+        fs::remove_all(p.dir, ec);
+    }
+    return ok ? 0 : 1;
+}